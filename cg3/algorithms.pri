@@ -22,8 +22,10 @@ HEADERS += \
     $$PWD/algorithms/marching_cubes.h \
     $$PWD/algorithms/mesh_function_smoothing.h \
     $$PWD/algorithms/normalization.h \
+    $$PWD/algorithms/quickhull3.h \
     $$PWD/algorithms/saliency.h \
     $$PWD/algorithms/sphere_coverage.h \
+    $$PWD/algorithms/sphere_directions.h \
     $$PWD/algorithms/global_optimal_rotation_matrix.h
 
 CG3_STATIC {
@@ -37,8 +39,10 @@ SOURCES += \
     $$PWD/algorithms/marching_cubes.cpp \
     $$PWD/algorithms/mesh_function_smoothing.cpp \
     $$PWD/algorithms/normalization.cpp \
+    $$PWD/algorithms/quickhull3.cpp \
     $$PWD/algorithms/saliency.cpp \
     $$PWD/algorithms/laplacian_smoothing.cpp \
-    $$PWD/algorithms/sphere_coverage.cpp
+    $$PWD/algorithms/sphere_coverage.cpp \
+    $$PWD/algorithms/sphere_directions.cpp
 
 }
@@ -6,20 +6,38 @@
  */
 #include "convex_hull2.h"
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "cg3/geometry/point2.h"
 #include "cg3/geometry/utils2.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace cg3 {
 
 /* ----- INTERNAL FUNCTION DECLARATION ----- */
 
 namespace internal {
 
+/** Minimum number of points for which the parallel pipeline is used */
+static const unsigned int CONVEX_HULL_2D_PARALLEL_THRESHOLD = 1 << 14;
+
+/** Number of point sets processed by each task of the batched hulls */
+static const unsigned int CONVEX_HULL_2D_BATCH_BLOCK = 1024;
+
 template <class T = double, class InputIterator, class OutputIterator>
 inline void grahamScanOnContainer(const InputIterator first, const InputIterator end, OutputIterator& outIt);
 
+template <class T = double, class OutputIterator>
+inline OutputIterator sortedConvexHull2D(const std::vector<Point2<T>>& sortedPoints, OutputIterator outIt);
+
+template <class T = double>
+inline void octagonFilter2D(const std::vector<T>& x, const std::vector<T>& y, std::vector<unsigned char>& keep);
+
 } //namespace cg3::internal
 
 
@@ -54,6 +72,197 @@ OutputIterator convexHull2D(InputIterator first, InputIterator end, OutputIterat
     std::vector<Point2<T>> sortedPoints(first, end);
     std::sort(sortedPoints.begin(), sortedPoints.end());
 
+    return internal::sortedConvexHull2D<T>(sortedPoints, outIt);
+}
+
+
+
+/* ----- IMPLEMENTATION OF PARALLEL PIPELINE ----- */
+
+/**
+ * @brief Get the 2D convex hull using the parallel pipeline.
+ * See the iterator version for the differences with convexHull2D.
+ * @param[in] container Container of the points of the shape
+ * @param[out] convexHull Output container for the convex hull
+ */
+template <class T, class InputContainer, class OutputContainer>
+void parallelConvexHull2D(const InputContainer& container, OutputContainer& convexHull)
+{
+    parallelConvexHull2D<T>(container.begin(), container.end(), std::back_inserter(convexHull));
+}
+
+/**
+ * @brief Get the 2D convex hull using the parallel pipeline on iterators of containers.
+ *
+ * Points are stored as separated coordinate arrays, and the points that lie
+ * inside the octagon of the extreme points along 8 directions are discarded
+ * with a vectorized test. The remaining points are split in chunks whose hulls
+ * are computed in parallel, and the hull of the union of the chunk hulls is the
+ * result.
+ *
+ * The orientation tests are not exact: with more than one thread, on
+ * (near-)collinear or (near-)coincident points the output can differ from
+ * the one of convexHull2D, which tests the points in another order (e.g. a
+ * point lying almost on a hull edge can be kept by one and discarded by the
+ * other). On points in general position the output is the same.
+ *
+ * @param[in] first First iterator of the input container
+ * @param[in] end End iterator of the input container
+ * @param[out] outIt Output iterator for the container containing the convex hull
+ * @return New output iterator
+ */
+template <class T, class InputIterator, class OutputIterator>
+OutputIterator parallelConvexHull2D(InputIterator first, InputIterator end, OutputIterator outIt)
+{
+    std::vector<Point2<T>> points(first, end);
+    if (points.size() < internal::CONVEX_HULL_2D_PARALLEL_THRESHOLD)
+        return convexHull2D<T>(points.begin(), points.end(), outIt);
+
+    //Octagon pre-filter on separated coordinates
+    const long long int n = (long long int)points.size();
+    std::vector<T> x(n), y(n);
+    #pragma omp parallel for
+    for (long long int i = 0; i < n; i++) {
+        x[i] = points[i].x();
+        y[i] = points[i].y();
+    }
+    std::vector<unsigned char> keep;
+    internal::octagonFilter2D<T>(x, y, keep);
+
+    std::vector<Point2<T>> candidates;
+    for (long long int i = 0; i < n; i++)
+        if (keep[i])
+            candidates.push_back(points[i]);
+
+    //Chunked hulls
+    unsigned int nChunks = 1;
+    #ifdef _OPENMP
+    nChunks = omp_get_max_threads();
+    #endif
+    if (nChunks > 1 && candidates.size() >= internal::CONVEX_HULL_2D_PARALLEL_THRESHOLD) {
+        std::vector<std::vector<Point2<T>>> chunkHulls(nChunks);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int c = 0; c < (int)nChunks; c++) {
+            convexHull2D<T>(
+                        candidates.begin() + candidates.size() * c / nChunks,
+                        candidates.begin() + candidates.size() * (c+1) / nChunks,
+                        std::back_inserter(chunkHulls[c]));
+        }
+
+        candidates.clear();
+        for (const std::vector<Point2<T>>& chunkHull : chunkHulls)
+            candidates.insert(candidates.end(), chunkHull.begin(), chunkHull.end());
+    }
+
+    return convexHull2D<T>(candidates.begin(), candidates.end(), outIt);
+}
+
+
+
+/* ----- IMPLEMENTATION OF BATCHED CONVEX HULLS ----- */
+
+/**
+ * @brief Get the 2D convex hulls of many point sets, processed in parallel.
+ *
+ * Point sets are stored in a single vector: the i-th set is composed by the
+ * points in [offsets[i], offsets[i+1]). The hulls are returned in the same
+ * layout, each one with the order of convexHull2D.
+ *
+ * @param[in] points Points of all the sets
+ * @param[in] offsets Offsets of the sets (number of sets + 1)
+ * @param[out] hulls Points of all the hulls
+ * @param[out] hullOffsets Offsets of the hulls (number of sets + 1)
+ */
+template <class T>
+void convexHulls2D(
+        const std::vector<Point2<T>>& points,
+        const std::vector<unsigned int>& offsets,
+        std::vector<Point2<T>>& hulls,
+        std::vector<unsigned int>& hullOffsets)
+{
+    hulls.clear();
+    hullOffsets.clear();
+    if (offsets.empty())
+        return;
+
+    const unsigned int nSets = (unsigned int)offsets.size() - 1;
+    const unsigned int nBlocks = (nSets + internal::CONVEX_HULL_2D_BATCH_BLOCK - 1) / internal::CONVEX_HULL_2D_BATCH_BLOCK;
+    std::vector<std::vector<Point2<T>>> blockHulls(nBlocks);
+    hullOffsets.resize(nSets + 1, 0);
+
+    #pragma omp parallel
+    {
+        std::vector<Point2<T>> sortedPoints;
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < (int)nBlocks; b++) {
+            const unsigned int firstSet = b * internal::CONVEX_HULL_2D_BATCH_BLOCK;
+            const unsigned int lastSet = std::min(nSets, firstSet + internal::CONVEX_HULL_2D_BATCH_BLOCK);
+            for (unsigned int s = firstSet; s < lastSet; s++) {
+                const size_t sizeBefore = blockHulls[b].size();
+                if (offsets[s] < offsets[s+1]) {
+                    sortedPoints.assign(points.begin() + offsets[s], points.begin() + offsets[s+1]);
+                    std::sort(sortedPoints.begin(), sortedPoints.end());
+                    internal::sortedConvexHull2D<T>(sortedPoints, std::back_inserter(blockHulls[b]));
+                }
+                hullOffsets[s+1] = (unsigned int)(blockHulls[b].size() - sizeBefore);
+            }
+        }
+    }
+
+    for (unsigned int s = 0; s < nSets; s++)
+        hullOffsets[s+1] += hullOffsets[s];
+
+    hulls.resize(hullOffsets[nSets]);
+    #pragma omp parallel for
+    for (int b = 0; b < (int)nBlocks; b++) {
+        std::copy(
+                    blockHulls[b].begin(),
+                    blockHulls[b].end(),
+                    hulls.begin() + hullOffsets[b * internal::CONVEX_HULL_2D_BATCH_BLOCK]);
+    }
+}
+
+/**
+ * @brief Get the 2D convex hulls of many point sets, processed in parallel
+ * @param[in] pointSets Containers of the points of each set
+ * @param[out] hulls Convex hull of each set, with the order of convexHull2D
+ */
+template <class T, class InputContainer>
+void convexHulls2D(
+        const std::vector<InputContainer>& pointSets,
+        std::vector<std::vector<Point2<T>>>& hulls)
+{
+    hulls.clear();
+    hulls.resize(pointSets.size());
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long int s = 0; s < (long long int)pointSets.size(); s++) {
+        convexHull2D<T>(pointSets[s].begin(), pointSets[s].end(), std::back_inserter(hulls[s]));
+    }
+}
+
+
+
+
+/* ----- INTERNAL FUNCTIONS IMPLEMENTATION ----- */
+
+namespace internal {
+
+/**
+ * @brief Graham scan on upper and lower convex hull of sorted points
+ * @param[in] sortedPoints Points sorted in lexicographic order
+ * @param[out] outIt Output iterator for the container containing the convex hull
+ * @return New output iterator
+ */
+template <class T, class OutputIterator>
+OutputIterator sortedConvexHull2D(const std::vector<Point2<T>>& sortedPoints, OutputIterator outIt)
+{
+    //If the container is empty
+    if (sortedPoints.empty())
+        return outIt;
+
     //If the is composed by 1 points (or more than 1 of the same point)
     if (*(sortedPoints.begin()) == *(sortedPoints.rbegin())) {
         *outIt = *(sortedPoints.begin());
@@ -63,18 +272,101 @@ OutputIterator convexHull2D(InputIterator first, InputIterator end, OutputIterat
     }
 
     //Graham scan on upper and lower convex hull
-    internal::grahamScanOnContainer<T>(sortedPoints.begin(), sortedPoints.end(), outIt);
-    internal::grahamScanOnContainer<T>(sortedPoints.rbegin(), sortedPoints.rend(), outIt);
+    grahamScanOnContainer<T>(sortedPoints.begin(), sortedPoints.end(), outIt);
+    grahamScanOnContainer<T>(sortedPoints.rbegin(), sortedPoints.rend(), outIt);
 
     return outIt;
 }
 
+/**
+ * @brief Octagon pre-filter: computes the extreme points along 8 directions
+ * and marks the points that lie outside (or on the boundary of) the octagon
+ * they form. Points strictly inside cannot be vertices of the hull.
+ * The test is vectorized over the separated coordinate arrays.
+ * @param[in] x X coordinates of the points
+ * @param[in] y Y coordinates of the points
+ * @param[out] keep 1 for the points that may be on the convex hull, 0 otherwise
+ */
+template <class T>
+void octagonFilter2D(const std::vector<T>& x, const std::vector<T>& y, std::vector<unsigned char>& keep)
+{
+    const long long int n = (long long int)x.size();
+    keep.assign(n, 1);
+    if (n == 0)
+        return;
+
+    //Directions in counterclockwise order: x, x+y, y, -x+y, -x, -x-y, -y, x-y
+    long long int extremes[8];
+    double extremeValues[8];
+    for (unsigned int d = 0; d < 8; d++) {
+        extremes[d] = 0;
+        extremeValues[d] = -std::numeric_limits<double>::max();
+    }
 
+    #pragma omp parallel
+    {
+        long long int localExtremes[8];
+        double localValues[8];
+        for (unsigned int d = 0; d < 8; d++) {
+            localExtremes[d] = 0;
+            localValues[d] = -std::numeric_limits<double>::max();
+        }
 
+        #pragma omp for nowait
+        for (long long int i = 0; i < n; i++) {
+            const double px = x[i], py = y[i];
+            const double values[8] = {px, px + py, py, py - px, -px, -px - py, -py, px - py};
+            for (unsigned int d = 0; d < 8; d++) {
+                if (values[d] > localValues[d]) {
+                    localValues[d] = values[d];
+                    localExtremes[d] = i;
+                }
+            }
+        }
 
-/* ----- INTERNAL FUNCTIONS IMPLEMENTATION ----- */
+        #pragma omp critical
+        {
+            for (unsigned int d = 0; d < 8; d++) {
+                if (localValues[d] > extremeValues[d] ||
+                        (localValues[d] == extremeValues[d] && localExtremes[d] < extremes[d])) {
+                    extremeValues[d] = localValues[d];
+                    extremes[d] = localExtremes[d];
+                }
+            }
+        }
+    }
 
-namespace internal {
+    //Edges of the octagon, skipping the repeated vertices
+    double ax[8], ay[8], ex[8], ey[8];
+    unsigned int nEdges = 0;
+    for (unsigned int d = 0; d < 8; d++) {
+        const long long int a = extremes[d], b = extremes[(d+1)%8];
+        if (x[a] != x[b] || y[a] != y[b]) {
+            ax[nEdges] = x[a];
+            ay[nEdges] = y[a];
+            ex[nEdges] = (double)x[b] - x[a];
+            ey[nEdges] = (double)y[b] - y[a];
+            nEdges++;
+        }
+    }
+    if (nEdges < 3)
+        return;
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    const T* px = x.data();
+    const T* py = y.data();
+    unsigned char* k = keep.data();
+
+    #pragma omp parallel for simd
+    for (long long int i = 0; i < n; i++) {
+        unsigned char inside = 1;
+        for (unsigned int e = 0; e < nEdges; e++)
+            inside &= (ex[e] * (py[i] - ay[e]) - ey[e] * (px[i] - ax[e]) > eps);
+        k[i] = !inside;
+    }
+    for (unsigned int d = 0; d < 8; d++)
+        k[extremes[d]] = 1;
+}
 
 /**
  * @brief Graham scan on a collection of points (upper or lower)
@@ -7,6 +7,10 @@
 #ifndef CG3_CONVEXHULL2D_H
 #define CG3_CONVEXHULL2D_H
 
+#include <vector>
+
+#include "cg3/geometry/point2.h"
+
 namespace cg3 {
 
 /* Graham scan */
@@ -17,6 +21,28 @@ void convexHull2D(const InputContainer& container, OutputContainer& convexHull);
 template <class T = double, class InputIterator, class OutputIterator>
 OutputIterator convexHull2D(const InputIterator first, const InputIterator end, OutputIterator outIt);
 
+/* Parallel pipeline: octagon pre-filter and chunked hulls */
+
+template <class T = double, class InputContainer, class OutputContainer>
+void parallelConvexHull2D(const InputContainer& container, OutputContainer& convexHull);
+
+template <class T = double, class InputIterator, class OutputIterator>
+OutputIterator parallelConvexHull2D(const InputIterator first, const InputIterator end, OutputIterator outIt);
+
+/* Batched hulls of many point sets */
+
+template <class T = double>
+void convexHulls2D(
+        const std::vector<Point2<T>>& points,
+        const std::vector<unsigned int>& offsets,
+        std::vector<Point2<T>>& hulls,
+        std::vector<unsigned int>& hullOffsets);
+
+template <class T = double, class InputContainer>
+void convexHulls2D(
+        const std::vector<InputContainer>& pointSets,
+        std::vector<std::vector<Point2<T>>>& hulls);
+
 } //namespace cg3
 
 #include "convex_hull2.cpp"
@@ -6,6 +6,8 @@
  */
 #include "convex_hull2_incremental.h"
 
+#include "convex_hull2.h"
+
 namespace cg3 {
 
 
@@ -13,6 +15,9 @@ namespace cg3 {
 
 namespace internal {
 
+/** Minimum number of points that are inserted as a single batch */
+static const unsigned int INCREMENTAL_CONVEX_HULL_2D_BATCH_THRESHOLD = 64;
+
 template <class T>
 void processConvexHull(
         const Point2<T>& point,
@@ -72,8 +77,14 @@ IncrementalConvexHull<T>::IncrementalConvexHull(const InputContainer& container)
 template <class T> template <class InputIterator>
 void IncrementalConvexHull<T>::addPoints(const InputIterator first, const InputIterator end)
 {
-    for (InputIterator it = first; it != end; it++) {
-        this->addPoint(*it);
+    std::vector<Point2<T>> points(first, end);
+    if (points.size() >= internal::INCREMENTAL_CONVEX_HULL_2D_BATCH_THRESHOLD) {
+        this->addPointsBatch(points);
+    }
+    else {
+        for (const Point2<T>& p : points) {
+            this->addPoint(p);
+        }
     }
 }
 
@@ -101,6 +112,35 @@ void IncrementalConvexHull<T>::addPoint(const Point2<T>& point)
     internal::processConvexHull<T>(point, this->upper, this->lower);
 }
 
+/**
+ * @brief Add a batch of points to the convex hull: the hull of the current
+ * hull vertices and of the new points is computed with the parallel pipeline,
+ * and the upper and lower hulls are rebuilt from it.
+ * It is used by addPoints for large sets of points, and it is faster than
+ * inserting the points one at a time when points are streamed in batches.
+ * @param[in] points Input points
+ */
+template <class T>
+void IncrementalConvexHull<T>::addPointsBatch(const std::vector<Point2<T>>& points)
+{
+    std::vector<Point2<T>> allPoints(points);
+    this->convexHull(std::back_inserter(allPoints));
+
+    std::vector<Point2<T>> hull;
+    parallelConvexHull2D<T>(allPoints.begin(), allPoints.end(), std::back_inserter(hull));
+
+    this->clear();
+    if (hull.empty())
+        return;
+
+    //The hull starts from the minimum point and reaches the maximum point
+    //through the upper hull, then goes back through the lower hull
+    typename std::vector<Point2<T>>::iterator maxIt = std::max_element(hull.begin(), hull.end());
+    this->upper.insert(hull.begin(), std::next(maxIt));
+    this->lower.insert(maxIt, hull.end());
+    this->lower.insert(hull.front());
+}
+
 /**
  * @brief Get convex hull of the current data structure
  * @param[out] out Output iterator
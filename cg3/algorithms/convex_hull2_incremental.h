@@ -8,6 +8,7 @@
 #define CG3_CONVEXHULL2D_INCREMENTAL_H
 
 #include <set>
+#include <vector>
 
 #include "cg3/geometry/point2.h"
 #include "cg3/geometry/utils2.h"
@@ -44,6 +45,8 @@ public:
     template <class InputIterator>
     void addPoints(const InputIterator first, const InputIterator end);
 
+    void addPointsBatch(const std::vector<Point2<T>>& points);
+
 
     template <class OutputIterator>
     void convexHull(OutputIterator out);
@@ -11,6 +11,9 @@
 
 #include <cg3/geometry/transformations3.h>
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef CG3_DCEL_DEFINED
 #include <cg3/meshes/dcel/dcel.h>
 #endif
@@ -33,6 +36,182 @@ CG3_INLINE void defineRotation(const cg3::Vec3d& zAxis,
 }
 
 #ifdef CG3_WITH_EIGEN
+
+namespace internal {
+
+/**
+ * @brief Rotation matrix that brings zAxis on the Z axis, with the same
+ * convention of defineRotation. Directions (anti)parallel to Z are handled
+ * explicitly, since the rotation axis is not defined.
+ */
+CG3_INLINE Eigen::Matrix3d rotationToZAxis(const Vec3d& zAxis)
+{
+	Vec3d dir = zAxis;
+	dir.normalize();
+	if (dir.z() >= 1 - CG3_EPSILON)
+		return Eigen::Matrix3d::Identity();
+	if (dir.z() <= -1 + CG3_EPSILON)
+		return cg3::rotationMatrix(Vec3d(1,0,0), M_PI);
+
+	Vec3d axis;
+	double angle;
+	defineRotation(dir, axis, angle);
+	return cg3::rotationMatrix(axis, angle);
+}
+
+/**
+ * @brief Sum over the normals of the L1 norm of the rotated normals.
+ * Each row of the matrix gives one component of the rotated normals, so the
+ * kernel is a vectorizable reduction over the contiguous arrays.
+ */
+CG3_INLINE double l1Extent(const NormalArrays& normals, const Eigen::Matrix3d& m)
+{
+	const double m00 = m(0,0), m01 = m(0,1), m02 = m(0,2);
+	const double m10 = m(1,0), m11 = m(1,1), m12 = m(1,2);
+	const double m20 = m(2,0), m21 = m(2,1), m22 = m(2,2);
+	const double* nx = normals.x.data();
+	const double* ny = normals.y.data();
+	const double* nz = normals.z.data();
+	const long long int n = (long long int) normals.x.size();
+
+	double extent = 0.0;
+	#pragma omp simd reduction(+:extent)
+	for (long long int i = 0; i < n; i++) {
+		extent += std::fabs(m00 * nx[i] + m01 * ny[i] + m02 * nz[i]) +
+				std::fabs(m10 * nx[i] + m11 * ny[i] + m12 * nz[i]) +
+				std::fabs(m20 * nx[i] + m21 * ny[i] + m22 * nz[i]);
+	}
+	return extent;
+}
+
+/**
+ * @brief Computes, in parallel, the L1 extent of the normals rotated
+ * by the rotation associated to each direction of the pool
+ */
+CG3_INLINE void l1Extents(
+		const NormalArrays& normals,
+		const std::vector<Vec3d>& dirPool,
+		std::vector<double>& extents)
+{
+	extents.resize(dirPool.size());
+
+	#pragma omp parallel for schedule(dynamic, 8)
+	for (long long int i = 0; i < (long long int) dirPool.size(); i++) {
+		extents[i] = l1Extent(normals, rotationToZAxis(dirPool[i]));
+	}
+}
+
+/**
+ * @brief Fibonacci sampling of the spherical cap of the given half angle
+ * centered on dir
+ */
+CG3_INLINE std::vector<Vec3d> sphericalCapDirections(const Vec3d& dir, double halfAngle, unsigned int nSamples)
+{
+	const Eigen::Matrix3d toDir = rotationToZAxis(dir).transpose();
+	const double minCos = std::cos(halfAngle);
+	const double Phi = std::sqrt(3);
+
+	std::vector<Vec3d> dirs;
+	dirs.reserve(nSamples);
+	for (unsigned int i = 0; i < nSamples; i++){
+		double phi = 2*M_PI * (i/Phi - std::floor(i/Phi));
+		double cosTheta = 1 - (1 - minCos) * (i + 0.5) / nSamples;
+		double sinTheta = std::sqrt(std::max(0.0, 1 - cosTheta*cosTheta));
+		Vec3d d(cos(phi)*sinTheta, sin(phi)*sinTheta, cosTheta);
+		d.rotate(toDir);
+		dirs.push_back(d);
+	}
+	return dirs;
+}
+
+/**
+ * @brief Batched evaluation of the directions of the pool. If refinementLevels
+ * is greater than zero, the best directions are refined by sampling spherical
+ * caps around them, halving the cap at each level.
+ */
+CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(
+		const NormalArrays& normals,
+		const std::vector<Vec3d>& dirPool,
+		unsigned int refinementLevels)
+{
+	static const unsigned int N_REFINED_CANDIDATES = 4;
+	static const unsigned int N_CAP_SAMPLES = 64;
+
+	if (dirPool.empty())
+		return Eigen::Matrix3d::Identity();
+
+	std::vector<double> extents;
+	l1Extents(normals, dirPool, extents);
+
+	//Candidates sorted by extent (and direction, for ties)
+	std::vector<unsigned int> order(dirPool.size());
+	for (unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+		return extents[a] < extents[b] || (extents[a] == extents[b] && dirPool[a] < dirPool[b]);
+	});
+
+	Vec3d bestZ = dirPool[order[0]];
+	double bestExtent = extents[order[0]];
+
+	if (refinementLevels > 0) {
+		//Initial cap: the average spacing of the directions of the pool
+		const double startAngle = std::sqrt(4 * M_PI / dirPool.size());
+		const unsigned int nCandidates = std::min((unsigned int) order.size(), N_REFINED_CANDIDATES);
+		for (unsigned int c = 0; c < nCandidates; c++) {
+			Vec3d candidate = dirPool[order[c]];
+			double candidateExtent = extents[order[c]];
+			double angle = startAngle;
+			for (unsigned int l = 0; l < refinementLevels; l++) {
+				std::vector<Vec3d> capDirs = sphericalCapDirections(candidate, angle, N_CAP_SAMPLES);
+				std::vector<double> capExtents;
+				l1Extents(normals, capDirs, capExtents);
+				for (unsigned int i = 0; i < capDirs.size(); i++) {
+					if (capExtents[i] < candidateExtent) {
+						candidateExtent = capExtents[i];
+						candidate = capDirs[i];
+					}
+				}
+				angle /= 2;
+			}
+			if (candidateExtent < bestExtent) {
+				bestExtent = candidateExtent;
+				bestZ = candidate;
+			}
+		}
+	}
+
+	return rotationToZAxis(bestZ);
+}
+
+} //namespace cg3::internal
+
+/**
+ * @ingroup cg3Algorithms
+ * @brief Computes the rotation matrix that, if applied to a set of normals,
+ * minimizes the angle between the normals and the global axis
+ * @param normals: the normals (e.g. the face normals of a mesh)
+ * @param dirPool: candidate directions
+ * @param refinementLevels: number of coarse-to-fine refinements around the best directions
+ * @return A rotation matrix for the normals
+ */
+CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(
+		const std::vector<Vec3d>& normals,
+		const std::vector<Vec3d>& dirPool,
+		unsigned int refinementLevels)
+{
+	internal::NormalArrays n;
+	n.x.resize(normals.size());
+	n.y.resize(normals.size());
+	n.z.resize(normals.size());
+	for (unsigned int i = 0; i < normals.size(); i++) {
+		n.x[i] = normals[i].x();
+		n.y[i] = normals[i].y();
+		n.z[i] = normals[i].z();
+	}
+	return internal::globalOptimalRotationMatrix(n, dirPool, refinementLevels);
+}
+
 #ifdef CG3_DCEL_DEFINED
 /**
  * @ingroup cg3Algorithms
@@ -40,46 +219,35 @@ CG3_INLINE void defineRotation(const cg3::Vec3d& zAxis,
  * minimizes the angle between the face normals and the global axis
  * @param inputMesh
  * @param nDirs
+ * @param refinementLevels: number of coarse-to-fine refinements around the best directions
  * @return A rotation matrix for the input mesh
  */
 CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(
 		const cg3::Dcel& inputMesh,
-		unsigned int nDirs)
+		unsigned int nDirs,
+		unsigned int refinementLevels)
 {
+	std::shared_ptr<const std::vector<Vec3d>> dirPool = cg3::sharedSphereCoverageFibonacci(nDirs);
 
-	std::vector<Vec3d> dirPool = cg3::sphereCoverageFibonacci(nDirs);
-
-	return globalOptimalRotationMatrix(inputMesh, dirPool);
+	return globalOptimalRotationMatrix(inputMesh, *dirPool, refinementLevels);
 }
 
-CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(const Dcel &inputMesh, const std::vector<Vec3d> &dirPool)
+CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(
+		const Dcel &inputMesh,
+		const std::vector<Vec3d> &dirPool,
+		unsigned int refinementLevels)
 {
-	std::set<std::pair<double,Vec3d>> priorizitedOrientations;
-	for(Vec3d zAxis : dirPool) {
-		Vec3d axis;
-		double angle;
-		zAxis.normalize();
-		defineRotation(zAxis, axis, angle);
-		Eigen::Matrix3d mr = rotationMatrix(axis, angle);
-
-		double L1_extent = 0.0;
-		for(const Dcel::Face* f : inputMesh.faceIterator()) {
-			Vec3d n = f->normal();
-			n.rotate(mr);
-			L1_extent += std::fabs(n.x()) + std::fabs(n.y()) + std::fabs(n.z());
-		}
-
-		priorizitedOrientations.insert(std::make_pair(L1_extent,zAxis));
+	internal::NormalArrays normals;
+	normals.x.reserve(inputMesh.numberFaces());
+	normals.y.reserve(inputMesh.numberFaces());
+	normals.z.reserve(inputMesh.numberFaces());
+	for(const Dcel::Face* f : inputMesh.faceIterator()) {
+		normals.x.push_back(f->normal().x());
+		normals.y.push_back(f->normal().y());
+		normals.z.push_back(f->normal().z());
 	}
 
-	Vec3d  bestZ  = priorizitedOrientations.begin()->second;
-
-	Vec3d  axis;
-	double angle;
-	bestZ.normalize();
-	defineRotation(bestZ, axis, angle);
-
-	return cg3::rotationMatrix(axis, angle);
+	return internal::globalOptimalRotationMatrix(normals, dirPool, refinementLevels);
 }
 #endif
 
@@ -90,47 +258,38 @@ CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(const Dcel &inputMesh, co
  * minimizes the angle between the face normals and the global axis
  * @param inputMesh
  * @param nDirs
+ * @param refinementLevels: number of coarse-to-fine refinements around the best directions
  * @return
  */
 CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(
         const SimpleEigenMesh& inputMesh,
-		unsigned int nDirs)
+		unsigned int nDirs,
+		unsigned int refinementLevels)
 {
-	std::vector<Vec3d> dirPool = cg3::sphereCoverageFibonacci(nDirs);
+	std::shared_ptr<const std::vector<Vec3d>> dirPool = cg3::sharedSphereCoverageFibonacci(nDirs);
 
-	return globalOptimalRotationMatrix(inputMesh, dirPool);
+	return globalOptimalRotationMatrix(inputMesh, *dirPool, refinementLevels);
 }
 
 CG3_INLINE Eigen::Matrix3d globalOptimalRotationMatrix(
 		const SimpleEigenMesh &inputMesh,
-		const std::vector<Vec3d> &dirPool)
+		const std::vector<Vec3d> &dirPool,
+		unsigned int refinementLevels)
 {
-	std::set<std::pair<double,Vec3d>> priorizitedOrientations;
-	for(Vec3d zAxis : dirPool) {
-		Vec3d axis;
-		double angle;
-		zAxis.normalize();
-		defineRotation(zAxis, axis, angle);
-		Eigen::Matrix3d mr = rotationMatrix(axis, angle);
-
-		double L1_extent = 0.0;
-		for(unsigned int f = 0; f < inputMesh.numberFaces(); f++) {
-			Vec3d n = inputMesh.faceNormal(f);
-			n.rotate(mr);
-			L1_extent += std::fabs(n.x()) + std::fabs(n.y()) + std::fabs(n.z());
-		}
+	internal::NormalArrays normals;
+	normals.x.resize(inputMesh.numberFaces());
+	normals.y.resize(inputMesh.numberFaces());
+	normals.z.resize(inputMesh.numberFaces());
 
-		priorizitedOrientations.insert(std::make_pair(L1_extent,zAxis));
+	#pragma omp parallel for
+	for(long long int f = 0; f < (long long int) inputMesh.numberFaces(); f++) {
+		Vec3d n = inputMesh.faceNormal(f);
+		normals.x[f] = n.x();
+		normals.y[f] = n.y();
+		normals.z[f] = n.z();
 	}
 
-	Vec3d  bestZ  = priorizitedOrientations.begin()->second;
-
-	Vec3d  axis;
-	double angle;
-	bestZ.normalize();
-	defineRotation(bestZ, axis, angle);
-
-	return cg3::rotationMatrix(axis, angle);
+	return internal::globalOptimalRotationMatrix(normals, dirPool, refinementLevels);
 }
 
 #endif
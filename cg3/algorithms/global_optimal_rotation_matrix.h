@@ -10,6 +10,8 @@
 
 #include <cg3/geometry/point3.h>
 
+#include <vector>
+
 #ifdef CG3_WITH_EIGEN
 #include <Eigen/Core>
 #endif
@@ -17,15 +19,43 @@
 namespace cg3 {
 
 #ifdef CG3_WITH_EIGEN
+
+namespace internal {
+
+/**
+ * @brief Face normals stored as separated contiguous arrays
+ */
+struct NormalArrays {
+	std::vector<double> x, y, z;
+};
+
+Eigen::Matrix3d rotationToZAxis(const cg3::Vec3d& zAxis);
+double l1Extent(const NormalArrays& normals, const Eigen::Matrix3d& m);
+void l1Extents(
+		const NormalArrays& normals,
+		const std::vector<cg3::Vec3d>& dirPool,
+		std::vector<double>& extents);
+Eigen::Matrix3d globalOptimalRotationMatrix(
+		const NormalArrays& normals,
+		const std::vector<cg3::Vec3d>& dirPool,
+		unsigned int refinementLevels);
+
+} //namespace cg3::internal
+
+Eigen::Matrix3d globalOptimalRotationMatrix(
+		const std::vector<cg3::Vec3d>& normals,
+		const std::vector<cg3::Vec3d>& dirPool,
+		unsigned int refinementLevels = 0);
+
 #ifdef CG3_DCEL_DEFINED
 class Dcel;
-Eigen::Matrix3d globalOptimalRotationMatrix(const Dcel& inputMesh, unsigned int nDirs = 1000);
-Eigen::Matrix3d globalOptimalRotationMatrix(const Dcel& inputMesh, const std::vector<cg3::Vec3d>& dirPool);
+Eigen::Matrix3d globalOptimalRotationMatrix(const Dcel& inputMesh, unsigned int nDirs = 1000, unsigned int refinementLevels = 0);
+Eigen::Matrix3d globalOptimalRotationMatrix(const Dcel& inputMesh, const std::vector<cg3::Vec3d>& dirPool, unsigned int refinementLevels = 0);
 #endif // CG3_DCEL_DEFINED
 #ifdef CG3_EIGENMESH_DEFINED
 class SimpleEigenMesh;
-Eigen::Matrix3d globalOptimalRotationMatrix(const SimpleEigenMesh& inputMesh, unsigned int nDirs = 1000);
-Eigen::Matrix3d globalOptimalRotationMatrix(const SimpleEigenMesh& inputMesh, const std::vector<cg3::Vec3d>& dirPool);
+Eigen::Matrix3d globalOptimalRotationMatrix(const SimpleEigenMesh& inputMesh, unsigned int nDirs = 1000, unsigned int refinementLevels = 0);
+Eigen::Matrix3d globalOptimalRotationMatrix(const SimpleEigenMesh& inputMesh, const std::vector<cg3::Vec3d>& dirPool, unsigned int refinementLevels = 0);
 #endif // CG3_EIGENMESH_DEFINED
 #endif // CG3_WITH_EIGEN
 
@@ -6,46 +6,334 @@
  */
 #include "laplacian_smoothing.h"
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef CG3_DCEL_DEFINED
 #include <cg3/meshes/dcel/dcel.h>
 #endif
 
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
 namespace cg3 {
 
-#ifdef CG3_DCEL_DEFINED
+namespace internal {
 
 /**
- * @brief Computes nIt iterations of laplacian smoothing on the mesh
- * @param [in/out] mesh: mesh on which the smoothing will be applied
- * @param [in] nIt: number of iterations
+ * @brief Builds the flat representation of a mesh used by the smoothing algorithms
+ * @param [in] coords: coordinates of the vertices (x, y, z for each vertex)
+ * @param [in] faces: vertex indices of each face (polygonal faces are allowed)
+ * @param [in] weights: uniform or cotangent weights. Cotangent weights are
+ * computed on the input positions (negative weights are clamped to zero) and
+ * vertices with all null weights fall back to uniform weights
+ * @param [in] fixedVertices: for each vertex, true if it must not be moved
+ * (it may be empty)
+ * @param [out] m: the smoothing mesh
  */
-CG3_INLINE void laplacianSmoothing(cg3::Dcel& mesh, unsigned int nIt)
+CG3_INLINE void buildSmoothingMesh(
+		const std::vector<double>& coords,
+		const std::vector<std::vector<unsigned int>>& faces,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices,
+		SmoothingMesh& m)
 {
-	std::map<uint, cg3::Point3d> mapCoords;
+	const unsigned int nv = (unsigned int) coords.size() / 3;
 
-	for (uint i = 0; i < nIt; ++i){
-		for (const cg3::Dcel::Vertex* v : mesh.vertexIterator()){
-			cg3::Point3d avg;
-			uint n = 0;
-			for (const cg3::Dcel::Vertex* adj : v->adjacentVertexIterator()){
-				avg += adj->coordinate();
-				n++;
-			}
-			if (n > 0){
-				avg /= n;
-				mapCoords[v->id()] = avg;
+	m.x.resize(nv);
+	m.y.resize(nv);
+	m.z.resize(nv);
+	m.fixed.assign(nv, 0);
+	for (unsigned int v = 0; v < nv; ++v){
+		m.x[v] = coords[v*3];
+		m.y[v] = coords[v*3+1];
+		m.z[v] = coords[v*3+2];
+		if (v < fixedVertices.size() && fixedVertices[v])
+			m.fixed[v] = 1;
+	}
+
+	//CSR adjacency: count, fill and then sort and remove duplicates of each list
+	std::vector<unsigned int> count(nv+1, 0);
+	for (const std::vector<unsigned int>& f : faces){
+		for (unsigned int i = 0; i < f.size(); ++i){
+			count[f[i]+1]++;
+			count[f[(i+1) % f.size()]+1]++;
+		}
+	}
+	for (unsigned int v = 0; v < nv; ++v)
+		count[v+1] += count[v];
+	std::vector<unsigned int> adj(count[nv]);
+	std::vector<unsigned int> pos(count.begin(), count.end()-1);
+	for (const std::vector<unsigned int>& f : faces){
+		for (unsigned int i = 0; i < f.size(); ++i){
+			unsigned int a = f[i], b = f[(i+1) % f.size()];
+			adj[pos[a]++] = b;
+			adj[pos[b]++] = a;
+		}
+	}
+
+	m.offsets.assign(nv+1, 0);
+	m.neighbours.clear();
+	m.neighbours.reserve(adj.size() / 2);
+	for (unsigned int v = 0; v < nv; ++v){
+		std::sort(adj.begin() + count[v], adj.begin() + count[v+1]);
+		auto last = std::unique(adj.begin() + count[v], adj.begin() + count[v+1]);
+		m.neighbours.insert(m.neighbours.end(), adj.begin() + count[v], last);
+		m.offsets[v+1] = (unsigned int) m.neighbours.size();
+	}
+
+	m.weights.assign(m.neighbours.size(), 1.0);
+	if (weights == COTANGENT_WEIGHTS){
+		std::fill(m.weights.begin(), m.weights.end(), 0.0);
+		auto addWeight = [&](unsigned int a, unsigned int b, double w) {
+			auto it = std::lower_bound(m.neighbours.begin() + m.offsets[a], m.neighbours.begin() + m.offsets[a+1], b);
+			if (it != m.neighbours.begin() + m.offsets[a+1] && *it == b)
+				m.weights[it - m.neighbours.begin()] += w;
+		};
+		for (const std::vector<unsigned int>& f : faces){
+			//polygons are triangulated as a fan
+			for (unsigned int i = 1; i + 1 < f.size(); ++i){
+				const unsigned int t[3] = {f[0], f[i], f[i+1]};
+				for (unsigned int c = 0; c < 3; ++c){
+					unsigned int o = t[c], a = t[(c+1)%3], b = t[(c+2)%3];
+					double ux = m.x[a]-m.x[o], uy = m.y[a]-m.y[o], uz = m.z[a]-m.z[o];
+					double vx = m.x[b]-m.x[o], vy = m.y[b]-m.y[o], vz = m.z[b]-m.z[o];
+					double dot = ux*vx + uy*vy + uz*vz;
+					double cx = uy*vz - uz*vy, cy = uz*vx - ux*vz, cz = ux*vy - uy*vx;
+					double cross = std::sqrt(cx*cx + cy*cy + cz*cz);
+					if (cross > 0){
+						double cot = 0.5 * dot / cross;
+						addWeight(a, b, cot);
+						addWeight(b, a, cot);
+					}
+				}
 			}
 		}
-		for (const std::pair<uint, cg3::Point3d>& p : mapCoords){
-			mesh.vertex(p.first)->setCoordinate(p.second);
+		for (double& w : m.weights)
+			w = std::max(w, 0.0);
+	}
+
+	//Normalization
+	#pragma omp parallel for
+	for (long long int v = 0; v < (long long int) nv; ++v){
+		double sum = 0;
+		for (unsigned int j = m.offsets[v]; j < m.offsets[v+1]; ++j)
+			sum += m.weights[j];
+		for (unsigned int j = m.offsets[v]; j < m.offsets[v+1]; ++j)
+			m.weights[j] = sum > 0 ? m.weights[j] / sum : 1.0 / (m.offsets[v+1] - m.offsets[v]);
+	}
+}
+
+/**
+ * @brief One step of laplacian smoothing: p' = p + lambda * (avg(p_j) - p).
+ * Reads the positions in (x, y, z) and writes them in (nx, ny, nz).
+ */
+CG3_INLINE void laplacianStep(
+		const SmoothingMesh& m,
+		const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+		double lambda,
+		std::vector<double>& nx, std::vector<double>& ny, std::vector<double>& nz)
+{
+	const long long int nv = (long long int) x.size();
+
+	#pragma omp parallel for schedule(static, 1024)
+	for (long long int v = 0; v < nv; ++v){
+		const unsigned int begin = m.offsets[v], end = m.offsets[v+1];
+		if (m.fixed[v] || begin == end){
+			nx[v] = x[v];
+			ny[v] = y[v];
+			nz[v] = z[v];
+			continue;
+		}
+		double ax = 0, ay = 0, az = 0;
+		for (unsigned int j = begin; j < end; ++j){
+			const unsigned int n = m.neighbours[j];
+			const double w = m.weights[j];
+			ax += w * x[n];
+			ay += w * y[n];
+			az += w * z[n];
+		}
+		nx[v] = x[v] + lambda * (ax - x[v]);
+		ny[v] = y[v] + lambda * (ay - y[v]);
+		nz[v] = z[v] + lambda * (az - z[v]);
+	}
+}
+
+/**
+ * @brief Computes nIt iterations of laplacian smoothing, with double buffered positions
+ */
+CG3_INLINE void laplacianSmoothing(SmoothingMesh& m, unsigned int nIt, double lambda)
+{
+	std::vector<double> nx(m.x.size()), ny(m.y.size()), nz(m.z.size());
+	for (unsigned int i = 0; i < nIt; ++i){
+		laplacianStep(m, m.x, m.y, m.z, lambda, nx, ny, nz);
+		m.x.swap(nx);
+		m.y.swap(ny);
+		m.z.swap(nz);
+	}
+}
+
+/**
+ * @brief Computes nIt iterations of Taubin smoothing: each iteration is a
+ * laplacian step with lambda (> 0) followed by a step with mu (< -lambda),
+ * that avoids the shrinking of the mesh.
+ */
+CG3_INLINE void taubinSmoothing(SmoothingMesh& m, unsigned int nIt, double lambda, double mu)
+{
+	std::vector<double> nx(m.x.size()), ny(m.y.size()), nz(m.z.size());
+	for (unsigned int i = 0; i < nIt; ++i){
+		laplacianStep(m, m.x, m.y, m.z, lambda, nx, ny, nz);
+		laplacianStep(m, nx, ny, nz, mu, m.x, m.y, m.z);
+	}
+}
+
+/**
+ * @brief Computes nIt iterations of HC (Humphrey's Classes) smoothing, which
+ * pushes the laplacian result back towards the original and the previous positions.
+ * @param [in] alpha: influence of the original positions, in [0, 1]
+ * @param [in] beta: influence of the current position with respect to the
+ * neighbours in the correction step, in [0, 1]
+ */
+CG3_INLINE void hcSmoothing(SmoothingMesh& m, unsigned int nIt, double alpha, double beta)
+{
+	const long long int nv = (long long int) m.x.size();
+	const std::vector<double> ox = m.x, oy = m.y, oz = m.z;
+	std::vector<double> qx(nv), qy(nv), qz(nv);
+	std::vector<double> bx(nv), by(nv), bz(nv);
+
+	for (unsigned int i = 0; i < nIt; ++i){
+		m.x.swap(qx);
+		m.y.swap(qy);
+		m.z.swap(qz);
+		laplacianStep(m, qx, qy, qz, 1.0, m.x, m.y, m.z);
+
+		#pragma omp parallel for schedule(static, 1024)
+		for (long long int v = 0; v < nv; ++v){
+			bx[v] = m.x[v] - (alpha * ox[v] + (1 - alpha) * qx[v]);
+			by[v] = m.y[v] - (alpha * oy[v] + (1 - alpha) * qy[v]);
+			bz[v] = m.z[v] - (alpha * oz[v] + (1 - alpha) * qz[v]);
+		}
+
+		#pragma omp parallel for schedule(static, 1024)
+		for (long long int v = 0; v < nv; ++v){
+			const unsigned int begin = m.offsets[v], end = m.offsets[v+1];
+			if (m.fixed[v] || begin == end)
+				continue;
+			double ax = 0, ay = 0, az = 0;
+			for (unsigned int j = begin; j < end; ++j){
+				const unsigned int n = m.neighbours[j];
+				const double w = m.weights[j];
+				ax += w * bx[n];
+				ay += w * by[n];
+				az += w * bz[n];
+			}
+			m.x[v] -= beta * bx[v] + (1 - beta) * ax;
+			m.y[v] -= beta * by[v] + (1 - beta) * ay;
+			m.z[v] -= beta * bz[v] + (1 - beta) * az;
 		}
 	}
+}
+
+#ifdef CG3_DCEL_DEFINED
+
+/**
+ * @brief Builds the smoothing mesh of a Dcel; vertexIds[i] is the id of the
+ * Dcel vertex in position i. fixedVertices is indexed by vertex id.
+ */
+CG3_INLINE void buildSmoothingMesh(
+		const cg3::Dcel& mesh,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices,
+		SmoothingMesh& m,
+		std::vector<unsigned int>& vertexIds)
+{
+	std::vector<double> coords;
+	std::vector<bool> fixed;
+	std::vector<unsigned int> idToIndex;
+	vertexIds.clear();
+	coords.reserve(mesh.numberVertices() * 3);
+	for (const cg3::Dcel::Vertex* v : mesh.vertexIterator()){
+		if (v->id() >= idToIndex.size())
+			idToIndex.resize(v->id() + 1);
+		idToIndex[v->id()] = (unsigned int) vertexIds.size();
+		vertexIds.push_back(v->id());
+		coords.push_back(v->coordinate().x());
+		coords.push_back(v->coordinate().y());
+		coords.push_back(v->coordinate().z());
+		fixed.push_back(v->id() < fixedVertices.size() && fixedVertices[v->id()]);
+	}
+
+	std::vector<std::vector<unsigned int>> faces;
+	faces.reserve(mesh.numberFaces());
+	for (const cg3::Dcel::Face* f : mesh.faceIterator()){
+		std::vector<unsigned int> face;
+		for (const cg3::Dcel::Vertex* v : f->incidentVertexIterator())
+			face.push_back(idToIndex[v->id()]);
+		faces.push_back(face);
+	}
+
+	buildSmoothingMesh(coords, faces, weights, fixed, m);
+}
+
+CG3_INLINE void updateDcel(
+		cg3::Dcel& mesh,
+		const SmoothingMesh& m,
+		const std::vector<unsigned int>& vertexIds)
+{
+	for (unsigned int i = 0; i < vertexIds.size(); ++i)
+		mesh.vertex(vertexIds[i])->setCoordinate(cg3::Point3d(m.x[i], m.y[i], m.z[i]));
 	mesh.updateFaceNormals();
 	mesh.updateFaceAreas();
 	mesh.updateVertexNormals();
 	mesh.updateBoundingBox();
 }
 
+#endif
+
+#ifdef CG3_EIGENMESH_DEFINED
+
+CG3_INLINE void buildSmoothingMesh(
+		const cg3::SimpleEigenMesh& mesh,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices,
+		SmoothingMesh& m)
+{
+	std::vector<double> coords(mesh.numberVertices() * 3);
+	for (unsigned int v = 0; v < mesh.numberVertices(); ++v){
+		for (unsigned int i = 0; i < 3; ++i)
+			coords[v*3+i] = mesh.getVerticesMatrix()(v, i);
+	}
+	std::vector<std::vector<unsigned int>> faces(mesh.numberFaces(), std::vector<unsigned int>(3));
+	for (unsigned int f = 0; f < mesh.numberFaces(); ++f){
+		for (unsigned int i = 0; i < 3; ++i)
+			faces[f][i] = mesh.getFacesMatrix()(f, i);
+	}
+	buildSmoothingMesh(coords, faces, weights, fixedVertices, m);
+}
+
+CG3_INLINE void updateEigenMesh(cg3::SimpleEigenMesh& mesh, const SmoothingMesh& m)
+{
+	for (unsigned int v = 0; v < mesh.numberVertices(); ++v)
+		mesh.setVertex(v, m.x[v], m.y[v], m.z[v]);
+}
+
+#endif
+
+} //namespace cg3::internal
+
+#ifdef CG3_DCEL_DEFINED
+
+/**
+ * @brief Computes nIt iterations of laplacian smoothing on the mesh
+ * @param [in/out] mesh: mesh on which the smoothing will be applied
+ * @param [in] nIt: number of iterations
+ */
+CG3_INLINE void laplacianSmoothing(cg3::Dcel& mesh, unsigned int nIt)
+{
+	laplacianSmoothing(mesh, nIt, 1.0);
+}
+
 /**
  * @brief Computes nIt iterations of laplacian smoothing on the mesh and returns the result
  * @param [in] mesh: mesh on which the smoothing will be applied
@@ -59,7 +347,139 @@ CG3_INLINE Dcel laplacianSmoothing(const Dcel& mesh, unsigned int nIt)
 	return output;
 }
 
+/**
+ * @brief Computes nIt iterations of laplacian smoothing on the mesh,
+ * in parallel over the vertices
+ * @param [in/out] mesh: mesh on which the smoothing will be applied
+ * @param [in] nIt: number of iterations
+ * @param [in] lambda: step of each iteration (1 moves each vertex on the
+ * weighted average of its neighbours)
+ * @param [in] weights: uniform or cotangent weights
+ * @param [in] fixedVertices: for each vertex id, true if the vertex must not
+ * be moved (e.g. feature or boundary vertices). It may be empty
+ */
+CG3_INLINE void laplacianSmoothing(
+		cg3::Dcel& mesh,
+		unsigned int nIt,
+		double lambda,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices)
+{
+	internal::SmoothingMesh m;
+	std::vector<unsigned int> vertexIds;
+	internal::buildSmoothingMesh(mesh, weights, fixedVertices, m, vertexIds);
+	internal::laplacianSmoothing(m, nIt, lambda);
+	internal::updateDcel(mesh, m, vertexIds);
+}
+
+/**
+ * @brief Computes nIt iterations of Taubin lambda/mu smoothing on the mesh,
+ * which smooths without shrinking
+ * @param [in/out] mesh: mesh on which the smoothing will be applied
+ * @param [in] nIt: number of iterations
+ * @param [in] lambda: positive step
+ * @param [in] mu: negative step, with |mu| > lambda
+ * @param [in] weights: uniform or cotangent weights
+ * @param [in] fixedVertices: for each vertex id, true if the vertex must not be moved
+ */
+CG3_INLINE void taubinSmoothing(
+		cg3::Dcel& mesh,
+		unsigned int nIt,
+		double lambda,
+		double mu,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices)
+{
+	internal::SmoothingMesh m;
+	std::vector<unsigned int> vertexIds;
+	internal::buildSmoothingMesh(mesh, weights, fixedVertices, m, vertexIds);
+	internal::taubinSmoothing(m, nIt, lambda, mu);
+	internal::updateDcel(mesh, m, vertexIds);
+}
+
+/**
+ * @brief Computes nIt iterations of HC smoothing on the mesh, which
+ * smooths without shrinking
+ * @param [in/out] mesh: mesh on which the smoothing will be applied
+ * @param [in] nIt: number of iterations
+ * @param [in] alpha: influence of the original positions
+ * @param [in] beta: influence of the vertex with respect to its neighbours in the correction
+ * @param [in] weights: uniform or cotangent weights
+ * @param [in] fixedVertices: for each vertex id, true if the vertex must not be moved
+ */
+CG3_INLINE void hcSmoothing(
+		cg3::Dcel& mesh,
+		unsigned int nIt,
+		double alpha,
+		double beta,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices)
+{
+	internal::SmoothingMesh m;
+	std::vector<unsigned int> vertexIds;
+	internal::buildSmoothingMesh(mesh, weights, fixedVertices, m, vertexIds);
+	internal::hcSmoothing(m, nIt, alpha, beta);
+	internal::updateDcel(mesh, m, vertexIds);
+}
+
 #endif
 
+#ifdef CG3_EIGENMESH_DEFINED
 
+/**
+ * @brief Computes nIt iterations of laplacian smoothing on the mesh,
+ * in parallel over the vertices
+ * @see laplacianSmoothing(cg3::Dcel&, unsigned int, double, LaplacianWeights, const std::vector<bool>&)
+ */
+CG3_INLINE void laplacianSmoothing(
+		cg3::SimpleEigenMesh& mesh,
+		unsigned int nIt,
+		double lambda,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices)
+{
+	internal::SmoothingMesh m;
+	internal::buildSmoothingMesh(mesh, weights, fixedVertices, m);
+	internal::laplacianSmoothing(m, nIt, lambda);
+	internal::updateEigenMesh(mesh, m);
+}
+
+/**
+ * @brief Computes nIt iterations of Taubin lambda/mu smoothing on the mesh
+ * @see taubinSmoothing(cg3::Dcel&, unsigned int, double, double, LaplacianWeights, const std::vector<bool>&)
+ */
+CG3_INLINE void taubinSmoothing(
+		cg3::SimpleEigenMesh& mesh,
+		unsigned int nIt,
+		double lambda,
+		double mu,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices)
+{
+	internal::SmoothingMesh m;
+	internal::buildSmoothingMesh(mesh, weights, fixedVertices, m);
+	internal::taubinSmoothing(m, nIt, lambda, mu);
+	internal::updateEigenMesh(mesh, m);
 }
+
+/**
+ * @brief Computes nIt iterations of HC smoothing on the mesh
+ * @see hcSmoothing(cg3::Dcel&, unsigned int, double, double, LaplacianWeights, const std::vector<bool>&)
+ */
+CG3_INLINE void hcSmoothing(
+		cg3::SimpleEigenMesh& mesh,
+		unsigned int nIt,
+		double alpha,
+		double beta,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices)
+{
+	internal::SmoothingMesh m;
+	internal::buildSmoothingMesh(mesh, weights, fixedVertices, m);
+	internal::hcSmoothing(m, nIt, alpha, beta);
+	internal::updateEigenMesh(mesh, m);
+}
+
+#endif
+
+} //namespace cg3
@@ -14,12 +14,101 @@
 namespace cg3 {
 
 #ifdef CG3_DCEL_DEFINED
-
 class Dcel;
+#endif
+
+#ifdef CG3_EIGENMESH_DEFINED
+class SimpleEigenMesh;
+#endif
+
+/**
+ * @brief Weights of the neighbours of a vertex used by the smoothing algorithms
+ */
+enum LaplacianWeights { UNIFORM_WEIGHTS, COTANGENT_WEIGHTS };
+
+namespace internal {
+
+/**
+ * @brief Flat representation of a mesh used by the smoothing algorithms:
+ * CSR vertex-vertex adjacency with normalized weights, and coordinates
+ * stored as separated arrays.
+ */
+struct SmoothingMesh {
+	std::vector<unsigned int> offsets;    //neighbours of v are in [offsets[v], offsets[v+1])
+	std::vector<unsigned int> neighbours;
+	std::vector<double> weights;          //sum of the weights of each vertex is 1
+	std::vector<double> x, y, z;
+	std::vector<unsigned char> fixed;     //vertices that are not moved
+};
+
+void buildSmoothingMesh(
+		const std::vector<double>& coords,
+		const std::vector<std::vector<unsigned int>>& faces,
+		LaplacianWeights weights,
+		const std::vector<bool>& fixedVertices,
+		SmoothingMesh& m);
+
+void laplacianSmoothing(SmoothingMesh& m, unsigned int nIt, double lambda);
+void taubinSmoothing(SmoothingMesh& m, unsigned int nIt, double lambda, double mu);
+void hcSmoothing(SmoothingMesh& m, unsigned int nIt, double alpha, double beta);
+
+} //namespace cg3::internal
+
+#ifdef CG3_DCEL_DEFINED
 
 void laplacianSmoothing(cg3::Dcel& mesh, unsigned int nIt = 1);
 cg3::Dcel laplacianSmoothing(const cg3::Dcel& mesh, unsigned int nIt = 1);
 
+void laplacianSmoothing(
+		cg3::Dcel& mesh,
+		unsigned int nIt,
+		double lambda,
+		LaplacianWeights weights = UNIFORM_WEIGHTS,
+		const std::vector<bool>& fixedVertices = std::vector<bool>());
+
+void taubinSmoothing(
+		cg3::Dcel& mesh,
+		unsigned int nIt,
+		double lambda = 0.5,
+		double mu = -0.53,
+		LaplacianWeights weights = UNIFORM_WEIGHTS,
+		const std::vector<bool>& fixedVertices = std::vector<bool>());
+
+void hcSmoothing(
+		cg3::Dcel& mesh,
+		unsigned int nIt,
+		double alpha = 0.1,
+		double beta = 0.6,
+		LaplacianWeights weights = UNIFORM_WEIGHTS,
+		const std::vector<bool>& fixedVertices = std::vector<bool>());
+
+#endif
+
+#ifdef CG3_EIGENMESH_DEFINED
+
+void laplacianSmoothing(
+		cg3::SimpleEigenMesh& mesh,
+		unsigned int nIt,
+		double lambda = 1,
+		LaplacianWeights weights = UNIFORM_WEIGHTS,
+		const std::vector<bool>& fixedVertices = std::vector<bool>());
+
+void taubinSmoothing(
+		cg3::SimpleEigenMesh& mesh,
+		unsigned int nIt,
+		double lambda = 0.5,
+		double mu = -0.53,
+		LaplacianWeights weights = UNIFORM_WEIGHTS,
+		const std::vector<bool>& fixedVertices = std::vector<bool>());
+
+void hcSmoothing(
+		cg3::SimpleEigenMesh& mesh,
+		unsigned int nIt,
+		double alpha = 0.1,
+		double beta = 0.6,
+		LaplacianWeights weights = UNIFORM_WEIGHTS,
+		const std::vector<bool>& fixedVertices = std::vector<bool>());
+
 #endif
 
 } //namespace cg3
@@ -9,6 +9,13 @@
 
 #include <cg3/data_structures/arrays/arrays.h>
 
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace cg3 {
 
 namespace internal {
@@ -272,62 +279,581 @@ static const Array2D<int> triTable = {
     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}    //255
 };
 
-cg3::Point3d edgeCoordinate(const cg3::RegularLattice3D<bool>& l, uint i, uint j, uint k, uint edge){
-	switch (edge) {
-	case 0:  return (l.vertex(i,  j,  k  ) + l.vertex(i+1,j,  k  )) * 0.5;
-	case 1:  return (l.vertex(i+1,j,  k  ) + l.vertex(i+1,j+1,k  )) * 0.5;
-	case 2:  return (l.vertex(i+1,j+1,k  ) + l.vertex(i,  j+1,k  )) * 0.5;
-	case 3:  return (l.vertex(i,  j+1,k  ) + l.vertex(i,  j,  k  )) * 0.5;
-
-	case 4:  return (l.vertex(i,  j,  k+1) + l.vertex(i+1,j,  k+1)) * 0.5;
-	case 5:  return (l.vertex(i+1,j,  k+1) + l.vertex(i+1,j+1,k+1)) * 0.5;
-	case 6:  return (l.vertex(i+1,j+1,k+1) + l.vertex(i,  j+1,k+1)) * 0.5;
-	case 7:  return (l.vertex(i,  j+1,k+1) + l.vertex(i,  j,  k+1)) * 0.5;
-
-	case 8:  return (l.vertex(i,  j,  k  ) + l.vertex(i,  j,  k+1)) * 0.5;
-	case 9:  return (l.vertex(i+1,j,  k  ) + l.vertex(i+1,j,  k+1)) * 0.5;
-	case 10: return (l.vertex(i+1,j+1,k  ) + l.vertex(i+1,j+1,k+1)) * 0.5;
-	case 11: return (l.vertex(i,  j+1,k  ) + l.vertex(i,  j+1,k+1)) * 0.5;
-
-	default:
-		assert(0);
-		return cg3::Point3d();
+static const unsigned int MC_NULL_ID = std::numeric_limits<unsigned int>::max();
+static const unsigned int MC_FOREIGN_ID = 1u << 31;
+
+/**
+ * @brief Output of a slab of cells, processed by a single thread.
+ * Vertex ids of the triangles are local to the slab; ids flagged
+ * with MC_FOREIGN_ID refer to the first plane of the next slab.
+ */
+struct MarchingCubesSlab {
+	std::vector<double> vertices;
+	std::vector<unsigned int> triangles;
+};
+
+/**
+ * @brief Computes the ids of the vertices lying on the y and z edges of
+ * the plane i of the lattice.
+ *
+ * The vertices are numbered scanning the plane always in the same order,
+ * hence the foreign ids computed by a slab for its last plane match the
+ * local ids computed by the next slab for its first plane.
+ */
+template <class VT, class Inside, class Param>
+void marchingCubesPlane(
+		const cg3::RegularLattice3D<VT>& l,
+		uint i,
+		Inside inside,
+		Param param,
+		bool foreign,
+		std::vector<unsigned int>& yEdges,
+		std::vector<unsigned int>& zEdges,
+		MarchingCubesSlab& slab)
+{
+	const uint ny = l.resY(), nz = l.resZ();
+	const double x = l.boundingBox().minX() + i * l.unit();
+	unsigned int foreignCount = 0;
+
+	for (uint j = 0; j < ny; ++j){
+		const double y = l.boundingBox().minY() + j * l.unit();
+		for (uint k = 0; k < nz; ++k){
+			const double z = l.boundingBox().minZ() + k * l.unit();
+			const VT v = l.vertexProperty(i, j, k);
+			const bool in = inside(v);
+
+			yEdges[j*nz+k] = MC_NULL_ID;
+			if (j+1 < ny){
+				const VT v1 = l.vertexProperty(i, j+1, k);
+				if (inside(v1) != in){
+					if (foreign){
+						yEdges[j*nz+k] = MC_FOREIGN_ID | foreignCount++;
+					}
+					else {
+						yEdges[j*nz+k] = (unsigned int) slab.vertices.size() / 3;
+						slab.vertices.insert(slab.vertices.end(), {x, y + param(v, v1) * l.unit(), z});
+					}
+				}
+			}
+
+			zEdges[j*nz+k] = MC_NULL_ID;
+			if (k+1 < nz){
+				const VT v1 = l.vertexProperty(i, j, k+1);
+				if (inside(v1) != in){
+					if (foreign){
+						zEdges[j*nz+k] = MC_FOREIGN_ID | foreignCount++;
+					}
+					else {
+						zEdges[j*nz+k] = (unsigned int) slab.vertices.size() / 3;
+						slab.vertices.insert(slab.vertices.end(), {x, y, z + param(v, v1) * l.unit()});
+					}
+				}
+			}
+		}
 	}
 }
 
+/**
+ * @brief Marching cubes on the cell layers [i0, i1) of the lattice.
+ *
+ * Edge vertex ids are cached for the two planes and for the x edges of the
+ * current layer, so every vertex is created once without any coordinate lookup.
+ */
+template <class VT, class Inside, class Param>
+void marchingCubesSlab(
+		const cg3::RegularLattice3D<VT>& l,
+		uint i0,
+		uint i1,
+		Inside inside,
+		Param param,
+		MarchingCubesSlab& slab)
+{
+	const uint ny = l.resY(), nz = l.resZ();
+	const bool ownsLastPlane = (i1 == l.resX()-1);
+
+	std::vector<unsigned int> yCur(ny*nz), zCur(ny*nz), yNext(ny*nz), zNext(ny*nz), xEdges(ny*nz);
+
+	marchingCubesPlane(l, i0, inside, param, false, yCur, zCur, slab);
+
+	for (uint i = i0; i < i1; ++i){
+		//x edges between the planes i and i+1
+		const double x = l.boundingBox().minX() + i * l.unit();
+		for (uint j = 0; j < ny; ++j){
+			const double y = l.boundingBox().minY() + j * l.unit();
+			for (uint k = 0; k < nz; ++k){
+				const VT v0 = l.vertexProperty(i,   j, k);
+				const VT v1 = l.vertexProperty(i+1, j, k);
+				xEdges[j*nz+k] = MC_NULL_ID;
+				if (inside(v0) != inside(v1)){
+					xEdges[j*nz+k] = (unsigned int) slab.vertices.size() / 3;
+					slab.vertices.insert(
+								slab.vertices.end(),
+								{x + param(v0, v1) * l.unit(), y, l.boundingBox().minZ() + k * l.unit()});
+				}
+			}
+		}
+
+		marchingCubesPlane(l, i+1, inside, param, (i+1 == i1 && !ownsLastPlane), yNext, zNext, slab);
+
+		for (uint j = 0; j < ny-1; ++j){
+			for (uint k = 0; k < nz-1; ++k){
+				uint cubeIndex = 0;
+				if (inside(l.vertexProperty(i,   j,   k  ))) cubeIndex |= 1;
+				if (inside(l.vertexProperty(i+1, j,   k  ))) cubeIndex |= 2;
+				if (inside(l.vertexProperty(i+1, j+1, k  ))) cubeIndex |= 4;
+				if (inside(l.vertexProperty(i,   j+1, k  ))) cubeIndex |= 8;
+				if (inside(l.vertexProperty(i,   j,   k+1))) cubeIndex |= 16;
+				if (inside(l.vertexProperty(i+1, j,   k+1))) cubeIndex |= 32;
+				if (inside(l.vertexProperty(i+1, j+1, k+1))) cubeIndex |= 64;
+				if (inside(l.vertexProperty(i,   j+1, k+1))) cubeIndex |= 128;
+
+				if (cubeIndex == 0 || cubeIndex == 255)
+					continue;
+
+				const uint c = j*nz+k;
+				const unsigned int edgeIds[12] = {
+					xEdges[c], yNext[c], xEdges[c+nz], yCur[c],
+					xEdges[c+1], yNext[c+1], xEdges[c+nz+1], yCur[c+1],
+					zCur[c], zNext[c], zNext[c+nz], zCur[c+nz]
+				};
+
+				for(uint n = 0; n < 16 && triTable(cubeIndex,n) != -1; n+=3){
+					slab.triangles.push_back(edgeIds[triTable(cubeIndex, n+1)]);
+					slab.triangles.push_back(edgeIds[triTable(cubeIndex, n)]);
+					slab.triangles.push_back(edgeIds[triTable(cubeIndex, n+2)]);
+				}
+			}
+		}
+
+		std::swap(yCur, yNext);
+		std::swap(zCur, zNext);
+	}
 }
 
-CG3_INLINE Dcel marchingCubes(const cg3::RegularLattice3D<bool>& l)
+/**
+ * @brief Marching cubes engine: slabs of cell layers (along x, the slowest
+ * index of the lattice storage) are processed in parallel, then the
+ * local vertex ids of each slab are offset and merged into the indexed buffers.
+ *
+ * @param[in] inside: predicate telling if a vertex value is inside the surface
+ * @param[in] param: position, in [0, 1], of the surface along an edge given
+ * the values at its extremes
+ */
+template <class VT, class Inside, class Param>
+void marchingCubes(
+		const cg3::RegularLattice3D<VT>& l,
+		Inside inside,
+		Param param,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles)
 {
-	cg3::DcelBuilder b;
-	for (uint i = 0; i < l.resX()-1; ++i){
-		for (uint j = 0; j < l.resY()-1; ++j){
-			for (uint k = 0; k < l.resZ()-1; ++k){
+	vertices.clear();
+	triangles.clear();
 
-				uint cubeIndex = 0;
-				if (l.vertexProperty(i,   j,   k  )) cubeIndex |= 1;
-				if (l.vertexProperty(i+1, j,   k  )) cubeIndex |= 2;
-				if (l.vertexProperty(i+1, j+1, k  )) cubeIndex |= 4;
-				if (l.vertexProperty(i,   j+1, k  )) cubeIndex |= 8;
-				if (l.vertexProperty(i,   j,   k+1)) cubeIndex |= 16;
-				if (l.vertexProperty(i+1, j,   k+1)) cubeIndex |= 32;
-				if (l.vertexProperty(i+1, j+1, k+1)) cubeIndex |= 64;
-				if (l.vertexProperty(i,   j+1, k+1)) cubeIndex |= 128;
-
-				for(uint n = 0; n < 16 && internal::triTable(cubeIndex,n) != -1; n+=3){
-					cg3::Point3d p1 = internal::edgeCoordinate(
-								l, i, j, k, internal::triTable(cubeIndex, n));
-					cg3::Point3d p2 = internal::edgeCoordinate(
-								l, i, j, k, internal::triTable(cubeIndex, n+1));
-					cg3::Point3d p3 = internal::edgeCoordinate(
-								l, i, j, k, internal::triTable(cubeIndex, n+2));
-					b.addFace(p2, p1, p3);
+	if (l.resX() < 2 || l.resY() < 2 || l.resZ() < 2)
+		return;
+
+	const uint nCellLayers = l.resX()-1;
+	uint nSlabs = 1;
+	#ifdef _OPENMP
+	nSlabs = std::min(nCellLayers, (uint) omp_get_max_threads() * 4);
+	#endif
+
+	std::vector<MarchingCubesSlab> slabs(nSlabs);
+
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int s = 0; s < (int) nSlabs; ++s){
+		const uint i0 = (uint) ((unsigned long long) nCellLayers * s / nSlabs);
+		const uint i1 = (uint) ((unsigned long long) nCellLayers * (s+1) / nSlabs);
+		marchingCubesSlab(l, i0, i1, inside, param, slabs[s]);
+	}
+
+	std::vector<size_t> vOffsets(nSlabs+1, 0), tOffsets(nSlabs+1, 0);
+	for (uint s = 0; s < nSlabs; ++s){
+		vOffsets[s+1] = vOffsets[s] + slabs[s].vertices.size() / 3;
+		tOffsets[s+1] = tOffsets[s] + slabs[s].triangles.size();
+	}
+	vertices.resize(vOffsets[nSlabs] * 3);
+	triangles.resize(tOffsets[nSlabs]);
+
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int s = 0; s < (int) nSlabs; ++s){
+		std::copy(slabs[s].vertices.begin(), slabs[s].vertices.end(), vertices.begin() + vOffsets[s] * 3);
+		for (size_t t = 0; t < slabs[s].triangles.size(); ++t){
+			const unsigned int id = slabs[s].triangles[t];
+			if (id & MC_FOREIGN_ID)
+				triangles[tOffsets[s] + t] = (unsigned int) (vOffsets[s+1] + (id & ~MC_FOREIGN_ID));
+			else
+				triangles[tOffsets[s] + t] = (unsigned int) (vOffsets[s] + id);
+		}
+		std::vector<double>().swap(slabs[s].vertices);
+		std::vector<unsigned int>().swap(slabs[s].triangles);
+	}
+}
+
+/**
+ * @brief Output of a tile of a sparse lattice: vertices on the edges starting
+ * from the vertices of the tile, and their ids (MC_NULL_ID if there is no vertex).
+ */
+struct MarchingCubesTile {
+	std::vector<double> vertices;
+	std::vector<unsigned int> edgeIds;
+	std::vector<unsigned char> inside;
+};
+
+/**
+ * @brief Marching cubes engine for sparse lattices. Only the tiles which
+ * contain active vertices, and the tiles preceding them along each axis, are
+ * processed (in parallel), since all the other cells have all the vertices
+ * with the background value. Each edge belongs to the tile of its first
+ * vertex, so vertex ids are computed per tile and then offset.
+ */
+template <class VT, class Inside, class Param>
+void marchingCubes(
+		const cg3::SparseLattice3D<VT>& l,
+		Inside inside,
+		Param param,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles)
+{
+	typedef cg3::SparseLattice3D<VT> Lattice;
+	const uint TS = Lattice::TILE_SIZE;
+	const uint BS = TS + 1; //tile vertices plus one layer of the next tiles
+
+	vertices.clear();
+	triangles.clear();
+
+	if (l.resX() < 2 || l.resY() < 2 || l.resZ() < 2)
+		return;
+
+	//Tiles to be processed, indexed by their tile coordinates
+	std::vector<cg3::Point3i> tiles;
+	std::unordered_map<unsigned long long int, unsigned int> tileMap;
+	auto key = [](int ti, int tj, int tk) {
+		return ((unsigned long long int) ti << 42) | ((unsigned long long int) tj << 21) | (unsigned long long int) tk;
+	};
+	for (unsigned int t = 0; t < l.numberTiles(); ++t){
+		cg3::Point3i o = l.tileOrigin(t) / (int) TS;
+		for (int d = 0; d < 8; ++d){
+			cg3::Point3i n(o.x() - (d >> 2 & 1), o.y() - (d >> 1 & 1), o.z() - (d & 1));
+			if (n.x() >= 0 && n.y() >= 0 && n.z() >= 0 && tileMap.find(key(n.x(), n.y(), n.z())) == tileMap.end()){
+				tileMap[key(n.x(), n.y(), n.z())] = (unsigned int) tiles.size();
+				tiles.push_back(n);
+			}
+		}
+	}
+
+	std::vector<MarchingCubesTile> tileData(tiles.size());
+	const uint res[3] = {l.resX(), l.resY(), l.resZ()};
+
+	//Vertices of the edges owned by each tile
+	#pragma omp parallel for schedule(dynamic, 4)
+	for (int t = 0; t < (int) tiles.size(); ++t){
+		MarchingCubesTile& td = tileData[t];
+		const uint origin[3] = {tiles[t].x() * TS, tiles[t].y() * TS, tiles[t].z() * TS};
+
+		//Values of the tile and of the first layer of the next tiles
+		std::vector<VT> values(BS*BS*BS, l.background());
+		for (int d = 0; d < 8; ++d){
+			const uint dx = d >> 2 & 1, dy = d >> 1 & 1, dz = d & 1;
+			int lt = l.tileIndex(tiles[t].x() + dx, tiles[t].y() + dy, tiles[t].z() + dz);
+			if (lt < 0)
+				continue;
+			for (uint a = dx*TS; a < (dx ? BS : TS); ++a)
+				for (uint b = dy*TS; b < (dy ? BS : TS); ++b)
+					for (uint c = dz*TS; c < (dz ? BS : TS); ++c)
+						values[(a*BS+b)*BS+c] = l.tileVertexProperty(lt, a - dx*TS, b - dy*TS, c - dz*TS);
+		}
+		td.inside.resize(BS*BS*BS);
+		for (uint v = 0; v < BS*BS*BS; ++v)
+			td.inside[v] = inside(values[v]);
+
+		td.edgeIds.assign(TS*TS*TS*3, MC_NULL_ID);
+		for (uint a = 0; a < TS && origin[0]+a < res[0]; ++a){
+			for (uint b = 0; b < TS && origin[1]+b < res[1]; ++b){
+				for (uint c = 0; c < TS && origin[2]+c < res[2]; ++c){
+					const uint v0 = (a*BS+b)*BS+c;
+					const uint loc[3] = {a, b, c};
+					const uint next[3] = {BS*BS, BS, 1};
+					for (uint axis = 0; axis < 3; ++axis){
+						if (origin[axis] + loc[axis] + 1 >= res[axis] || td.inside[v0] == td.inside[v0 + next[axis]])
+							continue;
+						double p[3] = {
+							l.boundingBox().minX() + (origin[0]+a) * l.unit(),
+							l.boundingBox().minY() + (origin[1]+b) * l.unit(),
+							l.boundingBox().minZ() + (origin[2]+c) * l.unit()};
+						p[axis] += param(values[v0], values[v0 + next[axis]]) * l.unit();
+						td.edgeIds[((a*TS+b)*TS+c)*3+axis] = (unsigned int) td.vertices.size() / 3;
+						td.vertices.insert(td.vertices.end(), p, p+3);
+					}
 				}
 			}
 		}
 	}
+
+	std::vector<size_t> vOffsets(tiles.size()+1, 0);
+	for (uint t = 0; t < tiles.size(); ++t)
+		vOffsets[t+1] = vOffsets[t] + tileData[t].vertices.size() / 3;
+	vertices.resize(vOffsets[tiles.size()] * 3);
+
+	//Triangles of the cells having the first vertex in each tile
+	std::vector<std::vector<unsigned int>> tileTriangles(tiles.size());
+
+	//edge -> (first vertex offset, axis)
+	static const uint edgeOrigin[12][4] = {
+		{0,0,0,0}, {1,0,0,1}, {0,1,0,0}, {0,0,0,1},
+		{0,0,1,0}, {1,0,1,1}, {0,1,1,0}, {0,0,1,1},
+		{0,0,0,2}, {1,0,0,2}, {1,1,0,2}, {0,1,0,2}};
+
+	#pragma omp parallel for schedule(dynamic, 4)
+	for (int t = 0; t < (int) tiles.size(); ++t){
+		const MarchingCubesTile& td = tileData[t];
+		std::copy(td.vertices.begin(), td.vertices.end(), vertices.begin() + vOffsets[t] * 3);
+
+		const uint origin[3] = {tiles[t].x() * TS, tiles[t].y() * TS, tiles[t].z() * TS};
+		int neighbours[8];
+		for (int d = 0; d < 8; ++d){
+			auto it = tileMap.find(key(tiles[t].x() + (d >> 2 & 1), tiles[t].y() + (d >> 1 & 1), tiles[t].z() + (d & 1)));
+			neighbours[d] = it == tileMap.end() ? -1 : (int) it->second;
+		}
+
+		std::vector<unsigned int>& tt = tileTriangles[t];
+		for (uint a = 0; a < TS && origin[0]+a+1 < res[0]; ++a){
+			for (uint b = 0; b < TS && origin[1]+b+1 < res[1]; ++b){
+				for (uint c = 0; c < TS && origin[2]+c+1 < res[2]; ++c){
+					const uint v = (a*BS+b)*BS+c;
+					uint cubeIndex = 0;
+					if (td.inside[v                ]) cubeIndex |= 1;
+					if (td.inside[v+BS*BS          ]) cubeIndex |= 2;
+					if (td.inside[v+BS*BS+BS       ]) cubeIndex |= 4;
+					if (td.inside[v+BS             ]) cubeIndex |= 8;
+					if (td.inside[v+1              ]) cubeIndex |= 16;
+					if (td.inside[v+BS*BS+1        ]) cubeIndex |= 32;
+					if (td.inside[v+BS*BS+BS+1     ]) cubeIndex |= 64;
+					if (td.inside[v+BS+1           ]) cubeIndex |= 128;
+
+					if (cubeIndex == 0 || cubeIndex == 255)
+						continue;
+
+					unsigned int edgeIds[12];
+					for (uint e = 0; e < 12; ++e){
+						uint ea = a + edgeOrigin[e][0], eb = b + edgeOrigin[e][1], ec = c + edgeOrigin[e][2];
+						int owner = neighbours[(ea / TS) << 2 | (eb / TS) << 1 | (ec / TS)];
+						edgeIds[e] = MC_NULL_ID;
+						if (owner >= 0){
+							unsigned int id = tileData[owner].edgeIds[(((ea%TS)*TS+eb%TS)*TS+ec%TS)*3+edgeOrigin[e][3]];
+							if (id != MC_NULL_ID)
+								edgeIds[e] = (unsigned int) (vOffsets[owner] + id);
+						}
+					}
+
+					for(uint n = 0; n < 16 && triTable(cubeIndex,n) != -1; n+=3){
+						tt.push_back(edgeIds[triTable(cubeIndex, n+1)]);
+						tt.push_back(edgeIds[triTable(cubeIndex, n)]);
+						tt.push_back(edgeIds[triTable(cubeIndex, n+2)]);
+					}
+				}
+			}
+		}
+	}
+
+	for (const std::vector<unsigned int>& tt : tileTriangles)
+		triangles.insert(triangles.end(), tt.begin(), tt.end());
+}
+
+/**
+ * @brief Marching cubes on a scalar field: vertices with value lower than
+ * the iso value are inside, and the vertices of the surface are linearly
+ * interpolated along the edges.
+ */
+template <template <class> class Lattice, class VT>
+void marchingCubesScalarField(
+		const Lattice<VT>& l,
+		VT isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles)
+{
+	marchingCubes(
+				l,
+				[isoValue](VT v) { return v < isoValue; },
+				[isoValue](VT v0, VT v1) { return (double) (isoValue - v0) / (double) (v1 - v0); },
+				vertices,
+				triangles);
+}
+
+/**
+ * @brief Marching cubes on a boolean lattice: true vertices are inside,
+ * and the vertices of the surface are placed at the middle of the edges.
+ */
+template <template <class> class Lattice>
+cg3::Dcel marchingCubesBoolean(const Lattice<bool>& l)
+{
+	std::vector<double> vertices;
+	std::vector<unsigned int> triangles;
+	marchingCubes(
+				l,
+				[](bool v) { return v; },
+				[](bool, bool) { return 0.5; },
+				vertices,
+				triangles);
+
+	cg3::DcelBuilder b;
+	for (size_t v = 0; v < vertices.size(); v+=3)
+		b.addVertex(cg3::Point3d(vertices[v], vertices[v+1], vertices[v+2]));
+	for (size_t t = 0; t < triangles.size(); t+=3)
+		b.addFace(triangles[t], triangles[t+1], triangles[t+2]);
 	b.finalize();
 	return b.dcel();
 }
 
+#ifdef CG3_EIGENMESH_DEFINED
+CG3_INLINE cg3::SimpleEigenMesh eigenMeshFromBuffers(
+		const std::vector<double>& vertices,
+		const std::vector<unsigned int>& triangles)
+{
+	typedef Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> VMatrix;
+	typedef Eigen::Matrix<unsigned int, Eigen::Dynamic, 3, Eigen::RowMajor> FMatrix;
+
+	cg3::SimpleEigenMesh mesh;
+	mesh.setVerticesMatrix(VMatrix(Eigen::Map<const VMatrix>(vertices.data(), vertices.size() / 3, 3)));
+	mesh.setFacesMatrix(Eigen::Matrix<int, Eigen::Dynamic, 3, Eigen::RowMajor>(
+			Eigen::Map<const FMatrix>(triangles.data(), triangles.size() / 3, 3).cast<int>()));
+	return mesh;
+}
+#endif
+
+} //namespace cg3::internal
+
+/**
+ * @brief Marching cubes on a boolean lattice: true vertices are inside,
+ * and the vertices of the surface are placed at the middle of the edges.
+ */
+CG3_INLINE Dcel marchingCubes(const cg3::RegularLattice3D<bool>& l)
+{
+	return internal::marchingCubesBoolean(l);
+}
+
+/**
+ * @brief Marching cubes on a scalar field (e.g. a signed distance field).
+ *
+ * Vertices of the lattice with value lower than isoValue are considered
+ * inside. Slabs of the lattice are processed in parallel, and every vertex of
+ * the surface is shared by all its triangles (no duplicates).
+ *
+ * @param[in] l: the lattice
+ * @param[in] isoValue: value of the surface
+ * @param[out] vertices: coordinates of the vertices (x, y, z for each vertex)
+ * @param[out] triangles: vertex ids of the triangles (three for each triangle)
+ */
+CG3_INLINE void marchingCubes(
+		const RegularLattice3D<double>& l,
+		double isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles)
+{
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+}
+
+/**
+ * @brief Marching cubes on a scalar field of floats.
+ * @see marchingCubes(const RegularLattice3D<double>&, double, std::vector<double>&, std::vector<unsigned int>&)
+ */
+CG3_INLINE void marchingCubes(
+		const RegularLattice3D<float>& l,
+		float isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles)
+{
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+}
+
+#ifdef CG3_EIGENMESH_DEFINED
+/**
+ * @brief Marching cubes on a scalar field, returning a SimpleEigenMesh.
+ * @see marchingCubes(const RegularLattice3D<double>&, double, std::vector<double>&, std::vector<unsigned int>&)
+ */
+CG3_INLINE SimpleEigenMesh marchingCubes(const RegularLattice3D<double>& l, double isoValue)
+{
+	std::vector<double> vertices;
+	std::vector<unsigned int> triangles;
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+	return internal::eigenMeshFromBuffers(vertices, triangles);
+}
+
+/**
+ * @brief Marching cubes on a scalar field of floats, returning a SimpleEigenMesh.
+ * @see marchingCubes(const RegularLattice3D<double>&, double, std::vector<double>&, std::vector<unsigned int>&)
+ */
+CG3_INLINE SimpleEigenMesh marchingCubes(const RegularLattice3D<float>& l, float isoValue)
+{
+	std::vector<double> vertices;
+	std::vector<unsigned int> triangles;
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+	return internal::eigenMeshFromBuffers(vertices, triangles);
+}
+#endif
+
+/**
+ * @brief Marching cubes on a sparse boolean lattice: only the tiles
+ * containing active vertices are visited.
+ * @see marchingCubes(const cg3::RegularLattice3D<bool>&)
+ */
+CG3_INLINE Dcel marchingCubes(const cg3::SparseLattice3D<bool>& l)
+{
+	return internal::marchingCubesBoolean(l);
+}
+
+/**
+ * @brief Marching cubes on a sparse scalar field (e.g. a narrow band signed
+ * distance field): only the tiles containing active vertices are visited, in parallel.
+ * @see marchingCubes(const RegularLattice3D<double>&, double, std::vector<double>&, std::vector<unsigned int>&)
+ */
+CG3_INLINE void marchingCubes(
+		const SparseLattice3D<double>& l,
+		double isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles)
+{
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+}
+
+/**
+ * @brief Marching cubes on a sparse scalar field of floats.
+ * @see marchingCubes(const SparseLattice3D<double>&, double, std::vector<double>&, std::vector<unsigned int>&)
+ */
+CG3_INLINE void marchingCubes(
+		const SparseLattice3D<float>& l,
+		float isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles)
+{
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+}
+
+#ifdef CG3_EIGENMESH_DEFINED
+/**
+ * @brief Marching cubes on a sparse scalar field, returning a SimpleEigenMesh.
+ * @see marchingCubes(const SparseLattice3D<double>&, double, std::vector<double>&, std::vector<unsigned int>&)
+ */
+CG3_INLINE SimpleEigenMesh marchingCubes(const SparseLattice3D<double>& l, double isoValue)
+{
+	std::vector<double> vertices;
+	std::vector<unsigned int> triangles;
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+	return internal::eigenMeshFromBuffers(vertices, triangles);
+}
+
+/**
+ * @brief Marching cubes on a sparse scalar field of floats, returning a SimpleEigenMesh.
+ * @see marchingCubes(const SparseLattice3D<double>&, double, std::vector<double>&, std::vector<unsigned int>&)
+ */
+CG3_INLINE SimpleEigenMesh marchingCubes(const SparseLattice3D<float>& l, float isoValue)
+{
+	std::vector<double> vertices;
+	std::vector<unsigned int> triangles;
+	internal::marchingCubesScalarField(l, isoValue, vertices, triangles);
+	return internal::eigenMeshFromBuffers(vertices, triangles);
+}
+#endif
+
 } //namespace cg3
@@ -9,12 +9,61 @@
 #define CG3_MARCHING_CUBES_H
 
 #include <cg3/data_structures/lattices/regular_lattice.h>
+#include <cg3/data_structures/lattices/sparse_lattice.h>
 #include <cg3/meshes/dcel/dcel_builder.h>
 
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
+#include <vector>
+
 namespace cg3 {
 
 cg3::Dcel marchingCubes(const cg3::RegularLattice3D<bool>& l);
 
+void marchingCubes(
+		const cg3::RegularLattice3D<double>& l,
+		double isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles);
+void marchingCubes(
+		const cg3::RegularLattice3D<float>& l,
+		float isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles);
+
+#ifdef CG3_EIGENMESH_DEFINED
+cg3::SimpleEigenMesh marchingCubes(
+		const cg3::RegularLattice3D<double>& l,
+		double isoValue = 0);
+cg3::SimpleEigenMesh marchingCubes(
+		const cg3::RegularLattice3D<float>& l,
+		float isoValue = 0);
+#endif
+
+cg3::Dcel marchingCubes(const cg3::SparseLattice3D<bool>& l);
+
+void marchingCubes(
+		const cg3::SparseLattice3D<double>& l,
+		double isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles);
+void marchingCubes(
+		const cg3::SparseLattice3D<float>& l,
+		float isoValue,
+		std::vector<double>& vertices,
+		std::vector<unsigned int>& triangles);
+
+#ifdef CG3_EIGENMESH_DEFINED
+cg3::SimpleEigenMesh marchingCubes(
+		const cg3::SparseLattice3D<double>& l,
+		double isoValue = 0);
+cg3::SimpleEigenMesh marchingCubes(
+		const cg3::SparseLattice3D<float>& l,
+		float isoValue = 0);
+#endif
+
 } //namespace cg3
 
 #ifndef CG3_STATIC
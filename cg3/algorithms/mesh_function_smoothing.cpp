@@ -136,11 +136,16 @@ std::vector<T> vertexFunctionLaplacianSmoothing(
         const std::vector<std::vector<int>>& vvAdj)
 {
     std::vector<T> laplacianValue = function;
+    std::vector<T> lastValues(function.size());
+
+    const long long int nVertices = mesh.numberVertices();
 
     for (unsigned int it = 0; it < iterations; it++) {
-        std::vector<T> lastValues = laplacianValue;
+        //Double buffering: the values of the previous iteration are swapped, not copied
+        lastValues.swap(laplacianValue);
 
-        for(unsigned int vId = 0; vId < mesh.numberVertices(); vId++) {
+        #pragma omp parallel for schedule(static, 1024)
+        for(long long int vId = 0; vId < nVertices; vId++) {
             T adjValue = 0;
 
             for(size_t j = 0; j < vvAdj[vId].size(); j++) {
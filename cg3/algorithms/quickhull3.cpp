@@ -0,0 +1,621 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "quickhull3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "cg3/meshes/dcel/dcel_builder.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace cg3 {
+
+
+/* ----- INTERNAL FUNCTIONS DECLARATION ----- */
+
+namespace internal {
+
+/** Minimum number of points that are assigned to faces in parallel */
+static const unsigned int QUICKHULL_PARALLEL_THRESHOLD = 1 << 14;
+
+/** Minimum number of candidate points that are split in chunks hulled in parallel */
+static const unsigned int QUICKHULL_CHUNK_THRESHOLD = 1 << 16;
+
+inline double quickHullDistance(const QuickHullFace& f, const Point3d& p);
+
+inline unsigned int quickHullAddFace(
+        std::vector<QuickHullFace>& faces,
+        std::vector<unsigned int>& freeFaces,
+        unsigned int a, unsigned int b, unsigned int c,
+        const std::vector<Point3d>& points);
+
+inline bool quickHullInitialSimplex(
+        const std::vector<Point3d>& points,
+        const std::vector<unsigned int>& candidates,
+        double eps,
+        std::vector<QuickHullFace>& faces);
+
+inline void quickHullAssignPoints(
+        const std::vector<Point3d>& points,
+        const std::vector<unsigned int>& pointsToAssign,
+        const std::vector<unsigned int>& targetFaces,
+        double eps,
+        std::vector<QuickHullFace>& faces);
+
+} //namespace cg3::internal
+
+
+
+/* ----- IMPLEMENTATION OF QUICKHULL 3D ----- */
+
+/**
+ * @brief Computes the convex hull of a set of points with a parallel Quickhull.
+ *
+ * If aklToussaint is true, the points that lie inside the polytope of the
+ * extreme points along 14 directions are discarded before running the hull.
+ * Large sets of candidates are split in chunks whose hulls are computed in
+ * parallel, and the final hull is computed on the union of their vertices.
+ *
+ * @param[in] points: input points
+ * @param[out] triangles: triangles of the hull (three indices of the input
+ * points for each triangle, counterclockwise seen from outside)
+ * @param[in] aklToussaint: enables the Akl-Toussaint pre-filter
+ */
+inline void quickHull(
+        const std::vector<Point3d>& points,
+        std::vector<unsigned int>& triangles,
+        bool aklToussaint)
+{
+    triangles.clear();
+    if (points.size() < 4)
+        return;
+
+    const double eps = internal::quickHullEpsilon(points);
+
+    std::vector<unsigned int> candidates;
+    if (aklToussaint) {
+        internal::aklToussaintFilter(points, eps, candidates);
+    }
+    else {
+        candidates.resize(points.size());
+        for (unsigned int i = 0; i < points.size(); i++)
+            candidates[i] = i;
+    }
+
+    #ifdef _OPENMP
+    const unsigned int nChunks = omp_get_max_threads();
+    if (nChunks > 1 && candidates.size() > internal::QUICKHULL_CHUNK_THRESHOLD) {
+        std::vector<std::vector<unsigned int>> chunkVertices(nChunks);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int c = 0; c < (int)nChunks; c++) {
+            std::vector<unsigned int> chunk(
+                        candidates.begin() + candidates.size() * c / nChunks,
+                        candidates.begin() + candidates.size() * (c+1) / nChunks);
+            std::vector<unsigned int> chunkTriangles;
+            internal::quickHull(points, chunk, eps, chunkTriangles);
+            if (chunkTriangles.empty()) { //degenerate chunk: all its points are kept
+                chunkVertices[c] = std::move(chunk);
+            }
+            else {
+                std::sort(chunkTriangles.begin(), chunkTriangles.end());
+                chunkTriangles.erase(std::unique(chunkTriangles.begin(), chunkTriangles.end()), chunkTriangles.end());
+                chunkVertices[c] = std::move(chunkTriangles);
+            }
+        }
+
+        candidates.clear();
+        for (const std::vector<unsigned int>& cv : chunkVertices)
+            candidates.insert(candidates.end(), cv.begin(), cv.end());
+    }
+    #endif
+
+    internal::quickHull(points, candidates, eps, triangles);
+}
+
+/**
+ * @brief Computes the convex hull of a set of points with a parallel Quickhull.
+ * The hull is computed on indexed points, and the Dcel is built only at the end.
+ * The flag of each vertex of the resulting Dcel is the index of the input point.
+ * @param[in] points: input points
+ * @param[in] aklToussaint: enables the Akl-Toussaint pre-filter
+ * @return The convex hull as a Dcel
+ */
+inline Dcel quickHull(const std::vector<Point3d>& points, bool aklToussaint)
+{
+    std::vector<unsigned int> triangles;
+    quickHull(points, triangles, aklToussaint);
+    if (triangles.empty())
+        return Dcel();
+
+    std::vector<unsigned int> hullVertices(triangles);
+    std::sort(hullVertices.begin(), hullVertices.end());
+    hullVertices.erase(std::unique(hullVertices.begin(), hullVertices.end()), hullVertices.end());
+
+    DcelBuilder builder;
+    for (unsigned int v : hullVertices)
+        builder.addVertex(points[v], Vec3d(), Color(128, 128, 128), v);
+    for (unsigned int t = 0; t < triangles.size(); t += 3) {
+        unsigned int ids[3];
+        for (unsigned int i = 0; i < 3; i++)
+            ids[i] = std::lower_bound(hullVertices.begin(), hullVertices.end(), triangles[t+i]) - hullVertices.begin();
+        builder.addFace(ids[0], ids[1], ids[2]);
+    }
+    builder.finalize();
+
+    Dcel convexHull = builder.dcel();
+    convexHull.updateFaceNormals();
+    convexHull.updateVertexNormals();
+    convexHull.updateBoundingBox();
+    return convexHull;
+}
+
+inline Dcel quickHull(const Dcel& inputDcel, bool aklToussaint)
+{
+    std::vector<Point3d> points;
+    points.reserve(inputDcel.numberVertices());
+    for (const Dcel::Vertex* v : inputDcel.vertexIterator()){
+        points.push_back(v->coordinate());
+    }
+    return quickHull(points, aklToussaint);
+}
+
+template <class InputContainer>
+Dcel quickHull(const InputContainer& container, bool aklToussaint)
+{
+    return quickHull(container.begin(), container.end(), aklToussaint);
+}
+
+template <class InputIterator>
+Dcel quickHull(InputIterator first, InputIterator end, bool aklToussaint)
+{
+    std::vector<Point3d> points(first, end);
+    return quickHull(points, aklToussaint);
+}
+
+
+/* ----- INTERNAL FUNCTIONS IMPLEMENTATION ----- */
+
+namespace internal {
+
+/**
+ * @brief Tolerance used by the visibility tests, proportional to the
+ * magnitude of the coordinates of the input points
+ */
+inline double quickHullEpsilon(const std::vector<Point3d>& points)
+{
+    double mx = 0, my = 0, mz = 0;
+    #pragma omp parallel for reduction(max:mx,my,mz)
+    for (long long int i = 0; i < (long long int)points.size(); i++) {
+        mx = std::max(mx, std::fabs(points[i].x()));
+        my = std::max(my, std::fabs(points[i].y()));
+        mz = std::max(mz, std::fabs(points[i].z()));
+    }
+    return 3 * std::numeric_limits<double>::epsilon() * (mx + my + mz);
+}
+
+/**
+ * @brief Quickhull on the candidate points.
+ *
+ * Faces are stored in a flat vector (with a free list of the deleted faces),
+ * and every face stores the indices of the points that lie outside of it.
+ * At every step the furthest point of a face is inserted: the visible faces
+ * are collected with a visit of the adjacencies, the horizon is closed with
+ * new faces and the outside points of the visible faces are reassigned.
+ *
+ * @param[in] points: all the input points
+ * @param[in] candidates: indices of the points on which the hull is computed
+ * @param[in] eps: tolerance of the visibility tests
+ * @param[out] triangles: triangles of the hull, empty if the candidates are degenerate
+ */
+inline void quickHull(
+        const std::vector<Point3d>& points,
+        const std::vector<unsigned int>& candidates,
+        double eps,
+        std::vector<unsigned int>& triangles)
+{
+    struct HorizonEdge {
+        unsigned int a, b, face;
+    };
+
+    triangles.clear();
+
+    std::vector<QuickHullFace> faces;
+    std::vector<unsigned int> freeFaces;
+    if (!quickHullInitialSimplex(points, candidates, eps, faces))
+        return;
+
+    std::vector<unsigned int> newFaces = {0, 1, 2, 3};
+    quickHullAssignPoints(points, candidates, newFaces, eps, faces);
+
+    std::vector<unsigned int> stack;
+    for (unsigned int f : newFaces)
+        if (!faces[f].outside.empty())
+            stack.push_back(f);
+
+    std::vector<unsigned int> visible;
+    std::vector<unsigned int> orphans;
+    std::vector<HorizonEdge> horizon;
+    std::vector<std::pair<unsigned int, unsigned int>> startVertices;
+
+    while (!stack.empty()) {
+        const unsigned int f = stack.back();
+        stack.pop_back();
+        if (!faces[f].alive || faces[f].outside.empty())
+            continue;
+
+        const unsigned int eye = faces[f].furthest;
+        const Point3d& eyePoint = points[eye];
+
+        //visible faces and horizon
+        visible.clear();
+        horizon.clear();
+        faces[f].visible = true;
+        visible.push_back(f);
+        for (unsigned int i = 0; i < visible.size(); i++) {
+            const unsigned int vf = visible[i];
+            for (unsigned int e = 0; e < 3; e++) {
+                const unsigned int g = faces[vf].adj[e];
+                if (faces[g].visible)
+                    continue;
+                if (quickHullDistance(faces[g], eyePoint) > eps) {
+                    faces[g].visible = true;
+                    visible.push_back(g);
+                }
+                else {
+                    horizon.push_back({faces[vf].v[e], faces[vf].v[(e+1)%3], g});
+                }
+            }
+        }
+
+        //new faces
+        newFaces.clear();
+        startVertices.clear();
+        for (const HorizonEdge& h : horizon) {
+            const unsigned int nf = quickHullAddFace(faces, freeFaces, h.a, h.b, eye, points);
+            faces[nf].adj[0] = h.face;
+            QuickHullFace& g = faces[h.face];
+            for (unsigned int k = 0; k < 3; k++) {
+                if (g.v[k] == h.b && g.v[(k+1)%3] == h.a)
+                    g.adj[k] = nf;
+            }
+            newFaces.push_back(nf);
+            startVertices.push_back(std::make_pair(h.a, nf));
+        }
+        std::sort(startVertices.begin(), startVertices.end());
+        for (unsigned int nf : newFaces) {
+            const unsigned int g = std::lower_bound(
+                        startVertices.begin(),
+                        startVertices.end(),
+                        std::make_pair(faces[nf].v[1], 0u))->second;
+            faces[nf].adj[1] = g;
+            faces[g].adj[2] = nf;
+        }
+
+        //deletion of the visible faces and reassignment of their points
+        orphans.clear();
+        for (unsigned int vf : visible) {
+            for (unsigned int p : faces[vf].outside)
+                if (p != eye)
+                    orphans.push_back(p);
+            faces[vf].alive = false;
+            faces[vf].visible = false;
+            faces[vf].outside.clear();
+            freeFaces.push_back(vf);
+        }
+        quickHullAssignPoints(points, orphans, newFaces, eps, faces);
+
+        for (unsigned int nf : newFaces)
+            if (!faces[nf].outside.empty())
+                stack.push_back(nf);
+    }
+
+    for (const QuickHullFace& face : faces) {
+        if (face.alive) {
+            triangles.push_back(face.v[0]);
+            triangles.push_back(face.v[1]);
+            triangles.push_back(face.v[2]);
+        }
+    }
+}
+
+/**
+ * @brief Akl-Toussaint heuristic: computes the hull of the extreme points along
+ * 14 directions and discards all the points that lie inside it.
+ * @param[in] points: input points
+ * @param[in] eps: tolerance of the visibility tests
+ * @param[out] candidates: indices of the points that may lie on the hull
+ */
+inline void aklToussaintFilter(
+        const std::vector<Point3d>& points,
+        double eps,
+        std::vector<unsigned int>& candidates)
+{
+    //the 14 directions are the axes and the diagonals of the cube: the extremes
+    //are the minimum and the maximum of x, y, z, x+y+z, x+y-z, x-y+z and x-y-z
+    unsigned int extremes[14];
+    double extremeValues[14];
+    for (unsigned int d = 0; d < 14; d++) {
+        extremes[d] = 0;
+        extremeValues[d] = -std::numeric_limits<double>::max();
+    }
+
+    #pragma omp parallel
+    {
+        unsigned int localExtremes[14];
+        double localValues[14];
+        for (unsigned int d = 0; d < 14; d++) {
+            localExtremes[d] = 0;
+            localValues[d] = -std::numeric_limits<double>::max();
+        }
+
+        #pragma omp for nowait
+        for (long long int i = 0; i < (long long int)points.size(); i++) {
+            const Point3d& p = points[i];
+            const double xy = p.x() + p.y(), xmy = p.x() - p.y();
+            const double values[7] = {p.x(), p.y(), p.z(), xy + p.z(), xy - p.z(), xmy + p.z(), xmy - p.z()};
+            for (unsigned int d = 0; d < 7; d++) {
+                if (values[d] > localValues[2*d]) {
+                    localValues[2*d] = values[d];
+                    localExtremes[2*d] = i;
+                }
+                if (-values[d] > localValues[2*d+1]) {
+                    localValues[2*d+1] = -values[d];
+                    localExtremes[2*d+1] = i;
+                }
+            }
+        }
+
+        #pragma omp critical
+        {
+            for (unsigned int d = 0; d < 14; d++) {
+                if (localValues[d] > extremeValues[d] ||
+                        (localValues[d] == extremeValues[d] && localExtremes[d] < extremes[d])) {
+                    extremeValues[d] = localValues[d];
+                    extremes[d] = localExtremes[d];
+                }
+            }
+        }
+    }
+
+    std::vector<unsigned int> extremePoints(extremes, extremes + 14);
+    std::sort(extremePoints.begin(), extremePoints.end());
+    extremePoints.erase(std::unique(extremePoints.begin(), extremePoints.end()), extremePoints.end());
+
+    std::vector<unsigned int> polytope;
+    quickHull(points, extremePoints, eps, polytope);
+
+    candidates.clear();
+    if (polytope.empty()) { //degenerate polytope: no point is discarded
+        candidates.resize(points.size());
+        for (unsigned int i = 0; i < points.size(); i++)
+            candidates[i] = i;
+        return;
+    }
+
+    //planes of the polytope, stored as separated arrays
+    std::vector<QuickHullFace> polytopeFaces;
+    std::vector<unsigned int> unused;
+    for (unsigned int t = 0; t < polytope.size(); t += 3)
+        quickHullAddFace(polytopeFaces, unused, polytope[t], polytope[t+1], polytope[t+2], points);
+    const unsigned int nPlanes = (unsigned int)polytopeFaces.size();
+    std::vector<double> nx(nPlanes), ny(nPlanes), nz(nPlanes), d(nPlanes);
+    for (unsigned int i = 0; i < nPlanes; i++) {
+        nx[i] = polytopeFaces[i].n[0];
+        ny[i] = polytopeFaces[i].n[1];
+        nz[i] = polytopeFaces[i].n[2];
+        d[i] = polytopeFaces[i].d + eps;
+    }
+
+    std::vector<unsigned char> keep(points.size(), 0);
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)points.size(); i++) {
+        const double x = points[i].x(), y = points[i].y(), z = points[i].z();
+        unsigned char outside = 0;
+        for (unsigned int j = 0; j < nPlanes; j++)
+            outside |= (nx[j] * x + ny[j] * y + nz[j] * z > d[j]);
+        keep[i] = outside;
+    }
+    for (unsigned int v : polytope)
+        keep[v] = 1;
+
+    for (unsigned int i = 0; i < points.size(); i++)
+        if (keep[i])
+            candidates.push_back(i);
+}
+
+/**
+ * @brief Signed distance of a point from the plane of a face
+ */
+inline double quickHullDistance(const QuickHullFace& f, const Point3d& p)
+{
+    return f.n[0] * p.x() + f.n[1] * p.y() + f.n[2] * p.z() - f.d;
+}
+
+/**
+ * @brief Adds the face (a, b, c) reusing, if possible, a deleted face.
+ * Adjacencies are not set.
+ */
+inline unsigned int quickHullAddFace(
+        std::vector<QuickHullFace>& faces,
+        std::vector<unsigned int>& freeFaces,
+        unsigned int a, unsigned int b, unsigned int c,
+        const std::vector<Point3d>& points)
+{
+    unsigned int id;
+    if (!freeFaces.empty()) {
+        id = freeFaces.back();
+        freeFaces.pop_back();
+    }
+    else {
+        id = (unsigned int)faces.size();
+        faces.emplace_back();
+    }
+
+    QuickHullFace& f = faces[id];
+    f.v[0] = a;
+    f.v[1] = b;
+    f.v[2] = c;
+    f.adj[0] = f.adj[1] = f.adj[2] = 0;
+    f.outside.clear();
+    f.furthest = 0;
+    f.furthestDistance = 0;
+    f.alive = true;
+    f.visible = false;
+
+    Vec3d n = (points[b] - points[a]).cross(points[c] - points[a]);
+    n.normalize();
+    f.n[0] = n.x();
+    f.n[1] = n.y();
+    f.n[2] = n.z();
+    f.d = n.dot(points[a]);
+    return id;
+}
+
+/**
+ * @brief Builds the initial tetrahedron, choosing as vertices the two most
+ * distant extreme points along the axes, the furthest point from their line
+ * and the furthest point from the plane of the three.
+ * @return false if the candidates are collinear or coplanar
+ */
+inline bool quickHullInitialSimplex(
+        const std::vector<Point3d>& points,
+        const std::vector<unsigned int>& candidates,
+        double eps,
+        std::vector<QuickHullFace>& faces)
+{
+    if (candidates.size() < 4)
+        return false;
+
+    unsigned int ext[6];
+    for (unsigned int i = 0; i < 6; i++)
+        ext[i] = candidates[0];
+    for (unsigned int c : candidates) {
+        for (unsigned int a = 0; a < 3; a++) {
+            if (points[c][a] < points[ext[2*a]][a])
+                ext[2*a] = c;
+            if (points[c][a] > points[ext[2*a+1]][a])
+                ext[2*a+1] = c;
+        }
+    }
+
+    unsigned int v0 = ext[0], v1 = ext[1];
+    double maxDist = 0;
+    for (unsigned int i = 0; i < 6; i++) {
+        for (unsigned int j = i+1; j < 6; j++) {
+            double dist = points[ext[i]].dist(points[ext[j]]);
+            if (dist > maxDist) {
+                maxDist = dist;
+                v0 = ext[i];
+                v1 = ext[j];
+            }
+        }
+    }
+    if (maxDist <= eps)
+        return false;
+
+    const Vec3d line = (points[v1] - points[v0]) / maxDist;
+    unsigned int v2 = v0;
+    maxDist = 0;
+    for (unsigned int c : candidates) {
+        double dist = (points[c] - points[v0]).cross(line).length();
+        if (dist > maxDist) {
+            maxDist = dist;
+            v2 = c;
+        }
+    }
+    if (maxDist <= eps)
+        return false;
+
+    Vec3d normal = (points[v1] - points[v0]).cross(points[v2] - points[v0]);
+    normal.normalize();
+    unsigned int v3 = v0;
+    maxDist = 0;
+    for (unsigned int c : candidates) {
+        double dist = std::fabs(normal.dot(points[c] - points[v0]));
+        if (dist > maxDist) {
+            maxDist = dist;
+            v3 = c;
+        }
+    }
+    if (maxDist <= eps)
+        return false;
+
+    const unsigned int tet[4][4] = {
+        {v0, v1, v2, v3}, {v0, v1, v3, v2}, {v0, v2, v3, v1}, {v1, v2, v3, v0}};
+    std::vector<unsigned int> unused;
+    faces.clear();
+    for (unsigned int i = 0; i < 4; i++) {
+        unsigned int f = quickHullAddFace(faces, unused, tet[i][0], tet[i][1], tet[i][2], points);
+        if (quickHullDistance(faces[f], points[tet[i][3]]) > 0) { //normal must point outside
+            faces.pop_back();
+            quickHullAddFace(faces, unused, tet[i][0], tet[i][2], tet[i][1], points);
+        }
+    }
+
+    for (unsigned int f = 0; f < 4; f++) {
+        for (unsigned int e = 0; e < 3; e++) {
+            const unsigned int a = faces[f].v[e], b = faces[f].v[(e+1)%3];
+            for (unsigned int g = 0; g < 4; g++) {
+                for (unsigned int k = 0; k < 3; k++) {
+                    if (faces[g].v[k] == b && faces[g].v[(k+1)%3] == a)
+                        faces[f].adj[e] = g;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Assigns every point to the first target face that sees it, updating
+ * the furthest point of the face. Points that are not outside any target face
+ * are discarded. Large sets of points are classified in parallel.
+ */
+inline void quickHullAssignPoints(
+        const std::vector<Point3d>& points,
+        const std::vector<unsigned int>& pointsToAssign,
+        const std::vector<unsigned int>& targetFaces,
+        double eps,
+        std::vector<QuickHullFace>& faces)
+{
+    const long long int n = (long long int)pointsToAssign.size();
+    std::vector<int> target(n, -1);
+    std::vector<double> distance(n, 0);
+
+    #pragma omp parallel for if (n > QUICKHULL_PARALLEL_THRESHOLD)
+    for (long long int i = 0; i < n; i++) {
+        const Point3d& p = points[pointsToAssign[i]];
+        for (unsigned int f : targetFaces) {
+            const double dist = quickHullDistance(faces[f], p);
+            if (dist > eps) {
+                target[i] = f;
+                distance[i] = dist;
+                break;
+            }
+        }
+    }
+
+    for (long long int i = 0; i < n; i++) {
+        if (target[i] >= 0) {
+            QuickHullFace& f = faces[target[i]];
+            if (f.outside.empty() || distance[i] > f.furthestDistance) {
+                f.furthest = pointsToAssign[i];
+                f.furthestDistance = distance[i];
+            }
+            f.outside.push_back(pointsToAssign[i]);
+        }
+    }
+}
+
+} //namespace cg3::internal
+} //namespace cg3
@@ -0,0 +1,70 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_QUICKHULL3_H
+#define CG3_QUICKHULL3_H
+
+#include "cg3/meshes/dcel/dcel.h"
+
+#include <vector>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Triangle of the hull computed by the quickhull engine. Vertices
+ * and adjacent triangles are stored as indices, the i-th adjacent triangle
+ * shares the edge v[i] -> v[(i+1)%3]. Outside points are stored as indices
+ * of the input points.
+ */
+struct QuickHullFace {
+    unsigned int v[3];
+    unsigned int adj[3];
+    double n[3];
+    double d;
+    std::vector<unsigned int> outside;
+    unsigned int furthest;
+    double furthestDistance;
+    bool alive;
+    bool visible;
+};
+
+double quickHullEpsilon(const std::vector<Point3d>& points);
+
+void quickHull(
+        const std::vector<Point3d>& points,
+        const std::vector<unsigned int>& candidates,
+        double eps,
+        std::vector<unsigned int>& triangles);
+
+void aklToussaintFilter(
+        const std::vector<Point3d>& points,
+        double eps,
+        std::vector<unsigned int>& candidates);
+
+} //namespace cg3::internal
+
+void quickHull(
+        const std::vector<Point3d>& points,
+        std::vector<unsigned int>& triangles,
+        bool aklToussaint = true);
+
+Dcel quickHull(const std::vector<Point3d>& points, bool aklToussaint = true);
+
+Dcel quickHull(const Dcel& inputDcel, bool aklToussaint = true);
+
+template <class InputContainer>
+Dcel quickHull(const InputContainer& points, bool aklToussaint = true);
+
+template <class InputIterator>
+Dcel quickHull(InputIterator first, InputIterator end, bool aklToussaint = true);
+
+} //namespace cg3
+
+#include "quickhull3.cpp"
+
+#endif // CG3_QUICKHULL3_H
@@ -13,10 +13,165 @@
 #include <cg3/algorithms/mesh_function_smoothing.h>
 #include <cg3/algorithms/normalization.h>
 
+#include <cg3/utilities/timer.h>
+
+#include <algorithm>
+#include <cmath>
+
 namespace cg3 {
 
 #ifdef CG3_EIGENMESH_DEFINED
 
+namespace internal {
+
+/**
+ * @brief Computes the neighborhoods of a vertex for a set of radii.
+ *
+ * The neighborhoods used by the saliency are the vertices reached from vId
+ * through mesh edges passing only by vertices at distance lower or equal
+ * than a radius from vId. Each vertex gets as key the smallest of the radii
+ * for which it belongs to the neighborhood, and the list is sorted by key:
+ * the neighborhood of each radius is then the prefix of the list with
+ * key <= radius, and the same list is shared by all the scales.
+ *
+ * The visit uses a bucket queue with one bucket for each radius: a vertex
+ * reached from a vertex of bucket k is inserted in the bucket of the maximum
+ * between k and the smallest radius greater or equal than its distance from
+ * vId. Buckets are processed in order, hence the first time a vertex is
+ * reached its key is already the minimum one, and vertices are emitted
+ * sorted by key. Each distance is computed only once.
+ *
+ * @param[in] mesh Input mesh
+ * @param[in] vvAdj Vertex-vertex adjacencies of the mesh
+ * @param[in] vId Vertex
+ * @param[in] radii Radii of the neighborhoods, sorted in ascending order
+ * @param[in] workspace Buffers of the visit
+ * @param[out] neighbors Neighborhood sorted by key
+ */
+CG3_INLINE void sortedNeighborhood(
+        const EigenMesh& mesh,
+        const std::vector<std::vector<int>>& vvAdj,
+        unsigned int vId,
+        const std::vector<double>& radii,
+        SaliencyWorkspace& workspace,
+        std::vector<SaliencyNeighbor>& neighbors)
+{
+    neighbors.clear();
+    if (radii.empty())
+        return;
+
+    if (workspace.reached.size() != mesh.numberVertices()) {
+        workspace.reached.assign(mesh.numberVertices(), 0);
+        workspace.distance.resize(mesh.numberVertices());
+        workspace.stamp = 0;
+    }
+    const unsigned int stamp = ++workspace.stamp;
+    workspace.levels.resize(radii.size());
+
+    const cg3::Point3d p = mesh.vertex(vId);
+    const double radius = radii.back();
+
+    workspace.reached[vId] = stamp;
+    workspace.distance[vId] = 0;
+    workspace.levels[0].push_back(vId);
+
+    for (unsigned int level = 0; level < radii.size(); level++) {
+        std::vector<unsigned int>& bucket = workspace.levels[level];
+        while (!bucket.empty()) {
+            const unsigned int currentVertex = bucket.back();
+            bucket.pop_back();
+            neighbors.push_back({radii[level], workspace.distance[currentVertex], currentVertex});
+
+            for (int adjVId : vvAdj[currentVertex]) {
+                if (workspace.reached[adjVId] != stamp) {
+                    workspace.reached[adjVId] = stamp;
+                    const double distance = p.dist(mesh.vertex(adjVId));
+                    workspace.distance[adjVId] = distance;
+                    if (distance <= radius) {
+                        unsigned int adjLevel = level;
+                        while (radii[adjLevel] < distance)
+                            adjLevel++;
+                        workspace.levels[adjLevel].push_back(adjVId);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gaussian weighted value of a function on the prefix of a sorted
+ * neighborhood with key lower or equal than neighborDistance
+ */
+CG3_INLINE double gaussianWeightedValue(
+        const std::vector<SaliencyNeighbor>& neighbors,
+        const std::vector<double>& function,
+        const double sigma,
+        const double neighborDistance)
+{
+    double numerator = 0;
+    double denominator = 0;
+    for (const SaliencyNeighbor& n : neighbors) {
+        if (n.key > neighborDistance)
+            break;
+        double expression = std::exp(-(n.distance * n.distance) / (2.0 * sigma * sigma));
+        numerator += function[n.id] * expression;
+        denominator += expression;
+    }
+    return numerator / denominator;
+}
+
+/**
+ * @brief Computes the saliency for each of the given sigmas.
+ * The neighborhood of every vertex is visited once for the radii of all the
+ * scales, and the two gaussian smoothings of all the scales are evaluated
+ * on prefixes of it. Vertices are processed in parallel.
+ * @param[in] mesh Input mesh
+ * @param[in] meanCurvature Mean curvature values
+ * @param[in] vvAdj Vertex-vertex adjacencies of the mesh
+ * @param[in] sigmas Sigma of each scale
+ * @param[out] saliencies Saliency of each scale
+ */
+CG3_INLINE void computeSaliencies(
+        const EigenMesh& mesh,
+        const std::vector<double>& meanCurvature,
+        const std::vector<std::vector<int>>& vvAdj,
+        const std::vector<double>& sigmas,
+        std::vector<std::vector<double>>& saliencies)
+{
+    const long long int nVertices = mesh.numberVertices();
+    saliencies.assign(sigmas.size(), std::vector<double>(nVertices, 0));
+    if (sigmas.empty())
+        return;
+
+    //Neighbor distances of the two smoothings of all the scales
+    std::vector<double> radii;
+    for (double sigma : sigmas) {
+        radii.push_back(sigma * 2);
+        radii.push_back(sigma * 2 * 2);
+    }
+    std::sort(radii.begin(), radii.end());
+    radii.erase(std::unique(radii.begin(), radii.end()), radii.end());
+
+    #pragma omp parallel
+    {
+        SaliencyWorkspace workspace;
+        std::vector<SaliencyNeighbor> neighbors;
+
+        #pragma omp for schedule(dynamic, 64)
+        for (long long int vId = 0; vId < nVertices; vId++) {
+            sortedNeighborhood(mesh, vvAdj, vId, radii, workspace, neighbors);
+            for (size_t i = 0; i < sigmas.size(); i++) {
+                double gaussianWeighted1 = gaussianWeightedValue(neighbors, meanCurvature, sigmas[i], sigmas[i] * 2);
+                double gaussianWeighted2 = gaussianWeightedValue(neighbors, meanCurvature, sigmas[i] * 2, sigmas[i] * 2 * 2);
+                saliencies[i][vId] = std::abs(gaussianWeighted2 - gaussianWeighted1);
+            }
+        }
+    }
+}
+
+} //namespace cg3::internal
+
 /**
  * @brief Compute saliency
  * @param mesh Input mesh
@@ -29,16 +184,12 @@ CG3_INLINE std::vector<double> computeSaliency(
         const std::vector<double>& meanCurvature,
         const double sigma)
 {
-    std::vector<double> gaussianWeighted1 = cg3::vertexFunctionGaussianSmoothing(mesh, meanCurvature, 1, sigma, sigma * 2);
-    std::vector<double> gaussianWeighted2 = cg3::vertexFunctionGaussianSmoothing(mesh, meanCurvature, 1, sigma * 2, sigma * 2 * 2);
-
-    std::vector<double> saliency(gaussianWeighted1.size());
+    std::vector<std::vector<int>> vvAdj = cg3::libigl::vertexToVertexAdjacencies(mesh);
 
-    for (size_t i = 0; i < gaussianWeighted1.size(); i++) {
-        saliency[i] = std::abs(gaussianWeighted2[i] - gaussianWeighted1[i]);
-    }
+    std::vector<std::vector<double>> saliencies;
+    internal::computeSaliencies(mesh, meanCurvature, vvAdj, std::vector<double>(1, sigma), saliencies);
 
-    return saliency;
+    return saliencies[0];
 }
 
 /**
@@ -60,10 +211,18 @@ CG3_INLINE std::vector<double> computeSaliency(
 
 
 /**
- * @brief Compute multi-scale saliency
+ * @brief Compute multi-scale saliency.
+ *
+ * The neighborhood of each vertex is visited once for all the scales (see
+ * internal::sortedNeighborhood), and vertices and scales are processed in
+ * parallel.
+ *
  * @param mesh Input mesh
- * @param sigma Maximum distance of a vertex to be counted as neighbor in the saliency calculation
- * @param nRing Ring for computing the curvature
+ * @param meanCurvature Mean curvature values
+ * @param vvAdj Vertex-vertex adjacencies of the mesh
+ * @param nScales Number of scales
+ * @param eps Factor of the bounding box diagonal used for the sigma of the scales
+ * @param timings If not null, the time spent by each stage is stored here
  * @return Saliency
 */
 CG3_INLINE std::vector<double> computeSaliencyMultiScale(
@@ -71,8 +230,13 @@ CG3_INLINE std::vector<double> computeSaliencyMultiScale(
         const std::vector<double>& meanCurvature,
         const std::vector<std::vector<int>>& vvAdj,
         const unsigned int nScales,
-        const double eps)
+        const double eps,
+        SaliencyTimings* timings)
 {
+    cg3::Timer totalTimer;
+    cg3::Timer timer;
+
+    const long long int nVertices = mesh.numberVertices();
     double boundingBoxFactor = (mesh.boundingBox().diag() * eps);
 
     //Calculate sigmas
@@ -82,81 +246,85 @@ CG3_INLINE std::vector<double> computeSaliencyMultiScale(
     }
 
     //Calculate saliencies for each scale
-    std::vector<std::vector<double>> saliencies(nScales);
-    for(size_t i = 0; i < nScales; i++){
-        saliencies[i] = cg3::computeSaliency(mesh, meanCurvature, sigma[i]);
-    }
+    std::vector<std::vector<double>> saliencies;
+    internal::computeSaliencies(mesh, meanCurvature, vvAdj, sigma, saliencies);
+
+    timer.stop();
+    if (timings)
+        timings->smoothing = timer.delay();
+    timer.start();
 
-    //Find min and max saliencies
+    //Linear normalization of each scale
     std::vector<std::vector<double>> normalizedSaliencies(nScales);
-    for (size_t i = 0; i < saliencies.size(); i++) {
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < (int)nScales; i++) {
         normalizedSaliencies[i] = cg3::linearNormalization(saliencies[i]);
     }
 
-    //Find average local maximas
-    std::vector<std::vector<double>> localMaximas(nScales, std::vector<double>(mesh.numberVertices(), -std::numeric_limits<double>::max()));
-    for(size_t i = 0; i < nScales; i++) {
-        for(unsigned int vId = 0; vId < mesh.numberVertices(); vId++) {
-            //Current point being evaluated
-            cg3::Point3d p = mesh.vertex(vId);
-
-            //Stack
-            std::vector<int> stack;
-            std::vector<bool> visited(mesh.numberVertices(), false);
-
-            //Initializing with the current vertex
-            stack.push_back(vId);
-            visited[vId] = true;
-
-            while (!stack.empty()){
-                int currentVertex = stack.back();
-                stack.pop_back();
-
-                cg3::Point3d currentPoint = mesh.vertex(currentVertex);
-
-                for(size_t j = 0; j < vvAdj[currentVertex].size(); j++){
-                    int adjVId = vvAdj[currentVertex][j];
-
-                    if(!visited[adjVId]) {
-                        double distance = mesh.vertex(vId).dist(mesh.vertex(adjVId));
-
-                        if (distance <= sigma[i]) {
-                            stack.push_back(vvAdj[currentVertex][j]);
-                            visited[vvAdj[currentVertex][j]] = true;
-                        }
+    timer.stop();
+    if (timings)
+        timings->normalization = timer.delay();
+    timer.start();
+
+    //Find local maximas, on neighborhoods of the largest sigma shared by all the scales
+    std::vector<std::vector<double>> localMaximas(nScales, std::vector<double>(nVertices, -std::numeric_limits<double>::max()));
+    if (nScales > 0) {
+        #pragma omp parallel
+        {
+            internal::SaliencyWorkspace workspace;
+            std::vector<internal::SaliencyNeighbor> neighbors;
+
+            #pragma omp for schedule(dynamic, 64)
+            for (long long int vId = 0; vId < nVertices; vId++) {
+                internal::sortedNeighborhood(mesh, vvAdj, vId, sigma, workspace, neighbors);
+                for (size_t i = 0; i < nScales; i++) {
+                    double localMaxima = -std::numeric_limits<double>::max();
+                    for (const internal::SaliencyNeighbor& n : neighbors) {
+                        if (n.key > sigma[i])
+                            break;
+                        localMaxima = std::max(localMaxima, normalizedSaliencies[i][n.id]);
                     }
+                    localMaximas[i][vId] = localMaxima;
                 }
-
-                localMaximas[i][vId] = std::max(localMaximas[i][vId], normalizedSaliencies[i][currentVertex]);
             }
         }
     }
 
     //Multiply for non-linear normalization factor
-    for (size_t i = 0; i < nScales; i++) {
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < (int)nScales; i++) {
         double avgLocalMaxima = 0; //Local maxima average
         unsigned int nLocalMaxima = 0;
-        for(unsigned int vId = 0; vId < mesh.numberVertices(); vId++) {
+        for(long long int vId = 0; vId < nVertices; vId++) {
             if (localMaximas[i][vId] < 1) {
                 avgLocalMaxima += localMaximas[i][vId];
                 nLocalMaxima++;
             }
         }
-        avgLocalMaxima /= nLocalMaxima;
+        if (nLocalMaxima > 0)
+            avgLocalMaxima /= nLocalMaxima;
 
-        for(unsigned int vId = 0; vId < mesh.numberVertices(); vId++) {
+        for(long long int vId = 0; vId < nVertices; vId++) {
             normalizedSaliencies[i][vId] *= (1 - avgLocalMaxima) * (1 - avgLocalMaxima);
         }
     }
 
     //Compute final result
-    std::vector<double> saliencyMultiScale(mesh.numberVertices(), 0.0);
-    for (size_t i = 0; i < nScales; i++) {
-        for(unsigned int vId = 0; vId < mesh.numberVertices(); vId++) {
+    std::vector<double> saliencyMultiScale(nVertices, 0.0);
+    #pragma omp parallel for
+    for(long long int vId = 0; vId < nVertices; vId++) {
+        for (size_t i = 0; i < nScales; i++) {
             saliencyMultiScale[vId] += normalizedSaliencies[i][vId];
         }
     }
 
+    timer.stop();
+    totalTimer.stop();
+    if (timings) {
+        timings->localMaxima = timer.delay();
+        timings->total = timings->curvature + timings->adjacencies + totalTimer.delay();
+    }
+
     return saliencyMultiScale;
 }
 
@@ -172,10 +340,16 @@ CG3_INLINE std::vector<double> computeSaliencyMultiScale(
         const std::vector<std::vector<int>>& vvAdj,
         const unsigned int nRing,
         const unsigned int nScales,
-        const double eps)
+        const double eps,
+        SaliencyTimings* timings)
 {
+    cg3::Timer timer;
     std::vector<double> meanCurvature = cg3::libigl::meanVertexCurvature(mesh, nRing);
-    return computeSaliencyMultiScale(mesh, meanCurvature, vvAdj, nScales, eps);
+    timer.stop();
+    if (timings)
+        timings->curvature = timer.delay();
+
+    return computeSaliencyMultiScale(mesh, meanCurvature, vvAdj, nScales, eps, timings);
 }
 
 /**
@@ -189,10 +363,16 @@ CG3_INLINE std::vector<double> computeSaliencyMultiScale(
         const cg3::EigenMesh& mesh,
         const unsigned int nRing,
         const unsigned int nScales,
-        const double eps)
+        const double eps,
+        SaliencyTimings* timings)
 {
+    cg3::Timer timer;
     std::vector<std::vector<int>> vvAdj = cg3::libigl::vertexToVertexAdjacencies(mesh);
-    return computeSaliencyMultiScale(mesh, vvAdj, nRing, nScales, eps);
+    timer.stop();
+    if (timings)
+        timings->adjacencies = timer.delay();
+
+    return computeSaliencyMultiScale(mesh, vvAdj, nRing, nScales, eps, timings);
 }
 
 
@@ -14,6 +14,57 @@
 
 namespace cg3 {
 
+/**
+ * @brief Time (in seconds) spent by each stage of the multi-scale saliency
+ */
+struct SaliencyTimings {
+    double curvature = 0;      //mean curvature
+    double adjacencies = 0;    //vertex-vertex adjacencies
+    double smoothing = 0;      //gaussian smoothings of all the scales
+    double normalization = 0;  //linear normalization of all the scales
+    double localMaxima = 0;    //local maxima and non-linear normalization
+    double total = 0;
+};
+
+namespace internal {
+
+/**
+ * @brief Vertex of the neighborhood of a vertex, with its distance from the
+ * vertex and the smallest radius for which it belongs to the neighborhood
+ */
+struct SaliencyNeighbor {
+    double key;
+    double distance;
+    unsigned int id;
+};
+
+/**
+ * @brief Buffers used by the visits of the neighborhoods, one for each thread
+ */
+struct SaliencyWorkspace {
+    std::vector<unsigned int> reached;
+    std::vector<double> distance;
+    std::vector<std::vector<unsigned int>> levels;
+    unsigned int stamp = 0;
+};
+
+void sortedNeighborhood(
+        const EigenMesh& mesh,
+        const std::vector<std::vector<int>>& vvAdj,
+        unsigned int vId,
+        const std::vector<double>& radii,
+        SaliencyWorkspace& workspace,
+        std::vector<SaliencyNeighbor>& neighbors);
+
+void computeSaliencies(
+        const EigenMesh& mesh,
+        const std::vector<double>& meanCurvature,
+        const std::vector<std::vector<int>>& vvAdj,
+        const std::vector<double>& sigmas,
+        std::vector<std::vector<double>>& saliencies);
+
+} //namespace cg3::internal
+
 std::vector<double> computeSaliency(
         const EigenMesh& mesh,
         const std::vector<double>& meanCurvature,
@@ -30,20 +81,23 @@ std::vector<double> computeSaliencyMultiScale(
         const std::vector<double>& meanCurvature,
         const std::vector<std::vector<int>>& vvAdj,
         const unsigned int nScales = 5,
-        const double eps = 0.003);
+        const double eps = 0.003,
+        SaliencyTimings* timings = nullptr);
 
 std::vector<double> computeSaliencyMultiScale(
         const cg3::EigenMesh& mesh,
         const std::vector<std::vector<int>>& vvAdj,
         const unsigned int nRing = 5,
         const unsigned int nScales = 5,
-        const double eps = 0.003);
+        const double eps = 0.003,
+        SaliencyTimings* timings = nullptr);
 
 std::vector<double> computeSaliencyMultiScale(
         const cg3::EigenMesh& mesh,
         const unsigned int nRing = 5,
         const unsigned int nScales = 5,
-        const double eps = 0.003);
+        const double eps = 0.003,
+        SaliencyTimings* timings = nullptr);
 
 
 } //namespace cg3
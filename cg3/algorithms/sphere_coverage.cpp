@@ -7,6 +7,8 @@
  */
 
 #include "sphere_coverage.h"
+#include <map>
+#include <mutex>
 #include <random>
 
 namespace cg3 {
@@ -27,8 +29,9 @@ inline std::vector<Point3d> sphereCoverage(
     if (nSamples > 0) {
         points.reserve(nSamples);
 
-        static std::random_device r;
-        static std::mt19937 mt(r());
+        //one generator per thread: concurrent calls do not share its state
+        static thread_local std::random_device r;
+        static thread_local std::mt19937 mt(r());
         std::uniform_real_distribution<> dist(0, 1);
 
         double rnd = 1;
@@ -79,4 +82,23 @@ inline std::vector<cg3::Point3d> sphereCoverageFibonacci(unsigned int nSamples)
     return points;
 }
 
+/**
+ * @brief sharedSphereCoverageFibonacci
+ *
+ * Returns the same points of sphereCoverageFibonacci, computed only the first
+ * time a given number of samples is requested. The returned points are
+ * immutable and can be shared between threads. This function is thread safe.
+ */
+inline std::shared_ptr<const std::vector<cg3::Point3d>> sharedSphereCoverageFibonacci(unsigned int nSamples)
+{
+    static std::mutex cacheMutex;
+    static std::map<unsigned int, std::shared_ptr<const std::vector<cg3::Point3d>>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::shared_ptr<const std::vector<cg3::Point3d>>& points = cache[nSamples];
+    if (!points)
+        points = std::make_shared<const std::vector<cg3::Point3d>>(sphereCoverageFibonacci(nSamples));
+    return points;
+}
+
 } //namespace cg3
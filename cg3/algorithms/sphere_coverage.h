@@ -11,12 +11,16 @@
 
 #include <cg3/geometry/point3.h>
 
+#include <memory>
+
 namespace cg3 {
 
 std::vector<Point3d> sphereCoverage(unsigned int nSamples = 1000, bool deterministic = true);
 
 std::vector<Point3d> sphereCoverageFibonacci(unsigned int nSamples = 1000);
 
+std::shared_ptr<const std::vector<Point3d>> sharedSphereCoverageFibonacci(unsigned int nSamples = 1000);
+
 } //namespace cg3
 
 #include "sphere_coverage.cpp"
@@ -0,0 +1,225 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "sphere_directions.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+
+namespace cg3 {
+
+CG3_INLINE SphereDirections::SphereDirections() :
+    cellSize(2),
+    gridRes(1),
+    gridBuildSize(0)
+{
+}
+
+/**
+ * @brief Creates a set containing the first nDirections directions of the sequence
+ */
+CG3_INLINE SphereDirections::SphereDirections(unsigned int nDirections) :
+    SphereDirections()
+{
+    refine(nDirections);
+}
+
+CG3_INLINE unsigned int SphereDirections::size() const
+{
+    return (unsigned int)dirs.size();
+}
+
+CG3_INLINE const Vec3d& SphereDirections::direction(unsigned int i) const
+{
+    return dirs[i];
+}
+
+CG3_INLINE const std::vector<Vec3d>& SphereDirections::directions() const
+{
+    return dirs;
+}
+
+/**
+ * @brief Returns the first nDirections directions of the set, which are evenly
+ * distributed as well.
+ */
+CG3_INLINE std::vector<Vec3d> SphereDirections::directions(unsigned int nDirections) const
+{
+    nDirections = std::min(nDirections, size());
+    return std::vector<Vec3d>(dirs.begin(), dirs.begin() + nDirections);
+}
+
+/**
+ * @brief Appends directions to the set until it contains nDirections directions.
+ * The directions already in the set are not modified.
+ */
+CG3_INLINE void SphereDirections::refine(unsigned int nDirections)
+{
+    if (nDirections <= dirs.size())
+        return;
+    unsigned int first = (unsigned int)dirs.size();
+    dirs.reserve(nDirections);
+    for (unsigned int i = first; i < nDirections; ++i)
+        dirs.push_back(sequenceDirection(i));
+
+    if (dirs.size() >= 2 * (size_t)gridBuildSize) {
+        buildGrid();
+    }
+    else {
+        for (unsigned int i = first; i < nDirections; ++i)
+            insertInGrid(i);
+    }
+}
+
+/**
+ * @brief Returns the index of the direction of the set nearest to dir.
+ * dir does not need to be normalized. The set must not be empty.
+ *
+ * Cells are visited in rings of increasing size around the cell of dir,
+ * stopping when no unvisited cell can contain a nearer direction.
+ */
+CG3_INLINE unsigned int SphereDirections::nearestDirection(const Vec3d& dir) const
+{
+    assert(!dirs.empty());
+    Vec3d q = dir;
+    q.normalize();
+    int ci, cj, ck;
+    cellOf(q, ci, cj, ck);
+
+    unsigned int best = std::numeric_limits<unsigned int>::max();
+    double bestDist = std::numeric_limits<double>::max();
+    for (int r = 0; r <= gridRes; ++r) {
+        for (int i = ci - r; i <= ci + r; ++i) {
+            if (i < 0 || i >= gridRes)
+                continue;
+            for (int j = cj - r; j <= cj + r; ++j) {
+                if (j < 0 || j >= gridRes)
+                    continue;
+                bool onShell = std::abs(i - ci) == r || std::abs(j - cj) == r;
+                int kStep = onShell || r == 0 ? 1 : 2 * r;
+                for (int k = ck - r; k <= ck + r; k += kStep) {
+                    if (k < 0 || k >= gridRes)
+                        continue;
+                    auto it = cells.find(cellKey(i, j, k));
+                    if (it == cells.end())
+                        continue;
+                    for (unsigned int id : it->second) {
+                        double d = (dirs[id] - q).lengthSquared();
+                        if (d < bestDist || (d == bestDist && id < best)) {
+                            bestDist = d;
+                            best = id;
+                        }
+                    }
+                }
+            }
+        }
+        //directions in cells outside the ring are farther than r * cellSize
+        if (best != std::numeric_limits<unsigned int>::max() &&
+                std::sqrt(bestDist) <= r * cellSize)
+            break;
+    }
+    return best;
+}
+
+/**
+ * @brief Returns the i-th direction of the sequence.
+ *
+ * The R2 sequence (additive recurrence based on the plastic number) gives a
+ * point of the square, which is mapped on the sphere with the concentric
+ * octahedral equal-area mapping (Clarberg, "Fast equal-area mapping of the
+ * (hemi)sphere using SIMD", JGT 2008). The mapping has low distortion, hence
+ * the even distribution of the sequence is preserved on the sphere.
+ */
+CG3_INLINE Vec3d SphereDirections::sequenceDirection(unsigned int i)
+{
+    const double g = 1.32471795724474602596;
+    const double a1 = 1.0 / g;
+    const double a2 = 1.0 / (g * g);
+    double u = 0.5 + a1 * i;
+    double v = 0.5 + a2 * i;
+    u = 2 * (u - std::floor(u)) - 1;
+    v = 2 * (v - std::floor(v)) - 1;
+
+    double au = std::abs(u), av = std::abs(v);
+    double sd = 1 - (au + av);
+    double r = 1 - std::abs(sd);
+    double phi = (r == 0 ? 1 : (av - au) / r + 1) * M_PI / 4;
+    double z = std::copysign(1 - r * r, sd);
+    double s = r * std::sqrt(std::max(0.0, 2 - r * r));
+    return Vec3d(
+                std::copysign(std::cos(phi), u) * s,
+                std::copysign(std::sin(phi), v) * s,
+                z);
+}
+
+CG3_INLINE unsigned long long int SphereDirections::cellKey(int i, int j, int k) const
+{
+    return ((unsigned long long int)i * gridRes + j) * gridRes + k;
+}
+
+CG3_INLINE void SphereDirections::cellOf(const Vec3d& p, int& i, int& j, int& k) const
+{
+    i = std::min(gridRes - 1, std::max(0, (int)std::floor((p.x() + 1) / cellSize)));
+    j = std::min(gridRes - 1, std::max(0, (int)std::floor((p.y() + 1) / cellSize)));
+    k = std::min(gridRes - 1, std::max(0, (int)std::floor((p.z() + 1) / cellSize)));
+}
+
+CG3_INLINE void SphereDirections::insertInGrid(unsigned int id)
+{
+    int i, j, k;
+    cellOf(dirs[id], i, j, k);
+    cells[cellKey(i, j, k)].push_back(id);
+}
+
+/**
+ * @brief The size of the cells is the average distance between directions,
+ * so that every cell crossed by the sphere contains few directions
+ */
+CG3_INLINE void SphereDirections::buildGrid()
+{
+    gridBuildSize = (unsigned int)dirs.size();
+    cellSize = std::min(2.0, std::sqrt(4 * M_PI / gridBuildSize));
+    gridRes = std::max(1, (int)std::ceil(2 / cellSize));
+    cells.clear();
+    cells.reserve(gridBuildSize);
+    for (unsigned int id = 0; id < dirs.size(); ++id)
+        insertInGrid(id);
+}
+
+/**
+ * @brief Returns an immutable set of nDirections directions, which can be
+ * shared between threads.
+ *
+ * Sets are cached: when a set of the requested size has not been computed
+ * yet, it is obtained by refining the largest cached set having less
+ * directions. This function is thread safe.
+ */
+CG3_INLINE std::shared_ptr<const SphereDirections> sharedSphereDirections(unsigned int nDirections)
+{
+    static std::mutex cacheMutex;
+    static std::map<unsigned int, std::shared_ptr<const SphereDirections>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.lower_bound(nDirections);
+    if (it != cache.end() && it->first == nDirections)
+        return it->second;
+
+    std::shared_ptr<SphereDirections> set;
+    if (it != cache.begin()) {
+        --it;
+        set = std::make_shared<SphereDirections>(*it->second);
+        set->refine(nDirections);
+    }
+    else {
+        set = std::make_shared<SphereDirections>(nDirections);
+    }
+    cache[nDirections] = set;
+    return set;
+}
+
+} //namespace cg3
@@ -0,0 +1,74 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_SPHERE_DIRECTIONS_H
+#define CG3_SPHERE_DIRECTIONS_H
+
+#include <cg3/geometry/point3.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace cg3 {
+
+/**
+ * @brief A progressive set of evenly distributed directions on the unit sphere.
+ *
+ * The i-th direction depends only on i: directions are generated by a
+ * low-discrepancy sequence mapped on the sphere with an equal-area projection,
+ * hence every prefix of the set is evenly distributed. A coarse set can then be
+ * refined by appending new directions, without recomputing the existing ones.
+ *
+ * Directions are bucketed in a uniform grid of cells having the size of the
+ * average distance between directions, which allows to find the nearest
+ * direction of a query in constant expected time. The grid is rebuilt every
+ * time the set doubles its size.
+ *
+ * The class is not synchronized: a const SphereDirections can be read by
+ * any number of threads. Use sharedSphereDirections to get cached immutable
+ * sets that can be shared between threads and algorithms.
+ */
+class SphereDirections
+{
+public:
+    SphereDirections();
+    SphereDirections(unsigned int nDirections);
+
+    unsigned int size() const;
+    const cg3::Vec3d& direction(unsigned int i) const;
+    const std::vector<cg3::Vec3d>& directions() const;
+    std::vector<cg3::Vec3d> directions(unsigned int nDirections) const;
+
+    void refine(unsigned int nDirections);
+    unsigned int nearestDirection(const cg3::Vec3d& dir) const;
+
+    static cg3::Vec3d sequenceDirection(unsigned int i);
+
+protected:
+    unsigned long long int cellKey(int i, int j, int k) const;
+    void cellOf(const cg3::Vec3d& p, int& i, int& j, int& k) const;
+    void insertInGrid(unsigned int id);
+    void buildGrid();
+
+    std::vector<cg3::Vec3d> dirs;
+    double cellSize;
+    int gridRes;
+    unsigned int gridBuildSize;
+    std::unordered_map<unsigned long long int, std::vector<unsigned int>> cells;
+};
+
+std::shared_ptr<const SphereDirections> sharedSphereDirections(unsigned int nDirections);
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define  CG3_SPHERE_DIRECTIONS_CPP "sphere_directions.cpp"
+#include  CG3_SPHERE_DIRECTIONS_CPP
+#undef  CG3_SPHERE_DIRECTIONS_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_SPHERE_DIRECTIONS_H
@@ -119,6 +119,8 @@ contains(DEFINES, CG3_CGAL_DEFINED) { #if CGAL was found, depending on the archi
         $$PWD/cgal/minimum_bbox2.h \
         $$PWD/cgal/polyhedron.h \
         $$PWD/cgal/sdf.h \
+        $$PWD/cgal/sdf_session.h \
+        $$PWD/cgal/internal/facet_with_id_pmap.h \
         $$PWD/cgal/segment_intersections2.h \
         $$PWD/cgal/slicer.h \
         $$PWD/cgal/surface_mesh.h \
@@ -138,6 +140,7 @@ contains(DEFINES, CG3_CGAL_DEFINED) { #if CGAL was found, depending on the archi
         $$PWD/cgal/minimum_bbox2.cpp \
         $$PWD/cgal/polyhedron.cpp \
         $$PWD/cgal/sdf.cpp \
+        $$PWD/cgal/sdf_session.cpp \
         $$PWD/cgal/segment_intersections2.cpp \
         $$PWD/cgal/slicer.cpp \
         $$PWD/cgal/surface_mesh.cpp \
@@ -0,0 +1,49 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_CGAL_FACET_WITH_ID_PMAP_H
+#define CG3_CGAL_FACET_WITH_ID_PMAP_H
+
+#include "../polyhedron.h"
+
+#include <CGAL/boost/graph/graph_traits_Polyhedron_3.h>
+
+#include <vector>
+
+namespace cg3 {
+namespace cgal {
+namespace internal {
+
+/**
+ * @brief Property map that stores the values of the facets of a
+ * PolyhedronWithId in a vector indexed by facet id.
+ */
+template<class ValueType>
+struct Facet_with_id_pmap
+    : public boost::put_get_helper<ValueType&,
+             Facet_with_id_pmap<ValueType> >
+{
+    typedef boost::graph_traits<PolyhedronWithId>::face_descriptor face_descriptor;
+
+    typedef face_descriptor key_type;
+    typedef ValueType value_type;
+    typedef value_type& reference;
+    typedef boost::lvalue_property_map_tag category;
+    Facet_with_id_pmap(
+      std::vector<ValueType>& internal_vector
+    ) : internal_vector(internal_vector) { }
+    reference operator[](key_type key) const
+    { return internal_vector[key->id()]; }
+private:
+    std::vector<ValueType>& internal_vector;
+};
+
+} //namespace cg3::cgal::internal
+} //namespace cg3::cgal
+} //namespace cg3
+
+#endif // CG3_CGAL_FACET_WITH_ID_PMAP_H
@@ -9,15 +9,12 @@
 #include "polyhedron.h"
 
 #include <CGAL/Polyhedron_incremental_builder_3.h>
+#include <CGAL/Inverse_index.h>
 
 #include <vector>
 #include <string>
 #include <algorithm>
 
-#ifdef CG3_DCEL_DEFINED
-#include <cg3/meshes/dcel/dcel_builder.h>
-#endif
-
 namespace cg3 {
 namespace cgal {
 
@@ -25,16 +22,17 @@ namespace cgal {
 /**
  * @ingroup cg3cgal
  * @brief cgal::polyhedron::getPolyhedronFromDcel
+ *
+ * The vertices and the faces of the polyhedron have the order of the
+ * vertexIterator and of the faceIterator of the dcel: the index of a vertex
+ * (face) of the polyhedron is the one given by dcel.compactVertexIds()
+ * (dcel.compactFaceIds()).
+ *
  * @param dcel
- * @param vertexMap
- * @param faceMap
  * @return
  */
 template<class P>
-P polyhedronFromDcel(
-        const Dcel& dcel,
-        std::map<const Dcel::Vertex*, int>& vertexMap,
-        std::map<const Dcel::Face*, int>& faceMap)
+P polyhedronFromDcel(const Dcel& dcel)
 {
     typedef typename P::HalfedgeDS  HalfedgeDS;
 
@@ -42,19 +40,14 @@ P polyhedronFromDcel(
     {
     public:
         const Dcel* mesh;
-        std::map<const Dcel::Vertex*, int>* vertexMap;
-        std::map<const Dcel::Face*, int>* faceMap;
 
-        PolyhedronBuilder(const Dcel* dcel,
-                              std::map<const Dcel::Vertex*, int>& vertexMap,
-                              std::map<const Dcel::Face*, int>& faceMap) :
-            mesh(dcel), vertexMap(&vertexMap), faceMap(&faceMap)
+        PolyhedronBuilder(const Dcel* dcel) :
+            mesh(dcel)
         {}
 
         void operator()( HalfedgeDS& hds)
         {
-            vertexMap->clear();
-            faceMap->clear();
+            const std::vector<int> vertexIds = mesh->compactVertexIds();
 
             // Postcondition: hds is a valid polyhedral surface.
             CGAL::Polyhedron_incremental_builder_3<HalfedgeDS> B( hds, true);
@@ -63,39 +56,68 @@ P polyhedronFromDcel(
             typedef typename HalfedgeDS::Vertex   PolyhedronVertex;
             typedef typename PolyhedronVertex::Point        PolyhedronPoint;
 
-            int vIndex = 0;
             for (const Dcel::Vertex* v : mesh->vertexIterator()) {
 				Point3d coordinate = v->coordinate();
 
                 B.add_vertex(PolyhedronPoint(coordinate.x(), coordinate.y(), coordinate.z()));
-                vertexMap->insert(std::make_pair(v,vIndex));
-                vIndex++;
             }
 
-            int fIndex = 0;
             for (const Dcel::Face* f : mesh->faceIterator()) {
                 B.begin_facet();
                 for (const Dcel::Vertex* v : f->incidentVertexIterator()) {
-                    B.add_vertex_to_facet(vertexMap->at(v));
+                    B.add_vertex_to_facet(vertexIds[v->id()]);
                 }
                 B.end_facet();
-                faceMap->insert(std::make_pair(f, fIndex));
-                fIndex++;
             }
             B.end_surface();
         }
     };
 
     P mesh;
-    PolyhedronBuilder polyhedronDcelBuilder(&dcel, vertexMap, faceMap);
+    PolyhedronBuilder polyhedronDcelBuilder(&dcel);
     mesh.delegate(polyhedronDcelBuilder);
 
     return mesh;
 }
 
+/**
+ * @ingroup cg3cgal
+ * @brief cgal::polyhedron::getPolyhedronFromDcel
+ *
+ * Like polyhedronFromDcel(const Dcel&), and fills the maps with the index in
+ * the polyhedron of every vertex and face of the dcel.
+ *
+ * @param dcel
+ * @param vertexMap
+ * @param faceMap
+ * @return
+ */
+template<class P>
+P polyhedronFromDcel(
+        const Dcel& dcel,
+        std::map<const Dcel::Vertex*, int>& vertexMap,
+        std::map<const Dcel::Face*, int>& faceMap)
+{
+    vertexMap.clear();
+    int vIndex = 0;
+    for (const Dcel::Vertex* v : dcel.vertexIterator())
+        vertexMap.insert(vertexMap.end(), std::make_pair(v, vIndex++));
+
+    faceMap.clear();
+    int fIndex = 0;
+    for (const Dcel::Face* f : dcel.faceIterator())
+        faceMap.insert(faceMap.end(), std::make_pair(f, fIndex++));
+
+    return polyhedronFromDcel<P>(dcel);
+}
+
 /**
  * @ingroup cg3cgal
  * @brief cgal::polyhedron::getDcelFromPolyhedron
+ *
+ * The vertices and the faces of the dcel have the order of the vertices and
+ * of the facets of the polyhedron.
+ *
  * @param poly
  * @return
  */
@@ -105,18 +127,40 @@ Dcel dcelFromPolyhedron(const P& poly)
     typedef typename P::HalfedgeDS  HalfedgeDS;
     typedef typename HalfedgeDS::Vertex  PolyhedronVertex;
     typedef typename PolyhedronVertex::Point       PolyhedronPoint;
-	DcelBuilder d;
-    for (typename P::Vertex_const_iterator vit = poly.vertices_begin(); vit != poly.vertices_end(); ++vit){
-        PolyhedronPoint p = (*vit).point();
-		Point3d point(p.x(), p.y(), p.z());
-        d.addVertex(point);
-    }
+    typedef typename P::Vertex_const_iterator Vertex_const_iterator;
+    typedef typename P::Halfedge_around_facet_const_circulator Halfedge_facet_circulator;
 
-    //add faces to dcel
+    std::vector<double> coords;
+    std::vector<unsigned int> faces, faceSizes;
+    coords.reserve(poly.size_of_vertices() * 3);
+    faces.reserve(poly.size_of_halfedges() / 2);
+    faceSizes.reserve(poly.size_of_facets());
+
+    for (Vertex_const_iterator vit = poly.vertices_begin(); vit != poly.vertices_end(); ++vit){
+        const PolyhedronPoint& p = vit->point();
+        coords.push_back(CGAL::to_double(p.x()));
+        coords.push_back(CGAL::to_double(p.y()));
+        coords.push_back(CGAL::to_double(p.z()));
+    }
 
-	d.finalize();
+    // index of every vertex in the vertex list, as in the CGAL writers
+    CGAL::Inverse_index<Vertex_const_iterator> vertexIds(poly.vertices_begin(), poly.vertices_end());
+    for (typename P::Facet_const_iterator fit = poly.facets_begin(); fit != poly.facets_end(); ++fit) {
+        Halfedge_facet_circulator circulator = fit->facet_begin();
+        unsigned int size = 0;
+        do {
+            faces.push_back((unsigned int)vertexIds[Vertex_const_iterator(circulator->vertex())]);
+            size++;
+        } while (++circulator != fit->facet_begin());
+        faceSizes.push_back(size);
+    }
 
-	return d.dcel();
+    Dcel d;
+    d.loadFromArrays(
+                (unsigned int)poly.size_of_vertices(), coords.data(),
+                (unsigned int)faceSizes.size(), faces.data(), faceSizes.data());
+    d.updateVertexNormals();
+    return d;
 }
 #endif
 
@@ -179,32 +223,36 @@ SimpleEigenMesh eigenMeshFromPolyhedron(const P& poly)
     typedef typename P::HalfedgeDS  HalfedgeDS;
     typedef typename HalfedgeDS::Vertex  PolyhedronVertex;
     typedef typename PolyhedronVertex::Point       PolyhedronPoint;
+    typedef typename P::Vertex_const_iterator Vertex_const_iterator;
     typedef typename P::Halfedge_around_facet_const_circulator Halfedge_facet_circulator;
 
-    SimpleEigenMesh d;
+    Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> V(poly.size_of_vertices(), 3);
+    Eigen::Matrix<int, Eigen::Dynamic, 3, Eigen::RowMajor> F(poly.size_of_facets(), 3);
 
-    std::map<PolyhedronPoint, unsigned int> map;
-
-    for (typename P::Vertex_const_iterator vit = poly.vertices_begin(); vit != poly.vertices_end(); ++vit) {
-        PolyhedronPoint p = (*vit).point();
-		Point3d point(p.x(), p.y(), p.z());
-        map.insert(std::make_pair(p, d.addVertex(point)));
+    int vIndex = 0;
+    for (Vertex_const_iterator vit = poly.vertices_begin(); vit != poly.vertices_end(); ++vit) {
+        const PolyhedronPoint& p = vit->point();
+        V(vIndex, 0) = CGAL::to_double(p.x());
+        V(vIndex, 1) = CGAL::to_double(p.y());
+        V(vIndex, 2) = CGAL::to_double(p.z());
+        vIndex++;
     }
 
+    CGAL::Inverse_index<Vertex_const_iterator> vertexIds(poly.vertices_begin(), poly.vertices_end());
+
+    int fIndex = 0;
     for (typename P::Facet_const_iterator fit = poly.facets_begin(); fit != poly.facets_end(); ++fit) {
         Halfedge_facet_circulator circulator = fit->facet_begin();
 
-        unsigned int v[3];
         int i = 0;
         do {
-            v[i] = map.at(circulator->vertex()->point());
+            F(fIndex, i) = (int)vertexIds[Vertex_const_iterator(circulator->vertex())];
             i++;
-        } while (++circulator != fit->facet_begin());
-
-        d.addFace(v[0], v[1], v[2]);
+        } while (++circulator != fit->facet_begin() && i < 3);
+        fIndex++;
     }
 
-    return d;
+    return SimpleEigenMesh(V, F);
 }
 
 #endif
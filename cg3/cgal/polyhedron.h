@@ -38,17 +38,12 @@ typedef CGAL::Polyhedron_3<CGAL::Exact_predicates_inexact_constructions_kernel>
 typedef CGAL::Polyhedron_3<CGAL::Simple_cartesian<double>, CGAL::Polyhedron_items_with_id_3> PolyhedronWithId;
 
 #ifdef  CG3_DCEL_DEFINED
-namespace internal {
-
-static std::map<const Dcel::Vertex*, int> dummyVertexMap;
-static std::map<const Dcel::Face*, int> dummyFaceMap;
-
-} //namespace cg3::cgal::internal
-
+template<class P = Polyhedron>
+P polyhedronFromDcel(const Dcel& dcel);
 template<class P = Polyhedron>
 P polyhedronFromDcel(const Dcel& dcel,
-        std::map<const Dcel::Vertex*, int>& vertexMap = internal::dummyVertexMap,
-        std::map<const Dcel::Face*, int>& faceMap = internal::dummyFaceMap);
+        std::map<const Dcel::Vertex*, int>& vertexMap,
+        std::map<const Dcel::Face*, int>& faceMap);
 
 template<class P = Polyhedron>
 Dcel dcelFromPolyhedron(const P& poly);
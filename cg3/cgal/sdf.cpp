@@ -62,11 +62,26 @@ CG3_INLINE std::vector<double> SDFMap(const Polyhedron &mesh)
 
 #ifdef  CG3_DCEL_DEFINED
 //USAGE EXAMPLE:
-//std::map<const Dcel::Face*, double> sdfMap = CGALInterface::SDF::getSDFMap(drawableDcel);
-//for (Dcel::Face* face : drawableDcel->faceIterator()) {
-//    face->setColor(Color(255*sdfMap.at(face), 255*sdfMap.at(face), 255*sdfMap.at(face)));
+//std::vector<double> sdf = cg3::cgal::SDFValues(dcel);
+//std::vector<int> ids = dcel.compactFaceIds();
+//for (Dcel::Face* face : dcel.faceIterator()) {
+//    double v = sdf[ids[face->id()]];
+//    face->setColor(Color(255*v, 255*v, 255*v));
 //}
 
+/**
+ * @ingroup cg3cgal
+ * @brief Computes the SDF of the faces of the Dcel with CGAL::sdf_values.
+ * @param dcel
+ * @return the SDF value of every face, indexed by dcel.compactFaceIds()
+ * (i.e. in the order of the faceIterator)
+ */
+CG3_INLINE std::vector<double> SDFValues(const Dcel& dcel)
+{
+    Polyhedron mesh = polyhedronFromDcel(dcel);
+    return SDFMap(mesh);
+}
+
 /**
  * @ingroup cg3cgal
  * @brief cgal::sdf::getSDFMap
@@ -75,34 +90,13 @@ CG3_INLINE std::vector<double> SDFMap(const Polyhedron &mesh)
  */
 CG3_INLINE std::map<const Dcel::Face*, double> SDFMap(const Dcel& dcel)
 {
-    std::map<const Dcel::Face*, int> faceMap;
-    std::map<const Dcel::Vertex*, int> vertexMap;
-    Polyhedron mesh = polyhedronFromDcel(dcel, vertexMap, faceMap);
-
-    // compute inverse map
-    std::map<int, const Dcel::Face*> invFaceMap;
-    for (const Dcel::Face* face : dcel.faceIterator()) {
-         invFaceMap.insert(std::make_pair(faceMap.at(face), face));
-    }
-
-    std::vector<double> sdf = SDFMap(mesh);
+    std::vector<double> sdf = SDFValues(dcel);
 
-    // save SDF values
+    // save SDF values: the facets of the polyhedron follow the faceIterator
     std::map<const Dcel::Face*, double> sdfMap;
-
-    int fIndex = 0;
-    for (Polyhedron::Facet_const_iterator facet_it = mesh.facets_begin();
-         facet_it != mesh.facets_end(); ++facet_it) {
-
-        // get SDF value
-        double sdfValue = sdf[fIndex];
-
-        // save on the result sdf map
-        const Dcel::Face* face = invFaceMap.at(fIndex);
-        sdfMap.insert(std::make_pair(face, sdfValue));
-
-        fIndex++;
-    }
+    unsigned int fIndex = 0;
+    for (const Dcel::Face* face : dcel.faceIterator())
+        sdfMap.insert(std::make_pair(face, sdf[fIndex++]));
 
     return sdfMap;
 }
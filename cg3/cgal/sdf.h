@@ -23,6 +23,7 @@ namespace cgal {
 std::vector<double> SDFMap(const Polyhedron& mesh);
 
 #ifdef  CG3_DCEL_DEFINED
+std::vector<double> SDFValues(const Dcel& dcel);
 std::map<const Dcel::Face*, double> SDFMap(const Dcel& dcel);
 #endif
 
@@ -9,6 +9,8 @@
 
 #if BOOST_VERSION > 106501
 
+#include "internal/facet_with_id_pmap.h"
+
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/boost/graph/graph_traits_Polyhedron_3.h>
 #include <CGAL/IO/Polyhedron_iostream.h>
@@ -55,6 +57,20 @@ CG3_INLINE std::vector<int> sdfSegmentation(const Polyhedron &mesh)
     return association;
 }
 
+#ifdef  CG3_DCEL_DEFINED
+/**
+ * @ingroup cg3cgal
+ * @brief Segments the Dcel with CGAL::segmentation_from_sdf_values.
+ * @return the label of every face, indexed by dcel.compactFaceIds()
+ * (i.e. in the order of the faceIterator)
+ */
+CG3_INLINE std::vector<int> sdfSegmentation(const Dcel& dcel)
+{
+    Polyhedron mesh = polyhedronFromDcel(dcel);
+    return sdfSegmentation(mesh);
+}
+#endif
+
 #ifdef  CG3_EIGENMESH_DEFINED
 
 CG3_INLINE std::vector<int> sdfSegmentation(const SimpleEigenMesh &m)
@@ -65,32 +81,6 @@ CG3_INLINE std::vector<int> sdfSegmentation(const SimpleEigenMesh &m)
 #endif
 
 
-template<class ValueType>
-struct Facet_with_id_pmap
-    : public boost::put_get_helper<ValueType&,
-             Facet_with_id_pmap<ValueType> >
-{
-
-    typedef boost::graph_traits<PolyhedronWithId>::vertex_descriptor     vertex_descriptor;
-    typedef boost::graph_traits<PolyhedronWithId>::halfedge_descriptor   halfedge_descriptor;
-    typedef boost::graph_traits<PolyhedronWithId>::face_descriptor       face_descriptor;
-    typedef CGAL::Mean_curvature_flow_skeletonization<PolyhedronWithId>        Skeletonization;
-    typedef Skeletonization::Skeleton                                    Skeleton;
-    typedef Skeleton::vertex_descriptor                                  Skeleton_vertex;
-
-    typedef face_descriptor key_type;
-    typedef ValueType value_type;
-    typedef value_type& reference;
-    typedef boost::lvalue_property_map_tag category;
-    Facet_with_id_pmap(
-      std::vector<ValueType>& internal_vector
-    ) : internal_vector(internal_vector) { }
-    reference operator[](key_type key) const
-    { return internal_vector[key->id()]; }
-private:
-    std::vector<ValueType>& internal_vector;
-};
-
 CG3_INLINE std::vector<int> skeletonSdfSegmentation(PolyhedronWithId& mesh)
 {
     typedef boost::graph_traits<PolyhedronWithId>::vertex_descriptor     vertex_descriptor;
@@ -121,7 +111,7 @@ CG3_INLINE std::vector<int> skeletonSdfSegmentation(PolyhedronWithId& mesh)
 
     // create a property-map for sdf values
     std::vector<double> sdf_values( num_faces(mesh) );
-    Facet_with_id_pmap<double> sdf_property_map(sdf_values);
+    internal::Facet_with_id_pmap<double> sdf_property_map(sdf_values);
 
     // compute sdf values with skeleton
     BOOST_FOREACH(face_descriptor f, faces(mesh))
@@ -137,7 +127,7 @@ CG3_INLINE std::vector<int> skeletonSdfSegmentation(PolyhedronWithId& mesh)
 
     // create a property-map for segment-ids (it is an adaptor for this case)
     std::vector<std::size_t> segment_ids( num_faces(mesh) );
-    Facet_with_id_pmap<std::size_t> segment_property_map(segment_ids);
+    internal::Facet_with_id_pmap<std::size_t> segment_property_map(segment_ids);
 
     // segment the mesh using default parameters
     std::size_t number_of_segments = CGAL::segmentation_from_sdf_values(mesh, sdf_property_map, segment_property_map);
@@ -159,6 +149,20 @@ CG3_INLINE std::vector<int> skeletonSdfSegmentation(PolyhedronWithId& mesh)
     return association;
 }
 
+#ifdef  CG3_DCEL_DEFINED
+/**
+ * @ingroup cg3cgal
+ * @brief Segments the Dcel using the SDF computed from its skeleton.
+ * @return the label of every face, indexed by dcel.compactFaceIds()
+ * (i.e. in the order of the faceIterator)
+ */
+CG3_INLINE std::vector<int> skeletonSdfSegmentation(const Dcel& dcel)
+{
+    PolyhedronWithId pmesh = polyhedronFromDcel<PolyhedronWithId>(dcel);
+    return skeletonSdfSegmentation(pmesh);
+}
+#endif
+
 #ifdef  CG3_EIGENMESH_DEFINED
 
 CG3_INLINE std::vector<int> skeletonSdfSegmentation(const SimpleEigenMesh &mesh)
@@ -14,6 +14,9 @@
 
 #include "polyhedron.h"
 
+#ifdef  CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/dcel.h>
+#endif
 #ifdef  CG3_EIGENMESH_DEFINED
 #include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
 #endif
@@ -24,6 +27,11 @@ namespace cgal {
 std::vector<int> skeletonSdfSegmentation(PolyhedronWithId& mesh);
 std::vector<int> sdfSegmentation(const Polyhedron& mesh);
 
+#ifdef  CG3_DCEL_DEFINED
+std::vector<int> sdfSegmentation(const Dcel& dcel);
+std::vector<int> skeletonSdfSegmentation(const Dcel& dcel);
+#endif
+
 #ifdef  CG3_EIGENMESH_DEFINED
 std::vector<int> sdfSegmentation(const SimpleEigenMesh& m);
 std::vector<int> skeletonSdfSegmentation(const SimpleEigenMesh& m);
@@ -0,0 +1,344 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "sdf_session.h"
+
+#include <CGAL/mesh_segmentation.h>
+#include <CGAL/Polyhedron_items_with_id_3.h>
+#if BOOST_VERSION > 106501
+#include <CGAL/extract_mean_curvature_flow_skeleton.h>
+#include <boost/foreach.hpp>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace cg3 {
+namespace cgal {
+
+/**
+ * @brief Creates a session on a copy of the given polyhedron. The results are
+ * indexed by the position of the facets in the polyhedron.
+ * @param mesh: a triangle mesh
+ */
+CG3_INLINE SDFSession::SDFSession(const PolyhedronWithId& mesh) :
+    mesh(mesh)
+{
+    outputIds.resize(mesh.size_of_facets());
+    for (unsigned int i = 0; i < outputIds.size(); i++)
+        outputIds[i] = i;
+    outputSize = (unsigned int)outputIds.size();
+    init();
+}
+
+#ifdef  CG3_DCEL_DEFINED
+/**
+ * @brief Creates a session on a triangle Dcel. The results are indexed by the
+ * ids of the faces of the Dcel.
+ * @param dcel
+ */
+CG3_INLINE SDFSession::SDFSession(const Dcel& dcel) :
+    mesh(polyhedronFromDcel<PolyhedronWithId>(dcel))
+{
+    outputIds.reserve(dcel.numberFaces());
+    for (const Dcel::Face* f : dcel.faceIterator())
+        outputIds.push_back(f->id());
+    outputSize = (unsigned int)dcel.compactFaceIds().size();
+    //the dcel could not be converted (e.g. non manifold): no results
+    if (mesh.size_of_facets() != outputIds.size())
+        mesh.clear();
+    init();
+}
+#endif
+
+#ifdef  CG3_EIGENMESH_DEFINED
+/**
+ * @brief Creates a session on a SimpleEigenMesh. The results are indexed by
+ * the indices of the faces of the mesh.
+ * @param m
+ */
+CG3_INLINE SDFSession::SDFSession(const SimpleEigenMesh& m) :
+    mesh(polyhedronFromEigenMesh<PolyhedronWithId>(m))
+{
+    outputIds.resize(m.numberFaces());
+    for (unsigned int i = 0; i < outputIds.size(); i++)
+        outputIds[i] = i;
+    outputSize = (unsigned int)outputIds.size();
+    if (mesh.size_of_facets() != outputIds.size())
+        mesh.clear();
+    init();
+}
+#endif
+
+CG3_INLINE unsigned int SDFSession::numberFaces() const
+{
+    return (unsigned int)facets.size();
+}
+
+/**
+ * @brief Computes the Shape Diameter Function of every face.
+ *
+ * For every face, numberRays rays are cast inside the cone with apex on the
+ * centroid of the face, axis opposite to its normal and opening coneAngle.
+ * The SDF is the weighted average of the lengths of the rays, after removing
+ * the outliers.
+ *
+ * @param coneAngle: opening angle of the cone of rays, in radians
+ * @param numberRays: number of rays cast from every face
+ * @param postprocess: if true, the values are smoothed and normalized in
+ * [0, 1] (see CGAL::sdf_values_postprocessing); otherwise faces whose rays
+ * did not hit the mesh have value -1
+ * @param seed: seed of the rotation of the rays
+ * @return the sdf values, indexed by face id
+ */
+CG3_INLINE std::vector<double> SDFSession::sdf(
+        double coneAngle,
+        unsigned int numberRays,
+        bool postprocess,
+        unsigned int seed) const
+{
+    //Vogel's spiral on the unit disk: (x, y) of every sample
+    const double goldenAngle = CGAL_PI * (3.0 - std::sqrt(5.0));
+    std::vector<double> samples(numberRays * 2);
+    for (unsigned int i = 0; i < numberRays; i++) {
+        double r = std::sqrt((i + 0.5) / numberRays);
+        samples[i*2]   = r * std::cos(i * goldenAngle);
+        samples[i*2+1] = r * std::sin(i * goldenAngle);
+    }
+
+    std::vector<double> values(facets.size());
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)facets.size(); i++) {
+        values[i] = faceSdf((unsigned int)i, samples, coneAngle, seed);
+    }
+
+    if (postprocess && !values.empty())
+        values = postprocessed(values);
+    return toOutput(values);
+}
+
+/**
+ * @brief Segments the mesh with CGAL::segmentation_from_sdf_values.
+ * @param sdf: values returned by sdf() or skeletonSdf(), normalized in [0, 1]
+ * @param numberClusters: number of levels used by the soft clustering
+ * @param smoothingLambda: importance of the surface features in the graph cut
+ * @return the segment of every face, indexed by face id
+ */
+CG3_INLINE std::vector<int> SDFSession::segmentation(
+        const std::vector<double>& sdf,
+        unsigned int numberClusters,
+        double smoothingLambda) const
+{
+    std::vector<double> values(facets.size());
+    for (unsigned int i = 0; i < facets.size(); i++)
+        values[i] = sdf[outputIds[i]];
+    std::vector<std::size_t> labels(facets.size(), 0);
+    if (!facets.empty()) {
+        internal::Facet_with_id_pmap<double> sdfMap(values);
+        internal::Facet_with_id_pmap<std::size_t> segmentMap(labels);
+        CGAL::segmentation_from_sdf_values(
+                    mesh, sdfMap, segmentMap, numberClusters, smoothingLambda);
+    }
+    return toOutput(labels);
+}
+
+/**
+ * @brief Segments the mesh using the sdf values computed with the default
+ * parameters.
+ */
+CG3_INLINE std::vector<int> SDFSession::sdfSegmentation(
+        unsigned int numberClusters,
+        double smoothingLambda) const
+{
+    return segmentation(sdf(), numberClusters, smoothingLambda);
+}
+
+#if BOOST_VERSION > 106501
+/**
+ * @brief Computes, for every face, the average distance of its vertices from
+ * the mean curvature flow skeleton of the mesh.
+ *
+ * The skeleton is extracted at the first call.
+ *
+ * @param postprocess: if true, the values are smoothed and normalized in [0, 1]
+ * @return the values, indexed by face id
+ */
+CG3_INLINE std::vector<double> SDFSession::skeletonSdf(bool postprocess)
+{
+    typedef boost::graph_traits<PolyhedronWithId>::vertex_descriptor vertex_descriptor;
+    typedef CGAL::Mean_curvature_flow_skeletonization<PolyhedronWithId> Skeletonization;
+    typedef Skeletonization::Skeleton Skeleton;
+    typedef Skeleton::vertex_descriptor Skeleton_vertex;
+
+    if (skeletonValues.empty() && !facets.empty()) {
+        Skeleton skeleton;
+        CGAL::extract_mean_curvature_flow_skeleton(mesh, skeleton);
+        CGAL::set_halfedgeds_items_id(mesh);
+
+        std::vector<double> distances(mesh.size_of_vertices(), 0);
+        BOOST_FOREACH(Skeleton_vertex v, vertices(skeleton))
+        {
+            const PolyhedronWithId::Point& skel_pt = skeleton[v].point;
+            BOOST_FOREACH(vertex_descriptor mesh_v, skeleton[v].vertices)
+            {
+                const PolyhedronWithId::Point& mesh_pt = mesh_v->point();
+                distances[mesh_v->id()] = std::sqrt(CGAL::squared_distance(skel_pt, mesh_pt));
+            }
+        }
+
+        skeletonValues.resize(facets.size());
+        for (unsigned int i = 0; i < facets.size(); i++) {
+            PolyhedronWithId::Halfedge_handle h = facets[i]->halfedge();
+            skeletonValues[i] = (distances[h->vertex()->id()] +
+                    distances[h->next()->vertex()->id()] +
+                    distances[h->next()->next()->vertex()->id()]) / 3.;
+        }
+    }
+
+    if (postprocess && !skeletonValues.empty())
+        return toOutput(postprocessed(skeletonValues));
+    return toOutput(skeletonValues);
+}
+
+/**
+ * @brief Segments the mesh using the skeleton based sdf values.
+ */
+CG3_INLINE std::vector<int> SDFSession::skeletonSdfSegmentation(
+        unsigned int numberClusters,
+        double smoothingLambda)
+{
+    return segmentation(skeletonSdf(), numberClusters, smoothingLambda);
+}
+#endif
+
+CG3_INLINE void SDFSession::init()
+{
+    CGAL::set_halfedgeds_items_id(mesh);
+
+    facets.resize(mesh.size_of_facets());
+    centers.resize(facets.size());
+    normals.resize(facets.size());
+    for (PolyhedronWithId::Facet_iterator f = mesh.facets_begin(); f != mesh.facets_end(); ++f) {
+        facets[f->id()] = f;
+        PolyhedronWithId::Halfedge_handle h = f->halfedge();
+        const K::Point_3& p0 = h->vertex()->point();
+        const K::Point_3& p1 = h->next()->vertex()->point();
+        const K::Point_3& p2 = h->next()->next()->vertex()->point();
+        centers[f->id()] = CGAL::centroid(p0, p1, p2);
+        K::Vector_3 n = CGAL::cross_product(p1 - p0, p2 - p0);
+        double length = std::sqrt(n.squared_length());
+        normals[f->id()] = length > 0 ? n / length : n;
+    }
+
+    //the tree is built here: queries from several threads only read it
+    tree.reset(new internal::SDFTree(faces(mesh).first, faces(mesh).second, mesh));
+    tree->build();
+}
+
+/**
+ * @brief Casts the rays of a face and returns its raw sdf value, -1 if no ray
+ * hits the inner side of the mesh.
+ */
+CG3_INLINE double SDFSession::faceSdf(
+        unsigned int f,
+        const std::vector<double>& samples,
+        double coneAngle,
+        unsigned int seed) const
+{
+    const K::Vector_3& n = normals[f];
+    if (n.squared_length() == 0)
+        return -1;
+
+    //orthonormal basis of the plane of the face
+    K::Vector_3 u = std::abs(n.x()) < 0.9 ?
+                CGAL::cross_product(n, K::Vector_3(1, 0, 0)) :
+                CGAL::cross_product(n, K::Vector_3(0, 1, 0));
+    u = u / std::sqrt(u.squared_length());
+    K::Vector_3 v = CGAL::cross_product(n, u);
+
+    std::seed_seq seq{seed, f};
+    std::mt19937 generator(seq);
+    double rotation = std::uniform_real_distribution<double>(0, 2 * CGAL_PI)(generator);
+    double cr = std::cos(rotation), sr = std::sin(rotation);
+    double radius = std::tan(coneAngle / 2);
+
+    const PolyhedronWithId::Facet_handle facet = facets[f];
+    auto skip = [&facet](const PolyhedronWithId::Facet_handle& other) {
+        return other == facet;
+    };
+
+    std::vector<std::pair<double, double>> rays; //length, weight
+    rays.reserve(samples.size() / 2);
+    for (unsigned int i = 0; i < samples.size(); i += 2) {
+        double x = cr * samples[i] - sr * samples[i+1];
+        double y = sr * samples[i] + cr * samples[i+1];
+        K::Vector_3 d = -n + radius * (x * u + y * v);
+        auto hit = tree->first_intersection(K::Ray_3(centers[f], d), skip);
+        if (!hit)
+            continue;
+
+        //the ray must leave the mesh through the hit face
+        unsigned int g = (unsigned int)hit->second->id();
+        double dn = d * normals[g];
+        if (dn <= 0)
+            continue;
+        double dLength = std::sqrt(d.squared_length());
+        double t = ((centers[g] - centers[f]) * normals[g]) / dn;
+        rays.push_back(std::make_pair(t * dLength, 1 / dLength));
+    }
+    if (rays.empty())
+        return -1;
+
+    //rays farther than the standard deviation from the median are outliers
+    std::vector<double> lengths(rays.size());
+    for (unsigned int i = 0; i < rays.size(); i++)
+        lengths[i] = rays[i].first;
+    std::nth_element(lengths.begin(), lengths.begin() + lengths.size() / 2, lengths.end());
+    double median = lengths[lengths.size() / 2];
+    double deviation = 0, totalWeight = 0;
+    for (const std::pair<double, double>& r : rays) {
+        deviation += r.second * (r.first - median) * (r.first - median);
+        totalWeight += r.second;
+    }
+    deviation = std::sqrt(deviation / totalWeight);
+
+    double sum = 0, weight = 0;
+    for (const std::pair<double, double>& r : rays) {
+        if (std::abs(r.first - median) <= deviation) {
+            sum += r.second * r.first;
+            weight += r.second;
+        }
+    }
+    return weight > 0 ? sum / weight : median;
+}
+
+CG3_INLINE std::vector<double> SDFSession::postprocessed(std::vector<double> values) const
+{
+    internal::Facet_with_id_pmap<double> sdfMap(values);
+    CGAL::sdf_values_postprocessing(mesh, sdfMap);
+    return values;
+}
+
+CG3_INLINE std::vector<double> SDFSession::toOutput(const std::vector<double>& values) const
+{
+    std::vector<double> output(outputSize, -1);
+    for (unsigned int i = 0; i < values.size(); i++)
+        output[outputIds[i]] = values[i];
+    return output;
+}
+
+CG3_INLINE std::vector<int> SDFSession::toOutput(const std::vector<std::size_t>& labels) const
+{
+    std::vector<int> output(outputSize, -1);
+    for (unsigned int i = 0; i < labels.size(); i++)
+        output[outputIds[i]] = static_cast<int>(labels[i]);
+    return output;
+}
+
+} //namespace cg3::cgal
+} //namespace cg3
@@ -0,0 +1,140 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_CGAL_SDF_SESSION_H
+#define CG3_CGAL_SDF_SESSION_H
+
+#include <boost/version.hpp>
+
+#include "polyhedron.h"
+#include "internal/facet_with_id_pmap.h"
+
+#include <CGAL/AABB_tree.h>
+#include <CGAL/AABB_traits.h>
+#include <CGAL/AABB_face_graph_triangle_primitive.h>
+#include <CGAL/boost/graph/graph_traits_Polyhedron_3.h>
+
+#include <memory>
+#include <vector>
+
+#ifdef  CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/dcel.h>
+#endif
+#ifdef  CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
+namespace cg3 {
+namespace cgal {
+
+namespace internal {
+
+typedef CGAL::AABB_face_graph_triangle_primitive<PolyhedronWithId> SDFPrimitive;
+typedef CGAL::AABB_traits<PolyhedronWithId::Traits, SDFPrimitive> SDFTraits;
+typedef CGAL::AABB_tree<SDFTraits> SDFTree;
+
+} //namespace cg3::cgal::internal
+
+/**
+ * @ingroup cg3cgal
+ * @brief The SDFSession class computes the Shape Diameter Function of the
+ * faces of a triangle mesh, and the segmentations based on it.
+ *
+ * The mesh is converted and the AABB tree used to cast the rays is built only
+ * once, in the constructor; the skeleton used by the skeleton based SDF is
+ * extracted at the first call and then kept. Therefore the SDF can be computed
+ * several times with different parameters without paying again these costs:
+ *
+ * \code{*.cpp}
+ * cg3::cgal::SDFSession session(dcel);
+ * std::vector<double> sdf = session.sdf();
+ * std::vector<int> coarse = session.segmentation(sdf, 3);
+ * std::vector<int> fine = session.segmentation(sdf, 8, 0.1);
+ * \endcode
+ *
+ * All the results are vectors indexed by the ids of the faces of the input
+ * mesh (for a Dcel, unused ids have value -1).
+ *
+ * The rays of every face are cast in parallel, and are sampled in the cone
+ * with a pattern rotated by a random angle taken from a generator seeded with
+ * the seed and the face index: the results do not depend on the number of
+ * threads.
+ *
+ * The rays are cast by the session and not by CGAL::sdf_values: the scheme is
+ * the same, but the values are not bit-to-bit equal to the ones returned by
+ * SDFMap and by the other free functions, which keep using CGAL.
+ * The session has not yet been compared with CGAL::sdf_values on real meshes:
+ * prefer the free functions when the values must be the ones of CGAL.
+ */
+class SDFSession
+{
+public:
+    SDFSession(const PolyhedronWithId& mesh);
+    #ifdef  CG3_DCEL_DEFINED
+    SDFSession(const Dcel& dcel);
+    #endif
+    #ifdef  CG3_EIGENMESH_DEFINED
+    SDFSession(const SimpleEigenMesh& m);
+    #endif
+    SDFSession(const SDFSession&) = delete;
+    SDFSession& operator=(const SDFSession&) = delete;
+
+    unsigned int numberFaces() const;
+
+    std::vector<double> sdf(
+            double coneAngle = 2.0 / 3.0 * CGAL_PI,
+            unsigned int numberRays = 25,
+            bool postprocess = true,
+            unsigned int seed = 0) const;
+    std::vector<int> segmentation(
+            const std::vector<double>& sdf,
+            unsigned int numberClusters = 5,
+            double smoothingLambda = 0.26) const;
+    std::vector<int> sdfSegmentation(
+            unsigned int numberClusters = 5,
+            double smoothingLambda = 0.26) const;
+
+    #if BOOST_VERSION > 106501
+    std::vector<double> skeletonSdf(bool postprocess = true);
+    std::vector<int> skeletonSdfSegmentation(
+            unsigned int numberClusters = 5,
+            double smoothingLambda = 0.26);
+    #endif
+
+private:
+    typedef PolyhedronWithId::Traits K;
+
+    void init();
+    double faceSdf(
+            unsigned int f,
+            const std::vector<double>& samples,
+            double coneAngle,
+            unsigned int seed) const;
+    std::vector<double> postprocessed(std::vector<double> values) const;
+    std::vector<double> toOutput(const std::vector<double>& values) const;
+    std::vector<int> toOutput(const std::vector<std::size_t>& labels) const;
+
+    PolyhedronWithId mesh;
+    std::unique_ptr<internal::SDFTree> tree;
+    std::vector<PolyhedronWithId::Facet_handle> facets; //indexed by facet id
+    std::vector<K::Point_3> centers;
+    std::vector<K::Vector_3> normals;
+    std::vector<unsigned int> outputIds; //output index of every facet
+    unsigned int outputSize;
+    std::vector<double> skeletonValues;  //raw skeleton sdf, empty if not computed
+};
+
+} //namespace cg3::cgal
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_CGAL_SDF_SESSION_CPP "sdf_session.cpp"
+#include CG3_CGAL_SDF_SESSION_CPP
+#undef CG3_CGAL_SDF_SESSION_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_CGAL_SDF_SESSION_H
@@ -16,6 +16,21 @@
 #include <CGAL/AABB_traits.h>
 #include <CGAL/Polygon_mesh_slicer.h>
 
+#include <algorithm>
+#include <numeric>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/dcel.h>
+#endif
+
+#ifdef CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
 namespace cg3 {
 namespace cgal {
 namespace internal {
@@ -115,5 +130,392 @@ CG3_INLINE std::vector<std::vector<Point3d> > polylines(
 }
 #endif
 
+/**
+ * @brief Heights of the vertices along a normal, intervals of heights of the
+ * edges and edges sorted by the lower end of their interval.
+ */
+struct Slicer::Sweep {
+    std::vector<double> heights;
+    std::vector<double> low, high;
+    std::vector<unsigned int> order;
+};
+
+/**
+ * @brief Returns true if the i-th polyline is closed (its last index is equal
+ * to the first one).
+ */
+CG3_INLINE bool Slicer::Slice::isClosed(unsigned int i) const
+{
+    return polylines[i].size() > 1 && polylines[i].front() == polylines[i].back();
+}
+
+/**
+ * @brief Returns the polylines as sequences of points, in the format returned
+ * by polylines().
+ */
+CG3_INLINE std::vector<std::vector<Point3d>> Slicer::Slice::polylinePoints() const
+{
+    std::vector<std::vector<Point3d>> result(polylines.size());
+    for (unsigned int i = 0; i < polylines.size(); i++){
+        result[i].reserve(polylines[i].size());
+        for (unsigned int p : polylines[i])
+            result[i].push_back(points[p]);
+    }
+    return result;
+}
+
+/**
+ * @brief Creates a slicer on a surface mesh. Non triangular faces are
+ * triangulated as fans.
+ * @param mesh
+ */
+CG3_INLINE Slicer::Slicer(const SurfaceMesh& mesh)
+{
+    std::vector<unsigned int> vertexIds(mesh.num_vertices());
+    vertices.reserve(mesh.number_of_vertices());
+    for (SurfaceMesh::Vertex_index v : mesh.vertices()){
+        const SurfaceMesh::Point& p = mesh.point(v);
+        vertexIds[(unsigned int)v] = (unsigned int)vertices.size();
+        vertices.push_back(Point3d(p.x(), p.y(), p.z()));
+    }
+    triangles.reserve(mesh.number_of_faces() * 3);
+    std::vector<unsigned int> face;
+    for (SurfaceMesh::Face_index f : mesh.faces()){
+        face.clear();
+        for (SurfaceMesh::Vertex_index v : mesh.vertices_around_face(mesh.halfedge(f)))
+            face.push_back(vertexIds[(unsigned int)v]);
+        for (unsigned int i = 1; i + 1 < face.size(); i++){
+            triangles.push_back(face[0]);
+            triangles.push_back(face[i]);
+            triangles.push_back(face[i+1]);
+        }
+    }
+    build();
+}
+
+#ifdef CG3_DCEL_DEFINED
+/**
+ * @brief Creates a slicer on a Dcel. Non triangular faces are triangulated as
+ * fans.
+ * @param mesh
+ */
+CG3_INLINE Slicer::Slicer(const Dcel& mesh)
+{
+    const std::vector<int> vertexIds = mesh.compactVertexIds();
+    vertices.reserve(mesh.numberVertices());
+    for (const Dcel::Vertex* v : mesh.vertexIterator())
+        vertices.push_back(v->coordinate());
+    triangles.reserve(mesh.numberFaces() * 3);
+    std::vector<unsigned int> face;
+    for (const Dcel::Face* f : mesh.faceIterator()){
+        face.clear();
+        for (const Dcel::Vertex* v : f->incidentVertexIterator())
+            face.push_back(vertexIds[v->id()]);
+        for (unsigned int i = 1; i + 1 < face.size(); i++){
+            triangles.push_back(face[0]);
+            triangles.push_back(face[i]);
+            triangles.push_back(face[i+1]);
+        }
+    }
+    build();
+}
+#endif
+
+#ifdef CG3_EIGENMESH_DEFINED
+/**
+ * @brief Creates a slicer on a SimpleEigenMesh.
+ * @param mesh
+ */
+CG3_INLINE Slicer::Slicer(const SimpleEigenMesh& mesh)
+{
+    vertices.resize(mesh.numberVertices());
+    for (unsigned int i = 0; i < mesh.numberVertices(); i++)
+        vertices[i] = mesh.vertex(i);
+    triangles.resize(mesh.numberFaces() * 3);
+    for (unsigned int i = 0; i < mesh.numberFaces(); i++){
+        Point3i f = mesh.face(i);
+        triangles[i*3]   = f.x();
+        triangles[i*3+1] = f.y();
+        triangles[i*3+2] = f.z();
+    }
+    build();
+}
+#endif
+
+CG3_INLINE unsigned int Slicer::numberTriangles() const
+{
+    return (unsigned int)triangles.size() / 3;
+}
+
+CG3_INLINE unsigned int Slicer::numberEdges() const
+{
+    return (unsigned int)edges.size();
+}
+
+/**
+ * @brief Computes the contours of the plane normal * p + d = 0.
+ *
+ * @par Complexity:
+ *      \e O(numEdges)
+ */
+CG3_INLINE Slicer::Slice Slicer::slice(const Vec3d& normal, double d) const
+{
+    Sweep s;
+    s.heights.resize(vertices.size());
+    for (unsigned int i = 0; i < vertices.size(); i++)
+        s.heights[i] = normal.dot(vertices[i]);
+
+    const double t = -d;
+    std::vector<unsigned int> crossing;
+    for (unsigned int e = 0; e < edges.size(); e++){
+        double h0 = s.heights[edges[e][0]], h1 = s.heights[edges[e][1]];
+        if (std::min(h0, h1) < t && std::max(h0, h1) >= t)
+            crossing.push_back(e);
+    }
+
+    Slice result;
+    std::vector<int> local(edges.size(), -1);
+    contours(s, t, crossing, local, result);
+    return result;
+}
+
+/**
+ * @brief Computes the contours of the parallel planes normal * p + d = 0, for
+ * every d in offsets.
+ *
+ * The planes are sorted and split among the threads: every thread sweeps its
+ * range of planes.
+ *
+ * @return the slices, in the order of the offsets
+ */
+CG3_INLINE std::vector<Slicer::Slice> Slicer::sliceMany(
+        const Vec3d& normal,
+        const std::vector<double>& offsets) const
+{
+    unsigned int nChunks = 1;
+    #ifdef _OPENMP
+    nChunks = omp_get_max_threads();
+    #endif
+    return sweep(normal, offsets, nChunks);
+}
+
+/**
+ * @brief Computes the contours of the parallel planes normal * p + d = 0, for
+ * every d in offsets, in a single pass on the edges sorted by height.
+ *
+ * @return the slices, in the order of the offsets
+ *
+ * @par Complexity:
+ *      \e O(numEdges * log(numEdges) + numPlanes * log(numPlanes) + numCrossings)
+ */
+CG3_INLINE std::vector<Slicer::Slice> Slicer::sweep(
+        const Vec3d& normal,
+        const std::vector<double>& offsets) const
+{
+    return sweep(normal, offsets, 1);
+}
+
+CG3_INLINE void Slicer::build()
+{
+    //half edges sorted by their (undirected) edge
+    const unsigned int nHalfEdges = (unsigned int)triangles.size();
+    auto key = [&](unsigned int h) {
+        unsigned int a = triangles[h];
+        unsigned int b = triangles[h - h % 3 + (h % 3 + 1) % 3];
+        return std::make_pair(std::min(a, b), std::max(a, b));
+    };
+    std::vector<unsigned int> sorted(nHalfEdges);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::sort(sorted.begin(), sorted.end(), [&](unsigned int h1, unsigned int h2) {
+        return key(h1) < key(h2);
+    });
+
+    //every pair of half edges on the same vertices is an edge
+    triangleEdges.resize(nHalfEdges);
+    edges.reserve(nHalfEdges / 2 + 1);
+    edgeHalfEdges.reserve(nHalfEdges / 2 + 1);
+    for (unsigned int i = 0; i < nHalfEdges; ){
+        const std::pair<unsigned int, unsigned int> k = key(sorted[i]);
+        unsigned int j = i + 1;
+        while (j < nHalfEdges && key(sorted[j]) == k)
+            j++;
+        for (unsigned int h = i; h < j; h += 2){
+            unsigned int e = (unsigned int)edges.size();
+            edges.push_back({{k.first, k.second}});
+            edgeHalfEdges.push_back({{(int)sorted[h], h + 1 < j ? (int)sorted[h+1] : -1}});
+            triangleEdges[sorted[h]] = e;
+            if (h + 1 < j)
+                triangleEdges[sorted[h+1]] = e;
+        }
+        i = j;
+    }
+}
+
+CG3_INLINE std::vector<Slicer::Slice> Slicer::sweep(
+        const Vec3d& normal,
+        const std::vector<double>& offsets,
+        unsigned int nChunks) const
+{
+    Sweep s;
+    s.heights.resize(vertices.size());
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)vertices.size(); i++)
+        s.heights[i] = normal.dot(vertices[i]);
+    s.low.resize(edges.size());
+    s.high.resize(edges.size());
+    for (unsigned int e = 0; e < edges.size(); e++){
+        double h0 = s.heights[edges[e][0]], h1 = s.heights[edges[e][1]];
+        s.low[e] = std::min(h0, h1);
+        s.high[e] = std::max(h0, h1);
+    }
+    s.order.resize(edges.size());
+    std::iota(s.order.begin(), s.order.end(), 0);
+    std::sort(s.order.begin(), s.order.end(), [&](unsigned int e1, unsigned int e2) {
+        return s.low[e1] < s.low[e2];
+    });
+
+    //planes sorted by height (-d)
+    std::vector<unsigned int> planes(offsets.size());
+    std::iota(planes.begin(), planes.end(), 0);
+    std::sort(planes.begin(), planes.end(), [&](unsigned int p1, unsigned int p2) {
+        return offsets[p1] > offsets[p2];
+    });
+
+    std::vector<Slice> result(offsets.size());
+    nChunks = std::max(1u, std::min(nChunks, (unsigned int)planes.size()));
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int c = 0; c < (int)nChunks; c++){
+        unsigned int begin = (unsigned int)(planes.size() * c / nChunks);
+        unsigned int end = (unsigned int)(planes.size() * (c + 1) / nChunks);
+        sweepRange(s, offsets, planes, begin, end, result);
+    }
+    return result;
+}
+
+/**
+ * @brief Sweeps the sorted planes in [begin, end), keeping the list of the
+ * edges crossed by the current plane.
+ */
+CG3_INLINE void Slicer::sweepRange(
+        const Sweep& s,
+        const std::vector<double>& offsets,
+        const std::vector<unsigned int>& planes,
+        unsigned int begin,
+        unsigned int end,
+        std::vector<Slice>& result) const
+{
+    std::vector<int> local(edges.size(), -1);
+    std::vector<unsigned int> active;
+    unsigned int next = 0;
+    for (unsigned int i = begin; i < end; i++){
+        const double t = -offsets[planes[i]];
+        while (next < s.order.size() && s.low[s.order[next]] < t){
+            active.push_back(s.order[next]);
+            next++;
+        }
+        //edges that are now below the plane
+        unsigned int n = 0;
+        for (unsigned int e : active)
+            if (s.high[e] >= t)
+                active[n++] = e;
+        active.resize(n);
+
+        contours(s, t, active, local, result[planes[i]]);
+    }
+}
+
+/**
+ * @brief Links the intersections of the crossing edges with the plane at
+ * height t into polylines.
+ *
+ * In every triangle crossed by the plane, the segment goes from the edge
+ * whose half edge goes upward to the edge whose half edge goes downward.
+ * local must contain -1 for every edge, and it is restored before returning.
+ */
+CG3_INLINE void Slicer::contours(
+        const Sweep& s,
+        double t,
+        const std::vector<unsigned int>& crossing,
+        std::vector<int>& local,
+        Slice& slice) const
+{
+    const unsigned int n = (unsigned int)crossing.size();
+    slice.points.resize(n);
+    slice.polylines.clear();
+    for (unsigned int i = 0; i < n; i++){
+        unsigned int e = crossing[i];
+        local[e] = i;
+        const Point3d& p0 = vertices[edges[e][0]];
+        const Point3d& p1 = vertices[edges[e][1]];
+        double h0 = s.heights[edges[e][0]], h1 = s.heights[edges[e][1]];
+        if (h0 == t)
+            slice.points[i] = p0;
+        else if (h1 == t)
+            slice.points[i] = p1;
+        else
+            slice.points[i] = p0 + (p1 - p0) * ((t - h0) / (h1 - h0));
+    }
+
+    std::vector<int> next(n, -1);
+    std::vector<bool> hasPrev(n, false);
+    for (unsigned int i = 0; i < n; i++){
+        for (int h : edgeHalfEdges[crossing[i]]){
+            if (h < 0)
+                continue;
+            unsigned int f = h / 3, k = h % 3;
+            unsigned int a = triangles[h], b = triangles[f*3 + (k+1)%3];
+            if (!(s.heights[a] < t && s.heights[b] >= t))
+                continue;
+            for (unsigned int j = 1; j < 3; j++){
+                int o = local[triangleEdges[f*3 + (k+j)%3]];
+                if (o >= 0 && o != (int)i){
+                    if (next[i] < 0 && !hasPrev[o]){
+                        next[i] = o;
+                        hasPrev[o] = true;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    for (unsigned int e : crossing)
+        local[e] = -1;
+
+    //open polylines start from points without a previous one, then closed ones
+    std::vector<bool> visited(n, false);
+    for (unsigned int pass = 0; pass < 2; pass++){
+        for (unsigned int start = 0; start < n; start++){
+            if (visited[start] || (pass == 0 && hasPrev[start]))
+                continue;
+            std::vector<unsigned int> polyline;
+            unsigned int i = start;
+            bool closed = false;
+            for (;;){
+                visited[i] = true;
+                if (polyline.empty() || slice.points[polyline.back()] != slice.points[i])
+                    polyline.push_back(i);
+                if (next[i] < 0)
+                    break;
+                i = next[i];
+                if (visited[i]){
+                    closed = (i == start);
+                    break;
+                }
+            }
+            if (closed){
+                if (polyline.size() > 1 && slice.points[polyline.back()] == slice.points[polyline.front()])
+                    polyline.back() = polyline.front();
+                else
+                    polyline.push_back(polyline.front());
+                if (polyline.size() >= 4)
+                    slice.polylines.push_back(polyline);
+            }
+            else if (polyline.size() >= 2){
+                slice.polylines.push_back(polyline);
+            }
+        }
+    }
+}
+
 } //namespace cg3::cgal
 } //namespace cg3
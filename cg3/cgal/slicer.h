@@ -12,6 +12,9 @@
 
 #include "surface_mesh.h"
 
+#include <array>
+#include <vector>
+
 namespace cg3 {
 
 class Plane;
@@ -39,6 +42,84 @@ std::vector<std::vector<Point3d> > polylines(
         double d);
     #endif
 
+/**
+ * @ingroup cg3cgal
+ * @brief The Slicer class computes the contours of the intersections between
+ * a triangle mesh and many planes.
+ *
+ * The edges of the mesh and their adjacencies with the triangles are computed
+ * once, in the constructor. Then, for a given normal, the edges are sorted by
+ * the interval of heights they span, and the planes are swept in ascending
+ * order keeping only the edges that cross the current plane: all the contours
+ * are computed in a single pass (sweep), or in a pass for every thread
+ * (sliceMany).
+ *
+ * Every plane has equation normal * p + d = 0, as in polylines(), where d is
+ * one of the given offsets. The contours of a plane are returned as a Slice:
+ * a vector of points (one for every edge crossed by the plane) and polylines
+ * made by indices of that vector. A closed polyline ends with its first index,
+ * following the CGAL convention; open polylines come from the borders of the
+ * mesh. Polylines are oriented consistently with the orientation of the mesh.
+ *
+ * A vertex lying on a plane is considered above it: the contours are always
+ * well defined, but can contain consecutive points with the same coordinates,
+ * that are skipped in the polylines.
+ */
+class Slicer
+{
+public:
+    struct Slice {
+        std::vector<Point3d> points;
+        std::vector<std::vector<unsigned int>> polylines;
+
+        bool isClosed(unsigned int i) const;
+        std::vector<std::vector<Point3d>> polylinePoints() const;
+    };
+
+    Slicer(const SurfaceMesh& mesh);
+    #ifdef CG3_DCEL_DEFINED
+    Slicer(const Dcel& mesh);
+    #endif
+    #ifdef CG3_EIGENMESH_DEFINED
+    Slicer(const SimpleEigenMesh& mesh);
+    #endif
+
+    unsigned int numberTriangles() const;
+    unsigned int numberEdges() const;
+
+    Slice slice(const Vec3d& normal, double d) const;
+    std::vector<Slice> sliceMany(const Vec3d& normal, const std::vector<double>& offsets) const;
+    std::vector<Slice> sweep(const Vec3d& normal, const std::vector<double>& offsets) const;
+
+private:
+    struct Sweep;
+
+    void build();
+    std::vector<Slice> sweep(
+            const Vec3d& normal,
+            const std::vector<double>& offsets,
+            unsigned int nChunks) const;
+    void sweepRange(
+            const Sweep& s,
+            const std::vector<double>& offsets,
+            const std::vector<unsigned int>& planes,
+            unsigned int begin,
+            unsigned int end,
+            std::vector<Slice>& result) const;
+    void contours(
+            const Sweep& s,
+            double t,
+            const std::vector<unsigned int>& crossing,
+            std::vector<int>& local,
+            Slice& slice) const;
+
+    std::vector<Point3d> vertices;
+    std::vector<unsigned int> triangles;             //3 vertices per triangle
+    std::vector<unsigned int> triangleEdges;         //edge of every half edge: the k-th goes from triangles[k] to the next vertex
+    std::vector<std::array<unsigned int, 2>> edges;  //vertices of every edge
+    std::vector<std::array<int, 2>> edgeHalfEdges;   //half edges of every edge, -1 if missing
+};
+
 } //namespace cg3::cgal
 } //namespace cg3
 
@@ -25,6 +25,50 @@ typedef SurfaceMesh::Vertex_index VertexDescriptor;
 } //namespace cg3::cgal::internal
 
 #ifdef CG3_DCEL_DEFINED
+/**
+ * @ingroup cg3cgal
+ * @brief getDcelFromSurfaceMesh
+ *
+ * The vertices and the faces of the dcel have the order of the vertices and
+ * of the faces of the surface mesh; removed elements are skipped.
+ *
+ * @param mesh
+ * @return
+ */
+CG3_INLINE Dcel dcelFromSurfaceMesh(const SurfaceMesh& mesh)
+{
+    std::vector<double> coords;
+    std::vector<unsigned int> faces, faceSizes;
+    std::vector<unsigned int> vertexIds(mesh.num_vertices());
+    coords.reserve(mesh.number_of_vertices() * 3);
+    faces.reserve(mesh.number_of_halfedges());
+    faceSizes.reserve(mesh.number_of_faces());
+
+    unsigned int vIndex = 0;
+    for (internal::VertexDescriptor v : mesh.vertices()){
+        const internal::K::Point_3& p = mesh.point(v);
+        coords.push_back(p.x());
+        coords.push_back(p.y());
+        coords.push_back(p.z());
+        vertexIds[(unsigned int)v] = vIndex++;
+    }
+    for (SurfaceMesh::Face_index f : mesh.faces()){
+        unsigned int size = 0;
+        for (internal::VertexDescriptor v : mesh.vertices_around_face(mesh.halfedge(f))){
+            faces.push_back(vertexIds[(unsigned int)v]);
+            size++;
+        }
+        faceSizes.push_back(size);
+    }
+
+    Dcel d;
+    d.loadFromArrays(
+                vIndex, coords.data(),
+                (unsigned int)faceSizes.size(), faces.data(), faceSizes.data());
+    d.updateVertexNormals();
+    return d;
+}
+
 /**
  * @ingroup cg3cgal
  * @brief getSurfaceMeshFromDcel
@@ -34,15 +78,17 @@ typedef SurfaceMesh::Vertex_index VertexDescriptor;
 CG3_INLINE SurfaceMesh surfaceMeshFromDcel(const Dcel &d)
 {
     SurfaceMesh mesh;
-    std::map<const Dcel::Vertex*, internal::VertexDescriptor> mapV;
+    mesh.reserve(d.numberVertices(), d.numberHalfEdges() / 2, d.numberFaces());
+    //vertices are added in order: the index of a vertex is its compact id
+    const std::vector<int> vertexIds = d.compactVertexIds();
     for(const Dcel::Vertex* v : d.vertexIterator()){
-        internal::VertexDescriptor vd = mesh.add_vertex((internal::K::Point_3(v->coordinate().x(),v->coordinate().y(),v->coordinate().z())));
-        mapV[v] = vd;
+        mesh.add_vertex((internal::K::Point_3(v->coordinate().x(),v->coordinate().y(),v->coordinate().z())));
     }
+    std::vector<internal::VertexDescriptor> lv;
     for (const Dcel::Face* f : d.faceIterator()){
-        std::list<internal::VertexDescriptor> lv;
+        lv.clear();
         for (const Dcel::Vertex* v : f->incidentVertexIterator()){
-            lv.push_back(mapV.at(v));
+            lv.push_back(internal::VertexDescriptor(vertexIds[v->id()]));
         }
         mesh.add_face(lv);
     }
@@ -50,6 +96,69 @@ CG3_INLINE SurfaceMesh surfaceMeshFromDcel(const Dcel &d)
 }
 #endif
 
+#ifdef CG3_EIGENMESH_DEFINED
+/**
+ * @ingroup cg3cgal
+ * @brief getEigenMeshFromSurfaceMesh
+ *
+ * The surface mesh must be made of triangles; removed elements are skipped.
+ *
+ * @param mesh
+ * @return
+ */
+CG3_INLINE SimpleEigenMesh eigenMeshFromSurfaceMesh(const SurfaceMesh& mesh)
+{
+    Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> V(mesh.number_of_vertices(), 3);
+    Eigen::Matrix<int, Eigen::Dynamic, 3, Eigen::RowMajor> F(mesh.number_of_faces(), 3);
+    std::vector<int> vertexIds(mesh.num_vertices());
+
+    int vIndex = 0;
+    for (internal::VertexDescriptor v : mesh.vertices()){
+        const internal::K::Point_3& p = mesh.point(v);
+        V(vIndex, 0) = p.x();
+        V(vIndex, 1) = p.y();
+        V(vIndex, 2) = p.z();
+        vertexIds[(unsigned int)v] = vIndex++;
+    }
+    int fIndex = 0;
+    for (SurfaceMesh::Face_index f : mesh.faces()){
+        int i = 0;
+        for (internal::VertexDescriptor v : mesh.vertices_around_face(mesh.halfedge(f))){
+            if (i < 3)
+                F(fIndex, i) = vertexIds[(unsigned int)v];
+            i++;
+        }
+        fIndex++;
+    }
+    return SimpleEigenMesh(V, F);
+}
+
+/**
+ * @ingroup cg3cgal
+ * @brief getSurfaceMeshFromEigenMesh
+ * @param m
+ * @return
+ */
+CG3_INLINE SurfaceMesh surfaceMeshFromEigenMesh(const SimpleEigenMesh& m)
+{
+    SurfaceMesh mesh;
+    mesh.reserve(m.numberVertices(), m.numberFaces() * 3 / 2, m.numberFaces());
+    for (unsigned int i = 0; i < m.numberVertices(); i++){
+        const Point3d p = m.vertex(i);
+        mesh.add_vertex(internal::K::Point_3(p.x(), p.y(), p.z()));
+    }
+    //vertices are added in order: the i-th vertex has index i
+    for (unsigned int i = 0; i < m.numberFaces(); i++){
+        const Point3i f = m.face(i);
+        mesh.add_face(
+                    internal::VertexDescriptor(f.x()),
+                    internal::VertexDescriptor(f.y()),
+                    internal::VertexDescriptor(f.z()));
+    }
+    return mesh;
+}
+#endif
+
 } //namespace cg3::cgal
 } //namespace cg3
 
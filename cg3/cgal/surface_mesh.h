@@ -34,7 +34,8 @@ SurfaceMesh surfaceMeshFromDcel(const Dcel& d);
 #endif
 
 #ifdef  CG3_EIGENMESH_DEFINED
-
+SimpleEigenMesh eigenMeshFromSurfaceMesh(const SurfaceMesh& mesh);
+SurfaceMesh surfaceMeshFromEigenMesh(const SimpleEigenMesh& m);
 #endif
 
 } //namespace cg3::cgal
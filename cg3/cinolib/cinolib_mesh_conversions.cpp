@@ -23,24 +23,15 @@ CG3_INLINE void eigenMeshToTrimesh(cinolib::Trimesh<>& m, const SimpleEigenMesh&
     unsigned int nVertices=simpleEigenMesh.numberVertices();
     unsigned int nFaces=simpleEigenMesh.numberFaces();
 
-    std::vector<double> coords;
-    std::vector<unsigned int> tris;
-
-    coords.resize(nVertices*3);
-    tris.resize(nFaces*3);
-
-    for(unsigned int i=0;i<nVertices;++i) {
-        unsigned int j=i*3;
-        coords[j]=simpleEigenMesh.vertex(i).x();
-        coords[j+1]=simpleEigenMesh.vertex(i).y();
-        coords[j+2]=simpleEigenMesh.vertex(i).z();
-
-    }
-    for(unsigned int i=0;i<nFaces;++i) {
-        unsigned int j=i*3;
-        tris[j]=simpleEigenMesh.face(i).x();
-        tris[j+1]=simpleEigenMesh.face(i).y();
-        tris[j+2]=simpleEigenMesh.face(i).z();
+    //V and F are row major: coordinates and indices are contiguous
+    const double* v = simpleEigenMesh.getVerticesMatrix().data();
+    const int* f = simpleEigenMesh.getFacesMatrix().data();
+    std::vector<double> coords(v, v + nVertices*3);
+    std::vector<unsigned int> tris(nFaces*3);
+
+    #pragma omp parallel for
+    for(long long int i=0;i<(long long int)nFaces*3;++i) {
+        tris[i]=f[i];
     }
     m = cinolib::Trimesh<>(coords, tris);
 }
@@ -55,7 +46,7 @@ CG3_INLINE void dcelToTrimesh(cinolib::Trimesh<>& m, const Dcel& d)
     std::vector<double> coords;
     std::vector<unsigned int> tris;
 
-    std::map<const Dcel::Vertex*, int> map;
+    const std::vector<int> map = d.compactVertexIds();
 
     coords.resize(nVertices*3);
     tris.resize(nFaces*3);
@@ -67,7 +58,6 @@ CG3_INLINE void dcelToTrimesh(cinolib::Trimesh<>& m, const Dcel& d)
         coords[j]=coord.x();
         coords[j+1]=coord.y();
         coords[j+2]=coord.z();
-        map[v] = i;
         i++;
     }
 
@@ -76,7 +66,7 @@ CG3_INLINE void dcelToTrimesh(cinolib::Trimesh<>& m, const Dcel& d)
         unsigned int j=i*3;
         for (const Dcel::Vertex* v : f->incidentVertexIterator()){
             if (j < (i+1)*3){
-                tris[j] = map[v];
+                tris[j] = map[v->id()];
                 j++;
             }
         }
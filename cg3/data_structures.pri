@@ -34,6 +34,8 @@ HEADERS += \
     $$PWD/data_structures/graphs/undirected_node.h \
     $$PWD/data_structures/lattices/regular_lattice.h \ #lattices
     $$PWD/data_structures/lattices/regular_lattice_iterators.h \
+    $$PWD/data_structures/lattices/sparse_lattice.h \
+    $$PWD/data_structures/lattices/sparse_lattice_iterators.h \
     $$PWD/data_structures/trees/includes/tree_common.h \ #tree common
     $$PWD/data_structures/trees/includes/iterators/tree_genericiterator.h \
     $$PWD/data_structures/trees/includes/iterators/tree_insertiterator.h \
@@ -55,7 +57,16 @@ HEADERS += \
     $$PWD/data_structures/trees/includes/nodes/rangetree_node.h \
     $$PWD/data_structures/trees/includes/rangetree_types.h \ #aabb tree
     $$PWD/data_structures/trees/aabbtree.h \
-    $$PWD/data_structures/trees/includes/nodes/aabb_node.h
+    $$PWD/data_structures/trees/includes/nodes/aabb_node.h \
+    $$PWD/data_structures/trees/kdtree.h \ #kd tree
+    $$PWD/data_structures/trees/triangle_bvh.h \ #bvh
+    $$PWD/data_structures/trees/bplustree.h \ #b+ tree
+    $$PWD/data_structures/trees/includes/node_pool.h \
+    $$PWD/data_structures/trees/includes/parallel_helpers.h \
+    $$PWD/data_structures/trees/includes/nodes/bplustree_node.h \
+    $$PWD/data_structures/trees/includes/iterators/bplustree_iterator.h \
+    $$PWD/data_structures/trees/concurrent_tree.h \ #concurrent tree
+    $$PWD/data_structures/trees/includes/read_indicator.h
 
 CG3_STATIC {
 SOURCES += \
@@ -74,15 +85,25 @@ SOURCES += \
     $$PWD/data_structures/graphs/includes/nodes/graph_node.cpp \
     $$PWD/data_structures/lattices/regular_lattice.cpp \ #lattices
     $$PWD/data_structures/lattices/regular_lattice_iterators.cpp \
+    $$PWD/data_structures/lattices/sparse_lattice.cpp \
+    $$PWD/data_structures/lattices/sparse_lattice_iterators.cpp \
     $$PWD/data_structures/trees/aabbtree.cpp \
     $$PWD/data_structures/trees/avlinner.cpp \
     $$PWD/data_structures/trees/avlleaf.cpp \
     $$PWD/data_structures/trees/bstinner.cpp \
+    $$PWD/data_structures/trees/bplustree.cpp \
     $$PWD/data_structures/trees/bstleaf.cpp \
+    $$PWD/data_structures/trees/concurrent_tree.cpp \
+    $$PWD/data_structures/trees/kdtree.cpp \
+    $$PWD/data_structures/trees/triangle_bvh.cpp \
     $$PWD/data_structures/trees/includes/avl_helpers.cpp \
     $$PWD/data_structures/trees/includes/bst_helpers.cpp \
     $$PWD/data_structures/trees/includes/bstinner_helpers.cpp \
     $$PWD/data_structures/trees/includes/bstleaf_helpers.cpp \
+    $$PWD/data_structures/trees/includes/node_pool.cpp \
+    $$PWD/data_structures/trees/includes/parallel_helpers.cpp \
+    $$PWD/data_structures/trees/includes/read_indicator.cpp \
+    $$PWD/data_structures/trees/includes/iterators/bplustree_iterator.cpp \
     $$PWD/data_structures/trees/includes/iterators/tree_insertiterator.cpp \
     $$PWD/data_structures/trees/includes/iterators/tree_iterator.cpp \
     $$PWD/data_structures/trees/includes/iterators/tree_rangebased_iterators.cpp \
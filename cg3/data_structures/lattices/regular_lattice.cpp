@@ -33,6 +33,24 @@ RegularLattice3D<VT>::RegularLattice3D(const cg3::BoundingBox3 &bb, double unit,
     vertexProperties.resize(mresX,mresY,mresZ);
 }
 
+/**
+ * @brief Creates a lattice with the given number of vertices along each axis
+ * @param[in] min: coordinates of the vertex (0, 0, 0)
+ * @param[in] unit: distance between two adjacent vertices
+ */
+template<class VT>
+RegularLattice3D<VT>::RegularLattice3D(
+        const Point3d& min,
+        double unit,
+        unsigned int resX,
+        unsigned int resY,
+        unsigned int resZ) :
+    bb(min, Point3d(min.x() + unit * (resX-1), min.y() + unit * (resY-1), min.z() + unit * (resZ-1))),
+    _unit(unit)
+{
+    vertexProperties.resize(resX, resY, resZ);
+}
+
 template<class VT>
 unsigned int RegularLattice3D<VT>::resX() const
 {
@@ -27,6 +27,7 @@ public:
 
     RegularLattice3D();
     RegularLattice3D(const cg3::BoundingBox3& bb, double unit, bool outsideBB = true);
+    RegularLattice3D(const cg3::Point3d& min, double unit, unsigned int resX, unsigned int resY, unsigned int resZ);
 
     unsigned int resX() const;
     unsigned int resY() const;
@@ -0,0 +1,465 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "sparse_lattice.h"
+
+namespace cg3 {
+
+template <class VT>
+const unsigned int SparseLattice3D<VT>::TILE_SIZE;
+
+template <class VT>
+const unsigned int SparseLattice3D<VT>::TILE_VOLUME;
+
+template <class VT>
+SparseLattice3D<VT>::SparseLattice3D() :
+    _unit(0),
+    res{0, 0, 0},
+    _background()
+{
+}
+
+/**
+ * @brief Creates an empty sparse lattice: the vertices are computed as in the
+ * RegularLattice3D with the same parameters, and all have the background value.
+ */
+template<class VT>
+SparseLattice3D<VT>::SparseLattice3D(const cg3::BoundingBox3 &bb, double unit, const VT& background, bool outsideBB) :
+    bb(bb),
+    _unit(unit),
+    _background(background)
+{
+    res[0] = bb.lengthX() / unit;
+    if (outsideBB || std::fmod(bb.lengthX(), unit) == 0)
+        res[0]++;
+    res[1] = bb.lengthY() / unit;
+    if (outsideBB || std::fmod(bb.lengthY(), unit) == 0)
+        res[1]++;
+    res[2] = bb.lengthZ() / unit;
+    if (outsideBB || std::fmod(bb.lengthZ(), unit) == 0)
+        res[2]++;
+    this->bb.max() = Point3d(bb.minX() + unit * (res[0]-1), bb.minY() + unit * (res[1]-1), bb.minZ() + unit * (res[2]-1));
+}
+
+/**
+ * @brief Creates a sparse lattice from a dense one: only the vertices
+ * having a value different from the background are stored.
+ */
+template<class VT>
+SparseLattice3D<VT>::SparseLattice3D(const RegularLattice3D<VT>& l, const VT& background) :
+    bb(l.boundingBox()),
+    _unit(l.unit()),
+    res{l.resX(), l.resY(), l.resZ()},
+    _background(background)
+{
+    for (unsigned int i = 0; i < res[0]; i++){
+        for (unsigned int j = 0; j < res[1]; j++){
+            for (unsigned int k = 0; k < res[2]; k++){
+                VT v = l.vertexProperty(i, j, k);
+                if (!(v == background))
+                    setVertexProperty(i, j, k, v);
+            }
+        }
+    }
+}
+
+template<class VT>
+unsigned int SparseLattice3D<VT>::resX() const
+{
+    return res[0];
+}
+
+template<class VT>
+unsigned int SparseLattice3D<VT>::resY() const
+{
+    return res[1];
+}
+
+template<class VT>
+unsigned int SparseLattice3D<VT>::resZ() const
+{
+    return res[2];
+}
+
+template<class VT>
+const BoundingBox3 &SparseLattice3D<VT>::boundingBox() const
+{
+    return bb;
+}
+
+template<class VT>
+double SparseLattice3D<VT>::unit() const
+{
+    return _unit;
+}
+
+/**
+ * @brief Returns the value of the vertices which are not active
+ */
+template<class VT>
+const VT& SparseLattice3D<VT>::background() const
+{
+    return _background;
+}
+
+template<class VT>
+Point3d SparseLattice3D<VT>::vertex(
+        unsigned int i,
+        unsigned int j,
+        unsigned int k) const
+{
+    return cg3::Point3d(bb.minX() + i*_unit,
+                       bb.minY() + j*_unit,
+                       bb.minZ() + k*_unit);
+}
+
+template<class VT>
+Point3d SparseLattice3D<VT>::nearestVertex(const Point3d &p) const
+{
+    return cg3::Point3d(bb.minX() + indexOfCoordinateX(p.x())*_unit,
+                       bb.minY() + indexOfCoordinateY(p.y())*_unit,
+                       bb.minZ() + indexOfCoordinateZ(p.z())*_unit);
+}
+
+/**
+ * @brief Returns the value of the vertex (i, j, k): the background
+ * value if the vertex is not active
+ */
+template<class VT>
+VT SparseLattice3D<VT>::vertexProperty(
+        unsigned int i,
+        unsigned int j,
+        unsigned int k) const
+{
+    assert(i < res[0]);
+    assert(j < res[1]);
+    assert(k < res[2]);
+    const Tile* t = findTile(i, j, k);
+    if (t == nullptr)
+        return _background;
+    return t->values[localIndex(i, j, k)];
+}
+
+template<class VT>
+VT SparseLattice3D<VT>::vertexProperty(const Point3d &p) const
+{
+    return vertexProperty(
+            indexOfCoordinateX(p.x()),
+            indexOfCoordinateY(p.y()),
+            indexOfCoordinateZ(p.z()));
+}
+
+/**
+ * @brief Returns a reference to the value of the vertex (i, j, k).
+ * The vertex becomes active (and its tile is allocated if needed): use
+ * vertexProperty to read a vertex without activating it.
+ * Tiles are never moved, hence the reference is valid until clear() is called.
+ */
+template<class VT>
+VT& SparseLattice3D<VT>::activeVertexProperty(
+        unsigned int i,
+        unsigned int j,
+        unsigned int k)
+{
+    assert(i < res[0]);
+    assert(j < res[1]);
+    assert(k < res[2]);
+    Tile& t = tile(i, j, k);
+    unsigned int id = localIndex(i, j, k);
+    t.active[id / 64] |= (1ull << (id % 64));
+    return t.values[id];
+}
+
+template<class VT>
+VT& SparseLattice3D<VT>::activeVertexProperty(const Point3d& p)
+{
+    return activeVertexProperty(
+            indexOfCoordinateX(p.x()),
+            indexOfCoordinateY(p.y()),
+            indexOfCoordinateZ(p.z()));
+}
+
+template<class VT>
+void SparseLattice3D<VT>::setVertexProperty(const Point3d &p, const VT &property)
+{
+    activeVertexProperty(p) = property;
+}
+
+template<class VT>
+void SparseLattice3D<VT>::setVertexProperty(unsigned int i, unsigned int j, unsigned int k, const VT &property)
+{
+    activeVertexProperty(i, j, k) = property;
+}
+
+template<class VT>
+bool SparseLattice3D<VT>::isActive(unsigned int i, unsigned int j, unsigned int k) const
+{
+    const Tile* t = findTile(i, j, k);
+    if (t == nullptr)
+        return false;
+    unsigned int id = localIndex(i, j, k);
+    return (t->active[id / 64] >> (id % 64)) & 1;
+}
+
+/**
+ * @brief The vertex (i, j, k) is set to the background value and it is not active
+ * anymore. The memory of its tile is not released.
+ */
+template<class VT>
+void SparseLattice3D<VT>::deactivate(unsigned int i, unsigned int j, unsigned int k)
+{
+    auto it = tileMap.find(tileKey(i / TILE_SIZE, j / TILE_SIZE, k / TILE_SIZE));
+    if (it != tileMap.end()){
+        Tile& t = tiles[it->second];
+        unsigned int id = localIndex(i, j, k);
+        t.active[id / 64] &= ~(1ull << (id % 64));
+        t.values[id] = _background;
+    }
+}
+
+template<class VT>
+unsigned long long int SparseLattice3D<VT>::numberActiveVertices() const
+{
+    unsigned long long int n = 0;
+    for (const Tile& t : tiles){
+        for (unsigned int w = 0; w < TILE_VOLUME / 64; w++){
+            for (unsigned long long int word = t.active[w]; word != 0; word &= word - 1)
+                n++;
+        }
+    }
+    return n;
+}
+
+template<class VT>
+unsigned int SparseLattice3D<VT>::numberTiles() const
+{
+    return (unsigned int) tiles.size();
+}
+
+/**
+ * @brief Returns the indices of the first vertex of the tile t
+ */
+template<class VT>
+Point3i SparseLattice3D<VT>::tileOrigin(unsigned int t) const
+{
+    return Point3i(tiles[t].origin[0], tiles[t].origin[1], tiles[t].origin[2]);
+}
+
+/**
+ * @brief Returns the value of the vertex (a, b, c) of the tile t, with
+ * a, b, c in [0, TILE_SIZE)
+ */
+template<class VT>
+VT SparseLattice3D<VT>::tileVertexProperty(unsigned int t, unsigned int a, unsigned int b, unsigned int c) const
+{
+    return tiles[t].values[(a * TILE_SIZE + b) * TILE_SIZE + c];
+}
+
+/**
+ * @brief Returns the index of the tile having tile coordinates (ti, tj, tk)
+ * (i.e. containing the vertex (ti*TILE_SIZE, tj*TILE_SIZE, tk*TILE_SIZE)),
+ * -1 if the tile has not been allocated
+ */
+template<class VT>
+int SparseLattice3D<VT>::tileIndex(unsigned int ti, unsigned int tj, unsigned int tk) const
+{
+    auto it = tileMap.find(tileKey(ti, tj, tk));
+    if (it == tileMap.end())
+        return -1;
+    return (int) it->second;
+}
+
+/**
+ * @brief Returns the dense lattice having the same vertices and values
+ */
+template<class VT>
+RegularLattice3D<VT> SparseLattice3D<VT>::toRegularLattice() const
+{
+    RegularLattice3D<VT> l(bb.min(), _unit, res[0], res[1], res[2]);
+    for (unsigned int i = 0; i < res[0]; i++)
+        for (unsigned int j = 0; j < res[1]; j++)
+            for (unsigned int k = 0; k < res[2]; k++)
+                l.setVertexProperty(i, j, k, _background);
+
+    for (unsigned int t = 0; t < tiles.size(); t++){
+        const Tile& tile = tiles[t];
+        for (unsigned int a = 0; a < TILE_SIZE && tile.origin[0] + a < res[0]; a++)
+            for (unsigned int b = 0; b < TILE_SIZE && tile.origin[1] + b < res[1]; b++)
+                for (unsigned int c = 0; c < TILE_SIZE && tile.origin[2] + c < res[2]; c++)
+                    l.setVertexProperty(
+                                tile.origin[0] + a, tile.origin[1] + b, tile.origin[2] + c,
+                                tile.values[(a * TILE_SIZE + b) * TILE_SIZE + c]);
+    }
+    return l;
+}
+
+/**
+ * @brief Deactivates all the vertices and releases all the tiles
+ */
+template<class VT>
+void SparseLattice3D<VT>::clear()
+{
+    tiles.clear();
+    tileMap.clear();
+}
+
+/**
+ * @brief Only the tiles are saved: origins, active masks and values.
+ */
+template<class VT>
+void SparseLattice3D<VT>::serialize(std::ofstream &binaryFile) const
+{
+    std::vector<unsigned int> origins;
+    std::vector<unsigned long long int> masks;
+    std::vector<VT> values;
+    origins.reserve(tiles.size() * 3);
+    masks.reserve(tiles.size() * TILE_VOLUME / 64);
+    values.reserve(tiles.size() * TILE_VOLUME);
+    for (const Tile& t : tiles){
+        origins.insert(origins.end(), t.origin, t.origin + 3);
+        masks.insert(masks.end(), t.active, t.active + TILE_VOLUME / 64);
+        values.insert(values.end(), t.values, t.values + TILE_VOLUME);
+    }
+
+    std::vector<unsigned int> resolution(res, res + 3);
+    cg3::serializeObjectAttributes(
+                "cg3SparseLattice3D",
+                binaryFile,
+                bb,
+                _unit,
+                resolution,
+                _background,
+                origins,
+                masks,
+                values);
+}
+
+template<class VT>
+void SparseLattice3D<VT>::deserialize(std::ifstream &binaryFile)
+{
+    std::vector<unsigned int> resolution, origins;
+    std::vector<unsigned long long int> masks;
+    std::vector<VT> values;
+    cg3::deserializeObjectAttributes(
+                "cg3SparseLattice3D",
+                binaryFile,
+                bb,
+                _unit,
+                resolution,
+                _background,
+                origins,
+                masks,
+                values);
+
+    for (unsigned int i = 0; i < 3; i++)
+        res[i] = resolution[i];
+    clear();
+    tiles.resize(origins.size() / 3);
+    for (unsigned int t = 0; t < tiles.size(); t++){
+        Tile& tile = tiles[t];
+        for (unsigned int i = 0; i < 3; i++)
+            tile.origin[i] = origins[t * 3 + i];
+        for (unsigned int w = 0; w < TILE_VOLUME / 64; w++)
+            tile.active[w] = masks[t * TILE_VOLUME / 64 + w];
+        for (unsigned int v = 0; v < TILE_VOLUME; v++)
+            tile.values[v] = values[t * TILE_VOLUME + v];
+        tileMap[tileKey(tile.origin[0] / TILE_SIZE, tile.origin[1] / TILE_SIZE, tile.origin[2] / TILE_SIZE)] = t;
+    }
+}
+
+template<class VT>
+typename SparseLattice3D<VT>::ActiveIterator SparseLattice3D<VT>::activeBegin() const
+{
+    return ActiveIterator(0, 0, *this);
+}
+
+template<class VT>
+typename SparseLattice3D<VT>::ActiveIterator SparseLattice3D<VT>::activeEnd() const
+{
+    return ActiveIterator((unsigned int) tiles.size(), 0, *this);
+}
+
+template<class VT>
+typename SparseLattice3D<VT>::ActiveIterator SparseLattice3D<VT>::begin() const
+{
+    return activeBegin();
+}
+
+template<class VT>
+typename SparseLattice3D<VT>::ActiveIterator SparseLattice3D<VT>::end() const
+{
+    return activeEnd();
+}
+
+template<class VT>
+unsigned long long int SparseLattice3D<VT>::tileKey(unsigned int ti, unsigned int tj, unsigned int tk)
+{
+    return ((unsigned long long int) ti << 42) | ((unsigned long long int) tj << 21) | tk;
+}
+
+template<class VT>
+unsigned int SparseLattice3D<VT>::localIndex(unsigned int i, unsigned int j, unsigned int k)
+{
+    return ((i % TILE_SIZE) * TILE_SIZE + (j % TILE_SIZE)) * TILE_SIZE + (k % TILE_SIZE);
+}
+
+template<class VT>
+const typename SparseLattice3D<VT>::Tile* SparseLattice3D<VT>::findTile(unsigned int i, unsigned int j, unsigned int k) const
+{
+    auto it = tileMap.find(tileKey(i / TILE_SIZE, j / TILE_SIZE, k / TILE_SIZE));
+    if (it == tileMap.end())
+        return nullptr;
+    return &tiles[it->second];
+}
+
+/**
+ * @brief Returns the tile containing the vertex (i, j, k), allocating it
+ * if needed. Vertices of a new tile have the background value.
+ */
+template<class VT>
+typename SparseLattice3D<VT>::Tile& SparseLattice3D<VT>::tile(unsigned int i, unsigned int j, unsigned int k)
+{
+    unsigned long long int key = tileKey(i / TILE_SIZE, j / TILE_SIZE, k / TILE_SIZE);
+    auto it = tileMap.find(key);
+    if (it != tileMap.end())
+        return tiles[it->second];
+
+    tileMap[key] = (unsigned int) tiles.size();
+    tiles.push_back(Tile());
+    Tile& t = tiles.back();
+    t.origin[0] = (i / TILE_SIZE) * TILE_SIZE;
+    t.origin[1] = (j / TILE_SIZE) * TILE_SIZE;
+    t.origin[2] = (k / TILE_SIZE) * TILE_SIZE;
+    for (unsigned int w = 0; w < TILE_VOLUME / 64; w++)
+        t.active[w] = 0;
+    for (unsigned int v = 0; v < TILE_VOLUME; v++)
+        t.values[v] = _background;
+    return t;
+}
+
+template<class VT>
+uint SparseLattice3D<VT>::indexOfCoordinateX(double x) const
+{
+    double deltax = x - bb.minX();
+    return (deltax * (res[0]-1)) / bb.lengthX();
+}
+
+template<class VT>
+uint SparseLattice3D<VT>::indexOfCoordinateY(double y) const
+{
+    double deltay = y - bb.minY();
+    return (deltay * (res[1]-1)) / bb.lengthY();
+}
+
+template<class VT>
+uint SparseLattice3D<VT>::indexOfCoordinateZ(double z) const
+{
+    double deltaz = z - bb.minZ();
+    return (deltaz * (res[2]-1)) / bb.lengthZ();
+}
+
+} //namespace cg3
@@ -0,0 +1,113 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_SPARSE_LATTICE_H
+#define CG3_SPARSE_LATTICE_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+#include "regular_lattice.h"
+
+namespace cg3 {
+
+/**
+ * @brief A regular lattice which stores only the vertices that have been set.
+ *
+ * Vertices are grouped in tiles of 8x8x8 vertices, allocated only when one of
+ * their vertices is set, and tiles are indexed by a hash table. The vertices that
+ * have been set are active; all the other vertices have the background value.
+ * It has the same geometry of a RegularLattice3D, but the memory depends only
+ * on the number of tiles containing active vertices (e.g. a narrow band around
+ * a surface). Reading a vertex with vertexProperty never allocates memory, also
+ * on a non-const lattice: vertices are activated only by setVertexProperty and
+ * activeVertexProperty.
+ */
+template <class VT>
+class SparseLattice3D : public cg3::SerializableObject
+{
+public:
+
+    //iterators
+    class ActiveIterator;
+
+    static const unsigned int TILE_SIZE = 8;
+    static const unsigned int TILE_VOLUME = TILE_SIZE * TILE_SIZE * TILE_SIZE;
+
+    SparseLattice3D();
+    SparseLattice3D(const cg3::BoundingBox3& bb, double unit, const VT& background = VT(), bool outsideBB = true);
+    SparseLattice3D(const cg3::RegularLattice3D<VT>& l, const VT& background = VT());
+
+    unsigned int resX() const;
+    unsigned int resY() const;
+    unsigned int resZ() const;
+
+    const cg3::BoundingBox3& boundingBox() const;
+    double unit() const;
+    const VT& background() const;
+
+    cg3::Point3d vertex(unsigned int i, unsigned int j, unsigned int k) const;
+    cg3::Point3d nearestVertex(const cg3::Point3d& p) const;
+    VT vertexProperty(unsigned int i, unsigned int j, unsigned int k) const;
+    VT vertexProperty(const cg3::Point3d& p) const;
+    VT& activeVertexProperty(unsigned int i, unsigned int j, unsigned int k);
+    VT& activeVertexProperty(const cg3::Point3d& p);
+    void setVertexProperty(const cg3::Point3d& p, const VT& property);
+    void setVertexProperty(unsigned int i, unsigned int j, unsigned int k, const VT& property);
+
+    bool isActive(unsigned int i, unsigned int j, unsigned int k) const;
+    void deactivate(unsigned int i, unsigned int j, unsigned int k);
+    unsigned long long int numberActiveVertices() const;
+
+    unsigned int numberTiles() const;
+    cg3::Point3i tileOrigin(unsigned int t) const;
+    VT tileVertexProperty(unsigned int t, unsigned int a, unsigned int b, unsigned int c) const;
+    int tileIndex(unsigned int ti, unsigned int tj, unsigned int tk) const;
+
+    cg3::RegularLattice3D<VT> toRegularLattice() const;
+    void clear();
+
+    // SerializableObject interface
+    void serialize(std::ofstream& binaryFile) const;
+    void deserialize(std::ifstream& binaryFile);
+
+    ActiveIterator activeBegin() const;
+    ActiveIterator activeEnd() const;
+    ActiveIterator begin() const;
+    ActiveIterator end() const;
+
+protected:
+
+    struct Tile {
+        unsigned int origin[3];
+        unsigned long long int active[TILE_VOLUME / 64];
+        VT values[TILE_VOLUME];
+    };
+
+    static unsigned long long int tileKey(unsigned int ti, unsigned int tj, unsigned int tk);
+    static unsigned int localIndex(unsigned int i, unsigned int j, unsigned int k);
+    const Tile* findTile(unsigned int i, unsigned int j, unsigned int k) const;
+    Tile& tile(unsigned int i, unsigned int j, unsigned int k);
+    uint indexOfCoordinateX(double x) const;
+    uint indexOfCoordinateY(double y) const;
+    uint indexOfCoordinateZ(double z) const;
+
+    cg3::BoundingBox3 bb;
+    double _unit;
+    unsigned int res[3];
+    VT _background;
+    std::deque<Tile> tiles;
+    std::unordered_map<unsigned long long int, unsigned int> tileMap;
+};
+
+} //namespace cg3
+
+#include "sparse_lattice_iterators.h"
+#include "sparse_lattice.cpp"
+
+#endif // CG3_SPARSE_LATTICE_H
@@ -0,0 +1,116 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "sparse_lattice_iterators.h"
+
+namespace cg3 {
+
+template<class VT>
+cg3::SparseLattice3D<VT>::ActiveIterator::ActiveIterator() : l(nullptr), tile(0), pos(0)
+{
+}
+
+template<class VT>
+std::pair<Point3d, const VT&> cg3::SparseLattice3D<VT>::ActiveIterator::operator *() const
+{
+    return std::pair<Point3d, const VT&>(vertex(), property());
+}
+
+template<class VT>
+bool cg3::SparseLattice3D<VT>::ActiveIterator::operator ==(const cg3::SparseLattice3D<VT>::ActiveIterator& otherIterator) const
+{
+    return l == otherIterator.l && tile == otherIterator.tile && pos == otherIterator.pos;
+}
+
+template<class VT>
+bool cg3::SparseLattice3D<VT>::ActiveIterator::operator !=(const cg3::SparseLattice3D<VT>::ActiveIterator& otherIterator) const
+{
+    return !(*this == otherIterator);
+}
+
+template<class VT>
+typename cg3::SparseLattice3D<VT>::ActiveIterator cg3::SparseLattice3D<VT>::ActiveIterator::operator ++()
+{
+    ++pos;
+    nextActive();
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseLattice3D<VT>::ActiveIterator cg3::SparseLattice3D<VT>::ActiveIterator::operator ++(int)
+{
+    ActiveIterator old = *this;
+    ++pos;
+    nextActive();
+    return old;
+}
+
+template<class VT>
+unsigned int cg3::SparseLattice3D<VT>::ActiveIterator::i() const
+{
+    return l->tiles[tile].origin[0] + pos / (TILE_SIZE * TILE_SIZE);
+}
+
+template<class VT>
+unsigned int cg3::SparseLattice3D<VT>::ActiveIterator::j() const
+{
+    return l->tiles[tile].origin[1] + (pos / TILE_SIZE) % TILE_SIZE;
+}
+
+template<class VT>
+unsigned int cg3::SparseLattice3D<VT>::ActiveIterator::k() const
+{
+    return l->tiles[tile].origin[2] + pos % TILE_SIZE;
+}
+
+template<class VT>
+Point3d cg3::SparseLattice3D<VT>::ActiveIterator::vertex() const
+{
+    return l->vertex(i(), j(), k());
+}
+
+template<class VT>
+const VT& cg3::SparseLattice3D<VT>::ActiveIterator::property() const
+{
+    return l->tiles[tile].values[pos];
+}
+
+template<class VT>
+cg3::SparseLattice3D<VT>::ActiveIterator::ActiveIterator(unsigned int tile, unsigned int pos, const SparseLattice3D<VT>& g) :
+    l(&g), tile(tile), pos(pos)
+{
+    nextActive();
+}
+
+/**
+ * @brief Moves the iterator on the first active vertex starting from the
+ * current position, skipping the empty 64-bit words of the active masks.
+ */
+template<class VT>
+void cg3::SparseLattice3D<VT>::ActiveIterator::nextActive()
+{
+    while (tile < l->tiles.size()) {
+        const unsigned long long int* active = l->tiles[tile].active;
+        while (pos < TILE_VOLUME) {
+            unsigned long long int word = active[pos / 64] >> (pos % 64);
+            if (word == 0) {
+                pos = (pos / 64 + 1) * 64;
+            }
+            else {
+                while ((word & 1) == 0) {
+                    word >>= 1;
+                    ++pos;
+                }
+                return;
+            }
+        }
+        ++tile;
+        pos = 0;
+    }
+    pos = 0;
+}
+
+} //namespace cg3
@@ -0,0 +1,52 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_SPARSE_LATTICE_ITERATORS_H
+#define CG3_SPARSE_LATTICE_ITERATORS_H
+
+namespace cg3 {
+
+template <class VT>
+class SparseLattice3D;
+
+/**
+ * @brief Iterator over the active vertices of a SparseLattice3D,
+ * visited tile by tile.
+ */
+template <class VT>
+class SparseLattice3D<VT>::ActiveIterator
+{
+    friend class SparseLattice3D;
+public:
+    ActiveIterator();
+
+    std::pair<Point3d, const VT&> operator *() const;
+    bool operator == (const ActiveIterator& otherIterator) const;
+    bool operator != (const ActiveIterator& otherIterator) const;
+
+    ActiveIterator operator ++ ();
+    ActiveIterator operator ++ (int);
+
+    unsigned int i() const;
+    unsigned int j() const;
+    unsigned int k() const;
+    Point3d vertex() const;
+    const VT& property() const;
+
+protected:
+    const SparseLattice3D<VT>* l;
+    unsigned int tile;
+    unsigned int pos;
+    ActiveIterator(unsigned int tile, unsigned int pos, const SparseLattice3D<VT>& g);
+    void nextActive();
+};
+
+} //namespace cg3
+
+#include "sparse_lattice_iterators.cpp"
+
+#endif // CG3_SPARSE_LATTICE_ITERATORS_H
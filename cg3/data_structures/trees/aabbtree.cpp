@@ -164,31 +164,40 @@ void AABBTree<D,K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 
     //Sort the collection
     internal::PairComparator<K,T> pairComparator(comparator);
-    std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
+    internal::parallelSortHelper(sortedVec.begin(), sortedVec.end(), pairComparator);
 
     //Create nodes
-    std::vector<Node*> sortedNodes;
-    for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
-        sortedNodes.push_back(node);
+    const long long int numberOfNodes = (long long int) sortedVec.size();
+    std::vector<Node*> sortedNodes(sortedVec.size());
+    #pragma omp parallel for if (numberOfNodes > (long long int) internal::TREE_PARALLEL_THRESHOLD)
+    for (long long int i = 0; i < numberOfNodes; i++) {
+        sortedNodes[i] = new Node(sortedVec[i].first, sortedVec[i].second);
     }
 
-    //Calling the bottom up helper
-    this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
+    //Calling the parallel construction helper, which sets the height
+    //and the AABB of the nodes (children before parents)
+    AABBValueExtractor extractor = this->aabbValueExtractor;
+    this->entries = internal::constructionParallelHelperLeaf<Node,K,C>(
                 sortedNodes,
                 this->root,
-                comparator);
-
-    //Update the height of nodes and create their AABBs
-    for (Node*& node : sortedNodes) {
-        if (node != nullptr && node->isLeaf()) {
-            //Update height
-            internal::updateHeightHelper(node);
-
-            //Update AABBs
-            this->updateAABBHelper(node, aabbValueExtractor);
-        }
-    }
+                comparator,
+                [extractor](Node* node) {
+                    node->height = 1 + std::max(internal::getHeightHelper(node->left),
+                                                internal::getHeightHelper(node->right));
+
+                    if (node->isLeaf()) {
+                        for (int i = 0; i < D; i++) {
+                            node->aabb.min[i] = extractor(node->key, MIN, i+1);
+                            node->aabb.max[i] = extractor(node->key, MAX, i+1);
+                        }
+                    }
+                    else {
+                        for (int i = 0; i < D; i++) {
+                            node->aabb.min[i] = std::min(node->left->aabb.min[i], node->right->aabb.min[i]);
+                            node->aabb.max[i] = std::max(node->left->aabb.max[i], node->right->aabb.max[i]);
+                        }
+                    }
+                });
 }
 
 
@@ -0,0 +1,1302 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "bplustree.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "assert.h"
+
+namespace cg3 {
+
+
+/* --------- CONSTRUCTORS/DESTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] customComparator Custom comparator to be used to compare if a key
+ * is less than another one. The default comparator is the < operator
+ */
+template <class K, class T, class C, unsigned int N>
+BPlusTree<K,T,C,N>::BPlusTree(const C& customComparator) :
+    comparator(customComparator)
+{
+    this->initialize();
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs) to be inserted
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ * @param[in] customComparator Custom comparator to be used to compare if a key
+ * is less than another one. The default comparator is the < operator
+ */
+template <class K, class T, class C, unsigned int N>
+BPlusTree<K,T,C,N>::BPlusTree(
+        const std::vector<std::pair<K,T>>& vec,
+        const C& customComparator) :
+    comparator(customComparator)
+{
+    this->initialize();
+    this->construction(vec);
+}
+
+/**
+ * @brief Constructor with a vector of values to be inserted
+ *
+ * @param[in] vec Vector of values
+ * @param[in] customComparator Custom comparator to be used to compare if a key
+ * is less than another one. The default comparator is the < operator
+ */
+template <class K, class T, class C, unsigned int N>
+BPlusTree<K,T,C,N>::BPlusTree(
+        const std::vector<K>& vec,
+        const C& customComparator) :
+    comparator(customComparator)
+{
+    this->initialize();
+    this->construction(vec);
+}
+
+/**
+ * @brief Copy constructor. The copy is bulk loaded from the entries
+ * of the input tree, which are already sorted.
+ *
+ * @param bst B+ tree
+ */
+template <class K, class T, class C, unsigned int N>
+BPlusTree<K,T,C,N>::BPlusTree(const BPlusTree<K,T,C,N>& bst) :
+    comparator(bst.comparator)
+{
+    this->initialize();
+
+    std::vector<std::pair<K,T>> sortedVec;
+    sortedVec.reserve(bst.entries);
+    for (const LeafNode* leaf = bst.firstLeaf; leaf != nullptr; leaf = leaf->next) {
+        for (unsigned int i = 0; i < leaf->size; i++) {
+            sortedVec.push_back(std::make_pair(leaf->keys[i], leaf->values[i]));
+        }
+    }
+
+    this->bulkLoadHelper(sortedVec);
+}
+
+/**
+ * @brief Move constructor
+ * @param bst B+ tree
+ */
+template <class K, class T, class C, unsigned int N>
+BPlusTree<K,T,C,N>::BPlusTree(BPlusTree<K,T,C,N>&& bst) :
+    comparator(bst.comparator)
+{
+    this->initialize();
+    this->swap(bst);
+}
+
+/**
+ * @brief Destructor
+ */
+template <class K, class T, class C, unsigned int N>
+BPlusTree<K,T,C,N>::~BPlusTree()
+{
+    this->clear();
+}
+
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+
+/**
+ * @brief Construction of the B+ tree given the initial values
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] vec Vector of values
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::construction(const std::vector<K>& vec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+    pairVec.reserve(vec.size());
+
+    for (const K& entry : vec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    construction(pairVec);
+}
+
+/**
+ * @brief Construction of the B+ tree given the initial values (pairs of
+ * keys/values)
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    if (vec.size() == 0)
+        return;
+
+    std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
+
+    //Sort the collection
+    internal::PairComparator<K,T,C> pairComparator(comparator);
+    internal::parallelSortHelper(sortedVec.begin(), sortedVec.end(), pairComparator);
+
+    this->bulkLoadHelper(sortedVec);
+}
+
+/**
+ * @brief Construction of the B+ tree given the initial values, already
+ * sorted by key. No sort is performed, and the tree is bulk loaded in
+ * linear time.
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] sortedVec Sorted vector of values
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::sortedConstruction(const std::vector<K>& sortedVec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+    pairVec.reserve(sortedVec.size());
+
+    for (const K& entry : sortedVec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    sortedConstruction(pairVec);
+}
+
+/**
+ * @brief Construction of the B+ tree given the initial entries (pairs of
+ * keys/values), already sorted by key. No sort is performed, and the tree
+ * is bulk loaded in linear time.
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] sortedVec Sorted vector of pairs of keys/values
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::sortedConstruction(const std::vector<std::pair<K,T>>& sortedVec)
+{
+    this->clear();
+
+    if (sortedVec.size() == 0)
+        return;
+
+    this->bulkLoadHelper(sortedVec);
+}
+
+
+/**
+ * @brief Insert in the B+ tree a given value
+ *
+ * @param[in] key Key/value to be inserted
+ * @return The iterator pointing to the entry if it has been
+ * successfully inserted, end iterator otherwise
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::insert(const K& key)
+{
+    return insert(key, key);
+}
+
+/**
+ * @brief Insert in the B+ tree a given value with the given key
+ *
+ * If an entry with the same key is already contained, the new
+ * entry will be not inserted
+ *
+ * @param[in] key Key of the entry
+ * @param[in] value Value of the entry
+ * @return The iterator pointing to the entry if it has been
+ * successfully inserted, end iterator otherwise
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::insert(
+        const K& key, const T& value)
+{
+    //Empty tree: the root is a leaf
+    if (root == nullptr) {
+        LeafNode* leaf = leafPool.allocate();
+        root = leaf;
+        firstLeaf = leaf;
+        lastLeaf = leaf;
+        height = 0;
+    }
+
+    LeafNode* insertedLeaf = nullptr;
+    unsigned int insertedPos = 0;
+    K splitKey;
+    void* newSibling = nullptr;
+
+    bool inserted = insertHelper(
+                root, height,
+                key, value,
+                insertedLeaf, insertedPos,
+                splitKey, newSibling);
+
+    //The root has been split: the tree grows by one level
+    if (newSibling != nullptr) {
+        InnerNode* newRoot = innerPool.allocate();
+        newRoot->size = 2;
+        newRoot->keys[0] = splitKey;
+        newRoot->children[0] = root;
+        newRoot->children[1] = newSibling;
+
+        root = newRoot;
+        height++;
+    }
+
+    if (!inserted)
+        return end();
+
+    this->entries++;
+
+    return iterator(this, insertedLeaf, insertedPos);
+}
+
+
+/**
+ * @brief Erase the entry with the given key
+ *
+ * @param[in] key Key of the entry to be erased
+ * @return True if the entry has been found and erased, false otherwise
+ */
+template <class K, class T, class C, unsigned int N>
+bool BPlusTree<K,T,C,N>::erase(const K& key)
+{
+    if (root == nullptr)
+        return false;
+
+    if (!eraseHelper(root, height, key))
+        return false;
+
+    this->entries--;
+
+    //Shrink the tree if the root has only one child
+    if (height > 0 && static_cast<InnerNode*>(root)->size == 1) {
+        InnerNode* oldRoot = static_cast<InnerNode*>(root);
+        root = oldRoot->children[0];
+        innerPool.deallocate(oldRoot);
+        height--;
+    }
+    //Empty tree
+    else if (height == 0 && static_cast<LeafNode*>(root)->size == 0) {
+        leafPool.deallocate(static_cast<LeafNode*>(root));
+        root = nullptr;
+        firstLeaf = nullptr;
+        lastLeaf = nullptr;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Find entry with the given key
+ *
+ * @param[in] key Key of the entry to be found
+ * @return The iterator pointing to the entry if it has been
+ * found, end iterator otherwise
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::find(const K& key)
+{
+    LeafNode* leaf = findLeafHelper(key);
+    if (leaf == nullptr)
+        return end();
+
+    unsigned int pos = leafLowerBoundHelper(leaf, key);
+    if (pos < leaf->size && internal::isEqual(leaf->keys[pos], key, comparator))
+        return iterator(this, leaf, pos);
+
+    return end();
+}
+
+/**
+ * @brief Find the entry which is equal/lower than a given key
+ *
+ * @param[in] key Input key
+ * @return The iterator pointing to the entry if it has been
+ * found, end iterator otherwise
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::findLower(const K& key)
+{
+    LeafNode* leaf = findLeafHelper(key);
+    if (leaf == nullptr)
+        return end();
+
+    unsigned int pos = leafLowerBoundHelper(leaf, key);
+    if (pos < leaf->size && internal::isEqual(leaf->keys[pos], key, comparator))
+        return iterator(this, leaf, pos);
+
+    //Predecessor of the lower bound
+    if (pos > 0)
+        return iterator(this, leaf, pos - 1);
+    if (leaf->prev != nullptr)
+        return iterator(this, leaf->prev, leaf->prev->size - 1);
+
+    return end();
+}
+
+/**
+ * @brief Find the entry which is upper than a given key
+ *
+ * @param[in] key Input key
+ * @return The iterator pointing to the entry if it has been
+ * found, end iterator otherwise
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::findUpper(const K& key)
+{
+    LeafNode* leaf = findLeafHelper(key);
+    if (leaf == nullptr)
+        return end();
+
+    unsigned int pos = leafLowerBoundHelper(leaf, key);
+    if (pos < leaf->size && internal::isEqual(leaf->keys[pos], key, comparator))
+        pos++;
+
+    if (pos < leaf->size)
+        return iterator(this, leaf, pos);
+    if (leaf->next != nullptr)
+        return iterator(this, leaf->next, 0);
+
+    return end();
+}
+
+
+/**
+ * @brief Get the number of entries
+ *
+ * @return Number of entries
+ */
+template <class K, class T, class C, unsigned int N>
+TreeSize BPlusTree<K,T,C,N>::size()
+{
+    return this->entries;
+}
+
+/**
+ * @brief Check if the B+ tree is empty
+ *
+ * @return True if the B+ tree is empty
+ */
+template <class K, class T, class C, unsigned int N>
+bool BPlusTree<K,T,C,N>::empty()
+{
+    return this->size() == 0;
+}
+
+/**
+ * @brief Clear the B+ tree, releasing the memory of the node pools
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::clear()
+{
+    leafPool.clear();
+    innerPool.clear();
+
+    this->initialize();
+}
+
+/**
+ * @brief Get the height of the B+ tree (number of levels)
+ *
+ * @return Height of the B+ tree
+ */
+template <class K, class T, class C, unsigned int N>
+TreeSize BPlusTree<K,T,C,N>::getHeight()
+{
+    if (root == nullptr)
+        return 0;
+
+    return height + 1;
+}
+
+
+/**
+ * @brief Range query: it scans the linked leaves from the lower bound
+ * of the start key
+ *
+ * @param[in] start Minimum key
+ * @param[in] end Maximum key
+ * @param[out] out Output iterator container (iterators of the entries)
+ */
+template <class K, class T, class C, unsigned int N> template <class OutputIterator>
+void BPlusTree<K,T,C,N>::rangeQuery(
+        const K& start, const K& end,
+        OutputIterator out)
+{
+    LeafNode* leaf = findLeafHelper(start);
+    if (leaf == nullptr)
+        return;
+
+    unsigned int pos = leafLowerBoundHelper(leaf, start);
+
+    while (leaf != nullptr) {
+        for (; pos < leaf->size; pos++) {
+            if (internal::isGreater(leaf->keys[pos], end, comparator))
+                return;
+
+            *out = iterator(this, leaf, pos);
+            out++;
+        }
+        leaf = leaf->next;
+        pos = 0;
+    }
+}
+
+/**
+ * @brief Range query which outputs the values of the entries instead of
+ * their iterators
+ *
+ * @param[in] start Minimum key
+ * @param[in] end Maximum key
+ * @param[out] out Output iterator container (values)
+ */
+template <class K, class T, class C, unsigned int N> template <class OutputIterator>
+void BPlusTree<K,T,C,N>::rangeQueryValues(
+        const K& start, const K& end,
+        OutputIterator out)
+{
+    LeafNode* leaf = findLeafHelper(start);
+    if (leaf == nullptr)
+        return;
+
+    unsigned int pos = leafLowerBoundHelper(leaf, start);
+
+    while (leaf != nullptr) {
+        for (; pos < leaf->size; pos++) {
+            if (internal::isGreater(leaf->keys[pos], end, comparator))
+                return;
+
+            *out = leaf->values[pos];
+            out++;
+        }
+        leaf = leaf->next;
+        pos = 0;
+    }
+}
+
+
+
+/* ----- ITERATOR MIN/MAX NEXT/PREV ----- */
+
+/**
+ * @brief Get minimum key entry
+ *
+ * @return The iterator pointing to the minimum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::getMin()
+{
+    if (firstLeaf == nullptr)
+        return end();
+
+    return iterator(this, firstLeaf, 0);
+}
+
+/**
+ * @brief Get maximum key entry
+ *
+ * @return The iterator pointing to the maximum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::getMax()
+{
+    if (lastLeaf == nullptr)
+        return end();
+
+    return iterator(this, lastLeaf, lastLeaf->size - 1);
+}
+
+/**
+ * @brief Get the next entry
+ *
+ * @param[in] it Iterator
+ * @return The iterator pointing to the next entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::getNext(iterator it)
+{
+    it.next();
+    return it;
+}
+
+/**
+ * @brief Get the previous entry
+ *
+ * @param[in] it Iterator
+ * @return The iterator pointing to the previous entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::getPrev(iterator it)
+{
+    it.prev();
+    return it;
+}
+
+
+
+/* --------- ITERATORS --------- */
+
+/**
+ * @brief Begin iterator
+ *
+ * @return Iterator pointing to the minimum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::begin()
+{
+    return getMin();
+}
+
+/**
+ * @brief End iterator
+ *
+ * @return Iterator pointing after the maximum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::iterator BPlusTree<K,T,C,N>::end()
+{
+    return iterator(this, nullptr, 0);
+}
+
+/**
+ * @brief Begin const iterator
+ *
+ * @return Const iterator pointing to the minimum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::const_iterator BPlusTree<K,T,C,N>::cbegin()
+{
+    return const_iterator(this, firstLeaf, 0);
+}
+
+/**
+ * @brief End const iterator
+ *
+ * @return Const iterator pointing after the maximum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::const_iterator BPlusTree<K,T,C,N>::cend()
+{
+    return const_iterator(this, nullptr, 0);
+}
+
+/**
+ * @brief Begin reverse iterator
+ *
+ * @return Reverse iterator pointing to the maximum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::reverse_iterator BPlusTree<K,T,C,N>::rbegin()
+{
+    if (lastLeaf == nullptr)
+        return rend();
+
+    return reverse_iterator(this, lastLeaf, lastLeaf->size - 1);
+}
+
+/**
+ * @brief End reverse iterator
+ *
+ * @return Reverse iterator pointing before the minimum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::reverse_iterator BPlusTree<K,T,C,N>::rend()
+{
+    return reverse_iterator(this, nullptr, 0);
+}
+
+/**
+ * @brief Begin const reverse iterator
+ *
+ * @return Const reverse iterator pointing to the maximum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::const_reverse_iterator BPlusTree<K,T,C,N>::crbegin()
+{
+    if (lastLeaf == nullptr)
+        return crend();
+
+    return const_reverse_iterator(this, lastLeaf, lastLeaf->size - 1);
+}
+
+/**
+ * @brief End const reverse iterator
+ *
+ * @return Const reverse iterator pointing before the minimum entry
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::const_reverse_iterator BPlusTree<K,T,C,N>::crend()
+{
+    return const_reverse_iterator(this, nullptr, 0);
+}
+
+/**
+ * @brief Inserter iterator
+ *
+ * @return Inserter iterator
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::insert_iterator BPlusTree<K,T,C,N>::inserter()
+{
+    return insert_iterator(this);
+}
+
+/**
+ * @brief Get range based iterator of the B+ tree
+ *
+ * @return Range based iterator
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::RangeBasedIterator BPlusTree<K,T,C,N>::getIterator()
+{
+    return RangeBasedIterator(this);
+}
+
+/**
+ * @brief Get range based const iterator of the B+ tree
+ *
+ * @return Range based const iterator
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::RangeBasedConstIterator BPlusTree<K,T,C,N>::getConstIterator()
+{
+    return RangeBasedConstIterator(this);
+}
+
+/**
+ * @brief Get range based reverse iterator of the B+ tree
+ *
+ * @return Range based reverse iterator
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::RangeBasedReverseIterator BPlusTree<K,T,C,N>::getReverseIterator()
+{
+    return RangeBasedReverseIterator(this);
+}
+
+/**
+ * @brief Get range based const reverse iterator of the B+ tree
+ *
+ * @return Range based const reverse iterator
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::RangeBasedConstReverseIterator BPlusTree<K,T,C,N>::getConstReverseIterator()
+{
+    return RangeBasedConstReverseIterator(this);
+}
+
+
+
+/* --------- SWAP FUNCTIONS --------- */
+
+/**
+ * @brief Assignment operator
+ * @param[out] bst Parameter to be assigned
+ * @return Current object
+ */
+template <class K, class T, class C, unsigned int N>
+BPlusTree<K,T,C,N>& BPlusTree<K,T,C,N>::operator= (BPlusTree<K,T,C,N> bst)
+{
+    this->swap(bst);
+    return *this;
+}
+
+/**
+ * @brief Swap B+ tree with another one
+ * @param[out] bst B+ tree to be swapped with this object
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::swap(BPlusTree<K,T,C,N>& bst)
+{
+    using std::swap;
+    swap(this->root, bst.root);
+    swap(this->firstLeaf, bst.firstLeaf);
+    swap(this->lastLeaf, bst.lastLeaf);
+    swap(this->height, bst.height);
+    swap(this->entries, bst.entries);
+    swap(this->comparator, bst.comparator);
+    this->leafPool.swap(bst.leafPool);
+    this->innerPool.swap(bst.innerPool);
+}
+
+/**
+ * @brief Swap graph with another one
+ * @param b1 First B+ tree
+ * @param b2 Second B+ tree
+ */
+template <class K, class T, class C, unsigned int N>
+void swap(BPlusTree<K,T,C,N>& b1, BPlusTree<K,T,C,N>& b2)
+{
+    b1.swap(b2);
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Initialization of the B+ tree
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::initialize()
+{
+    this->root = nullptr;
+    this->firstLeaf = nullptr;
+    this->lastLeaf = nullptr;
+    this->height = 0;
+    this->entries = 0;
+}
+
+/**
+ * @brief Bottom up construction of the B+ tree given a vector of sorted
+ * entries. Duplicates are skipped (the first occurrence is kept).
+ *
+ * Entries are evenly distributed in the leaves, and children are evenly
+ * distributed in the inner nodes, so every node (except the root) is at
+ * least half full.
+ *
+ * @param[in] sortedVec Sorted vector of entries (pair of keys/values)
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::bulkLoadHelper(const std::vector<std::pair<K,T>>& sortedVec)
+{
+    //Count unique entries
+    TreeSize numberOfEntries = 0;
+    for (size_t i = 0; i < sortedVec.size(); i++) {
+        if (i == 0 || !internal::isEqual(sortedVec[i-1].first, sortedVec[i].first, comparator))
+            numberOfEntries++;
+    }
+    if (numberOfEntries == 0)
+        return;
+
+    //Create leaves
+    TreeSize numberOfLeaves = (numberOfEntries + N - 1) / N;
+
+    std::vector<void*> levelNodes;
+    std::vector<K> levelMinKeys;
+    levelNodes.reserve(numberOfLeaves);
+    levelMinKeys.reserve(numberOfLeaves);
+
+    size_t vecIndex = 0;
+    LeafNode* prevLeaf = nullptr;
+    for (TreeSize l = 0; l < numberOfLeaves; l++) {
+        TreeSize leafSize = numberOfEntries / numberOfLeaves +
+                (l < numberOfEntries % numberOfLeaves ? 1 : 0);
+
+        LeafNode* leaf = leafPool.allocate();
+        while (leaf->size < leafSize) {
+            //Avoid duplicates
+            if (vecIndex == 0 || !internal::isEqual(sortedVec[vecIndex-1].first, sortedVec[vecIndex].first, comparator)) {
+                leaf->keys[leaf->size] = sortedVec[vecIndex].first;
+                leaf->values[leaf->size] = sortedVec[vecIndex].second;
+                leaf->size++;
+            }
+            vecIndex++;
+        }
+
+        //Linking leaves
+        leaf->prev = prevLeaf;
+        if (prevLeaf != nullptr)
+            prevLeaf->next = leaf;
+        else
+            firstLeaf = leaf;
+        prevLeaf = leaf;
+
+        levelNodes.push_back(leaf);
+        levelMinKeys.push_back(leaf->keys[0]);
+    }
+    lastLeaf = prevLeaf;
+
+    //Create inner levels until an only remaining node
+    height = 0;
+    while (levelNodes.size() > 1) {
+        TreeSize numberOfNodes = levelNodes.size();
+        TreeSize numberOfParents = (numberOfNodes + N - 1) / N;
+
+        std::vector<void*> newLevelNodes;
+        std::vector<K> newLevelMinKeys;
+        newLevelNodes.reserve(numberOfParents);
+        newLevelMinKeys.reserve(numberOfParents);
+
+        size_t nodeIndex = 0;
+        for (TreeSize p = 0; p < numberOfParents; p++) {
+            TreeSize parentSize = numberOfNodes / numberOfParents +
+                    (p < numberOfNodes % numberOfParents ? 1 : 0);
+
+            InnerNode* inner = innerPool.allocate();
+            for (TreeSize c = 0; c < parentSize; c++) {
+                inner->children[c] = levelNodes[nodeIndex];
+                if (c > 0)
+                    inner->keys[c-1] = levelMinKeys[nodeIndex];
+                nodeIndex++;
+            }
+            inner->size = (unsigned int) parentSize;
+
+            newLevelNodes.push_back(inner);
+            newLevelMinKeys.push_back(levelMinKeys[nodeIndex - parentSize]);
+        }
+
+        levelNodes.swap(newLevelNodes);
+        levelMinKeys.swap(newLevelMinKeys);
+        height++;
+    }
+
+    root = levelNodes[0];
+    entries = numberOfEntries;
+}
+
+/**
+ * @brief Find the leaf in which a key is (or should be) contained
+ *
+ * @param[in] key Key
+ * @return The leaf node, nullptr if the tree is empty
+ */
+template <class K, class T, class C, unsigned int N>
+typename BPlusTree<K,T,C,N>::LeafNode* BPlusTree<K,T,C,N>::findLeafHelper(const K& key)
+{
+    if (root == nullptr)
+        return nullptr;
+
+    void* node = root;
+    for (unsigned int level = height; level > 0; level--) {
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        node = inner->children[innerChildIndexHelper(inner, key)];
+    }
+
+    return static_cast<LeafNode*>(node);
+}
+
+/**
+ * @brief Position of the first key in the leaf which is not less
+ * than the given key
+ */
+template <class K, class T, class C, unsigned int N>
+unsigned int BPlusTree<K,T,C,N>::leafLowerBoundHelper(const LeafNode* leaf, const K& key)
+{
+    unsigned int first = 0;
+    unsigned int count = leaf->size;
+
+    while (count > 0) {
+        unsigned int step = count / 2;
+        if (internal::isLess(leaf->keys[first + step], key, comparator)) {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+/**
+ * @brief Index of the child of an inner node in which the key
+ * is (or should be) contained: the number of separator keys
+ * which are less or equal than the given key
+ */
+template <class K, class T, class C, unsigned int N>
+unsigned int BPlusTree<K,T,C,N>::innerChildIndexHelper(const InnerNode* inner, const K& key)
+{
+    unsigned int first = 0;
+    unsigned int count = inner->size - 1;
+
+    while (count > 0) {
+        unsigned int step = count / 2;
+        if (!internal::isLess(key, inner->keys[first + step], comparator)) {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+/**
+ * @brief Insert an entry in a non-full leaf at the given position
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::leafInsertAtHelper(
+        LeafNode* leaf, unsigned int pos,
+        const K& key, const T& value)
+{
+    assert(leaf->size < N);
+
+    for (unsigned int i = leaf->size; i > pos; i--) {
+        leaf->keys[i] = std::move(leaf->keys[i-1]);
+        leaf->values[i] = std::move(leaf->values[i-1]);
+    }
+    leaf->keys[pos] = key;
+    leaf->values[pos] = value;
+    leaf->size++;
+}
+
+/**
+ * @brief Recursive insertion of an entry in the subtree of a node
+ *
+ * @param[in] node Root of the subtree
+ * @param[in] level Level of the node (0 for leaves)
+ * @param[in] key Key of the entry
+ * @param[in] value Value of the entry
+ * @param[out] insertedLeaf Leaf containing the entry
+ * @param[out] insertedPos Position of the entry in the leaf
+ * @param[out] splitKey Minimum key of the new sibling, if the node has been split
+ * @param[out] newSibling New sibling of the node if it has been split,
+ * nullptr otherwise
+ * @return True if the entry has been inserted, false if the key
+ * was already contained
+ */
+template <class K, class T, class C, unsigned int N>
+bool BPlusTree<K,T,C,N>::insertHelper(
+        void* node, unsigned int level,
+        const K& key, const T& value,
+        LeafNode*& insertedLeaf, unsigned int& insertedPos,
+        K& splitKey, void*& newSibling)
+{
+    newSibling = nullptr;
+
+    //Leaf node
+    if (level == 0) {
+        LeafNode* leaf = static_cast<LeafNode*>(node);
+
+        unsigned int pos = leafLowerBoundHelper(leaf, key);
+
+        //If the key is already in the B+ tree
+        if (pos < leaf->size && internal::isEqual(leaf->keys[pos], key, comparator)) {
+            insertedLeaf = leaf;
+            insertedPos = pos;
+            return false;
+        }
+
+        if (leaf->size < N) {
+            leafInsertAtHelper(leaf, pos, key, value);
+            insertedLeaf = leaf;
+            insertedPos = pos;
+            return true;
+        }
+
+        //Split the leaf: the upper half goes in a new leaf
+        LeafNode* right = leafPool.allocate();
+        unsigned int mid = N / 2;
+        for (unsigned int i = mid; i < N; i++) {
+            right->keys[i - mid] = std::move(leaf->keys[i]);
+            right->values[i - mid] = std::move(leaf->values[i]);
+        }
+        right->size = N - mid;
+        leaf->size = mid;
+
+        //Linking the new leaf
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr)
+            leaf->next->prev = right;
+        else
+            lastLeaf = right;
+        leaf->next = right;
+
+        if (pos <= mid) {
+            leafInsertAtHelper(leaf, pos, key, value);
+            insertedLeaf = leaf;
+            insertedPos = pos;
+        }
+        else {
+            leafInsertAtHelper(right, pos - mid, key, value);
+            insertedLeaf = right;
+            insertedPos = pos - mid;
+        }
+
+        splitKey = right->keys[0];
+        newSibling = right;
+
+        return true;
+    }
+
+    //Inner node
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    unsigned int childIndex = innerChildIndexHelper(inner, key);
+
+    K childSplitKey;
+    void* childSibling = nullptr;
+
+    bool inserted = insertHelper(
+                inner->children[childIndex], level - 1,
+                key, value,
+                insertedLeaf, insertedPos,
+                childSplitKey, childSibling);
+
+    if (childSibling == nullptr)
+        return inserted;
+
+    //Room for the new child
+    if (inner->size < N) {
+        for (unsigned int i = inner->size - 1; i > childIndex; i--) {
+            inner->keys[i] = std::move(inner->keys[i-1]);
+        }
+        for (unsigned int i = inner->size; i > childIndex + 1; i--) {
+            inner->children[i] = inner->children[i-1];
+        }
+        inner->keys[childIndex] = childSplitKey;
+        inner->children[childIndex + 1] = childSibling;
+        inner->size++;
+
+        return inserted;
+    }
+
+    //Split the inner node: N+1 children are distributed in two nodes
+    K tmpKeys[N];
+    void* tmpChildren[N+1];
+    for (unsigned int i = 0, j = 0; i < N; i++) {
+        if (i == childIndex)
+            tmpKeys[j++] = childSplitKey;
+        if (i < N - 1)
+            tmpKeys[j++] = std::move(inner->keys[i]);
+    }
+    for (unsigned int i = 0, j = 0; i < N; i++) {
+        tmpChildren[j++] = inner->children[i];
+        if (i == childIndex)
+            tmpChildren[j++] = childSibling;
+    }
+
+    unsigned int leftSize = (N + 1) / 2;
+
+    InnerNode* right = innerPool.allocate();
+    for (unsigned int i = 0; i < leftSize; i++) {
+        inner->children[i] = tmpChildren[i];
+    }
+    for (unsigned int i = 0; i + 1 < leftSize; i++) {
+        inner->keys[i] = std::move(tmpKeys[i]);
+    }
+    inner->size = leftSize;
+
+    for (unsigned int i = leftSize; i < N + 1; i++) {
+        right->children[i - leftSize] = tmpChildren[i];
+    }
+    for (unsigned int i = leftSize; i < N; i++) {
+        right->keys[i - leftSize] = std::move(tmpKeys[i]);
+    }
+    right->size = N + 1 - leftSize;
+
+    splitKey = std::move(tmpKeys[leftSize - 1]);
+    newSibling = right;
+
+    return inserted;
+}
+
+/**
+ * @brief Recursive deletion of an entry in the subtree of a node. Children
+ * which become less than half full are rebalanced with a sibling.
+ *
+ * @param[in] node Root of the subtree
+ * @param[in] level Level of the node (0 for leaves)
+ * @param[in] key Key of the entry
+ * @return True if the entry has been erased, false if it was not found
+ */
+template <class K, class T, class C, unsigned int N>
+bool BPlusTree<K,T,C,N>::eraseHelper(
+        void* node, unsigned int level,
+        const K& key)
+{
+    //Leaf node
+    if (level == 0) {
+        LeafNode* leaf = static_cast<LeafNode*>(node);
+
+        unsigned int pos = leafLowerBoundHelper(leaf, key);
+        if (pos >= leaf->size || !internal::isEqual(leaf->keys[pos], key, comparator))
+            return false;
+
+        for (unsigned int i = pos; i + 1 < leaf->size; i++) {
+            leaf->keys[i] = std::move(leaf->keys[i+1]);
+            leaf->values[i] = std::move(leaf->values[i+1]);
+        }
+        leaf->size--;
+
+        return true;
+    }
+
+    //Inner node
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    unsigned int childIndex = innerChildIndexHelper(inner, key);
+    void* child = inner->children[childIndex];
+
+    if (!eraseHelper(child, level - 1, key))
+        return false;
+
+    unsigned int childSize = (level - 1 == 0 ?
+                static_cast<LeafNode*>(child)->size :
+                static_cast<InnerNode*>(child)->size);
+
+    if (childSize < N / 2)
+        rebalanceChildHelper(inner, childIndex, level - 1);
+
+    return true;
+}
+
+/**
+ * @brief Rebalance an underfull child of an inner node, merging it with
+ * an adjacent sibling or redistributing the entries between them.
+ *
+ * @param[in] parent Inner node
+ * @param[in] childIndex Index of the underfull child
+ * @param[in] childLevel Level of the child (0 for leaves)
+ */
+template <class K, class T, class C, unsigned int N>
+void BPlusTree<K,T,C,N>::rebalanceChildHelper(
+        InnerNode* parent,
+        unsigned int childIndex,
+        unsigned int childLevel)
+{
+    if (parent->size < 2)
+        return;
+
+    //Pair of adjacent children (j, j+1)
+    unsigned int j = (childIndex > 0 ? childIndex - 1 : childIndex);
+    bool merge = false;
+
+    //Leaves
+    if (childLevel == 0) {
+        LeafNode* left = static_cast<LeafNode*>(parent->children[j]);
+        LeafNode* right = static_cast<LeafNode*>(parent->children[j+1]);
+
+        if (left->size + right->size <= N) {
+            for (unsigned int i = 0; i < right->size; i++) {
+                left->keys[left->size + i] = std::move(right->keys[i]);
+                left->values[left->size + i] = std::move(right->values[i]);
+            }
+            left->size += right->size;
+
+            //Unlink the right leaf
+            left->next = right->next;
+            if (right->next != nullptr)
+                right->next->prev = left;
+            else
+                lastLeaf = left;
+
+            leafPool.deallocate(right);
+            merge = true;
+        }
+        else {
+            unsigned int target = (left->size + right->size) / 2;
+
+            //Move entries from the right leaf to the left one
+            if (left->size < target) {
+                unsigned int n = target - left->size;
+                for (unsigned int i = 0; i < n; i++) {
+                    left->keys[left->size + i] = std::move(right->keys[i]);
+                    left->values[left->size + i] = std::move(right->values[i]);
+                }
+                for (unsigned int i = n; i < right->size; i++) {
+                    right->keys[i - n] = std::move(right->keys[i]);
+                    right->values[i - n] = std::move(right->values[i]);
+                }
+                left->size += n;
+                right->size -= n;
+            }
+            //Move entries from the left leaf to the right one
+            else if (left->size > target) {
+                unsigned int n = left->size - target;
+                for (unsigned int i = right->size; i > 0; i--) {
+                    right->keys[i - 1 + n] = std::move(right->keys[i - 1]);
+                    right->values[i - 1 + n] = std::move(right->values[i - 1]);
+                }
+                for (unsigned int i = 0; i < n; i++) {
+                    right->keys[i] = std::move(left->keys[target + i]);
+                    right->values[i] = std::move(left->values[target + i]);
+                }
+                left->size -= n;
+                right->size += n;
+            }
+
+            parent->keys[j] = right->keys[0];
+        }
+    }
+    //Inner nodes
+    else {
+        InnerNode* left = static_cast<InnerNode*>(parent->children[j]);
+        InnerNode* right = static_cast<InnerNode*>(parent->children[j+1]);
+
+        if (left->size + right->size <= N) {
+            //The separator goes down between the two nodes
+            left->keys[left->size - 1] = parent->keys[j];
+            for (unsigned int i = 0; i + 1 < right->size; i++) {
+                left->keys[left->size + i] = std::move(right->keys[i]);
+            }
+            for (unsigned int i = 0; i < right->size; i++) {
+                left->children[left->size + i] = right->children[i];
+            }
+            left->size += right->size;
+
+            innerPool.deallocate(right);
+            merge = true;
+        }
+        else {
+            unsigned int target = (left->size + right->size) / 2;
+
+            //Rotate children from right to left through the parent
+            while (left->size < target) {
+                left->keys[left->size - 1] = std::move(parent->keys[j]);
+                left->children[left->size] = right->children[0];
+                left->size++;
+
+                parent->keys[j] = std::move(right->keys[0]);
+                for (unsigned int i = 0; i + 2 < right->size; i++) {
+                    right->keys[i] = std::move(right->keys[i+1]);
+                }
+                for (unsigned int i = 0; i + 1 < right->size; i++) {
+                    right->children[i] = right->children[i+1];
+                }
+                right->size--;
+            }
+            //Rotate children from left to right through the parent
+            while (left->size > target) {
+                for (unsigned int i = right->size - 1; i > 0; i--) {
+                    right->keys[i] = std::move(right->keys[i-1]);
+                }
+                for (unsigned int i = right->size; i > 0; i--) {
+                    right->children[i] = right->children[i-1];
+                }
+                right->keys[0] = std::move(parent->keys[j]);
+                right->children[0] = left->children[left->size - 1];
+                right->size++;
+
+                parent->keys[j] = std::move(left->keys[left->size - 2]);
+                left->size--;
+            }
+        }
+    }
+
+    //Remove the separator and the merged child from the parent
+    if (merge) {
+        for (unsigned int i = j; i + 2 < parent->size; i++) {
+            parent->keys[i] = std::move(parent->keys[i+1]);
+        }
+        for (unsigned int i = j + 1; i + 1 < parent->size; i++) {
+            parent->children[i] = parent->children[i+1];
+        }
+        parent->size--;
+    }
+}
+
+}
@@ -0,0 +1,218 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_BPLUSTREE_H
+#define CG3_BPLUSTREE_H
+
+#include <vector>
+#include <utility>
+
+#include "includes/tree_common.h"
+#include "includes/node_pool.h"
+#include "includes/parallel_helpers.h"
+
+#include "includes/iterators/bplustree_iterator.h"
+#include "includes/iterators/tree_insertiterator.h"
+#include "includes/iterators/tree_rangebased_iterators.h"
+
+#include "includes/nodes/bplustree_node.h"
+
+namespace cg3 {
+
+/**
+ * @brief A B+ tree
+ *
+ * Ordered container with the same interface of BSTLeaf/AVLLeaf, but
+ * with N entries per node: keys and values are stored in the leaves, which
+ * are linked in order. Iterations and range queries scan contiguous arrays
+ * of entries instead of following parent/child pointers, and nodes are
+ * allocated from pools. It supports bulk loading from sorted input.
+ * No duplicates are allowed. Keys and values must be default constructible.
+ *
+ * Unlike the binary trees, insertions and deletions invalidate the
+ * iterators.
+ */
+template <class K, class T = K, class C = DefaultComparatorType<K>, unsigned int N = 32>
+class BPlusTree
+{
+
+    static_assert(N >= 4, "The B+ tree node capacity must be at least 4");
+
+public:
+
+    /* Typedefs */
+
+    typedef internal::BPlusTreeLeafNode<K,T,N> LeafNode;
+    typedef internal::BPlusTreeInnerNode<K,N> InnerNode;
+
+    typedef BPlusTreeIterator<BPlusTree<K,T,C,N>, LeafNode, T> iterator;
+    typedef BPlusTreeIterator<BPlusTree<K,T,C,N>, LeafNode, const T> const_iterator;
+
+    typedef BPlusTreeReverseIterator<BPlusTree<K,T,C,N>, LeafNode, T> reverse_iterator;
+    typedef BPlusTreeReverseIterator<BPlusTree<K,T,C,N>, LeafNode, const T> const_reverse_iterator;
+
+    typedef TreeInsertIterator<BPlusTree<K,T,C,N>, K> insert_iterator;
+
+    typedef TreeRangeBasedIterator<BPlusTree<K,T,C,N>> RangeBasedIterator;
+    typedef TreeRangeBasedConstIterator<BPlusTree<K,T,C,N>> RangeBasedConstIterator;
+    typedef TreeRangeBasedReverseIterator<BPlusTree<K,T,C,N>> RangeBasedReverseIterator;
+    typedef TreeRangeBasedConstReverseIterator<BPlusTree<K,T,C,N>> RangeBasedConstReverseIterator;
+
+
+
+    /* Constructors/destructor */
+
+    explicit BPlusTree(const C& customComparator = &internal::defaultComparator<K>);
+    explicit BPlusTree(const std::vector<std::pair<K,T>>& vec,
+            const C& customComparator = &internal::defaultComparator<K>);
+    explicit BPlusTree(const std::vector<K>& vec,
+            const C& customComparator = &internal::defaultComparator<K>);
+
+    BPlusTree(const BPlusTree<K,T,C,N>& bst);
+    BPlusTree(BPlusTree<K,T,C,N>&& bst);
+
+    ~BPlusTree();
+
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    void sortedConstruction(const std::vector<K>& sortedVec);
+    void sortedConstruction(const std::vector<std::pair<K,T>>& sortedVec);
+
+    iterator insert(const K& key);
+    iterator insert(const K& key, const T& value);
+
+    bool erase(const K& key);
+
+    iterator find(const K& key);
+
+    iterator findLower(const K& key);
+    iterator findUpper(const K& key);
+
+
+    TreeSize size();
+    bool empty();
+
+    void clear();
+
+    TreeSize getHeight();
+
+
+
+    template <class OutputIterator>
+    void rangeQuery(
+            const K& start, const K& end,
+            OutputIterator out);
+
+    template <class OutputIterator>
+    void rangeQueryValues(
+            const K& start, const K& end,
+            OutputIterator out);
+
+
+
+    /* Iterator Min/Max Next/Prev */
+
+    iterator getMin();
+    iterator getMax();
+
+    iterator getNext(const iterator it);
+    iterator getPrev(const iterator it);
+
+
+
+    /* Iterators */
+
+    iterator begin();
+    iterator end();
+
+    const_iterator cbegin();
+    const_iterator cend();
+
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
+    const_reverse_iterator crbegin();
+    const_reverse_iterator crend();
+
+    insert_iterator inserter();
+
+    RangeBasedIterator getIterator();
+    RangeBasedConstIterator getConstIterator();
+    RangeBasedReverseIterator getReverseIterator();
+    RangeBasedConstReverseIterator getConstReverseIterator();
+
+
+    /* Swap function and assignment */
+
+    inline BPlusTree<K,T,C,N>& operator= (BPlusTree<K,T,C,N> bst);
+    inline void swap(BPlusTree<K,T,C,N>& bst);
+
+protected:
+
+    /* Protected fields */
+
+    void* root;
+
+    LeafNode* firstLeaf;
+    LeafNode* lastLeaf;
+
+    unsigned int height; //Number of inner levels
+
+    TreeSize entries;
+
+    C comparator;
+
+    internal::NodePool<LeafNode> leafPool;
+    internal::NodePool<InnerNode> innerPool;
+
+
+    /* Protected methods */
+
+    void initialize();
+
+    void bulkLoadHelper(
+            const std::vector<std::pair<K,T>>& sortedVec);
+
+    inline LeafNode* findLeafHelper(const K& key);
+    inline unsigned int leafLowerBoundHelper(const LeafNode* leaf, const K& key);
+    inline unsigned int innerChildIndexHelper(const InnerNode* inner, const K& key);
+    inline void leafInsertAtHelper(
+            LeafNode* leaf, unsigned int pos,
+            const K& key, const T& value);
+
+    bool insertHelper(
+            void* node, unsigned int level,
+            const K& key, const T& value,
+            LeafNode*& insertedLeaf, unsigned int& insertedPos,
+            K& splitKey, void*& newSibling);
+
+    bool eraseHelper(
+            void* node, unsigned int level,
+            const K& key);
+
+    void rebalanceChildHelper(
+            InnerNode* parent,
+            unsigned int childIndex,
+            unsigned int childLevel);
+
+};
+
+
+template <class K, class T, class C, unsigned int N>
+void swap(BPlusTree<K,T,C,N>& b1, BPlusTree<K,T,C,N>& b2);
+
+
+}
+
+
+#include "bplustree.cpp"
+
+#endif // CG3_BPLUSTREE_H
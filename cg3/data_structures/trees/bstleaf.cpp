@@ -146,17 +146,18 @@ void BSTLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 
     //Sort the collection
     internal::PairComparator<K,T> pairComparator(comparator);
-    std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
+    internal::parallelSortHelper(sortedVec.begin(), sortedVec.end(), pairComparator);
 
     //Create nodes
-    std::vector<Node*> sortedNodes;
-    for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
-        sortedNodes.push_back(node);
+    const long long int numberOfNodes = (long long int) sortedVec.size();
+    std::vector<Node*> sortedNodes(sortedVec.size());
+    #pragma omp parallel for if (numberOfNodes > (long long int) internal::TREE_PARALLEL_THRESHOLD)
+    for (long long int i = 0; i < numberOfNodes; i++) {
+        sortedNodes[i] = new Node(sortedVec[i].first, sortedVec[i].second);
     }
 
-    //Calling the bottom up construction helper
-    this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
+    //Calling the parallel construction helper
+    this->entries = internal::constructionParallelHelperLeaf<Node,K,C>(
                 sortedNodes,
                 this->root,
                 comparator);
@@ -0,0 +1,245 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "concurrent_tree.h"
+
+#include <thread>
+
+namespace cg3 {
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor, empty tree
+ */
+template <class Tree>
+ConcurrentTree<Tree>::ConcurrentTree() :
+    activeInstance(0),
+    versionIndex(0)
+{
+
+}
+
+/**
+ * @brief Constructor with an initial tree, which is copied
+ *
+ * @param[in] tree Tree
+ */
+template <class Tree>
+ConcurrentTree<Tree>::ConcurrentTree(const Tree& tree) :
+    instances{tree, tree},
+    activeInstance(0),
+    versionIndex(0)
+{
+
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Execute a read operation on the tree. It never waits for writers
+ * and it can be called concurrently by any number of threads.
+ *
+ * The function receives a reference to the tree, and it must use only
+ * methods which do not modify it (find, rangeQuery, aabbOverlapQuery,
+ * iterations, ...). Iterators must not be used outside the function.
+ *
+ * @param[in] function Function taking a Tree& as parameter
+ * @return The value returned by the function
+ */
+template <class Tree>
+template <class F>
+auto ConcurrentTree<Tree>::read(F function) -> decltype(function(std::declval<Tree&>()))
+{
+    ReadGuard guard(readIndicators[versionIndex.load()]);
+
+    return function(instances[activeInstance.load()]);
+}
+
+/**
+ * @brief Execute a write operation on the tree. Writers are serialized,
+ * readers can work concurrently.
+ *
+ * All the modifications done by the function become visible to the
+ * readers at the same time. The function is applied to both the copies
+ * of the tree, so it must be deterministic: applied to two equal trees,
+ * it must leave them equal.
+ *
+ * If the function throws an exception, the exception is propagated to
+ * the caller. If it is thrown on the first copy, the modifications are
+ * never visible and the tree is left unchanged; if it is thrown on the
+ * second copy, the modifications are already visible and the second copy
+ * is rebuilt as a copy of the first one. In both cases the two copies of
+ * the tree are equal again.
+ *
+ * @param[in] function Function taking a Tree& as parameter
+ */
+template <class Tree>
+template <class F>
+void ConcurrentTree<Tree>::write(F function)
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+
+    const unsigned int active = activeInstance.load();
+
+    //Modify the instance that no reader is using and make it visible
+    try {
+        function(instances[1 - active]);
+    }
+    catch (...) {
+        instances[1 - active] = instances[active];
+        throw;
+    }
+    activeInstance.store(1 - active);
+
+    //Wait for the readers of the old instance before modifying it
+    toggleVersionAndWaitHelper();
+
+    try {
+        function(instances[active]);
+    }
+    catch (...) {
+        instances[active] = instances[1 - active];
+        throw;
+    }
+}
+
+/**
+ * @brief Get a copy of the current version of the tree, which can
+ * be used without any synchronization
+ *
+ * @return Copy of the tree
+ */
+template <class Tree>
+Tree ConcurrentTree<Tree>::snapshot()
+{
+    return read([](Tree& tree) {
+        return Tree(tree);
+    });
+}
+
+/**
+ * @brief Insert an entry in the tree
+ *
+ * @param[in] args Arguments of the insert method of the tree (key, value)
+ */
+template <class Tree>
+template <class... Args>
+void ConcurrentTree<Tree>::insert(const Args&... args)
+{
+    write([&](Tree& tree) {
+        tree.insert(args...);
+    });
+}
+
+/**
+ * @brief Erase an entry from the tree
+ *
+ * @param[in] key Key of the entry
+ */
+template <class Tree>
+template <class K>
+void ConcurrentTree<Tree>::erase(const K& key)
+{
+    write([&](Tree& tree) {
+        tree.erase(key);
+    });
+}
+
+/**
+ * @brief Construction of the tree given the input vector
+ *
+ * @param[in] vec Vector of keys or of key/value pairs
+ */
+template <class Tree>
+template <class V>
+void ConcurrentTree<Tree>::construction(const V& vec)
+{
+    write([&](Tree& tree) {
+        tree.construction(vec);
+    });
+}
+
+/**
+ * @brief Clear the tree
+ */
+template <class Tree>
+void ConcurrentTree<Tree>::clear()
+{
+    write([](Tree& tree) {
+        tree.clear();
+    });
+}
+
+/**
+ * @brief Get the number of entries in the tree
+ * @return Number of entries
+ */
+template <class Tree>
+size_t ConcurrentTree<Tree>::size()
+{
+    return read([](Tree& tree) {
+        return (size_t) tree.size();
+    });
+}
+
+/**
+ * @brief Check if the tree is empty
+ * @return True if the tree is empty
+ */
+template <class Tree>
+bool ConcurrentTree<Tree>::empty()
+{
+    return read([](Tree& tree) {
+        return tree.empty();
+    });
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Redirect the new readers on the other read indicator, and wait
+ * until all the readers which could have seen the old instance have left
+ */
+template <class Tree>
+void ConcurrentTree<Tree>::toggleVersionAndWaitHelper()
+{
+    const unsigned int previous = versionIndex.load();
+    const unsigned int next = 1 - previous;
+
+    //Readers still registered on next from an older toggle
+    while (!readIndicators[next].isEmpty())
+        std::this_thread::yield();
+
+    versionIndex.store(next);
+
+    while (!readIndicators[previous].isEmpty())
+        std::this_thread::yield();
+}
+
+
+
+/* --------- READ GUARD --------- */
+
+template <class Tree>
+inline ConcurrentTree<Tree>::ReadGuard::ReadGuard(internal::ReadIndicator& indicator) :
+    indicator(indicator)
+{
+    indicator.arrive();
+}
+
+template <class Tree>
+inline ConcurrentTree<Tree>::ReadGuard::~ReadGuard()
+{
+    indicator.depart();
+}
+
+}
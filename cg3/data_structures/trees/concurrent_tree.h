@@ -0,0 +1,118 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_CONCURRENTTREE_H
+#define CG3_CONCURRENTTREE_H
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include "includes/read_indicator.h"
+
+namespace cg3 {
+
+/**
+ * @brief Wrapper which allows to query a tree (BSTLeaf, AVLLeaf, AABBTree,
+ * RangeTree, BPlusTree, ...) from many threads while another thread
+ * modifies it.
+ *
+ * It keeps two copies of the tree (left-right technique): readers always
+ * work on the copy which is not being modified, without locks and without
+ * ever waiting for the writers. A writer applies the modification to the
+ * inactive copy, makes it visible to the new readers, waits for the readers
+ * of the old copy to leave and then applies the same modification to it.
+ * Writers are serialized by a mutex.
+ *
+ * Each read operation sees a single consistent version of the tree for all
+ * its duration (snapshot isolation), and a write operation (possibly
+ * composed of several insertions/deletions) becomes visible atomically.
+ *
+ * Read functions must not modify the tree and must not let iterators or
+ * node pointers escape: they are valid only inside the read function.
+ * Write functions are executed twice, so they must be deterministic and
+ * must not have other side effects. If a write function throws, the two
+ * copies are made equal again by copying the tree (see write()).
+ * The memory used is twice the memory of the tree.
+ */
+template <class Tree>
+class ConcurrentTree
+{
+
+public:
+
+    /* Constructors */
+
+    ConcurrentTree();
+    explicit ConcurrentTree(const Tree& tree);
+
+    ConcurrentTree(const ConcurrentTree<Tree>&) = delete;
+    ConcurrentTree<Tree>& operator= (const ConcurrentTree<Tree>&) = delete;
+
+
+    /* Public methods */
+
+    template <class F>
+    auto read(F function) -> decltype(function(std::declval<Tree&>()));
+
+    template <class F>
+    void write(F function);
+
+    Tree snapshot();
+
+
+    template <class... Args>
+    void insert(const Args&... args);
+
+    template <class K>
+    void erase(const K& key);
+
+    template <class V>
+    void construction(const V& vec);
+
+    void clear();
+
+    size_t size();
+    bool empty();
+
+protected:
+
+    /* Reader guard */
+
+    class ReadGuard {
+    public:
+        inline ReadGuard(internal::ReadIndicator& indicator);
+        inline ~ReadGuard();
+    private:
+        internal::ReadIndicator& indicator;
+    };
+
+
+    /* Protected fields */
+
+    Tree instances[2];
+
+    std::atomic<unsigned int> activeInstance; //Instance used by the readers
+    std::atomic<unsigned int> versionIndex;  //Read indicator used by the new readers
+
+    internal::ReadIndicator readIndicators[2];
+
+    std::mutex writerMutex;
+
+
+    /* Protected methods */
+
+    void toggleVersionAndWaitHelper();
+
+};
+
+}
+
+
+#include "concurrent_tree.cpp"
+
+#endif // CG3_CONCURRENTTREE_H
@@ -419,6 +419,147 @@ TreeSize constructionBottomUpHelperLeaf(
     return numberOfEntries;
 }
 
+/**
+ * Construction of the balanced BST given a vector of sorted elements
+ *
+ * Parallel construction: duplicates are removed, then the two halves of
+ * the leaves are recursively built in parallel (fork-join) and joined by
+ * a new parent node. The resulting tree is perfectly balanced, so it also
+ * satisfies the AVL constraints.
+ *
+ * @param[in] sortedVec Sorted vector of nodes
+ * @param[out] rootNode Root node of the BST
+ * @param[in] comparator Less comparator for keys
+ * @returns Number of entries inserted in the BST
+ */
+template <class Node, class K, class C>
+TreeSize constructionParallelHelperLeaf(
+        std::vector<Node*>& sortedNodes,
+        Node*& rootNode,
+        C& comparator)
+{
+    return constructionParallelHelperLeaf<Node,K,C>(
+                sortedNodes, rootNode, comparator,
+                [](Node*) {});
+}
+
+/**
+ * Construction of the balanced BST given a vector of sorted elements
+ *
+ * Parallel construction: duplicates are removed, then the two halves of
+ * the leaves are recursively built in parallel (fork-join) and joined by
+ * a new parent node. The resulting tree is perfectly balanced, so it also
+ * satisfies the AVL constraints.
+ *
+ * The update function is called on every node after its children have
+ * been built (e.g. to set heights or bounding boxes). It can be called
+ * concurrently on nodes of disjoint subtrees.
+ *
+ * @param[in] sortedVec Sorted vector of nodes
+ * @param[out] rootNode Root node of the BST
+ * @param[in] comparator Less comparator for keys
+ * @param[in] updateNodeFunction Function called on each node (leaves included)
+ * @returns Number of entries inserted in the BST
+ */
+template <class Node, class K, class C, class F>
+TreeSize constructionParallelHelperLeaf(
+        std::vector<Node*>& sortedNodes,
+        Node*& rootNode,
+        C& comparator,
+        F updateNodeFunction)
+{
+    //Remove duplicates
+    std::vector<Node*> leaves;
+    leaves.reserve(sortedNodes.size());
+    for (size_t i = 0; i < sortedNodes.size(); i++) {
+        Node* node = sortedNodes[i];
+
+        if (leaves.empty() || !isEqual(leaves.back()->key, node->key, comparator)) {
+            leaves.push_back(node);
+        }
+        //If it has not been inserted
+        else {
+            delete node;
+            node = nullptr;
+            sortedNodes[i] = nullptr;
+        }
+    }
+
+    if (leaves.empty()) {
+        rootNode = nullptr;
+        return 0;
+    }
+
+    Node* const* leavesData = leaves.data();
+    const TreeSize numberOfLeaves = leaves.size();
+    F* function = &updateNodeFunction;
+
+    runParallelTasksHelper([&]() {
+        rootNode = constructionSubtreeHelperLeaf(leavesData, 0, numberOfLeaves, function);
+    });
+
+    rootNode->parent = nullptr;
+
+    return numberOfLeaves;
+}
+
+/**
+ * Recursive construction of the subtree of the leaves in [start, end)
+ *
+ * @param[in] leaves Array of sorted leaves
+ * @param[in] start Start index of the leaves
+ * @param[in] end End index of the leaves
+ * @param[in] updateNodeFunction Function called on each node
+ * @return The root of the subtree
+ */
+template <class Node, class F>
+Node* constructionSubtreeHelperLeaf(
+        Node* const* leaves,
+        const TreeSize start, const TreeSize end,
+        F* updateNodeFunction)
+{
+    //Leaf
+    if (end - start == 1) {
+        Node* leaf = leaves[start];
+        leaf->left = nullptr;
+        leaf->right = nullptr;
+
+        (*updateNodeFunction)(leaf);
+
+        return leaf;
+    }
+
+    TreeSize mid = start + (end - start + 1) / 2;
+
+    Node* leftChild = nullptr;
+    Node* rightChild = nullptr;
+
+    if (end - start > TREE_PARALLEL_THRESHOLD) {
+        #pragma omp task shared(leftChild) firstprivate(leaves, start, mid, updateNodeFunction)
+        leftChild = constructionSubtreeHelperLeaf(leaves, start, mid, updateNodeFunction);
+
+        rightChild = constructionSubtreeHelperLeaf(leaves, mid, end, updateNodeFunction);
+
+        #pragma omp taskwait
+    }
+    else {
+        leftChild = constructionSubtreeHelperLeaf(leaves, start, mid, updateNodeFunction);
+        rightChild = constructionSubtreeHelperLeaf(leaves, mid, end, updateNodeFunction);
+    }
+
+    //The key of the parent is the minimum of the right subtree
+    Node* node = new Node(leaves[mid]->key);
+
+    node->left = leftChild;
+    node->right = rightChild;
+    leftChild->parent = node;
+    rightChild->parent = node;
+
+    (*updateNodeFunction)(node);
+
+    return node;
+}
+
 
 
 
@@ -10,6 +10,7 @@
 #include "bst_helpers.h"
 
 #include "tree_common.h"
+#include "parallel_helpers.h"
 
 #include <vector>
 
@@ -51,6 +52,25 @@ inline TreeSize constructionBottomUpHelperLeaf(
         Node*& rootNode,
         C& comparator);
 
+template <class Node, class K, class C>
+inline TreeSize constructionParallelHelperLeaf(
+        std::vector<Node*>& sortedNodes,
+        Node*& rootNode,
+        C& comparator);
+
+template <class Node, class K, class C, class F>
+inline TreeSize constructionParallelHelperLeaf(
+        std::vector<Node*>& sortedNodes,
+        Node*& rootNode,
+        C& comparator,
+        F updateNodeFunction);
+
+template <class Node, class F>
+inline Node* constructionSubtreeHelperLeaf(
+        Node* const* leaves,
+        const TreeSize start, const TreeSize end,
+        F* updateNodeFunction);
+
 
 /* Range query helpers */
 
@@ -0,0 +1,212 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "bplustree_iterator.h"
+
+namespace cg3 {
+
+
+/* --------- ITERATOR OPERATOR OVERLOAD --------- */
+
+template <class B, class L, class T>
+bool BPlusTreeIterator<B,L,T>::operator ==(
+        const BPlusTreeIterator& otherIterator) const
+{
+    return (this->leaf == otherIterator.leaf && this->pos == otherIterator.pos);
+}
+
+template <class B, class L, class T>
+bool BPlusTreeIterator<B,L,T>::operator !=(const BPlusTreeIterator& otherIterator) const
+{
+    return !(*this == otherIterator);
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator ++()
+{
+    this->next();
+    return *this;
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator ++(int)
+{
+    BPlusTreeIterator oldIt = *this;
+    this->next();
+    return oldIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator +(int n)
+{
+    BPlusTreeIterator newIt = *this;
+    newIt += n;
+    return newIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator +=(int n)
+{
+    for (int i = 0; i < n; i++) {
+        this->next();
+    }
+    return *this;
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator --()
+{
+    this->prev();
+    return *this;
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator --(int)
+{
+    BPlusTreeIterator oldIt = *this;
+    this->prev();
+    return oldIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator -(int n)
+{
+    BPlusTreeIterator newIt = *this;
+    newIt -= n;
+    return newIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeIterator<B,L,T> BPlusTreeIterator<B,L,T>::operator -=(int n)
+{
+    for (int i = 0; i < n; i++) {
+        this->prev();
+    }
+    return *this;
+}
+
+template <class B, class L, class T>
+T& BPlusTreeIterator<B,L,T>::operator *() const
+{
+    return this->leaf->values[this->pos];
+}
+
+
+
+/* ----- PROTECTED METHODS ----- */
+
+/**
+ * @brief Move to the next entry, following the linked list of leaves.
+ * The end iterator has a null leaf.
+ */
+template <class B, class L, class T>
+void BPlusTreeIterator<B,L,T>::next()
+{
+    this->pos++;
+    if (this->pos >= this->leaf->size) {
+        this->leaf = this->leaf->next;
+        this->pos = 0;
+    }
+}
+
+/**
+ * @brief Move to the previous entry. Decrementing the end iterator
+ * gives the maximum entry, decrementing the minimum gives the end iterator.
+ */
+template <class B, class L, class T>
+void BPlusTreeIterator<B,L,T>::prev()
+{
+    if (this->leaf == nullptr) {
+        auto maxIt = this->bst->getMax();
+        this->leaf = maxIt.leaf;
+        this->pos = maxIt.pos;
+    }
+    else if (this->pos > 0) {
+        this->pos--;
+    }
+    else {
+        this->leaf = this->leaf->prev;
+        this->pos = (this->leaf != nullptr ? this->leaf->size - 1 : 0);
+    }
+}
+
+
+
+/* --------- REVERSE ITERATOR OPERATOR OVERLOAD --------- */
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator ++()
+{
+    if (this->leaf != nullptr)
+        this->prev();
+    return *this;
+}
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator ++(int)
+{
+    BPlusTreeReverseIterator oldIt = *this;
+    ++(*this);
+    return oldIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator +(int n)
+{
+    BPlusTreeReverseIterator newIt = *this;
+    newIt += n;
+    return newIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator +=(int n)
+{
+    for (int i = 0; i < n; i++) {
+        ++(*this);
+    }
+    return *this;
+}
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator --()
+{
+    if (this->leaf == nullptr) {
+        auto minIt = this->bst->getMin();
+        this->leaf = minIt.leaf;
+        this->pos = minIt.pos;
+    }
+    else {
+        this->next();
+    }
+    return *this;
+}
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator --(int)
+{
+    BPlusTreeReverseIterator oldIt = *this;
+    --(*this);
+    return oldIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator -(int n)
+{
+    BPlusTreeReverseIterator newIt = *this;
+    newIt -= n;
+    return newIt;
+}
+
+template <class B, class L, class T>
+BPlusTreeReverseIterator<B,L,T> BPlusTreeReverseIterator<B,L,T>::operator -=(int n)
+{
+    for (int i = 0; i < n; i++) {
+        --(*this);
+    }
+    return *this;
+}
+
+}
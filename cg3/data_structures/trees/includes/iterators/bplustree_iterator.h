@@ -0,0 +1,111 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_BPLUSTREEITERATOR_H
+#define CG3_BPLUSTREEITERATOR_H
+
+#include <iterator>
+
+namespace cg3 {
+
+/**
+ * @brief The iterator class for the B+ tree.
+ *
+ * It has the same interface of TreeIterator, but it points to a position
+ * (leaf node and slot) in the linked list of leaves: no parent pointers
+ * are followed during the iteration.
+ */
+template <class B, class L, class T>
+class BPlusTreeIterator :
+        public std::iterator<std::bidirectional_iterator_tag, T>
+{
+
+    template <class T1, class T2, class T3, unsigned int T4>
+    friend class BPlusTree;
+    template <class T1, class T2, class T3>
+    friend class BPlusTreeIterator;
+    template <class T1, class T2, class T3>
+    friend class BPlusTreeReverseIterator;
+
+public:
+
+    /* Constructors */
+
+    inline BPlusTreeIterator(B* bst, L* leaf, unsigned int pos) :
+        bst(bst), leaf(leaf), pos(pos) {}
+
+
+    /* Iterator operators */
+
+    inline bool operator == (const BPlusTreeIterator& otherIterator) const;
+    inline bool operator != (const BPlusTreeIterator& otherIterator) const;
+
+    inline BPlusTreeIterator operator ++ ();
+    inline BPlusTreeIterator operator ++ (int);
+    inline BPlusTreeIterator operator + (int);
+    inline BPlusTreeIterator operator += (int);
+
+    inline BPlusTreeIterator operator -- ();
+    inline BPlusTreeIterator operator -- (int);
+    inline BPlusTreeIterator operator - (int);
+    inline BPlusTreeIterator operator -= (int);
+
+    inline T& operator *() const;
+
+
+protected:
+
+    /* Protected methods */
+
+    inline void next();
+    inline void prev();
+
+
+    /* Fields */
+
+    B* bst;
+    L* leaf;
+    unsigned int pos;
+
+};
+
+
+/**
+ * @brief The reverse iterator class for the B+ tree
+ */
+template <class B, class L, class T>
+class BPlusTreeReverseIterator :
+        public BPlusTreeIterator<B,L,T>
+{
+
+public:
+
+    /* Constructors */
+
+    inline BPlusTreeReverseIterator(B* bst, L* leaf, unsigned int pos) :
+        BPlusTreeIterator<B,L,T>(bst, leaf, pos) {}
+
+
+    /* Iterator operators */
+
+    inline BPlusTreeReverseIterator operator ++ ();
+    inline BPlusTreeReverseIterator operator ++ (int);
+    inline BPlusTreeReverseIterator operator + (int);
+    inline BPlusTreeReverseIterator operator += (int);
+
+    inline BPlusTreeReverseIterator operator -- ();
+    inline BPlusTreeReverseIterator operator -- (int);
+    inline BPlusTreeReverseIterator operator - (int);
+    inline BPlusTreeReverseIterator operator -= (int);
+
+};
+
+}
+
+
+#include "bplustree_iterator.cpp"
+
+#endif // CG3_BPLUSTREEITERATOR_H
@@ -0,0 +1,103 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "node_pool.h"
+
+#include <utility>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] chunkSize Number of nodes allocated together
+ */
+template <class Node>
+NodePool<Node>::NodePool(size_t chunkSize) :
+    chunkSize(chunkSize > 0 ? chunkSize : 1),
+    usedInLastChunk(0)
+{
+
+}
+
+/**
+ * @brief Destructor
+ */
+template <class Node>
+NodePool<Node>::~NodePool()
+{
+    this->clear();
+}
+
+/**
+ * @brief Get a default constructed node from the pool
+ *
+ * @return Pointer to the node
+ */
+template <class Node>
+Node* NodePool<Node>::allocate()
+{
+    //Recycle a released node
+    if (!freeNodes.empty()) {
+        Node* node = freeNodes.back();
+        freeNodes.pop_back();
+        *node = Node();
+        return node;
+    }
+
+    //New chunk
+    if (chunks.empty() || usedInLastChunk == chunkSize) {
+        chunks.push_back(new Node[chunkSize]);
+        usedInLastChunk = 0;
+    }
+
+    return &(chunks.back()[usedInLastChunk++]);
+}
+
+/**
+ * @brief Release a node, that will be recycled by the next allocations
+ *
+ * @param[in] node Node previously allocated by this pool
+ */
+template <class Node>
+void NodePool<Node>::deallocate(Node* node)
+{
+    freeNodes.push_back(node);
+}
+
+/**
+ * @brief Release all the memory of the pool
+ */
+template <class Node>
+void NodePool<Node>::clear()
+{
+    for (Node* chunk : chunks) {
+        delete[] chunk;
+    }
+    chunks.clear();
+    freeNodes.clear();
+    usedInLastChunk = 0;
+}
+
+/**
+ * @brief Swap two pools
+ *
+ * @param[in] pool Other pool
+ */
+template <class Node>
+void NodePool<Node>::swap(NodePool<Node>& pool)
+{
+    std::swap(this->chunks, pool.chunks);
+    std::swap(this->freeNodes, pool.freeNodes);
+    std::swap(this->chunkSize, pool.chunkSize);
+    std::swap(this->usedInLastChunk, pool.usedInLastChunk);
+}
+
+}
+
+}
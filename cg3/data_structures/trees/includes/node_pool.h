@@ -0,0 +1,68 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_NODEPOOL_H
+#define CG3_NODEPOOL_H
+
+#include <vector>
+#include <cstddef>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Pool allocator for tree nodes.
+ *
+ * Nodes are allocated in chunks of contiguous memory, and released nodes
+ * are recycled through a free list. Nodes allocated one after the other
+ * are therefore close in memory, which improves the locality of the
+ * traversals. The memory is released only on clear() or destruction.
+ */
+template <class Node>
+class NodePool {
+
+public:
+
+    /* Constructors/Destructor */
+
+    explicit NodePool(size_t chunkSize = 256);
+
+    NodePool(const NodePool& pool) = delete;
+    NodePool& operator= (const NodePool& pool) = delete;
+
+    ~NodePool();
+
+
+    /* Public methods */
+
+    inline Node* allocate();
+    inline void deallocate(Node* node);
+
+    void clear();
+
+    inline void swap(NodePool<Node>& pool);
+
+
+private:
+
+    /* Fields */
+
+    std::vector<Node*> chunks;
+    std::vector<Node*> freeNodes;
+
+    size_t chunkSize;
+    size_t usedInLastChunk;
+
+};
+
+}
+
+}
+
+#include "node_pool.cpp"
+
+#endif // CG3_NODEPOOL_H
@@ -0,0 +1,76 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_BPLUSTREENODE_H
+#define CG3_BPLUSTREENODE_H
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief The leaf node of the B+ tree
+ *
+ * Keys and values are stored in two separate fixed-size arrays, so that
+ * searches scan a contiguous block of keys. Leaves are linked in a
+ * doubly linked list for the in-order iteration.
+ */
+template <class K, class T, unsigned int N>
+class BPlusTreeLeafNode {
+
+public:
+
+    /* Constructors */
+
+    BPlusTreeLeafNode() :
+        size(0), prev(nullptr), next(nullptr) {}
+
+
+    /* Fields */
+
+    unsigned int size;
+
+    K keys[N];
+    T values[N];
+
+    BPlusTreeLeafNode* prev;
+    BPlusTreeLeafNode* next;
+
+};
+
+/**
+ * @brief The inner node of the B+ tree
+ *
+ * It contains size children and size-1 separator keys: all the keys
+ * in children[i] are less than keys[i], all the keys in children[i+1]
+ * are greater or equal than keys[i]. The type of the children (inner
+ * or leaf node) depends on the level of the node in the tree.
+ */
+template <class K, unsigned int N>
+class BPlusTreeInnerNode {
+
+public:
+
+    /* Constructors */
+
+    BPlusTreeInnerNode() :
+        size(0) {}
+
+
+    /* Fields */
+
+    unsigned int size;
+
+    K keys[N-1];
+    void* children[N];
+
+};
+
+}
+
+}
+
+#endif // CG3_BPLUSTREENODE_H
@@ -0,0 +1,102 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "parallel_helpers.h"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Run a function which spawns OpenMP tasks. If the caller is not
+ * already in a parallel region, a team of threads is created and the
+ * function is executed by one of them; otherwise the function is
+ * executed directly, and its tasks are scheduled on the current team.
+ *
+ * @param[in] function Function to be executed
+ */
+template <class F>
+void runParallelTasksHelper(F function)
+{
+#ifdef _OPENMP
+    if (omp_in_parallel()) {
+        function();
+    }
+    else {
+        #pragma omp parallel
+        {
+            #pragma omp single
+            function();
+        }
+    }
+#else
+    function();
+#endif
+}
+
+/**
+ * @brief Parallel sort: the range is split in a chunk for each thread,
+ * chunks are sorted in parallel and then merged pairwise in parallel.
+ * It falls back to std::sort for small ranges, if OpenMP is not enabled
+ * or if it is called inside a parallel region.
+ *
+ * @param[in] first Begin of the range
+ * @param[in] last End of the range
+ * @param[in] comparator Less comparator
+ */
+template <class RandomIt, class Compare>
+void parallelSortHelper(RandomIt first, RandomIt last, Compare comparator)
+{
+    const long long int size = (long long int) (last - first);
+
+#ifdef _OPENMP
+    const int nChunks = omp_get_max_threads();
+
+    if (omp_in_parallel() || nChunks < 2 || size < (long long int) TREE_PARALLEL_THRESHOLD * nChunks) {
+        std::sort(first, last, comparator);
+        return;
+    }
+
+    //Chunk boundaries
+    std::vector<RandomIt> bounds(nChunks + 1);
+    for (int i = 0; i <= nChunks; i++) {
+        bounds[i] = first + (size * i) / nChunks;
+    }
+
+    //Sort chunks
+    #pragma omp parallel for
+    for (int i = 0; i < nChunks; i++) {
+        std::sort(bounds[i], bounds[i+1], comparator);
+    }
+
+    //Merge pairs of adjacent chunks
+    for (int width = 1; width < nChunks; width *= 2) {
+        #pragma omp parallel for
+        for (int i = 0; i < nChunks; i += 2 * width) {
+            if (i + width < nChunks) {
+                std::inplace_merge(
+                            bounds[i],
+                            bounds[i + width],
+                            bounds[std::min(i + 2 * width, nChunks)],
+                            comparator);
+            }
+        }
+    }
+#else
+    (void) size;
+    std::sort(first, last, comparator);
+#endif
+}
+
+}
+
+}
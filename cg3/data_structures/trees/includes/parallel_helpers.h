@@ -0,0 +1,35 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_TREEPARALLELHELPERS_H
+#define CG3_TREEPARALLELHELPERS_H
+
+#include <vector>
+
+namespace cg3 {
+
+namespace internal {
+
+/* Threshold (number of elements) under which the work is done serially */
+
+static const unsigned long long int TREE_PARALLEL_THRESHOLD = 4096;
+
+
+/* Fork-join helpers (OpenMP tasks, serial if OpenMP is not enabled) */
+
+template <class F>
+inline void runParallelTasksHelper(F function);
+
+template <class RandomIt, class Compare>
+inline void parallelSortHelper(RandomIt first, RandomIt last, Compare comparator);
+
+}
+
+}
+
+#include "parallel_helpers.cpp"
+
+#endif // CG3_TREEPARALLELHELPERS_H
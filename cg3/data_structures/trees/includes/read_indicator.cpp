@@ -0,0 +1,65 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "read_indicator.h"
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Default constructor, no active readers
+ */
+CG3_INLINE ReadIndicator::ReadIndicator()
+{
+    for (unsigned int i = 0; i < NUMBER_OF_SLOTS; i++)
+        slots[i].counter.store(0);
+}
+
+/**
+ * @brief Register a reader
+ */
+CG3_INLINE void ReadIndicator::arrive()
+{
+    slots[slotIndex()].counter.fetch_add(1);
+}
+
+/**
+ * @brief Unregister a reader (it must be called by the same thread
+ * which called arrive())
+ */
+CG3_INLINE void ReadIndicator::depart()
+{
+    slots[slotIndex()].counter.fetch_sub(1);
+}
+
+/**
+ * @brief Check if there are no active readers
+ * @return True if no reader is registered
+ */
+CG3_INLINE bool ReadIndicator::isEmpty() const
+{
+    for (unsigned int i = 0; i < NUMBER_OF_SLOTS; i++) {
+        if (slots[i].counter.load() != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Slot of the calling thread
+ */
+CG3_INLINE unsigned int ReadIndicator::slotIndex()
+{
+    //Slots are assigned round-robin to the threads at their first read
+    static std::atomic<unsigned int> nextSlot(0);
+    static thread_local const unsigned int index = nextSlot.fetch_add(1) % NUMBER_OF_SLOTS;
+    return index;
+}
+
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_READINDICATOR_H
+#define CG3_READINDICATOR_H
+
+#include <atomic>
+
+#include <cg3/cg3lib.h>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Counter of the active readers, split on several cache lines
+ * to reduce the contention between reader threads.
+ * Each thread always uses the same slot.
+ */
+class ReadIndicator
+{
+
+public:
+
+    ReadIndicator();
+
+    ReadIndicator(const ReadIndicator&) = delete;
+    ReadIndicator& operator= (const ReadIndicator&) = delete;
+
+    void arrive();
+    void depart();
+
+    bool isEmpty() const;
+
+protected:
+
+    static const unsigned int NUMBER_OF_SLOTS = 32;
+
+    struct alignas(64) Slot {
+        std::atomic<long long int> counter;
+    };
+
+    Slot slots[NUMBER_OF_SLOTS];
+
+    static unsigned int slotIndex();
+
+};
+
+}
+
+}
+
+#ifndef CG3_STATIC
+#define CG3_READ_INDICATOR_CPP "read_indicator.cpp"
+#include CG3_READ_INDICATOR_CPP
+#undef CG3_READ_INDICATOR_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_READINDICATOR_H
@@ -0,0 +1,435 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "kdtree.h"
+
+#include <algorithm>
+
+namespace cg3 {
+
+template <int D, class P>
+const typename KDTree<D,P>::Index KDTree<D,P>::NullIndex;
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] leafSize Maximum number of points stored in a leaf
+ */
+template <int D, class P>
+KDTree<D,P>::KDTree(unsigned int leafSize) :
+    leafSize(std::max(leafSize, 1u))
+{
+
+}
+
+/**
+ * @brief Constructor with the points to be indexed
+ *
+ * @param[in] points Vector of points
+ * @param[in] leafSize Maximum number of points stored in a leaf
+ */
+template <int D, class P>
+KDTree<D,P>::KDTree(const std::vector<P>& points, unsigned int leafSize) :
+    leafSize(std::max(leafSize, 1u))
+{
+    this->construction(points);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the KD-tree given the points.
+ *
+ * A clear operation is performed before the construction. Each node is split
+ * on the median of the dimension with the largest extent.
+ *
+ * @param[in] points Vector of points
+ */
+template <int D, class P>
+void KDTree<D,P>::construction(const std::vector<P>& points)
+{
+    this->clear();
+
+    if (points.empty())
+        return;
+
+    //Coordinates in input order, used during the construction
+    coords.resize(points.size());
+    indices.resize(points.size());
+    for (Index i = 0; i < points.size(); i++) {
+        coords[i] = toCoords(points[i]);
+        indices[i] = i;
+    }
+
+    nodes.reserve(2 * (points.size() / leafSize + 1));
+    buildHelper(0, (Index) points.size());
+
+    //Permute coordinates in tree order, so that leaves are contiguous
+    std::vector<Coords> sortedCoords(coords.size());
+    for (Index i = 0; i < indices.size(); i++) {
+        sortedCoords[i] = coords[indices[i]];
+    }
+    coords.swap(sortedCoords);
+}
+
+/**
+ * @brief Clear the KD-tree
+ */
+template <int D, class P>
+void KDTree<D,P>::clear()
+{
+    nodes.clear();
+    coords.clear();
+    indices.clear();
+}
+
+/**
+ * @brief Get the number of indexed points
+ * @return Number of points
+ */
+template <int D, class P>
+size_t KDTree<D,P>::size() const
+{
+    return indices.size();
+}
+
+/**
+ * @brief Check if the KD-tree is empty
+ * @return True if the KD-tree is empty
+ */
+template <int D, class P>
+bool KDTree<D,P>::empty() const
+{
+    return indices.empty();
+}
+
+/**
+ * @brief Find the nearest point to a query point
+ *
+ * @param[in] query Query point
+ * @param[out] sqDist If not null, squared distance of the nearest point
+ * @return Index of the nearest point in the construction vector, NullIndex
+ * if the tree is empty
+ */
+template <int D, class P>
+typename KDTree<D,P>::Index KDTree<D,P>::nearestNeighbour(
+        const P& query,
+        double* sqDist) const
+{
+    Index index = NullIndex;
+    double dist = std::numeric_limits<double>::max();
+
+    kNearestNeighbours(query, 1, &index, &dist);
+
+    if (sqDist != nullptr)
+        *sqDist = dist;
+
+    return index;
+}
+
+/**
+ * @brief Find the k nearest points to a query point.
+ *
+ * Results are written in caller-owned buffers of (at least) k elements,
+ * sorted by increasing distance. No allocation is performed.
+ *
+ * @param[in] query Query point
+ * @param[in] k Number of neighbours
+ * @param[out] outIndices Buffer of k elements for the indices of the points
+ * @param[out] outSqDistances Buffer of k elements for the squared distances
+ * @return Number of neighbours found (less than k only if size() < k)
+ */
+template <int D, class P>
+unsigned int KDTree<D,P>::kNearestNeighbours(
+        const P& query,
+        unsigned int k,
+        Index* outIndices,
+        double* outSqDistances) const
+{
+    if (nodes.empty() || k == 0)
+        return 0;
+
+    unsigned int found = 0;
+    kNearestNeighboursHelper(0, toCoords(query), k, found, outIndices, outSqDistances);
+
+    return found;
+}
+
+/**
+ * @brief Find the k nearest points to a query point.
+ *
+ * @param[in] query Query point
+ * @param[in] k Number of neighbours
+ * @param[out] outIndices Indices of the points, sorted by increasing distance
+ * @return Number of neighbours found
+ */
+template <int D, class P>
+unsigned int KDTree<D,P>::kNearestNeighbours(
+        const P& query,
+        unsigned int k,
+        std::vector<Index>& outIndices) const
+{
+    std::vector<double> sqDistances(k);
+    outIndices.resize(k);
+
+    unsigned int found = kNearestNeighbours(query, k, outIndices.data(), sqDistances.data());
+    outIndices.resize(found);
+
+    return found;
+}
+
+/**
+ * @brief Find all the points within a given distance from a query point
+ *
+ * The output vector is cleared but its capacity is kept, so it can be
+ * reused between queries without reallocations.
+ *
+ * @param[in] query Query point
+ * @param[in] radius Radius of the search
+ * @param[out] outIndices Indices of the points (not sorted)
+ * @return Number of points found
+ */
+template <int D, class P>
+unsigned int KDTree<D,P>::radiusSearch(
+        const P& query,
+        double radius,
+        std::vector<Index>& outIndices) const
+{
+    outIndices.clear();
+
+    if (!nodes.empty() && radius >= 0)
+        radiusSearchHelper(0, toCoords(query), radius * radius, outIndices);
+
+    return (unsigned int) outIndices.size();
+}
+
+/**
+ * @brief Batched k nearest neighbours query, computed in parallel.
+ *
+ * The output buffers contain k entries for each query (row-major): the
+ * neighbours of the i-th query start at i*k. Missing neighbours are set
+ * to NullIndex and to the maximum double value.
+ *
+ * @param[in] queries Query points
+ * @param[in] k Number of neighbours
+ * @param[out] outIndices Indices of the neighbours
+ * @param[out] outSqDistances Squared distances of the neighbours
+ */
+template <int D, class P>
+void KDTree<D,P>::batchKNearestNeighbours(
+        const std::vector<P>& queries,
+        unsigned int k,
+        std::vector<Index>& outIndices,
+        std::vector<double>& outSqDistances) const
+{
+    outIndices.resize(queries.size() * k);
+    outSqDistances.resize(queries.size() * k);
+
+    const long long int nQueries = (long long int) queries.size();
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long int i = 0; i < nQueries; i++) {
+        Index* ind = outIndices.data() + i*k;
+        double* dist = outSqDistances.data() + i*k;
+
+        unsigned int found = kNearestNeighbours(queries[i], k, ind, dist);
+        for (unsigned int j = found; j < k; j++) {
+            ind[j] = NullIndex;
+            dist[j] = std::numeric_limits<double>::max();
+        }
+    }
+}
+
+/**
+ * @brief Batched radius search, computed in parallel.
+ *
+ * @param[in] queries Query points
+ * @param[in] radius Radius of the search
+ * @param[out] outIndices For each query, the indices of the points found
+ */
+template <int D, class P>
+void KDTree<D,P>::batchRadiusSearch(
+        const std::vector<P>& queries,
+        double radius,
+        std::vector<std::vector<Index>>& outIndices) const
+{
+    outIndices.resize(queries.size());
+
+    const long long int nQueries = (long long int) queries.size();
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long int i = 0; i < nQueries; i++) {
+        radiusSearch(queries[i], radius, outIndices[i]);
+    }
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Recursive construction of the subtree of the points in [begin, end)
+ *
+ * @param[in] begin Start index (in the indices vector)
+ * @param[in] end End index (in the indices vector)
+ * @return Index of the created node
+ */
+template <int D, class P>
+typename KDTree<D,P>::Index KDTree<D,P>::buildHelper(Index begin, Index end)
+{
+    Index nodeId = (Index) nodes.size();
+    nodes.push_back(Node());
+    nodes[nodeId].begin = begin;
+    nodes[nodeId].end = end;
+    nodes[nodeId].left = NullIndex;
+    nodes[nodeId].right = NullIndex;
+    nodes[nodeId].splitDim = 0;
+    nodes[nodeId].splitValue = 0;
+
+    if (end - begin <= leafSize)
+        return nodeId;
+
+    //Dimension with the largest extent
+    Coords min = coords[indices[begin]];
+    Coords max = min;
+    for (Index i = begin + 1; i < end; i++) {
+        const Coords& c = coords[indices[i]];
+        for (int d = 0; d < D; d++) {
+            min[d] = std::min(min[d], c[d]);
+            max[d] = std::max(max[d], c[d]);
+        }
+    }
+    int splitDim = 0;
+    for (int d = 1; d < D; d++) {
+        if (max[d] - min[d] > max[splitDim] - min[splitDim])
+            splitDim = d;
+    }
+
+    //Median split
+    Index mid = begin + (end - begin) / 2;
+    std::nth_element(
+                indices.begin() + begin,
+                indices.begin() + mid,
+                indices.begin() + end,
+                [&](Index a, Index b) { return coords[a][splitDim] < coords[b][splitDim]; });
+
+    nodes[nodeId].splitDim = splitDim;
+    nodes[nodeId].splitValue = coords[indices[mid]][splitDim];
+
+    Index left = buildHelper(begin, mid);
+    Index right = buildHelper(mid, end);
+    nodes[nodeId].left = left;
+    nodes[nodeId].right = right;
+
+    return nodeId;
+}
+
+/**
+ * @brief Recursive k nearest neighbours search. The output buffers
+ * are kept sorted by increasing distance.
+ */
+template <int D, class P>
+void KDTree<D,P>::kNearestNeighboursHelper(
+        Index nodeId,
+        const Coords& q,
+        unsigned int k,
+        unsigned int& found,
+        Index* outIndices,
+        double* outSqDistances) const
+{
+    const Node& node = nodes[nodeId];
+
+    //Leaf: check all the points
+    if (node.left == NullIndex) {
+        for (Index i = node.begin; i < node.end; i++) {
+            double dist = sqDistance(q, coords[i]);
+
+            if (found < k || dist < outSqDistances[found-1]) {
+                //Insertion in the sorted buffers
+                unsigned int pos = (found < k) ? found++ : k-1;
+                while (pos > 0 && outSqDistances[pos-1] > dist) {
+                    outSqDistances[pos] = outSqDistances[pos-1];
+                    outIndices[pos] = outIndices[pos-1];
+                    pos--;
+                }
+                outSqDistances[pos] = dist;
+                outIndices[pos] = indices[i];
+            }
+        }
+        return;
+    }
+
+    double diff = q[node.splitDim] - node.splitValue;
+    Index nearNode = diff < 0 ? node.left : node.right;
+    Index farNode = diff < 0 ? node.right : node.left;
+
+    kNearestNeighboursHelper(nearNode, q, k, found, outIndices, outSqDistances);
+
+    if (found < k || diff*diff < outSqDistances[found-1])
+        kNearestNeighboursHelper(farNode, q, k, found, outIndices, outSqDistances);
+}
+
+/**
+ * @brief Recursive radius search
+ */
+template <int D, class P>
+void KDTree<D,P>::radiusSearchHelper(
+        Index nodeId,
+        const Coords& q,
+        double sqRadius,
+        std::vector<Index>& outIndices) const
+{
+    const Node& node = nodes[nodeId];
+
+    //Leaf: check all the points
+    if (node.left == NullIndex) {
+        for (Index i = node.begin; i < node.end; i++) {
+            if (sqDistance(q, coords[i]) <= sqRadius)
+                outIndices.push_back(indices[i]);
+        }
+        return;
+    }
+
+    double diff = q[node.splitDim] - node.splitValue;
+
+    if (diff < 0 || diff*diff <= sqRadius)
+        radiusSearchHelper(node.left, q, sqRadius, outIndices);
+    if (diff >= 0 || diff*diff <= sqRadius)
+        radiusSearchHelper(node.right, q, sqRadius, outIndices);
+}
+
+/**
+ * @brief Get the coordinates of a point
+ */
+template <int D, class P>
+typename KDTree<D,P>::Coords KDTree<D,P>::toCoords(const P& p)
+{
+    Coords c;
+    for (int d = 0; d < D; d++)
+        c[d] = p[d];
+    return c;
+}
+
+/**
+ * @brief Squared distance between two coordinate arrays
+ */
+template <int D, class P>
+double KDTree<D,P>::sqDistance(const Coords& a, const Coords& b)
+{
+    double dist = 0;
+    for (int d = 0; d < D; d++) {
+        double diff = a[d] - b[d];
+        dist += diff * diff;
+    }
+    return dist;
+}
+
+}
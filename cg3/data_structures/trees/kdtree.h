@@ -0,0 +1,143 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_KDTREE_H
+#define CG3_KDTREE_H
+
+#include <vector>
+#include <array>
+#include <limits>
+
+#include <cg3/geometry/point2.h>
+#include <cg3/geometry/point3.h>
+
+namespace cg3 {
+
+/**
+ * @brief Static KD-tree for nearest neighbour and radius searches
+ * on a set of D-dimensional points.
+ *
+ * The tree stores a copy of the coordinates in a flat array (permuted in
+ * tree order), so queries do not touch the input vector. Points are identified
+ * by their index in the vector used for the construction.
+ * All the query methods are const and can be called concurrently from
+ * several threads; batched queries are parallelized with OpenMP.
+ *
+ * P is any point type with an operator[] returning the i-th coordinate
+ * (e.g. cg3::Point2d, cg3::Point3d).
+ */
+template <int D, class P>
+class KDTree
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef unsigned int Index;
+
+    static const Index NullIndex = std::numeric_limits<Index>::max();
+
+
+    /* Constructors */
+
+    explicit KDTree(unsigned int leafSize = 16);
+    explicit KDTree(const std::vector<P>& points, unsigned int leafSize = 16);
+
+
+    /* Public methods */
+
+    void construction(const std::vector<P>& points);
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+
+    Index nearestNeighbour(const P& query, double* sqDist = nullptr) const;
+
+    unsigned int kNearestNeighbours(
+            const P& query,
+            unsigned int k,
+            Index* outIndices,
+            double* outSqDistances) const;
+    unsigned int kNearestNeighbours(
+            const P& query,
+            unsigned int k,
+            std::vector<Index>& outIndices) const;
+
+    unsigned int radiusSearch(
+            const P& query,
+            double radius,
+            std::vector<Index>& outIndices) const;
+
+    void batchKNearestNeighbours(
+            const std::vector<P>& queries,
+            unsigned int k,
+            std::vector<Index>& outIndices,
+            std::vector<double>& outSqDistances) const;
+
+    void batchRadiusSearch(
+            const std::vector<P>& queries,
+            double radius,
+            std::vector<std::vector<Index>>& outIndices) const;
+
+protected:
+
+    /* Node of the flat tree */
+
+    struct Node {
+        Index begin;      // first point (tree order) of the node
+        Index end;        // one past the last point of the node
+        Index left;       // child indices in the node vector (NullIndex for leaves)
+        Index right;
+        int splitDim;
+        double splitValue;
+    };
+
+    typedef std::array<double, D> Coords;
+
+
+    /* Protected fields */
+
+    std::vector<Node> nodes;
+    std::vector<Coords> coords;  // coordinates in tree order
+    std::vector<Index> indices;  // tree order -> input index
+
+    unsigned int leafSize;
+
+
+    /* Protected methods */
+
+    Index buildHelper(Index begin, Index end);
+
+    void kNearestNeighboursHelper(
+            Index nodeId,
+            const Coords& q,
+            unsigned int k,
+            unsigned int& found,
+            Index* outIndices,
+            double* outSqDistances) const;
+
+    void radiusSearchHelper(
+            Index nodeId,
+            const Coords& q,
+            double sqRadius,
+            std::vector<Index>& outIndices) const;
+
+    inline static Coords toCoords(const P& p);
+    inline static double sqDistance(const Coords& a, const Coords& b);
+
+};
+
+typedef KDTree<2, Point2d> KDTree2d;
+typedef KDTree<3, Point3d> KDTree3d;
+
+}
+
+
+#include "kdtree.cpp"
+
+#endif // CG3_KDTREE_H
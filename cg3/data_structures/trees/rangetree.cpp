@@ -161,34 +161,10 @@ void RangeTree<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
 
     //Sort the collection
     internal::PairComparator<K,T> pairComparator(comparator);
-    std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
+    internal::parallelSortHelper(sortedVec.begin(), sortedVec.end(), pairComparator);
 
-    //Create nodes
-    std::vector<Node*> sortedNodes;
-    for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
-        sortedNodes.push_back(node);
-    }
-
-    //Calling the bottom up helper
-    this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
-                sortedNodes,
-                this->root,
-                comparator);
-
-    //Update the height of nodes and create their AABBs
-    for (Node*& node : sortedNodes) {
-        if (node != nullptr && node->isLeaf()) {
-            //Update height
-            internal::updateHeightHelper(node);
-
-            //Create associate trees climbing on parents
-            this->createParentAssociatedTreeHelper(node);
-
-            //Insert new node into associated range trees of the node and the parents
-            this->insertIntoParentAssociatedTreesHelper(node, node->key, *(node->value));
-        }
-    }
+    //Bottom up construction of the tree and of the associated range trees
+    this->constructionFromSortedHelper(sortedVec);
 
     assert(this->dim < 2 || this->root->assRangeTree->size() == this->size());
 }
@@ -812,6 +788,101 @@ void RangeTree<K,T,C>::rangeSearchInNextDimensionHelper(
 
 
 
+/* ----- CONSTRUCTION HELPERS ----- */
+
+/**
+ * @brief Construction of the range tree given the entries sorted with
+ * the comparator of the current dimension
+ *
+ * The balanced tree is built in parallel, then the associated range trees
+ * are built bottom up: the entries of each subtree, sorted on the next
+ * dimension, are obtained merging the ones of the children, so no
+ * associated tree needs to sort its input.
+ *
+ * @param[in] sortedVec Sorted vector of pairs of keys/values
+ */
+template <class K, class T, class C>
+void RangeTree<K,T,C>::constructionFromSortedHelper(
+        const std::vector<std::pair<K,T>>& sortedVec)
+{
+    //Create nodes
+    const long long int numberOfNodes = (long long int) sortedVec.size();
+    std::vector<Node*> sortedNodes(sortedVec.size());
+    #pragma omp parallel for if (numberOfNodes > (long long int) internal::TREE_PARALLEL_THRESHOLD)
+    for (long long int i = 0; i < numberOfNodes; i++) {
+        sortedNodes[i] = new Node(sortedVec[i].first, sortedVec[i].second);
+    }
+
+    //Calling the parallel construction helper, which sets the height of the nodes
+    this->entries = internal::constructionParallelHelperLeaf<Node,K,C>(
+                sortedNodes,
+                this->root,
+                comparator,
+                [](Node* node) {
+                    node->height = 1 + std::max(internal::getHeightHelper(node->left),
+                                                internal::getHeightHelper(node->right));
+                });
+
+    //Create associated range trees
+    if (this->dim > 1 && this->root != nullptr) {
+        std::vector<std::pair<K,T>> rootEntries;
+        internal::runParallelTasksHelper([&]() {
+            this->createAssociatedTreesBottomUpHelper(this->root, rootEntries);
+        });
+    }
+}
+
+/**
+ * @brief Create the associated range trees of a subtree, children before
+ * parents. Subtrees are processed in parallel (fork-join).
+ *
+ * @param[in] node Root of the subtree
+ * @param[out] sortedEntries Entries of the subtree, sorted with the
+ * comparator of the next dimension
+ */
+template <class K, class T, class C>
+void RangeTree<K,T,C>::createAssociatedTreesBottomUpHelper(
+        Node* node,
+        std::vector<std::pair<K,T>>& sortedEntries)
+{
+    if (node->isLeaf()) {
+        sortedEntries.assign(1, std::make_pair(node->key, *(node->value)));
+    }
+    else {
+        std::vector<std::pair<K,T>> leftEntries;
+        std::vector<std::pair<K,T>> rightEntries;
+
+        //Subtrees with more than TREE_PARALLEL_THRESHOLD leaves are forked
+        if ((1ull << node->height) > internal::TREE_PARALLEL_THRESHOLD) {
+            Node* leftChild = node->left;
+            #pragma omp task shared(leftEntries) firstprivate(leftChild)
+            this->createAssociatedTreesBottomUpHelper(leftChild, leftEntries);
+
+            this->createAssociatedTreesBottomUpHelper(node->right, rightEntries);
+
+            #pragma omp taskwait
+        }
+        else {
+            this->createAssociatedTreesBottomUpHelper(node->left, leftEntries);
+            this->createAssociatedTreesBottomUpHelper(node->right, rightEntries);
+        }
+
+        //Merge the entries of the children
+        internal::PairComparator<K,T> nextPairComparator(this->customComparators[this->dim-2]);
+        sortedEntries.resize(leftEntries.size() + rightEntries.size());
+        std::merge(
+                    leftEntries.begin(), leftEntries.end(),
+                    rightEntries.begin(), rightEntries.end(),
+                    sortedEntries.begin(),
+                    nextPairComparator);
+    }
+
+    node->assRangeTree = new RangeTree<K,T,C>(this->dim-1, this->customComparators);
+    node->assRangeTree->constructionFromSortedHelper(sortedEntries);
+}
+
+
+
 /* ----- HELPERS FOR ASSOCIATED RANGE TREE ----- */
 
 /**
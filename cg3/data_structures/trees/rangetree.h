@@ -185,6 +185,17 @@ protected:
 
 
 
+    /* Construction helpers */
+
+    void constructionFromSortedHelper(
+            const std::vector<std::pair<K,T>>& sortedVec);
+
+    void createAssociatedTreesBottomUpHelper(
+            Node* node,
+            std::vector<std::pair<K,T>>& sortedEntries);
+
+
+
     /* Helpers for associate range trees */
 
     inline void createAssociatedTreeHelper(
@@ -0,0 +1,689 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "triangle_bvh.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace cg3 {
+
+namespace internal {
+
+/* Number of bins used to evaluate the surface area heuristic */
+static const unsigned int TRIANGLE_BVH_BINS = 16;
+
+/* Subtrees with less triangles than this are never built in parallel */
+static const unsigned int TRIANGLE_BVH_PARALLEL_THRESHOLD = 4096;
+
+/* Classification of a node with respect to a convex region */
+enum TriangleBVHNodeClass { BVH_OUTSIDE, BVH_INTERSECTING, BVH_INSIDE };
+
+}
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] leafSize Maximum number of triangles stored in a leaf
+ */
+CG3_INLINE TriangleBVH::TriangleBVH(unsigned int leafSize) :
+    nVertices(0),
+    leafSize(std::max(leafSize, 1u))
+{
+
+}
+
+/**
+ * @brief Constructor with the mesh to be indexed
+ *
+ * @param[in] coords Coordinates of the vertices (3 for each vertex)
+ * @param[in] nVertices Number of vertices
+ * @param[in] triangles Indices of the vertices of the triangles (3 for each triangle)
+ * @param[in] nTriangles Number of triangles
+ * @param[in] leafSize Maximum number of triangles stored in a leaf
+ */
+CG3_INLINE TriangleBVH::TriangleBVH(
+        const double* coords,
+        unsigned int nVertices,
+        const int* triangles,
+        unsigned int nTriangles,
+        unsigned int leafSize) :
+    nVertices(0),
+    leafSize(std::max(leafSize, 1u))
+{
+    this->construction(coords, nVertices, triangles, nTriangles);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the hierarchy given the mesh.
+ *
+ * A clear operation is performed before the construction. The top levels
+ * of the hierarchy are built serially, then the subtrees are built in
+ * parallel and appended to the flat array of nodes.
+ *
+ * @param[in] coords Coordinates of the vertices (3 for each vertex)
+ * @param[in] nVertices Number of vertices
+ * @param[in] triangles Indices of the vertices of the triangles (3 for each triangle)
+ * @param[in] nTriangles Number of triangles
+ */
+CG3_INLINE void TriangleBVH::construction(
+        const double* coords,
+        unsigned int nVertices,
+        const int* triangles,
+        unsigned int nTriangles)
+{
+    this->clear();
+    this->nVertices = nVertices;
+
+    if (nTriangles == 0)
+        return;
+
+    //Coordinates in input order, bounding boxes that are sorted during the construction
+    this->coords.resize(nTriangles);
+    this->vertices.resize(nTriangles);
+    this->primitives.resize(nTriangles);
+
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int) nTriangles; i++) {
+        BuildPrimitive& p = primitives[i];
+        p.triangle = (Index) i;
+        for (unsigned int k = 0; k < 3; k++) {
+            p.min[k] = std::numeric_limits<double>::max();
+            p.max[k] = -std::numeric_limits<double>::max();
+        }
+        for (unsigned int j = 0; j < 3; j++) {
+            Index v = (Index) triangles[3*i+j];
+            this->vertices[i][j] = v;
+            for (unsigned int k = 0; k < 3; k++) {
+                this->coords[i][3*j+k] = coords[3*v+k];
+                p.min[k] = std::min(p.min[k], coords[3*v+k]);
+                p.max[k] = std::max(p.max[k], coords[3*v+k]);
+            }
+        }
+    }
+
+    //Top levels, until subtrees are small enough to keep all the threads busy
+    unsigned int nThreads = 1;
+    #ifdef _OPENMP
+    nThreads = (unsigned int) omp_get_max_threads();
+    #endif
+    Index deferSize = std::max(
+                nTriangles / (8 * nThreads),
+                internal::TRIANGLE_BVH_PARALLEL_THRESHOLD);
+    std::vector<DeferredNode> deferred;
+    nodes.reserve(2 * (nTriangles / leafSize + 1));
+    buildHelper(nodes, 0, nTriangles, deferSize, &deferred);
+
+    //Deferred subtrees
+    std::vector<std::vector<Node>> subtrees(deferred.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long int i = 0; i < (long long int) deferred.size(); i++) {
+        subtrees[i].reserve(2 * ((deferred[i].end - deferred[i].begin) / leafSize + 1));
+        buildHelper(subtrees[i], deferred[i].begin, deferred[i].end, 0, nullptr);
+    }
+
+    //The root of each subtree replaces its placeholder, the other nodes are appended
+    for (size_t i = 0; i < deferred.size(); i++) {
+        const std::vector<Node>& subtree = subtrees[i];
+        const Index offset = (Index) nodes.size() - 1;
+        for (size_t j = 0; j < subtree.size(); j++) {
+            Node node = subtree[j];
+            if (node.left != NullIndex) {
+                node.left += offset;
+                node.right += offset;
+            }
+            if (j == 0)
+                nodes[deferred[i].node] = node;
+            else
+                nodes.push_back(node);
+        }
+    }
+
+    //Permute coordinates and vertices in tree order, so that leaves are contiguous
+    std::vector<TriangleCoords> sortedCoords(nTriangles);
+    std::vector<TriangleVertices> sortedVertices(nTriangles);
+    indices.resize(nTriangles);
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int) nTriangles; i++) {
+        indices[i] = primitives[i].triangle;
+        sortedCoords[i] = this->coords[indices[i]];
+        sortedVertices[i] = this->vertices[indices[i]];
+    }
+    this->coords.swap(sortedCoords);
+    this->vertices.swap(sortedVertices);
+
+    std::vector<BuildPrimitive>().swap(primitives);
+}
+
+/**
+ * @brief Clear the hierarchy
+ */
+CG3_INLINE void TriangleBVH::clear()
+{
+    nodes.clear();
+    coords.clear();
+    vertices.clear();
+    indices.clear();
+    primitives.clear();
+    nVertices = 0;
+}
+
+/**
+ * @brief Get the number of triangles
+ * @return Number of triangles
+ */
+CG3_INLINE size_t TriangleBVH::size() const
+{
+    return indices.size();
+}
+
+/**
+ * @brief Check if the hierarchy is empty
+ * @return True if it does not contain any triangle
+ */
+CG3_INLINE bool TriangleBVH::empty() const
+{
+    return indices.empty();
+}
+
+/**
+ * @brief Get the number of vertices of the indexed mesh
+ * @return Number of vertices
+ */
+CG3_INLINE unsigned int TriangleBVH::numberVertices() const
+{
+    return nVertices;
+}
+
+/**
+ * @brief Get the bounding box of the triangles
+ * @return Bounding box (not valid if the hierarchy is empty)
+ */
+CG3_INLINE BoundingBox3 TriangleBVH::boundingBox() const
+{
+    if (nodes.empty())
+        return BoundingBox3();
+    const Node& root = nodes[0];
+    return BoundingBox3(
+                Point3d(root.min[0], root.min[1], root.min[2]),
+                Point3d(root.max[0], root.max[1], root.max[2]));
+}
+
+/**
+ * @brief Closest intersection between a ray and the triangles.
+ *
+ * Both sides of the triangles are intersected. Children are visited in
+ * front-to-back order, and nodes farther than the closest hit found so far
+ * are skipped.
+ *
+ * @param[in] origin Origin of the ray
+ * @param[in] dir Direction of the ray (not necessarily normalized)
+ * @param[out] hit Closest intersection; t is expressed in units of dir
+ * @param[in] tMin Minimum parameter of the ray
+ * @param[in] tMax Maximum parameter of the ray
+ * @return True if the ray intersects a triangle
+ */
+CG3_INLINE bool TriangleBVH::rayIntersection(
+        const Point3d& origin,
+        const Vec3d& dir,
+        RayHit& hit,
+        double tMin,
+        double tMax) const
+{
+    if (nodes.empty())
+        return false;
+
+    const double o[3] = {origin.x(), origin.y(), origin.z()};
+    const double d[3] = {dir.x(), dir.y(), dir.z()};
+    const double invDir[3] = {1.0 / d[0], 1.0 / d[1], 1.0 / d[2]};
+
+    bool found = false;
+    double closest = tMax;
+
+    std::vector<Index> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!rayNodeIntersection(node, o, invDir, tMin, closest))
+            continue;
+
+        if (node.left == NullIndex) {
+            for (Index i = node.begin; i < node.end; i++) {
+                double t, u, v;
+                if (rayTriangleIntersection(coords[i], o, d, t, u, v) &&
+                        t >= tMin && t < closest)
+                {
+                    closest = t;
+                    hit.triangle = indices[i];
+                    hit.t = t;
+                    hit.u = u;
+                    hit.v = v;
+                    found = true;
+                }
+            }
+        }
+        else {
+            //The nearest child is pushed last, to be visited first
+            Index first = node.left, second = node.right;
+            const Node& l = nodes[first];
+            const Node& r = nodes[second];
+            unsigned int axis = 0;
+            double extent = -1;
+            for (unsigned int k = 0; k < 3; k++) {
+                if (node.max[k] - node.min[k] > extent) {
+                    extent = node.max[k] - node.min[k];
+                    axis = k;
+                }
+            }
+            if ((d[axis] >= 0) == (l.min[axis] + l.max[axis] > r.min[axis] + r.max[axis]))
+                std::swap(first, second);
+            stack.push_back(second);
+            stack.push_back(first);
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Triangles contained in a convex region
+ *
+ * Nodes outside the region are culled, and all the triangles of nodes
+ * entirely inside the region are reported without being tested.
+ *
+ * @param[in] region Convex region, as an intersection of half-spaces
+ * @param[out] outTriangles Indices of the triangles, in increasing order
+ * @param[in] completely If true, triangles must have all their vertices
+ * inside the region; otherwise at least one vertex is enough
+ */
+CG3_INLINE void TriangleBVH::trianglesInside(
+        const std::vector<HalfSpace>& region,
+        std::vector<Index>& outTriangles,
+        bool completely) const
+{
+    outTriangles.clear();
+    if (nodes.empty())
+        return;
+
+    std::vector<Index> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+
+        int c = classifyNode(node, region);
+        if (c == internal::BVH_OUTSIDE)
+            continue;
+
+        if (c == internal::BVH_INSIDE) {
+            outTriangles.insert(outTriangles.end(), indices.begin() + node.begin, indices.begin() + node.end);
+        }
+        else if (node.left == NullIndex) {
+            for (Index i = node.begin; i < node.end; i++) {
+                unsigned int nInside = 0;
+                for (unsigned int j = 0; j < 3; j++)
+                    nInside += pointInside(&coords[i][3*j], region) ? 1 : 0;
+                if (nInside == 3 || (!completely && nInside > 0))
+                    outTriangles.push_back(indices[i]);
+            }
+        }
+        else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    std::sort(outTriangles.begin(), outTriangles.end());
+}
+
+/**
+ * @brief Vertices contained in a convex region. Only the vertices
+ * of at least a triangle are considered.
+ *
+ * @param[in] region Convex region, as an intersection of half-spaces
+ * @param[out] outVertices Indices of the vertices, in increasing order
+ */
+CG3_INLINE void TriangleBVH::verticesInside(
+        const std::vector<HalfSpace>& region,
+        std::vector<Index>& outVertices) const
+{
+    outVertices.clear();
+    if (nodes.empty())
+        return;
+
+    std::vector<bool> inside(nVertices, false);
+    std::vector<Index> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+
+        int c = classifyNode(node, region);
+        if (c == internal::BVH_OUTSIDE)
+            continue;
+
+        if (c == internal::BVH_INSIDE || node.left == NullIndex) {
+            for (Index i = node.begin; i < node.end; i++) {
+                for (unsigned int j = 0; j < 3; j++) {
+                    if (!inside[vertices[i][j]] &&
+                            (c == internal::BVH_INSIDE || pointInside(&coords[i][3*j], region)))
+                    {
+                        inside[vertices[i][j]] = true;
+                    }
+                }
+            }
+        }
+        else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    for (Index v = 0; v < nVertices; v++) {
+        if (inside[v])
+            outVertices.push_back(v);
+    }
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Recursive construction of the subtree of the triangles
+ * from begin to end (tree order).
+ *
+ * @param[out] nodes Vector in which the nodes are stored
+ * @param[in] begin First triangle
+ * @param[in] end One past the last triangle
+ * @param[in] deferSize Subtrees with at most this number of triangles are
+ * not built, but added to the deferred subtrees
+ * @param[out] deferred Deferred subtrees (nullptr to build everything)
+ * @return Index of the root of the subtree
+ */
+CG3_INLINE TriangleBVH::Index TriangleBVH::buildHelper(
+        std::vector<Node>& nodes,
+        Index begin,
+        Index end,
+        Index deferSize,
+        std::vector<DeferredNode>* deferred)
+{
+    Node node;
+    node.begin = begin;
+    node.end = end;
+    node.left = NullIndex;
+    node.right = NullIndex;
+    for (unsigned int k = 0; k < 3; k++) {
+        node.min[k] = std::numeric_limits<double>::max();
+        node.max[k] = -std::numeric_limits<double>::max();
+    }
+    for (Index i = begin; i < end; i++) {
+        for (unsigned int k = 0; k < 3; k++) {
+            node.min[k] = std::min(node.min[k], primitives[i].min[k]);
+            node.max[k] = std::max(node.max[k], primitives[i].max[k]);
+        }
+    }
+
+    const Index nodeId = (Index) nodes.size();
+    nodes.push_back(node);
+
+    if (end - begin <= leafSize)
+        return nodeId;
+
+    if (deferred != nullptr && end - begin <= deferSize) {
+        deferred->push_back(DeferredNode{nodeId, begin, end});
+        return nodeId;
+    }
+
+    Index mid = partitionHelper(node);
+
+    Index left = buildHelper(nodes, begin, mid, deferSize, deferred);
+    Index right = buildHelper(nodes, mid, end, deferSize, deferred);
+    nodes[nodeId].left = left;
+    nodes[nodeId].right = right;
+
+    return nodeId;
+}
+
+/**
+ * @brief Partition of the triangles of a node in two children.
+ *
+ * Centroids of the bounding boxes are binned along the axis of largest extent, and the split
+ * between two bins with the lowest surface area heuristic cost is chosen.
+ * If all the centroids are coincident, triangles are split in halves.
+ *
+ * @param[in] node Node to be split
+ * @return First triangle of the right child
+ */
+CG3_INLINE TriangleBVH::Index TriangleBVH::partitionHelper(const Node& node)
+{
+    const unsigned int nBins = internal::TRIANGLE_BVH_BINS;
+
+    double cMin[3], cMax[3];
+    for (unsigned int k = 0; k < 3; k++) {
+        cMin[k] = std::numeric_limits<double>::max();
+        cMax[k] = -std::numeric_limits<double>::max();
+    }
+    for (Index i = node.begin; i < node.end; i++) {
+        for (unsigned int k = 0; k < 3; k++) {
+            double c = primitives[i].min[k] + primitives[i].max[k];
+            cMin[k] = std::min(cMin[k], c);
+            cMax[k] = std::max(cMax[k], c);
+        }
+    }
+
+    unsigned int axis = 0;
+    for (unsigned int k = 1; k < 3; k++) {
+        if (cMax[k] - cMin[k] > cMax[axis] - cMin[axis])
+            axis = k;
+    }
+
+    if (cMax[axis] <= cMin[axis])
+        return node.begin + (node.end - node.begin) / 2;
+
+    const double scale = nBins / (cMax[axis] - cMin[axis]);
+    auto binOf = [&](const BuildPrimitive& p) {
+        double c = p.min[axis] + p.max[axis];
+        unsigned int b = (unsigned int) ((c - cMin[axis]) * scale);
+        return std::min(b, nBins - 1);
+    };
+
+    //Number of triangles and bounding box of each bin
+    unsigned int counts[internal::TRIANGLE_BVH_BINS] = {};
+    double bMin[internal::TRIANGLE_BVH_BINS][3], bMax[internal::TRIANGLE_BVH_BINS][3];
+    for (unsigned int b = 0; b < nBins; b++) {
+        for (unsigned int k = 0; k < 3; k++) {
+            bMin[b][k] = std::numeric_limits<double>::max();
+            bMax[b][k] = -std::numeric_limits<double>::max();
+        }
+    }
+    for (Index i = node.begin; i < node.end; i++) {
+        const BuildPrimitive& p = primitives[i];
+        const unsigned int b = binOf(p);
+        counts[b]++;
+        for (unsigned int k = 0; k < 3; k++) {
+            bMin[b][k] = std::min(bMin[b][k], p.min[k]);
+            bMax[b][k] = std::max(bMax[b][k], p.max[k]);
+        }
+    }
+
+    auto area = [](const double* mi, const double* ma) {
+        double e[3] = {ma[0] - mi[0], ma[1] - mi[1], ma[2] - mi[2]};
+        return e[0] * e[1] + e[1] * e[2] + e[2] * e[0];
+    };
+
+    //Cost of the splits, sweeping from the right and then from the left
+    double rightCost[internal::TRIANGLE_BVH_BINS];
+    double accMin[3], accMax[3];
+    unsigned int accCount = 0;
+    for (unsigned int k = 0; k < 3; k++) {
+        accMin[k] = std::numeric_limits<double>::max();
+        accMax[k] = -std::numeric_limits<double>::max();
+    }
+    for (unsigned int b = nBins - 1; b > 0; b--) {
+        accCount += counts[b];
+        for (unsigned int k = 0; k < 3; k++) {
+            accMin[k] = std::min(accMin[k], bMin[b][k]);
+            accMax[k] = std::max(accMax[k], bMax[b][k]);
+        }
+        rightCost[b] = accCount > 0 ? accCount * area(accMin, accMax) : 0;
+    }
+
+    unsigned int bestSplit = 1;
+    double bestCost = std::numeric_limits<double>::max();
+    accCount = 0;
+    for (unsigned int k = 0; k < 3; k++) {
+        accMin[k] = std::numeric_limits<double>::max();
+        accMax[k] = -std::numeric_limits<double>::max();
+    }
+    for (unsigned int b = 1; b < nBins; b++) {
+        accCount += counts[b-1];
+        for (unsigned int k = 0; k < 3; k++) {
+            accMin[k] = std::min(accMin[k], bMin[b-1][k]);
+            accMax[k] = std::max(accMax[k], bMax[b-1][k]);
+        }
+        double cost = (accCount > 0 ? accCount * area(accMin, accMax) : 0) + rightCost[b];
+        if (accCount > 0 && accCount < node.end - node.begin && cost < bestCost) {
+            bestCost = cost;
+            bestSplit = b;
+        }
+    }
+
+    std::vector<BuildPrimitive>::iterator mid = std::partition(
+                primitives.begin() + node.begin,
+                primitives.begin() + node.end,
+                [&](const BuildPrimitive& p) { return binOf(p) < bestSplit; });
+
+    return (Index) (mid - primitives.begin());
+}
+
+/**
+ * @brief Classification of the bounding box of a node with respect to a
+ * convex region: outside if it is entirely outside of a half-space, inside
+ * if it is entirely inside of all the half-spaces, intersecting otherwise.
+ * Boxes crossing the corners of the region may be classified as
+ * intersecting even if they are outside.
+ *
+ * @param[in] node Node
+ * @param[in] region Convex region
+ * @return Class of the node (internal::TriangleBVHNodeClass)
+ */
+CG3_INLINE int TriangleBVH::classifyNode(
+        const Node& node,
+        const std::vector<HalfSpace>& region)
+{
+    bool inside = true;
+    for (const HalfSpace& h : region) {
+        double farthest = h[3], nearest = h[3];
+        for (unsigned int k = 0; k < 3; k++) {
+            if (h[k] >= 0) {
+                farthest += h[k] * node.max[k];
+                nearest += h[k] * node.min[k];
+            }
+            else {
+                farthest += h[k] * node.min[k];
+                nearest += h[k] * node.max[k];
+            }
+        }
+        if (farthest < 0)
+            return internal::BVH_OUTSIDE;
+        if (nearest < 0)
+            inside = false;
+    }
+    return inside ? internal::BVH_INSIDE : internal::BVH_INTERSECTING;
+}
+
+/**
+ * @brief Check if a point is inside a convex region
+ */
+CG3_INLINE bool TriangleBVH::pointInside(
+        const double* p,
+        const std::vector<HalfSpace>& region)
+{
+    for (const HalfSpace& h : region) {
+        if (h[0] * p[0] + h[1] * p[1] + h[2] * p[2] + h[3] < 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Slab test between a ray and the bounding box of a node
+ */
+CG3_INLINE bool TriangleBVH::rayNodeIntersection(
+        const Node& node,
+        const double* origin,
+        const double* invDir,
+        double tMin,
+        double tMax)
+{
+    for (unsigned int k = 0; k < 3; k++) {
+        double t0 = (node.min[k] - origin[k]) * invDir[k];
+        double t1 = (node.max[k] - origin[k]) * invDir[k];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        //comparisons written in this way ignore NaNs (ray parallel to a slab, starting on it)
+        tMin = t0 > tMin ? t0 : tMin;
+        tMax = t1 < tMax ? t1 : tMax;
+        if (tMin > tMax)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Moller-Trumbore intersection between a ray and a triangle
+ * (both sides)
+ */
+CG3_INLINE bool TriangleBVH::rayTriangleIntersection(
+        const TriangleCoords& tri,
+        const double* origin,
+        const double* dir,
+        double& t,
+        double& u,
+        double& v)
+{
+    const double e1[3] = {tri[3] - tri[0], tri[4] - tri[1], tri[5] - tri[2]};
+    const double e2[3] = {tri[6] - tri[0], tri[7] - tri[1], tri[8] - tri[2]};
+    const double p[3] = {
+        dir[1] * e2[2] - dir[2] * e2[1],
+        dir[2] * e2[0] - dir[0] * e2[2],
+        dir[0] * e2[1] - dir[1] * e2[0]};
+    const double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    if (det == 0)
+        return false;
+    const double invDet = 1.0 / det;
+
+    const double s[3] = {origin[0] - tri[0], origin[1] - tri[1], origin[2] - tri[2]};
+    u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+    if (u < 0 || u > 1)
+        return false;
+
+    const double q[3] = {
+        s[1] * e1[2] - s[2] * e1[1],
+        s[2] * e1[0] - s[0] * e1[2],
+        s[0] * e1[1] - s[1] * e1[0]};
+    v = (dir[0] * q[0] + dir[1] * q[1] + dir[2] * q[2]) * invDet;
+    if (v < 0 || u + v > 1)
+        return false;
+
+    t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+    return true;
+}
+
+}
@@ -0,0 +1,181 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_TRIANGLE_BVH_H
+#define CG3_TRIANGLE_BVH_H
+
+#include <vector>
+#include <array>
+#include <limits>
+
+#include <cg3/geometry/point3.h>
+#include <cg3/geometry/bounding_box3.h>
+
+namespace cg3 {
+
+/**
+ * @brief Static bounding volume hierarchy on the triangles of an indexed mesh,
+ * for ray casting and for queries on convex regions (e.g. view frustums).
+ *
+ * The hierarchy is built with the surface area heuristic on binned centroids,
+ * and it is stored in a flat array of nodes. Coordinates of the triangles are
+ * copied in tree order, so queries do not touch the input arrays.
+ * Triangles and vertices are identified by their indices in the input arrays.
+ * All the query methods are const and can be called concurrently.
+ */
+class TriangleBVH
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef unsigned int Index;
+
+    /**
+     * @brief Closest intersection of a ray with the triangles.
+     * The intersection point is
+     * (1-u-v) * v0 + u * v1 + v * v2 = origin + t * dir.
+     */
+    struct RayHit {
+        Index triangle;
+        double t;
+        double u;
+        double v;
+    };
+
+    /**
+     * @brief Half-space of the points p such that
+     * h[0]*p.x() + h[1]*p.y() + h[2]*p.z() + h[3] >= 0.
+     * Convex regions are intersections of half-spaces.
+     */
+    typedef std::array<double, 4> HalfSpace;
+
+
+    /* Constructors */
+
+    explicit TriangleBVH(unsigned int leafSize = 4);
+    TriangleBVH(
+            const double* coords,
+            unsigned int nVertices,
+            const int* triangles,
+            unsigned int nTriangles,
+            unsigned int leafSize = 4);
+
+
+    /* Public methods */
+
+    void construction(
+            const double* coords,
+            unsigned int nVertices,
+            const int* triangles,
+            unsigned int nTriangles);
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+    unsigned int numberVertices() const;
+    BoundingBox3 boundingBox() const;
+
+    bool rayIntersection(
+            const Point3d& origin,
+            const Vec3d& dir,
+            RayHit& hit,
+            double tMin = 0,
+            double tMax = std::numeric_limits<double>::max()) const;
+
+    void trianglesInside(
+            const std::vector<HalfSpace>& region,
+            std::vector<Index>& outTriangles,
+            bool completely = true) const;
+    void verticesInside(
+            const std::vector<HalfSpace>& region,
+            std::vector<Index>& outVertices) const;
+
+protected:
+
+    /* Node of the flat tree */
+
+    struct Node {
+        double min[3];
+        double max[3];
+        Index begin;      // first triangle (tree order) of the node
+        Index end;        // one past the last triangle of the node
+        Index left;       // child indices in the node vector (NullIndex for leaves)
+        Index right;
+    };
+
+    /* Subtree whose construction has been deferred, to be built in parallel */
+    struct DeferredNode {
+        Index node;
+        Index begin;
+        Index end;
+    };
+
+    /* Bounding box of a triangle, used only during the construction */
+    struct BuildPrimitive {
+        double min[3];
+        double max[3];
+        Index triangle;
+    };
+
+    typedef std::array<double, 9> TriangleCoords;
+    typedef std::array<Index, 3> TriangleVertices;
+
+    static const Index NullIndex = std::numeric_limits<Index>::max();
+
+
+    /* Protected fields */
+
+    std::vector<Node> nodes;
+    std::vector<TriangleCoords> coords;      // coordinates in tree order
+    std::vector<TriangleVertices> vertices;  // input vertex indices, in tree order
+    std::vector<Index> indices;              // tree order -> input index
+    unsigned int nVertices;
+
+    unsigned int leafSize;
+
+    //Used only during the construction, in tree order
+    std::vector<BuildPrimitive> primitives;
+
+
+    /* Protected methods */
+
+    Index buildHelper(
+            std::vector<Node>& nodes,
+            Index begin,
+            Index end,
+            Index deferSize,
+            std::vector<DeferredNode>* deferred);
+    Index partitionHelper(const Node& node);
+
+    static int classifyNode(const Node& node, const std::vector<HalfSpace>& region);
+    inline static bool pointInside(const double* p, const std::vector<HalfSpace>& region);
+    inline static bool rayNodeIntersection(
+            const Node& node,
+            const double* origin,
+            const double* invDir,
+            double tMin,
+            double tMax);
+    inline static bool rayTriangleIntersection(
+            const TriangleCoords& tri,
+            const double* origin,
+            const double* dir,
+            double& t,
+            double& u,
+            double& v);
+
+};
+
+}
+
+#ifndef CG3_STATIC
+#define CG3_TRIANGLE_BVH_CPP "triangle_bvh.cpp"
+#include CG3_TRIANGLE_BVH_CPP
+#undef CG3_TRIANGLE_BVH_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_TRIANGLE_BVH_H
@@ -12,6 +12,8 @@
 #include <igl/vertex_triangle_adjacency.h>
 #include <igl/adjacency_list.h>
 
+#include <algorithm>
+
 namespace cg3 {
 namespace libigl {
 namespace internal {
@@ -33,18 +35,50 @@ CG3_INLINE std::vector<SimpleEigenMesh> EigenMeshLibIglAlgorithms::connectedComp
     Eigen::MatrixXi FF = mm.F;
     igl::facet_components(FF, C);
     ///
-    for (unsigned int i = 0; i < C.size(); i++){
-        if (C(i) >= (int)connectedComponents.size()){
-            assert(C(i) == (int)connectedComponents.size());
-            SimpleEigenMesh m;
-            m.V = mm.V;
-            connectedComponents.push_back(m);
+    if (C.size() == 0)
+        return connectedComponents;
+
+    //faces sorted by component
+    const int nComponents = C.maxCoeff() + 1;
+    std::vector<int> firstFace(nComponents + 1, 0);
+    for (int i = 0; i < C.size(); i++)
+        firstFace[C(i) + 1]++;
+    for (int c = 0; c < nComponents; c++)
+        firstFace[c + 1] += firstFace[c];
+    std::vector<int> faces(C.size());
+    std::vector<int> position(firstFace.begin(), firstFace.end() - 1);
+    for (int i = 0; i < C.size(); i++)
+        faces[position[C(i)]++] = i;
+
+    //vertices of every component keep their relative order
+    std::vector<int> stamp(mm.V.rows(), -1);
+    std::vector<int> localId(mm.V.rows());
+    std::vector<int> vertices;
+    connectedComponents.resize(nComponents);
+    for (int c = 0; c < nComponents; c++){
+        vertices.clear();
+        for (int i = firstFace[c]; i < firstFace[c + 1]; i++){
+            for (unsigned int j = 0; j < 3; j++){
+                int v = mm.F(faces[i], j);
+                if (stamp[v] != c){
+                    stamp[v] = c;
+                    vertices.push_back(v);
+                }
+            }
+        }
+        std::sort(vertices.begin(), vertices.end());
+
+        SimpleEigenMesh& m = connectedComponents[c];
+        m.V.resize(vertices.size(), 3);
+        for (unsigned int i = 0; i < vertices.size(); i++){
+            localId[vertices[i]] = i;
+            m.V.row(i) = mm.V.row(vertices[i]);
+        }
+        m.F.resize(firstFace[c + 1] - firstFace[c], 3);
+        for (int i = firstFace[c]; i < firstFace[c + 1]; i++){
+            for (unsigned int j = 0; j < 3; j++)
+                m.F(i - firstFace[c], j) = localId[mm.F(faces[i], j)];
         }
-        connectedComponents[C(i)].addFace(mm.F.row(i));
-    }
-    for (unsigned int i = 0; i < connectedComponents.size(); i++){
-        Eigen::Matrix<int, Eigen::Dynamic, 1> I;
-        removeUnreferencedVertices(connectedComponents[i], I);
     }
     return connectedComponents;
 }
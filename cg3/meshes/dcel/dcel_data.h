@@ -31,6 +31,36 @@ protected:
 	std::vector<Vec3d> faceNormals;
 	std::vector<Color> faceColors;
 	#endif
+
+	//Modifications
+	//Recorded by the setters of vertices and faces (in release mode) only if
+	//the vectors have been sized by the user of the Dcel (see DrawableDcel),
+	//which is responsible to reset them.
+	enum {
+		COORDINATE_MODIFIED = 0b001,
+		NORMAL_MODIFIED     = 0b010,
+		COLOR_MODIFIED      = 0b100
+	};
+	std::vector<unsigned char> vertexModifications; //indexed by vertex id
+	std::vector<unsigned char> faceModifications;   //indexed by face id
+	bool topologyModified = true; //elements added/removed or connectivity changed
+
+	void markVertexModified(unsigned int vid, unsigned char modification)
+	{
+		if (vid < vertexModifications.size())
+			vertexModifications[vid] |= modification;
+	}
+
+	void markFaceModified(unsigned int fid, unsigned char modification)
+	{
+		if (fid < faceModifications.size())
+			faceModifications[fid] |= modification;
+	}
+
+	void markTopologyModified()
+	{
+		topologyModified = true;
+	}
 };
 
 } //namespace cg3::internal
@@ -234,6 +234,7 @@ CG3_INLINE void Face::setNormal(const Vec3d& newNormal)
 {
 	#ifdef NDEBUG
 	parent->faceNormals[_id] = newNormal;
+	parent->markFaceModified(_id, internal::DcelData::NORMAL_MODIFIED);
 	#else
 	_normal = newNormal;
 	#endif
@@ -258,6 +259,7 @@ CG3_INLINE void Face::setColor(const Color& newColor)
 {
 	#ifdef NDEBUG
 	parent->faceColors[_id] = newColor;
+	parent->markFaceModified(_id, internal::DcelData::COLOR_MODIFIED);
 	#else
 	_color = newColor;
 	#endif
@@ -281,6 +283,9 @@ CG3_INLINE HalfEdge* Face::outerHalfEdge()
 CG3_INLINE void Face::setOuterHalfEdge(HalfEdge* newOuterHalfEdge)
 {
 	_outerHalfEdge = newOuterHalfEdge;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 /**
@@ -291,6 +296,9 @@ CG3_INLINE void Face::setOuterHalfEdge(HalfEdge* newOuterHalfEdge)
 CG3_INLINE void Face::addInnerHalfEdge(HalfEdge* newInnerHalfEdge)
 {
 	_innerHalfEdges.push_back(newInnerHalfEdge);
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 /**
@@ -577,6 +585,7 @@ CG3_INLINE Vec3d Face::updateNormal()
         std::cerr << "Warning: degenerate triangle/polygon; ID: " << id() << "\n";
     #ifdef NDEBUG
     parent->faceNormals[_id] = normal;
+    parent->markFaceModified(_id, internal::DcelData::NORMAL_MODIFIED);
     #else
     this->_normal = normal;
     #endif
@@ -635,6 +644,9 @@ CG3_INLINE double Face::updateArea()
 CG3_INLINE void Face::removeInnerHalfEdge(const Face::InnerHalfEdgeIterator& iterator)
 {
     _innerHalfEdges.erase(iterator);
+    #ifdef NDEBUG
+    parent->markTopologyModified();
+    #endif
 }
 
 /**
@@ -651,6 +663,9 @@ CG3_INLINE bool Face::removeInnerHalfEdge(const HalfEdge* halfEdge)
     InnerHalfEdgeIterator i = std::find(_innerHalfEdges.begin(), _innerHalfEdges.end(), halfEdge);
     if (i != _innerHalfEdges.end()){
         _innerHalfEdges.erase(i);
+        #ifdef NDEBUG
+        parent->markTopologyModified();
+        #endif
         return true;
     }
     return false;
@@ -658,6 +673,9 @@ CG3_INLINE bool Face::removeInnerHalfEdge(const HalfEdge* halfEdge)
 
 CG3_INLINE void Face::removeAllInnerHalfEdges() {
     _innerHalfEdges.clear();
+    #ifdef NDEBUG
+    parent->markTopologyModified();
+    #endif
 }
 
 CG3_INLINE void Face::invertOrientation()
@@ -1139,6 +1157,9 @@ CG3_INLINE void Face::deserialize(std::ifstream& binaryFile)
 CG3_INLINE void Face::setId(unsigned int id)
 {
 	this->_id = id;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 /**
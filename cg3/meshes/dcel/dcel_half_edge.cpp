@@ -317,6 +317,9 @@ CG3_INLINE Face* HalfEdge::face()
 CG3_INLINE void HalfEdge::setFromVertex(Vertex* newFromVertex)
 {
 	_fromVertex = newFromVertex;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 /**
@@ -327,6 +330,9 @@ CG3_INLINE void HalfEdge::setFromVertex(Vertex* newFromVertex)
 CG3_INLINE void HalfEdge::setToVertex(Vertex* newToVertex)
 {
 	_toVertex = newToVertex;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 /**
@@ -347,6 +353,9 @@ CG3_INLINE void HalfEdge::setTwin(HalfEdge* newTwin)
 CG3_INLINE void HalfEdge::setPrev(HalfEdge* newPrev)
 {
 	_prev = newPrev;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 /**
@@ -357,6 +366,9 @@ CG3_INLINE void HalfEdge::setPrev(HalfEdge* newPrev)
 CG3_INLINE void HalfEdge::setNext(HalfEdge* newNext)
 {
 	_next = newNext;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 /**
@@ -367,6 +379,9 @@ CG3_INLINE void HalfEdge::setNext(HalfEdge* newNext)
 CG3_INLINE void HalfEdge::setFace(Face* newFace)
 {
 	_face = newFace;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 CG3_INLINE bool HalfEdge::isConvex() const {
@@ -478,6 +493,9 @@ CG3_INLINE void HalfEdge::deserialize(std::ifstream& binaryFile)
 CG3_INLINE void HalfEdge::setId(unsigned int id)
 {
 	this->_id = id;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 } //namespace cg3
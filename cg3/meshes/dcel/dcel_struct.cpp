@@ -13,6 +13,8 @@
 #include <cg3/io/load_save_file.h>
 #include <cg3/geometry/transformations3.h>
 
+#include <algorithm>
+
 #ifdef  CG3_CGAL_DEFINED
 #include <cg3/cgal/triangulation3.h>
 #endif //CGAL_DEFINED
@@ -865,6 +867,47 @@ double TemplatedDcel<V, HE, F>::averageHalfEdgesLength() const
     return average;
 }
 
+/**
+ * @brief Returns, for every vertex id, the id that the vertex would have after
+ * recalculateIds() (that is, its position in vertexIterator()), or -1 if the
+ * id is not used.
+ *
+ * Allows to map the vertices to the indices of arrays or of other mesh data
+ * structures without building maps.
+ *
+ * @par Complexity:
+ *      \e O(numVertices)
+ */
+template <class V, class HE, class F>
+std::vector<int> TemplatedDcel<V, HE, F>::compactVertexIds() const
+{
+    std::vector<int> ids(vertices.size(), -1);
+    int n = 0;
+    for (unsigned int i = 0; i < vertices.size(); i++)
+        if (vertices[i] != nullptr)
+            ids[i] = n++;
+    return ids;
+}
+
+/**
+ * @brief Returns, for every face id, the id that the face would have after
+ * recalculateIds() (that is, its position in faceIterator()), or -1 if the
+ * id is not used.
+ *
+ * @par Complexity:
+ *      \e O(numFaces)
+ */
+template <class V, class HE, class F>
+std::vector<int> TemplatedDcel<V, HE, F>::compactFaceIds() const
+{
+    std::vector<int> ids(faces.size(), -1);
+    int n = 0;
+    for (unsigned int i = 0; i < faces.size(); i++)
+        if (faces[i] != nullptr)
+            ids[i] = n++;
+    return ids;
+}
+
 /**
  * @brief Saves the mesh in a Wavefront OBJ file.
  *
@@ -1172,6 +1215,7 @@ bool TemplatedDcel<V, HE, F>::deleteVertex(typename TemplatedDcel::Vertex* v)
         }
         vertices[v->_id]=nullptr;
         unusedVids.insert(v->_id);
+        markTopologyModified();
         nVertices--;
 
         delete v;
@@ -1234,6 +1278,7 @@ bool TemplatedDcel<V, HE, F>::deleteHalfEdge(HalfEdge* he)
 				he->_fromVertex->_incidentHalfEdge = nullptr;
         halfEdges[he->_id] = nullptr;
         unusedHeids.insert(he->_id);
+        markTopologyModified();
         nHalfEdges--;
 
         delete he;
@@ -1287,6 +1332,7 @@ bool TemplatedDcel<V, HE, F>::deleteFace(Face* f)
         }
         faces[f->id()]=nullptr;
         unusedFids.insert(f->id());
+        markTopologyModified();
         nFaces--;
         delete f;
         return true;
@@ -1639,6 +1685,7 @@ void TemplatedDcel<V, HE, F>::clear()
     nVertices = 0;
     nFaces = 0;
     nHalfEdges = 0;
+    markTopologyModified();
     #ifdef NDEBUG
     vertexCoordinates.clear();
     vertexNormals.clear();
@@ -1893,9 +1940,7 @@ bool TemplatedDcel<V, HE, F>::loadFromObj(const std::string& filename)
     std::list<Color> vcolor, fcolor;
 
 	if (loadMeshFromObj(filename, coords, faces, fm, vnorm, vcolor, fcolor, fsizes)){
-        clear();
-		afterLoadFile(coords, faces, fm, vnorm, vcolor, fcolor, fsizes);
-        return true;
+		return afterLoadFile(coords, faces, fm, vnorm, vcolor, fcolor, fsizes);
     }
     else
         return false;
@@ -1925,9 +1970,7 @@ bool TemplatedDcel<V, HE, F>::loadFromPly(const std::string& filename)
     std::list<Color> vcolor, fcolor;
 
 	if (loadMeshFromPly(filename, coords, faces, mode, vnorm, vcolor, fcolor, fsizes)){
-        clear();
-		afterLoadFile(coords, faces, mode, vnorm, vcolor, fcolor, fsizes);
-        return true;
+		return afterLoadFile(coords, faces, mode, vnorm, vcolor, fcolor, fsizes);
     }
     else
 		return false;
@@ -1970,6 +2013,160 @@ bool TemplatedDcel<V, HE, F>::loadFromDcelFile(const std::string& filename)
     return true;
 }
 
+/**
+ * @brief Replaces the content of the Dcel with the mesh described by an
+ * indexed array of vertex coordinates and an array of face vertex indices.
+ *
+ * The vertex i will have id i and coordinates coords[3*i], coords[3*i+1] and
+ * coords[3*i+2]; the face j will have id j. If faceSizes is nullptr all the
+ * faces are triangles, otherwise the face j is made by the next faceSizes[j]
+ * indices of faceVertices.
+ *
+ * Half edges are linked through the indices of the arrays: the outgoing half
+ * edges of every vertex are sorted by destination, and the twin of a half edge
+ * is searched among the half edges outgoing from its destination vertex, so
+ * no map is built. Face normals and areas are computed in parallel; vertex
+ * normals are not computed (see updateVertexNormals()).
+ *
+ * @param[in] nv: number of vertices
+ * @param[in] coords: 3*nv vertex coordinates
+ * @param[in] nf: number of faces
+ * @param[in] faceVertices: vertex indices of the faces
+ * @param[in] faceSizes: number of vertices of every face, nullptr for triangle meshes
+ * @return false, leaving the Dcel empty, if a face has less than three
+ * vertices or a vertex index is out of range.
+ *
+ * @par Complexity:
+ *      \e O(numVertices) + \e O(numHalfEdges * log(maxCardinality))
+ */
+template <class V, class HE, class F>
+template <typename Index>
+bool TemplatedDcel<V, HE, F>::loadFromArrays(
+        unsigned int nv,
+        const double* coords,
+        unsigned int nf,
+        const Index* faceVertices,
+        const unsigned int* faceSizes)
+{
+    clear();
+
+    //first half edge of every face, and next half edge of every half edge
+    std::vector<unsigned int> firstHalfEdge(nf + 1, 0);
+    for (unsigned int i = 0; i < nf; i++){
+        unsigned int size = faceSizes == nullptr ? 3 : faceSizes[i];
+        if (size < 3)
+            return false;
+        firstHalfEdge[i+1] = firstHalfEdge[i] + size;
+    }
+    const unsigned int nhe = firstHalfEdge[nf];
+    for (unsigned int i = 0; i < nhe; i++){
+        if ((long long int)faceVertices[i] < 0 || (long long int)faceVertices[i] >= nv)
+            return false;
+    }
+    std::vector<unsigned int> next(nhe);
+    for (unsigned int i = 0; i < nf; i++){
+        for (unsigned int j = firstHalfEdge[i]; j < firstHalfEdge[i+1] - 1; j++)
+            next[j] = j + 1;
+        next[firstHalfEdge[i+1] - 1] = firstHalfEdge[i];
+    }
+
+    //half edges outgoing from every vertex
+    std::vector<unsigned int> firstOutgoing(nv + 1, 0);
+    for (unsigned int i = 0; i < nhe; i++)
+        firstOutgoing[faceVertices[i] + 1]++;
+    for (unsigned int i = 0; i < nv; i++)
+        firstOutgoing[i+1] += firstOutgoing[i];
+    std::vector<unsigned int> outgoing(nhe);
+    std::vector<unsigned int> position(firstOutgoing.begin(), firstOutgoing.end() - 1);
+    for (unsigned int i = 0; i < nhe; i++)
+        outgoing[position[faceVertices[i]]++] = i;
+
+    //outgoing half edges of every vertex sorted by destination, then by index
+    auto destination = [&](unsigned int h) {
+        return (unsigned int)faceVertices[next[h]];
+    };
+    #pragma omp parallel for
+    for (long long int v = 0; v < (long long int)nv; v++){
+        std::sort(outgoing.begin() + firstOutgoing[v], outgoing.begin() + firstOutgoing[v+1],
+                  [&](unsigned int h1, unsigned int h2) {
+            return std::make_pair(destination(h1), h1) < std::make_pair(destination(h2), h2);
+        });
+    }
+
+    //the k-th half edge a->b is the twin of the k-th half edge b->a
+    std::vector<int> twin(nhe, -1);
+    #pragma omp parallel for
+    for (long long int v = 0; v < (long long int)nv; v++){
+        const unsigned int a = (unsigned int)v;
+        for (unsigned int k = firstOutgoing[a]; k < firstOutgoing[a+1]; ){
+            const unsigned int b = destination(outgoing[k]);
+            unsigned int end = k + 1;
+            while (end < firstOutgoing[a+1] && destination(outgoing[end]) == b)
+                end++;
+            if (a != b){
+                //half edges b->a, contiguous in the outgoing list of b
+                auto cmp = [&](unsigned int h, unsigned int d) {
+                    return destination(h) < d;
+                };
+                unsigned int t = (unsigned int)(std::lower_bound(
+                            outgoing.begin() + firstOutgoing[b],
+                            outgoing.begin() + firstOutgoing[b+1], a, cmp) - outgoing.begin());
+                for (unsigned int r = k; r < end && t < firstOutgoing[b+1] && destination(outgoing[t]) == a; r++, t++)
+                    twin[outgoing[r]] = outgoing[t];
+            }
+            k = end;
+        }
+    }
+
+    vertices.reserve(nv);
+    halfEdges.reserve(nhe);
+    faces.reserve(nf);
+    #ifdef NDEBUG
+    vertexCoordinates.reserve(nv);
+    vertexNormals.reserve(nv);
+    vertexColors.reserve(nv);
+    faceNormals.reserve(nf);
+    faceColors.reserve(nf);
+    #endif
+
+    for (unsigned int i = 0; i < nv; i++){
+        Point3d coord(coords[3*i], coords[3*i+1], coords[3*i+2]);
+        if (i == 0) {
+            bBox.setMin(coord);
+            bBox.setMax(coord);
+        }
+        bBox.min() = bBox.min().min(coord);
+        bBox.max() = bBox.max().max(coord);
+        Vertex* v = addVertex(coord);
+        v->setCardinality(firstOutgoing[i+1] - firstOutgoing[i]);
+    }
+    for (unsigned int i = 0; i < nhe; i++)
+        addHalfEdge();
+
+    for (unsigned int i = 0; i < nf; i++){
+        Face* f = addFace();
+        f->setOuterHalfEdge(halfEdges[firstHalfEdge[i]]);
+        for (unsigned int j = firstHalfEdge[i]; j < firstHalfEdge[i+1]; j++){
+            HalfEdge* he = halfEdges[j];
+            Vertex* from = vertices[faceVertices[j]];
+            from->setIncidentHalfEdge(he);
+            he->setFromVertex(from);
+            he->setToVertex(vertices[faceVertices[next[j]]]);
+            he->setNext(halfEdges[next[j]]);
+            halfEdges[next[j]]->setPrev(he);
+            he->setFace(f);
+            if (twin[j] >= 0)
+                he->setTwin(halfEdges[twin[j]]);
+        }
+    }
+
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)nf; i++)
+        faces[i]->updateArea();
+
+    return true;
+}
+
 template <class V, class HE, class F>
 void TemplatedDcel<V, HE, F>::swap(TemplatedDcel& d)
 {
@@ -1983,6 +2180,8 @@ void TemplatedDcel<V, HE, F>::swap(TemplatedDcel& d)
     std::swap(nHalfEdges, d.nHalfEdges);
     std::swap(nFaces, d.nFaces);
     std::swap(bBox, d.bBox);
+    markTopologyModified();
+    d.markTopologyModified();
 
     #ifdef NDEBUG
     std::swap(vertexCoordinates, d.vertexCoordinates);
@@ -2529,7 +2728,7 @@ void TemplatedDcel<V, HE, F>::toStdVectors(
 		std::vector<unsigned int>& faceSizes,
 		std::vector<float>& faceColors) const
 {
-    std::map<int, int> mapVertices;
+    const std::vector<int> mapVertices = compactVertexIds();
     vertices.reserve(numberVertices()*3);
     verticesNormals.reserve(numberVertices()*3);
 	verticesColors.reserve(numberVertices()*3);
@@ -2538,7 +2737,6 @@ void TemplatedDcel<V, HE, F>::toStdVectors(
     faceSizes.reserve(numberFaces());
     faceColors.reserve(numberFaces()*3);
 
-    int iv = 0;
     for (const Vertex* v : vertexIterator()){
         vertices.push_back(v->coordinate().x());
         vertices.push_back(v->coordinate().y());
@@ -2549,13 +2747,12 @@ void TemplatedDcel<V, HE, F>::toStdVectors(
 		verticesColors.push_back(v->color().redF());
 		verticesColors.push_back(v->color().greenF());
 		verticesColors.push_back(v->color().blueF());
-        mapVertices[v->id()] = iv++;
     }
     for (const Face* f : faceIterator()){
         unsigned int size = 0;
         if (f->numberInnerHalfEdges() == 0) {
             for (const Vertex* v : f->incidentVertexIterator()){
-                assert(mapVertices.find(v->id()) != mapVertices.end());
+                assert(mapVertices[v->id()] >= 0);
                 faces.push_back(mapVertices[v->id()]);
                 size++;
             }
@@ -2564,7 +2761,7 @@ void TemplatedDcel<V, HE, F>::toStdVectors(
         else { // holes
             std::vector<const Vertex*> v = makeSingleBorder(f);
             for (unsigned int i = 0; i<v.size(); ++i) {
-                assert(mapVertices.find(v[i]->id()) != mapVertices.end());
+                assert(mapVertices[v[i]->id()] >= 0);
                 faces.push_back(mapVertices[v[i]->id()]);
             }
             size = (unsigned int)v.size();
@@ -2580,7 +2777,7 @@ void TemplatedDcel<V, HE, F>::toStdVectors(
 }
 
 template <class V, class HE, class F>
-void TemplatedDcel<V, HE, F>::afterLoadFile(
+bool TemplatedDcel<V, HE, F>::afterLoadFile(
         const std::list<double> &coords,
         const std::list<unsigned int> &faces,
 		const io::FileMeshMode& fm,
@@ -2589,199 +2786,54 @@ void TemplatedDcel<V, HE, F>::afterLoadFile(
         const std::list<Color> &fcolor,
         const std::list<unsigned int> &fsizes)
 {
-    std::vector<Vertex*> vertices;
-
-    std::map< std::pair<int,int>, HalfEdge* > edge;
-    typename std::map< std::pair<int,int>, HalfEdge* >::iterator eiter;
-
-    bool first = true;
-
-    std::list<double>::const_iterator vnit = vnorm.begin();
-    std::list<Color>::const_iterator vcit = vcolor.begin();
-    for (std::list<double>::const_iterator it = coords.begin(); it != coords.end(); ){
-        double x = *(it++), y = *(it++), z = *(it++);
-        Point3d coord(x,y,z);
-        if (first) {
-            bBox.setMin(coord);
-            bBox.setMax(coord);
-            first = false;
-        }
-        bBox.min() = bBox.min().min(coord);
-        bBox.max() = bBox.max().max(coord);
-
-        Vertex* vid = addVertex(coord);
+    std::vector<double> vcoords(coords.begin(), coords.end());
+    std::vector<unsigned int> vfaces(faces.begin(), faces.end());
+    std::vector<unsigned int> vfsizes(fsizes.begin(), fsizes.end());
+    unsigned int nindices = 0;
+    for (unsigned int size : vfsizes)
+        nindices += size;
+    if (nindices != vfaces.size())
+        return false;
 
-        vertices.push_back(vid);
+    if (!loadFromArrays(
+                (unsigned int)vcoords.size() / 3, vcoords.data(),
+                (unsigned int)vfsizes.size(), vfaces.data(), vfsizes.data()))
+        return false;
 
-		if (fm.hasVertexNormals()){
+    if (fm.hasVertexNormals()){
+        std::list<double>::const_iterator vnit = vnorm.begin();
+        for (Vertex* v : vertexIterator()){
             Vec3d norm;
             norm.setX(*(vnit++));
             norm.setY(*(vnit++));
             norm.setZ(*(vnit++));
-            vid->setNormal(norm);
-        }
-		if (fm.hasVertexColors()){
-            vid->setColor(*(vcit++));
+            v->setNormal(norm);
         }
     }
-
-    std::list<unsigned int>::const_iterator fit = faces.begin();
-    std::list<Color>::const_iterator fcit = fcolor.begin();
-    for (std::list<unsigned int>::const_iterator fsit = fsizes.begin(); fsit != fsizes.end(); ++fsit){
-
-        unsigned int thisSize = *fsit;
-        std::vector<unsigned int> nid;
-        nid.reserve(thisSize);
-        for (unsigned int i = 0; i < thisSize; i++){
-            nid.push_back(*(fit++));
-        }
-        nid.push_back(nid[0]);
-
-        std::pair<int, int> p;
-        HalfEdge* eid = nullptr;
-        Face* fid = addFace();
-        HalfEdge* prev = nullptr;
-        HalfEdge* first = nullptr;
-
-        for (unsigned int i=0; i<nid.size()-1; i++){
-            eid = addHalfEdge();
-            if (i==0) {
-                first = eid;
-                fid->setOuterHalfEdge(eid);
-            }
-            else {
-                eid->setPrev(prev);
-                prev->setNext(eid);
-            }
-            vertices[nid[i]]->setIncidentHalfEdge(eid);
-            eid->setFromVertex(vertices[nid[i]]);
-            vertices[nid[i]]->incrementCardinality();
-            eid->setToVertex(vertices[nid[i+1]]);
-            eid->setFace(fid);
-            p.first = nid[i+1];
-            p.second = nid[i];
-            eiter = edge.find(p);
-            if (eiter != edge.end()){
-                HalfEdge* twin = edge[p];
-                eid->setTwin(twin);
-                twin->setTwin(eid);
-                edge.erase(eiter);
-            }
-            else {
-                p.first = nid[i];
-                p.second = nid[i+1];
-                edge[p] = eid;
-            }
-            prev = eid;
-        }
-        eid->setNext(first);
-        first->setPrev(eid);
-
-		if (fm.hasFaceColors()){
-            Color c = *(fcit++);
-            fid->setColor(c);
-        }
-        else
-            fid->setColor(Color(128, 128, 128));
-
-        fid->updateNormal();
-        fid->updateArea();
+    if (fm.hasVertexColors()){
+        std::list<Color>::const_iterator vcit = vcolor.begin();
+        for (Vertex* v : vertexIterator())
+            v->setColor(*(vcit++));
+    }
+    if (fm.hasFaceColors()){
+        std::list<Color>::const_iterator fcit = fcolor.begin();
+        for (Face* f : faceIterator())
+            f->setColor(*(fcit++));
     }
 
-	if (! (fm.hasVertexNormals()))
+    if (! (fm.hasVertexNormals()))
         updateVertexNormals();
+    return true;
 }
 
 #ifdef  CG3_EIGENMESH_DEFINED
 template <class V, class HE, class F>
 void TemplatedDcel<V, HE, F>::copyFrom(const SimpleEigenMesh& eigenMesh)
 {
-    clear();
-
-    std::vector<Vertex*> vertices;
-
-    std::map< std::pair<int,int>, HalfEdge* > edge;
-    typename std::map< std::pair<int,int>, HalfEdge* >::iterator eiter;
-
-    bool first = true;
-
-
-    for (unsigned int i = 0; i < eigenMesh.numberVertices(); i++) {
-
-        Point3d coord = eigenMesh.vertex(i);
-
-        if (first) {
-            bBox.setMin(coord);
-            bBox.setMax(coord);
-            first = false;
-        }
-
-        if (coord.x() < bBox.minX()) bBox.setMinX(coord.x());
-        if (coord.y() < bBox.minY()) bBox.setMinY(coord.y());
-        if (coord.z() < bBox.minZ()) bBox.setMinZ(coord.z());
-
-        if (coord.x() > bBox.maxX()) bBox.setMaxX(coord.x());
-        if (coord.y() > bBox.maxY()) bBox.setMaxY(coord.y());
-        if (coord.z() > bBox.maxZ()) bBox.setMaxZ(coord.z());
-
-        Vertex* vid = addVertex(coord);
-
-        vertices.push_back(vid);
-    }
-
-    for (unsigned int i = 0; i < eigenMesh.numberFaces(); i++) {
-
-        std::vector<int> nid;
-        Point3i ff = eigenMesh.face(i);
-        nid.push_back(ff.x());
-        nid.push_back(ff.y());
-        nid.push_back(ff.z());
-        nid.push_back(nid[0]);
-        std::pair<int, int> p;
-        HalfEdge* eid = nullptr;
-        Face* fid = addFace();
-        HalfEdge* prev = nullptr;
-        HalfEdge* first = nullptr;
-
-        for (unsigned int i=0; i<nid.size()-1; i++){
-            eid = addHalfEdge();
-            if (i==0) {
-                first = eid;
-                fid->setOuterHalfEdge(eid);
-            }
-            else {
-                eid->setPrev(prev);
-                prev->setNext(eid);
-            }
-            vertices[nid[i]]->setIncidentHalfEdge(eid);
-            eid->setFromVertex(vertices[nid[i]]);
-            vertices[nid[i]]->incrementCardinality();
-            eid->setToVertex(vertices[nid[i+1]]);
-            eid->setFace(fid);
-            p.first = nid[i+1];
-            p.second = nid[i];
-            eiter = edge.find(p);
-            if (eiter != edge.end()){
-                HalfEdge* twin = edge[p];
-                eid->setTwin(twin);
-                twin->setTwin(eid);
-                edge.erase(eiter);
-            }
-            else {
-                p.first = nid[i];
-                p.second = nid[i+1];
-                edge[p] = eid;
-            }
-            prev = eid;
-        }
-        eid->setNext(first);
-        first->setPrev(eid);
-
-        fid->setColor(Color(128, 128, 128));
-
-        fid->updateNormal();
-        fid->updateArea();
-    }
+    //V and F are row major: coordinates and indices are contiguous
+    loadFromArrays(
+                eigenMesh.numberVertices(), eigenMesh.getVerticesMatrix().data(),
+                eigenMesh.numberFaces(), eigenMesh.getFacesMatrix().data());
 }
 
 template <class V, class HE, class F>
@@ -2803,92 +2855,22 @@ void TemplatedDcel<V, HE, F>::copyFrom(const EigenMesh& eigenMesh)
 template <class V, class HE, class F>
 void TemplatedDcel<V, HE, F>::copyFrom(const cinolib::Trimesh<> &trimesh)
 {
-    clear();
-
-    std::vector<Vertex*> vertices;
-
-    std::map< std::pair<int,int>, HalfEdge* > edge;
-    typename std::map< std::pair<int,int>, HalfEdge* >::iterator eiter;
-
-    bool first = true;
-
-
-    for (unsigned int i = 0; i < (unsigned int)trimesh.num_verts(); i++) {
-
-		Point3d coord(trimesh.vert(i));
-
-        if (first) {
-            bBox.setMin(coord);
-            bBox.setMax(coord);
-            first = false;
-        }
-
-        if (coord.x() < bBox.minX()) bBox.setMinX(coord.x());
-        if (coord.y() < bBox.minY()) bBox.setMinY(coord.y());
-        if (coord.z() < bBox.minZ()) bBox.setMinZ(coord.z());
-
-        if (coord.x() > bBox.maxX()) bBox.setMaxX(coord.x());
-        if (coord.y() > bBox.maxY()) bBox.setMaxY(coord.y());
-        if (coord.z() > bBox.maxZ()) bBox.setMaxZ(coord.z());
-
-        Vertex* vid = addVertex(coord);
-
-        vertices.push_back(vid);
-    }
-
-    for (unsigned int i = 0; i < (unsigned int)trimesh.num_polys(); i++) {
-
-        std::vector<int> nid;
-		Point3i ff(trimesh.poly_vert_id(i, 0), trimesh.poly_vert_id(i, 1), trimesh.poly_vert_id(i, 2));
-        nid.push_back(ff.x());
-        nid.push_back(ff.y());
-        nid.push_back(ff.z());
-        nid.push_back(nid[0]);
-        std::pair<int, int> p;
-        HalfEdge* eid = nullptr;
-        Face* fid = addFace();
-        HalfEdge* prev = nullptr;
-        HalfEdge* first = nullptr;
-
-        for (unsigned int i=0; i<nid.size()-1; i++){
-            eid = addHalfEdge();
-            if (i==0) {
-                first = eid;
-                fid->setOuterHalfEdge(eid);
-            }
-            else {
-                eid->setPrev(prev);
-                prev->setNext(eid);
-            }
-            vertices[nid[i]]->setIncidentHalfEdge(eid);
-            eid->setFromVertex(vertices[nid[i]]);
-            vertices[nid[i]]->incrementCardinality();
-            eid->setToVertex(vertices[nid[i+1]]);
-            eid->setFace(fid);
-            p.first = nid[i+1];
-            p.second = nid[i];
-            eiter = edge.find(p);
-            if (eiter != edge.end()){
-                HalfEdge* twin = edge[p];
-                eid->setTwin(twin);
-                twin->setTwin(eid);
-                edge.erase(eiter);
-            }
-            else {
-                p.first = nid[i];
-                p.second = nid[i+1];
-                edge[p] = eid;
-            }
-            prev = eid;
-        }
-        eid->setNext(first);
-        first->setPrev(eid);
-
-        fid->setColor(Color(128, 128, 128));
-
-        fid->updateNormal();
-        fid->updateArea();
-    }
+    const unsigned int nv = (unsigned int)trimesh.num_verts();
+    const unsigned int nf = (unsigned int)trimesh.num_polys();
+    std::vector<double> coords(nv * 3);
+    std::vector<unsigned int> tris(nf * 3);
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)nv; i++) {
+        coords[i*3]   = trimesh.vert(i).x();
+        coords[i*3+1] = trimesh.vert(i).y();
+        coords[i*3+2] = trimesh.vert(i).z();
+    }
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)nf; i++) {
+        for (unsigned int j = 0; j < 3; j++)
+            tris[i*3+j] = trimesh.poly_vert_id(i, j);
+    }
+    loadFromArrays(nv, coords.data(), nf, tris.data());
 }
 #endif //CG3_CINOLIB_DEFINED
 
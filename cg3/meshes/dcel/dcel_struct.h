@@ -177,6 +177,8 @@ public:
     double volume()                                         const;
     Point3d barycenter()                                  const;
     double averageHalfEdgesLength()                      const;
+    std::vector<int> compactVertexIds()                  const;
+    std::vector<int> compactFaceIds()                    const;
     bool saveOnObj(const std::string& fileNameObj) const;
     bool saveOnObj(const std::string& fileNameObj, bool saveProperties)             const;
 	bool saveOnPly(const std::string& fileNamePly, bool binary = true) const;
@@ -224,6 +226,13 @@ public:
     bool loadFromObj(const std::string& filename);
     bool loadFromPly(const std::string& filename);
     bool loadFromDcelFile(const std::string& filename);
+    template <typename Index>
+    bool loadFromArrays(
+            unsigned int nv,
+            const double* coords,
+            unsigned int nf,
+            const Index* faceVertices,
+            const unsigned int* faceSizes = nullptr);
 
     void swap(TemplatedDcel& d);
     void merge(const TemplatedDcel& d);
@@ -270,7 +279,7 @@ protected:
             std::vector<unsigned int> &faceSizes,
             std::vector<float> &faceColors) const;
 
-    void afterLoadFile(
+    bool afterLoadFile(
             const std::list<double>& coords,
             const std::list<unsigned int>& faces,
 			const io::FileMeshMode& fm,
@@ -201,6 +201,7 @@ CG3_INLINE void Vertex::setNormal(const Vec3d& newNormal)
 {
 	#ifdef NDEBUG
 	parent->vertexNormals[_id] = newNormal;
+	parent->markVertexModified(_id, internal::DcelData::NORMAL_MODIFIED);
 	#else
 	_normal = newNormal;
 	#endif
@@ -215,6 +216,7 @@ CG3_INLINE void Vertex::setCoordinate(const Point3d& newCoordinate)
 {
 	#ifdef NDEBUG
 	parent->vertexCoordinates[_id] = newCoordinate;
+	parent->markVertexModified(_id, internal::DcelData::COORDINATE_MODIFIED);
 	#else
 	_coordinate = newCoordinate;
 	#endif
@@ -233,6 +235,7 @@ CG3_INLINE void Vertex::setCardinality( int newCardinality )
 CG3_INLINE void Vertex::setColor(const Color& c) {
 	#ifdef NDEBUG
 	parent->vertexColors[_id] = c;
+	parent->markVertexModified(_id, internal::DcelData::COLOR_MODIFIED);
 	#else
 	_color = c;
 	#endif
@@ -402,6 +405,7 @@ CG3_INLINE Vec3d Vertex::updateNormal()
     }
     #ifdef NDEBUG
     parent->vertexNormals[_id] /= n;
+    parent->markVertexModified(_id, internal::DcelData::NORMAL_MODIFIED);
     #else
     _normal /= n;
     #endif
@@ -1254,6 +1258,9 @@ CG3_INLINE void Vertex::deserialize(std::ifstream& binaryFile)
 CG3_INLINE void Vertex::setId(unsigned int id)
 {
 	this->_id = id;
+	#ifdef NDEBUG
+	parent->markTopologyModified();
+	#endif
 }
 
 }
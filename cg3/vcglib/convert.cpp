@@ -100,17 +100,21 @@ void eigenToVCG(
 {
     vcgMesh.Clear();
 
-    vcg::tri::Allocator<PolyMeshType>::AddVertices(vcgMesh, V.rows());
-    for (int i = 0; i < V.rows(); i++) {
+    vcg::tri::Allocator<PolyMeshType>::AddVertices(vcgMesh, static_cast<size_t>(V.rows()));
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)V.rows(); i++) {
         typename PolyMeshType::CoordType vv(V(i,0), V(i,1), V(i,2));
         vcgMesh.vert[static_cast<size_t>(i)].P() = vv;
     }
 
+    //faces are filled directly from F, without copying its rows
     vcg::tri::Allocator<PolyMeshType>::AddFaces(vcgMesh, static_cast<size_t>(F.rows()));
+    const Eigen::Index numVertices = F.cols();
     for (int i = 0; i < F.rows(); i++) {
-        const Eigen::VectorXi& row = F.row(i);
-        Eigen::Index numVertices = row.size();
-        vcgMesh.face[static_cast<size_t>(i)].Alloc(numVertices);
+        vcgMesh.face[static_cast<size_t>(i)].Alloc(static_cast<int>(numVertices));
+    }
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)F.rows(); i++) {
         for (Eigen::Index j = 0; j < numVertices; j++) {
             vcgMesh.face[static_cast<size_t>(i)].V(j) = &(vcgMesh.vert[static_cast<size_t>(F(i,j))]);
         }
@@ -30,6 +30,12 @@ unix:!macx{
         LIBS += -lQGLViewer-qt5
     }
     LIBS += -lstdc++fs
+
+    #headless rendering: Mesa provides EGL also on machines without a GPU
+    exists(/usr/include/EGL/egl.h) {
+        DEFINES += CG3_EGL_DEFINED
+        LIBS += -lEGL
+    }
 }
 
 macx{
@@ -98,17 +104,22 @@ contains(DEFINES, CG3_VIEWER_DEFINED){
         $$PWD/viewer/glcanvas.h \
         $$PWD/viewer/mainwindow.h \
         $$PWD/viewer/drawable_objects/drawable_arrow3.h \
+        $$PWD/viewer/drawable_objects/drawable_arrows3.h \
         $$PWD/viewer/drawable_objects/drawable_bounding_box2.h \
         $$PWD/viewer/drawable_objects/drawable_bounding_box3.h \
         $$PWD/viewer/drawable_objects/drawable_cylinder.h \
+        $$PWD/viewer/drawable_objects/drawable_cylinders.h \
         $$PWD/viewer/drawable_objects/drawable_mixed_objects.h \
         $$PWD/viewer/drawable_objects/drawable_objects_container.h \
         $$PWD/viewer/drawable_objects/drawable_point2.h \
         $$PWD/viewer/drawable_objects/drawable_point3.h \
+        $$PWD/viewer/drawable_objects/drawable_points3.h \
         $$PWD/viewer/drawable_objects/drawable_polygon2.h \
         $$PWD/viewer/drawable_objects/drawable_segment2.h \
         $$PWD/viewer/drawable_objects/drawable_segment3.h \
+        $$PWD/viewer/drawable_objects/drawable_segments3.h \
         $$PWD/viewer/drawable_objects/drawable_sphere.h \
+        $$PWD/viewer/drawable_objects/drawable_spheres.h \
         $$PWD/viewer/drawable_objects/drawable_plane.h \
         $$PWD/viewer/drawable_objects/drawable_triangle3.h \
         $$PWD/viewer/interfaces/abstract_mainwindow.h \
@@ -117,35 +128,51 @@ contains(DEFINES, CG3_VIEWER_DEFINED){
         $$PWD/viewer/interfaces/manipulable_object.h \
         $$PWD/viewer/interfaces/pickable_object.h \
         $$PWD/viewer/interfaces/drawable_mesh.h \
+        $$PWD/viewer/opengl_objects/opengl_buffer.h \
+        $$PWD/viewer/opengl_objects/opengl_program.h \
+        $$PWD/viewer/opengl_objects/opengl_query.h \
         $$PWD/viewer/opengl_objects/opengl_objects2.h \
         $$PWD/viewer/opengl_objects/opengl_objects3.h \
         $$PWD/viewer/utilities/loadersaver.h \
         $$PWD/viewer/utilities/console_stream.h \
+        $$PWD/viewer/utilities/frame_profiler.h \
         $$PWD/viewer/utilities/utils.h \
+        $$PWD/viewer/utilities/picking.h \
         $$PWD/viewer/widgets/qclickablelabel.h \
         $$PWD/viewer/internal/drawable_mesh_drawlist_manager.h \
         $$PWD/viewer/internal/drawable_container_drawlist_manager.h \
         $$PWD/viewer/internal/drawable_object_drawlist_manager.h \
+        $$PWD/viewer/internal/instanced_primitives.h \
         $$PWD/viewer/internal/manipulable_object_drawlist_manager.h \
-        $$PWD/viewer/internal/submanager.h
+        $$PWD/viewer/internal/mesh_buffers.h \
+        $$PWD/viewer/internal/mesh_levels_of_detail.h \
+        $$PWD/viewer/internal/mesh_picker.h \
+        $$PWD/viewer/internal/submanager.h \
+        $$PWD/viewer/internal/vertex_batch.h \
+        $$PWD/viewer/internal/view_frustum.h
 
     CG3_STATIC {
     SOURCES += \
         $$PWD/viewer/glcanvas.cpp \
         $$PWD/viewer/mainwindow.cpp \
         $$PWD/viewer/drawable_objects/drawable_arrow3.cpp \
+        $$PWD/viewer/drawable_objects/drawable_arrows3.cpp \
         $$PWD/viewer/drawable_objects/drawable_bounding_box2.cpp \
         $$PWD/viewer/drawable_objects/drawable_bounding_box3.cpp \
         $$PWD/viewer/drawable_objects/drawable_cylinder.cpp \
+        $$PWD/viewer/drawable_objects/drawable_cylinders.cpp \
         $$PWD/viewer/drawable_objects/drawable_mixed_objects.cpp \
         $$PWD/viewer/drawable_objects/drawable_objects_container.cpp \
         $$PWD/viewer/drawable_objects/drawable_plane.cpp \
         $$PWD/viewer/drawable_objects/drawable_point2.cpp \
         $$PWD/viewer/drawable_objects/drawable_point3.cpp \
+        $$PWD/viewer/drawable_objects/drawable_points3.cpp \
         $$PWD/viewer/drawable_objects/drawable_polygon2.cpp \
         $$PWD/viewer/drawable_objects/drawable_segment2.cpp \
         $$PWD/viewer/drawable_objects/drawable_segment3.cpp \
+        $$PWD/viewer/drawable_objects/drawable_segments3.cpp \
         $$PWD/viewer/drawable_objects/drawable_sphere.cpp \
+        $$PWD/viewer/drawable_objects/drawable_spheres.cpp \
         $$PWD/viewer/drawable_objects/drawable_triangle3.cpp \
         $$PWD/viewer/interfaces/drawable_container.cpp \
         $$PWD/viewer/interfaces/drawable_mesh.cpp \
@@ -153,18 +180,50 @@ contains(DEFINES, CG3_VIEWER_DEFINED){
         $$PWD/viewer/internal/drawable_container_drawlist_manager.cpp \
         $$PWD/viewer/internal/drawable_mesh_drawlist_manager.cpp \
         $$PWD/viewer/internal/drawable_object_drawlist_manager.cpp \
+        $$PWD/viewer/internal/instanced_primitives.cpp \
         $$PWD/viewer/internal/manipulable_object_drawlist_manager.cpp \
+        $$PWD/viewer/internal/mesh_buffers.cpp \
+        $$PWD/viewer/internal/mesh_levels_of_detail.cpp \
+        $$PWD/viewer/internal/mesh_picker.cpp \
+        $$PWD/viewer/internal/vertex_batch.cpp \
+        $$PWD/viewer/internal/view_frustum.cpp \
+        $$PWD/viewer/opengl_objects/opengl_buffer.cpp \
+        $$PWD/viewer/opengl_objects/opengl_program.cpp \
+        $$PWD/viewer/opengl_objects/opengl_query.cpp \
         $$PWD/viewer/opengl_objects/opengl_objects2.cpp \
         $$PWD/viewer/opengl_objects/opengl_objects3.cpp \
         $$PWD/viewer/utilities/console_stream.cpp \
+        $$PWD/viewer/utilities/frame_profiler.cpp \
         $$PWD/viewer/utilities/loadersaver.cpp \
         $$PWD/viewer/utilities/utils.cpp \
+        $$PWD/viewer/utilities/picking.cpp \
         $$PWD/viewer/widgets/qclickablelabel.cpp
     }
 
     SOURCES +=  \
         $$PWD/viewer/interfaces/pickable_object.cpp
 
+    #picking uses the TriangleBVH of the DataStructures module
+    !contains(DEFINES, CG3_DATA_STRUCTURES_DEFINED){
+        HEADERS += \
+            $$PWD/data_structures/trees/triangle_bvh.h
+
+        CG3_STATIC {
+        SOURCES += \
+            $$PWD/data_structures/trees/triangle_bvh.cpp
+        }
+    }
+
+    contains(DEFINES, CG3_EGL_DEFINED) {
+        HEADERS += \
+            $$PWD/viewer/offscreen_renderer.h
+
+        CG3_STATIC {
+        SOURCES += \
+            $$PWD/viewer/offscreen_renderer.cpp
+        }
+    }
+
     FORMS += \
         $$PWD/viewer/mainwindow.ui \
         $$PWD/viewer/internal/drawable_mesh_drawlist_manager.ui \
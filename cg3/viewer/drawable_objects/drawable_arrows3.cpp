@@ -0,0 +1,187 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "drawable_arrows3.h"
+
+#include <assert.h>
+
+namespace cg3 {
+
+CG3_INLINE DrawableArrows3::DrawableArrows3(unsigned int slices) :
+    primitives(internal::InstancedPrimitives::TUBE, slices),
+    bbUpdated(true)
+{
+}
+
+CG3_INLINE DrawableArrows3::DrawableArrows3(
+        const std::vector<Segment3d>& segments,
+        double radius,
+        const QColor& color,
+        unsigned int slices) :
+    DrawableArrows3(slices)
+{
+    setArrows(segments, radius, color);
+}
+
+CG3_INLINE void DrawableArrows3::draw() const
+{
+    primitives.draw();
+}
+
+CG3_INLINE Point3d DrawableArrows3::sceneCenter() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.center();
+    return Point3d();
+}
+
+CG3_INLINE double DrawableArrows3::sceneRadius() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.diag() / 2;
+    return -1;
+}
+
+CG3_INLINE DrawStatistics DrawableArrows3::drawStatistics() const
+{
+    return primitives.drawStatistics();
+}
+
+CG3_INLINE unsigned int DrawableArrows3::size() const
+{
+    return (unsigned int) segments.size();
+}
+
+CG3_INLINE void DrawableArrows3::clear()
+{
+    segments.clear();
+    radii.clear();
+    primitives.clear();
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the arrows with arrows going from the first to the
+ * second end point of the given segments, all with the same radius and color.
+ */
+CG3_INLINE void DrawableArrows3::setArrows(
+        const std::vector<Segment3d>& segments,
+        double radius,
+        const QColor& color)
+{
+    this->segments = segments;
+    radii.assign(segments.size(), radius);
+    primitives.resize((unsigned int) segments.size() * 2);
+    for (unsigned int i = 0; i < segments.size(); ++i)
+        setTubes(i, segments[i].p1(), segments[i].p2(), radius, color);
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the arrows. The three vectors must have the same size.
+ */
+CG3_INLINE void DrawableArrows3::setArrows(
+        const std::vector<Segment3d>& segments,
+        const std::vector<double>& radii,
+        const std::vector<QColor>& colors)
+{
+    assert(segments.size() == radii.size() && segments.size() == colors.size());
+    this->segments = segments;
+    this->radii = radii;
+    primitives.resize((unsigned int) segments.size() * 2);
+    for (unsigned int i = 0; i < segments.size(); ++i)
+        setTubes(i, segments[i].p1(), segments[i].p2(), radii[i], colors[i]);
+    bbUpdated = false;
+}
+
+CG3_INLINE unsigned int DrawableArrows3::addArrow(
+        const Point3d& a,
+        const Point3d& b,
+        double radius,
+        const QColor& color)
+{
+    unsigned int i = size();
+    segments.push_back(Segment3d(a, b));
+    radii.push_back(radius);
+    primitives.resize((i+1) * 2);
+    setTubes(i, a, b, radius, color);
+    bbUpdated = false;
+    return i;
+}
+
+CG3_INLINE void DrawableArrows3::setArrow(
+        unsigned int i,
+        const Point3d& a,
+        const Point3d& b,
+        double radius,
+        const QColor& color)
+{
+    segments[i].set(a, b);
+    radii[i] = radius;
+    setTubes(i, a, b, radius, color);
+    bbUpdated = false;
+}
+
+CG3_INLINE void DrawableArrows3::setColor(unsigned int i, const QColor& color)
+{
+    primitives.setColor(i*2, color);
+    primitives.setColor(i*2+1, color);
+}
+
+CG3_INLINE void DrawableArrows3::setColor(const QColor& color)
+{
+    for (unsigned int i = 0; i < primitives.size(); ++i)
+        primitives.setColor(i, color);
+}
+
+CG3_INLINE const Segment3d& DrawableArrows3::segment(unsigned int i) const
+{
+    return segments[i];
+}
+
+CG3_INLINE double DrawableArrows3::radius(unsigned int i) const
+{
+    return radii[i];
+}
+
+CG3_INLINE unsigned int DrawableArrows3::slices() const
+{
+    return primitives.resolution();
+}
+
+CG3_INLINE void DrawableArrows3::setSlices(unsigned int slices)
+{
+    primitives.setResolution(slices);
+}
+
+CG3_INLINE void DrawableArrows3::setTubes(
+        unsigned int i,
+        const Point3d& a,
+        const Point3d& b,
+        double radius,
+        const QColor& color)
+{
+    Point3d midPoint = (a * 1 + b * 9) / 10;
+    primitives.setTube(i*2, a, radius, midPoint, radius, color);
+    primitives.setTube(i*2+1, midPoint, radius*2, b, 0, color);
+}
+
+CG3_INLINE void DrawableArrows3::updateBoundingBox() const
+{
+    if (bbUpdated)
+        return;
+    bb.reset();
+    for (unsigned int i = 0; i < segments.size(); ++i) {
+        Point3d r(radii[i]*2, radii[i]*2, radii[i]*2);
+        bb.min() = bb.min().min(segments[i].p1() - r).min(segments[i].p2() - r);
+        bb.max() = bb.max().max(segments[i].p1() + r).max(segments[i].p2() + r);
+    }
+    bbUpdated = true;
+}
+
+} //namespace cg3
@@ -0,0 +1,91 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_DRAWABLE_ARROWS3_H
+#define CG3_DRAWABLE_ARROWS3_H
+
+#include "../interfaces/drawable_object.h"
+#include "../internal/instanced_primitives.h"
+#include <cg3/geometry/bounding_box3.h>
+#include <cg3/geometry/segment3.h>
+#include <cg3/utilities/color.h>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3viewer
+ * @brief A set of arrows drawn as instances of a single tube mesh.
+ *
+ * Arrows are drawn as DrawableArrow3 draws them: a cylinder for the first
+ * nine tenths of the segment and a cone, with the double of the radius, for
+ * the last tenth.
+ */
+class DrawableArrows3 : public DrawableObject
+{
+public:
+    DrawableArrows3(unsigned int slices = 50);
+    DrawableArrows3(
+            const std::vector<Segment3d>& segments,
+            double radius,
+            const QColor& color = QColor(128,128,128),
+            unsigned int slices = 50);
+
+    // DrawableObject interface
+    void draw() const;
+    Point3d sceneCenter() const;
+    double sceneRadius() const;
+    DrawStatistics drawStatistics() const;
+
+    unsigned int size() const;
+    void clear();
+    void setArrows(
+            const std::vector<Segment3d>& segments,
+            double radius,
+            const QColor& color = QColor(128,128,128));
+    void setArrows(
+            const std::vector<Segment3d>& segments,
+            const std::vector<double>& radii,
+            const std::vector<QColor>& colors);
+    unsigned int addArrow(
+            const Point3d& a,
+            const Point3d& b,
+            double radius,
+            const QColor& color = QColor(128,128,128));
+    void setArrow(
+            unsigned int i,
+            const Point3d& a,
+            const Point3d& b,
+            double radius,
+            const QColor& color);
+    void setColor(unsigned int i, const QColor& color);
+    void setColor(const QColor& color);
+
+    const Segment3d& segment(unsigned int i) const;
+    double radius(unsigned int i) const;
+
+    unsigned int slices() const;
+    void setSlices(unsigned int slices);
+
+protected:
+    void setTubes(unsigned int i, const Point3d& a, const Point3d& b, double radius, const QColor& color);
+    void updateBoundingBox() const;
+
+    std::vector<Segment3d> segments;
+    std::vector<double> radii;
+    internal::InstancedPrimitives primitives; //two tubes for every arrow
+    mutable BoundingBox3 bb;
+    mutable bool bbUpdated;
+};
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_DRAWABLE_ARROWS3_CPP "drawable_arrows3.cpp"
+#include CG3_DRAWABLE_ARROWS3_CPP
+#undef CG3_DRAWABLE_ARROWS3_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_DRAWABLE_ARROWS3_H
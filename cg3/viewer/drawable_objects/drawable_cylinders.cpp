@@ -0,0 +1,174 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "drawable_cylinders.h"
+
+#include <assert.h>
+
+namespace cg3 {
+
+CG3_INLINE DrawableCylinders::DrawableCylinders(unsigned int slices) :
+    primitives(internal::InstancedPrimitives::TUBE, slices),
+    bbUpdated(true)
+{
+}
+
+CG3_INLINE DrawableCylinders::DrawableCylinders(
+        const std::vector<Segment3d>& segments,
+        double radius,
+        const QColor& color,
+        unsigned int slices) :
+    DrawableCylinders(slices)
+{
+    setCylinders(segments, radius, color);
+}
+
+CG3_INLINE void DrawableCylinders::draw() const
+{
+    primitives.draw();
+}
+
+CG3_INLINE Point3d DrawableCylinders::sceneCenter() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.center();
+    return Point3d();
+}
+
+CG3_INLINE double DrawableCylinders::sceneRadius() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.diag() / 2;
+    return -1;
+}
+
+CG3_INLINE DrawStatistics DrawableCylinders::drawStatistics() const
+{
+    return primitives.drawStatistics();
+}
+
+CG3_INLINE unsigned int DrawableCylinders::size() const
+{
+    return (unsigned int) segments.size();
+}
+
+CG3_INLINE void DrawableCylinders::clear()
+{
+    segments.clear();
+    radii.clear();
+    primitives.clear();
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the cylinders with cylinders linking the end points of
+ * the given segments, all with the same radius and color.
+ */
+CG3_INLINE void DrawableCylinders::setCylinders(
+        const std::vector<Segment3d>& segments,
+        double radius,
+        const QColor& color)
+{
+    this->segments = segments;
+    radii.assign(segments.size(), radius);
+    primitives.resize((unsigned int) segments.size());
+    for (unsigned int i = 0; i < segments.size(); ++i)
+        primitives.setTube(i, segments[i].p1(), radius, segments[i].p2(), radius, color);
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the cylinders. The three vectors must have the same size.
+ */
+CG3_INLINE void DrawableCylinders::setCylinders(
+        const std::vector<Segment3d>& segments,
+        const std::vector<double>& radii,
+        const std::vector<QColor>& colors)
+{
+    assert(segments.size() == radii.size() && segments.size() == colors.size());
+    this->segments = segments;
+    this->radii = radii;
+    primitives.resize((unsigned int) segments.size());
+    for (unsigned int i = 0; i < segments.size(); ++i)
+        primitives.setTube(i, segments[i].p1(), radii[i], segments[i].p2(), radii[i], colors[i]);
+    bbUpdated = false;
+}
+
+CG3_INLINE unsigned int DrawableCylinders::addCylinder(
+        const Point3d& a,
+        const Point3d& b,
+        double radius,
+        const QColor& color)
+{
+    unsigned int i = size();
+    segments.push_back(Segment3d(a, b));
+    radii.push_back(radius);
+    primitives.resize(i+1);
+    primitives.setTube(i, a, radius, b, radius, color);
+    bbUpdated = false;
+    return i;
+}
+
+CG3_INLINE void DrawableCylinders::setCylinder(
+        unsigned int i,
+        const Point3d& a,
+        const Point3d& b,
+        double radius,
+        const QColor& color)
+{
+    segments[i].set(a, b);
+    radii[i] = radius;
+    primitives.setTube(i, a, radius, b, radius, color);
+    bbUpdated = false;
+}
+
+CG3_INLINE void DrawableCylinders::setColor(unsigned int i, const QColor& color)
+{
+    primitives.setColor(i, color);
+}
+
+CG3_INLINE void DrawableCylinders::setColor(const QColor& color)
+{
+    for (unsigned int i = 0; i < size(); ++i)
+        primitives.setColor(i, color);
+}
+
+CG3_INLINE const Segment3d& DrawableCylinders::segment(unsigned int i) const
+{
+    return segments[i];
+}
+
+CG3_INLINE double DrawableCylinders::radius(unsigned int i) const
+{
+    return radii[i];
+}
+
+CG3_INLINE unsigned int DrawableCylinders::slices() const
+{
+    return primitives.resolution();
+}
+
+CG3_INLINE void DrawableCylinders::setSlices(unsigned int slices)
+{
+    primitives.setResolution(slices);
+}
+
+CG3_INLINE void DrawableCylinders::updateBoundingBox() const
+{
+    if (bbUpdated)
+        return;
+    bb.reset();
+    for (unsigned int i = 0; i < segments.size(); ++i) {
+        Point3d r(radii[i], radii[i], radii[i]);
+        bb.min() = bb.min().min(segments[i].p1() - r).min(segments[i].p2() - r);
+        bb.max() = bb.max().max(segments[i].p1() + r).max(segments[i].p2() + r);
+    }
+    bbUpdated = true;
+}
+
+} //namespace cg3
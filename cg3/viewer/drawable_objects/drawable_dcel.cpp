@@ -8,6 +8,11 @@
 
 #include "drawable_dcel.h"
 
+#include <cg3/utilities/hash.h>
+
+#include <algorithm>
+#include <climits>
+
 #ifdef __APPLE__
 #include <gl.h>
 #else
@@ -70,6 +75,7 @@ CG3_INLINE void DrawableDcel::clear()
     triangleNormals.clear();
     triangles.clear();
     triangleColors.clear();
+    invalidateBuffers();
 }
 
 CG3_INLINE void DrawableDcel::draw() const
@@ -125,115 +131,299 @@ CG3_INLINE double DrawableDcel::sceneRadius() const
  * Fa in modo che la mesh visualizzata sia effettivamente quella contenuta all'interno della struttura dati
  * Dcel. Deve essere chiamata ogni volta che è stata fatta una modifica nella Dcel e si vuole visualizzare tale
  * modifica.
+ *
+ * \~English
+ * If only coordinates, normals and colors of vertices and faces have been modified (through their setters,
+ * in release mode), only the modified data is updated. Otherwise, all the data is computed again.
  */
 CG3_INLINE void DrawableDcel::update()
 {
-    vertexCoordinates.clear();
-    vertexNormals.clear();
-    triangles.clear();
-    triangleColors.clear();
-    vertexColors.clear();
-    triangleNormals.clear();
-    facesWireframe.clear();
-    trianglesFacesMap.clear();
-    facesTrianglesMap.clear();
-    flaggedEdges.clear();
-    vertexCoordinates.reserve(numberVertices()*3);
-    vertexNormals.reserve(numberVertices()*3);
-    triangles.reserve(numberFaces()*3);
-    triangleColors.reserve(numberFaces()*3);
-    triangleNormals.reserve(numberFaces()*3);
-    vertexColors.resize(numberVertices()*3,0.5);
-    facesWireframe.reserve(numberHalfEdges());
-    trianglesFacesMap.reserve(numberFaces());
-    std::map<int, int> v_ids;
-    int vi = 0;
-
-    for (const Dcel::Vertex* v : vertexIterator()) {
-        Point3d p = v->coordinate();
-        Vec3d n = v->normal();
-        vertexCoordinates.push_back(p.x());
-        vertexCoordinates.push_back(p.y());
-        vertexCoordinates.push_back(p.z());
-        n.normalize();
-        vertexNormals.push_back(n.x());
-        vertexNormals.push_back(n.y());
-        vertexNormals.push_back(n.z());
-
-        v_ids[v->id()] = vi;
-        vi++;
+    #ifdef NDEBUG
+    if (!topologyModified &&
+            vertexModifications.size() == vertices.size() &&
+            faceModifications.size() == faces.size() &&
+            updateModified())
+        return;
+    #endif
+    fullUpdate();
+}
+
+/**
+ * @brief Computes again all the data drawn, in parallel over the vertices and
+ * the faces of the Dcel. Triangulations of polygonal faces are reused if their
+ * borders did not change.
+ */
+CG3_INLINE void DrawableDcel::fullUpdate()
+{
+    const unsigned int nvIds = (unsigned int)vertices.size();
+    const unsigned int nfIds = (unsigned int)faces.size();
+
+    verticesIndicesMap.assign(nvIds, -1);
+    unsigned int nv = 0;
+    for (unsigned int i = 0; i < nvIds; ++i)
+        if (vertices[i] != nullptr)
+            verticesIndicesMap[i] = nv++;
+    vertexCoordinates.resize(nv*3);
+    vertexNormals.resize(nv*3);
+    vertexColors.resize(nv*3);
+
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)nvIds; ++i) {
+        if (vertices[i] != nullptr)
+            updateVertex(vertices[i]);
     }
 
-    unsigned int actualTriangle = 0;
-    #ifdef CG3_CGAL_DEFINED
-    for (const Dcel::Face* f : faceIterator()) {
-        for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator()) {
-            unsigned int p1, p2;
-                p1 = v_ids[he->fromVertex()->id()];
-                p2 = v_ids[he->toVertex()->id()];
-                std::pair<unsigned int, unsigned int> edge(p1,p2);
-                facesWireframe.push_back(edge);
-            }
+    //number of triangles of every face, then first triangle of every face
+    facesTrianglesMap.assign(nfIds + 1, 0);
+    facesTriangulations.resize(nfIds);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (long long int i = 0; i < (long long int)nfIds; ++i) {
+        if (faces[i] != nullptr)
+            facesTrianglesMap[i] = updateFaceTriangulation(faces[i]);
+    }
+    unsigned int nt = 0;
+    for (unsigned int i = 0; i < nfIds; ++i) {
+        unsigned int n = facesTrianglesMap[i];
+        facesTrianglesMap[i] = nt;
+        nt += n;
+    }
+    facesTrianglesMap[nfIds] = nt;
 
+    triangles.resize(nt*3);
+    triangleNormals.resize(nt*3);
+    triangleColors.resize(nt*3);
+    trianglesFacesMap.resize(nt);
 
-        if (f->isTriangle()){
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)nfIds; ++i) {
+        const Face* f = faces[i];
+        if (f == nullptr)
+            continue;
+        unsigned int k = 3*facesTrianglesMap[i];
+        #ifdef CG3_CGAL_DEFINED
+        if (f->isTriangle()) {
             for (const Dcel::Vertex* v : f->incidentVertexIterator())
-                triangles.push_back(v_ids[v->id()]);
-            triangleColors.push_back(f->color().redF());
-            triangleColors.push_back(f->color().greenF());
-            triangleColors.push_back(f->color().blueF());
-            triangleNormals.push_back(f->normal().x());
-            triangleNormals.push_back(f->normal().y());
-            triangleNormals.push_back(f->normal().z());
-            trianglesFacesMap.push_back(f->id());
-            facesTrianglesMap[f->id()] = actualTriangle++;
+                triangles[k++] = verticesIndicesMap[v->id()];
         }
         else {
-            facesTrianglesMap[f->id()] = actualTriangle;
-            //Si ottiene la triangolazione della faccia e si inseriscono i triangoli
-            //prodotti nell'array tris.
-            std::vector<std::array<const Dcel::Vertex*, 3> > face_triangles;
-            f->triangulation(face_triangles);
-            std::array<const Dcel::Vertex*, 3> t;
-            for(unsigned int i = 0; i<face_triangles.size(); ++i){
-                t = face_triangles[i];
-                const Dcel::Vertex* v1 = t[0];
-                const Dcel::Vertex* v2 = t[1];
-                const Dcel::Vertex* v3 = t[2];
-                triangles.push_back(v_ids[v1->id()]);
-                triangles.push_back(v_ids[v3->id()]);
-                triangles.push_back(v_ids[v2->id()]);
-                trianglesFacesMap.push_back(f->id());
-                triangleColors.push_back(f->color().redF());
-                triangleColors.push_back(f->color().greenF());
-                triangleColors.push_back(f->color().blueF());
-                triangleNormals.push_back(f->normal().x());
-                triangleNormals.push_back(f->normal().y());
-                triangleNormals.push_back(f->normal().z());
-                actualTriangle++;
-            }
-            /***********************************************************************/
+            for (unsigned int vid : facesTriangulations[i].triangles)
+                triangles[k++] = verticesIndicesMap[vid];
         }
+        #else
+        Dcel::Face::ConstIncidentVertexIterator vit = f->incidentVertexBegin();
+        for (unsigned int j = 0; j < 3; ++j, ++vit)
+            triangles[k++] = verticesIndicesMap[(*vit)->id()];
+        #endif
+        for (unsigned int t = facesTrianglesMap[i]; t < facesTrianglesMap[i+1]; ++t)
+            trianglesFacesMap[t] = f->id();
+        updateFace(f);
     }
-    #else
+
+    facesWireframe.clear();
+    #ifdef CG3_CGAL_DEFINED
+    facesWireframe.reserve(numberHalfEdges());
     for (const Dcel::Face* f : faceIterator()) {
-        Dcel::Face::ConstIncidentVertexIterator vit = f->incidentVertexBegin();
-        triangles.push_back(v_ids[(*vit)->id()]);
-        ++vit;
-        triangles.push_back(v_ids[(*vit)->id()]);
-        ++vit;
-        triangles.push_back(v_ids[(*vit)->id()]);
-        triangleColors.push_back(f->color().redF());
-        triangleColors.push_back(f->color().greenF());
-        triangleColors.push_back(f->color().blueF());
-        triangleNormals.push_back(f->normal().x());
-        triangleNormals.push_back(f->normal().y());
-        triangleNormals.push_back(f->normal().z());
-        trianglesFacesMap.push_back(f->id());
-        facesTrianglesMap[f->id()] = actualTriangle++;
+        for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator()) {
+            facesWireframe.push_back(std::pair<unsigned int, unsigned int>(
+                        verticesIndicesMap[he->fromVertex()->id()],
+                        verticesIndicesMap[he->toVertex()->id()]));
+        }
+    }
+    #endif
+
+    updateFlaggedEdges();
+
+    vertexModifications.assign(nvIds, 0);
+    faceModifications.assign(nfIds, 0);
+    topologyModified = false;
+    invalidateBuffers();
+}
+
+/**
+ * @brief Updates only the data of the vertices and faces marked as modified
+ * by the Dcel, and invalidates the ranges of the buffers that contain them.
+ * @return false if a full update is needed: moving a vertex of a polygonal
+ * face may change its triangulation.
+ */
+CG3_INLINE bool DrawableDcel::updateModified()
+{
+    const long long int nvIds = vertices.size();
+    const long long int nfIds = faces.size();
+    const unsigned int nt = (unsigned int)trianglesFacesMap.size();
+
+    //triangles incident to vertices whose coordinates or normals changed
+    std::vector<unsigned char> moved(vertexCoordinates.size() / 3, 0);
+    unsigned int vFirst = UINT_MAX, vLast = 0;
+    int vAttributes = 0;
+    #pragma omp parallel for reduction(min:vFirst) reduction(max:vLast) reduction(|:vAttributes)
+    for (long long int i = 0; i < nvIds; ++i) {
+        unsigned char m = vertexModifications[i];
+        if (m == 0 || vertices[i] == nullptr)
+            continue;
+        unsigned int vi = verticesIndicesMap[i];
+        updateVertex(vertices[i]);
+        vFirst = std::min(vFirst, vi);
+        vLast = std::max(vLast, vi);
+        if (m & COORDINATE_MODIFIED)
+            vAttributes |= MESH_COORDINATES;
+        if (m & NORMAL_MODIFIED)
+            vAttributes |= MESH_NORMALS;
+        if (m & COLOR_MODIFIED)
+            vAttributes |= MESH_COLORS;
+        moved[vi] = m & (COORDINATE_MODIFIED | NORMAL_MODIFIED);
     }
+
+    unsigned int tFirst = UINT_MAX, tLast = 0;
+    int tAttributes = 0;
+    bool polygonMoved = false;
+    if (vAttributes & (MESH_COORDINATES | MESH_NORMALS)) {
+        #pragma omp parallel for reduction(min:tFirst) reduction(max:tLast) reduction(|:tAttributes) reduction(||:polygonMoved)
+        for (long long int t = 0; t < nt; ++t) {
+            unsigned char m = moved[triangles[3*t]] | moved[triangles[3*t+1]] | moved[triangles[3*t+2]];
+            if (m == 0)
+                continue;
+            tFirst = std::min(tFirst, (unsigned int)t);
+            tLast = std::max(tLast, (unsigned int)t);
+            if (m & COORDINATE_MODIFIED) {
+                tAttributes |= MESH_COORDINATES;
+                unsigned int fid = trianglesFacesMap[t];
+                if (facesTrianglesMap[fid+1] - facesTrianglesMap[fid] > 1)
+                    polygonMoved = true;
+            }
+            if (m & NORMAL_MODIFIED)
+                tAttributes |= MESH_NORMALS;
+        }
+    }
+    if (polygonMoved)
+        return false;
+
+    #pragma omp parallel for reduction(min:tFirst) reduction(max:tLast) reduction(|:tAttributes)
+    for (long long int i = 0; i < nfIds; ++i) {
+        unsigned char m = faceModifications[i];
+        if (m == 0 || faces[i] == nullptr || facesTrianglesMap[i] == facesTrianglesMap[i+1])
+            continue;
+        updateFace(faces[i]);
+        tFirst = std::min(tFirst, facesTrianglesMap[i]);
+        tLast = std::max(tLast, facesTrianglesMap[i+1] - 1);
+        if (m & NORMAL_MODIFIED)
+            tAttributes |= MESH_NORMALS;
+        if (m & COLOR_MODIFIED)
+            tAttributes |= MESH_COLORS;
+    }
+
+    if (vFirst <= vLast)
+        invalidateVertexBuffers(vFirst, vLast, vAttributes, false);
+    if (tFirst <= tLast)
+        invalidateTriangleBuffers(tFirst, tLast, tAttributes);
+
+    updateFlaggedEdges();
+
+    if (vFirst <= vLast)
+        std::fill(vertexModifications.begin(), vertexModifications.end(), 0);
+    if (tFirst <= tLast)
+        std::fill(faceModifications.begin(), faceModifications.end(), 0);
+    return true;
+}
+
+/**
+ * @brief Copies coordinates, normal and color of the vertex in the drawn arrays
+ */
+CG3_INLINE void DrawableDcel::updateVertex(const Vertex* v)
+{
+    unsigned int i = 3 * verticesIndicesMap[v->id()];
+    const Point3d& p = v->coordinate();
+    Vec3d n = v->normal();
+    n.normalize();
+    const Color& c = v->color();
+    vertexCoordinates[i] = p.x();
+    vertexCoordinates[i+1] = p.y();
+    vertexCoordinates[i+2] = p.z();
+    vertexNormals[i] = n.x();
+    vertexNormals[i+1] = n.y();
+    vertexNormals[i+2] = n.z();
+    vertexColors[i] = c.redF();
+    vertexColors[i+1] = c.greenF();
+    vertexColors[i+2] = c.blueF();
+}
+
+/**
+ * @brief Copies normal and color of the face in all its triangles
+ */
+CG3_INLINE void DrawableDcel::updateFace(const Face* f)
+{
+    const Vec3d& n = f->normal();
+    const Color& c = f->color();
+    for (unsigned int t = facesTrianglesMap[f->id()]; t < facesTrianglesMap[f->id()+1]; ++t) {
+        triangleNormals[3*t] = n.x();
+        triangleNormals[3*t+1] = n.y();
+        triangleNormals[3*t+2] = n.z();
+        triangleColors[3*t] = c.redF();
+        triangleColors[3*t+1] = c.greenF();
+        triangleColors[3*t+2] = c.blueF();
+    }
+}
+
+/**
+ * @brief Returns the number of triangles of the face. The triangulation of a
+ * polygonal face is computed only if the ids or the coordinates of the
+ * vertices of its borders changed since the last triangulation.
+ */
+CG3_INLINE unsigned int DrawableDcel::updateFaceTriangulation(const Face* f)
+{
+    #ifdef CG3_CGAL_DEFINED
+    FaceTriangulation& ft = facesTriangulations[f->id()];
+    if (f->isTriangle()) {
+        ft = FaceTriangulation();
+        return 1;
+    }
+
+    std::vector<unsigned int> borders;
+    std::size_t hash = 0;
+    for (const Dcel::Vertex* v : f->incidentVertexIterator()) {
+        borders.push_back(v->id());
+        cg3::hashCombine(hash, v->coordinate());
+    }
+    for (const Dcel::HalfEdge* inner : f->innerHalfEdgeIterator()) {
+        borders.push_back(UINT_MAX);
+        const Dcel::HalfEdge* he = inner;
+        do {
+            borders.push_back(he->fromVertex()->id());
+            cg3::hashCombine(hash, he->fromVertex()->coordinate());
+            he = he->next();
+        } while (he != inner);
+    }
+
+    if (borders != ft.borders || hash != ft.coordinatesHash || ft.triangles.empty()) {
+        std::vector<std::array<const Dcel::Vertex*, 3> > faceTriangles;
+        f->triangulation(faceTriangles);
+        ft.triangles.clear();
+        ft.triangles.reserve(faceTriangles.size() * 3);
+        for (const std::array<const Dcel::Vertex*, 3>& t : faceTriangles) {
+            ft.triangles.push_back(t[0]->id());
+            ft.triangles.push_back(t[2]->id());
+            ft.triangles.push_back(t[1]->id());
+        }
+        ft.borders = std::move(borders);
+        ft.coordinatesHash = hash;
+    }
+    return (unsigned int)ft.triangles.size() / 3;
+    #else
+    CG3_SUPPRESS_WARNING(f);
+    return 1;
     #endif
-    for (cg3::Dcel::HalfEdge* he : halfEdgeIterator()){
+}
+
+/**
+ * @brief Computes the segments drawn for the edges having the flag set by
+ * setFlaggedEdgesWireframe(). Flags are not tracked by the Dcel: segments
+ * are computed at every update, only if they are drawn.
+ */
+CG3_INLINE void DrawableDcel::updateFlaggedEdges()
+{
+    flaggedEdges.clear();
+    if (!(drawMode & DRAW_FLAGGED_EDGES))
+        return;
+    for (const cg3::Dcel::HalfEdge* he : halfEdgeIterator()){
         if (he->twin() != nullptr) {
             if (he->id() < he->twin()->id()){
                 if (he->flag() == flag || he->twin()->flag() == flag){
@@ -309,6 +499,7 @@ CG3_INLINE void DrawableDcel::setFlaggedEdgesWireframe(
     this->flag = flag;
     flaggedEdgesWireframeWidth = w;
     flaggedEdgesColor = color;
+    updateFlaggedEdges();
 }
 
 CG3_INLINE void DrawableDcel::deserialize(std::ifstream& binaryFile)
@@ -20,6 +20,11 @@ namespace cg3 {
  * @brief The DrawableDcel class allows to draw a Dcel in the Viewer.
  * In order to make visible any change made in the Dcel, you must execute the method DrawableDcel::update().
  *
+ * In release mode, the Dcel records which vertices and faces have been modified through their setters:
+ * if the topology of the Dcel did not change, update() patches only the modified data.
+ * Otherwise, all the data is computed again in parallel, reusing the triangulations of the polygonal faces
+ * that did not change.
+ *
  * @warning if you need performance, do not call update() inside a draw method; call it only when you made some modifications in the dcel.
  */
 class DrawableDcel : public Dcel, public DrawableMesh
@@ -63,6 +68,13 @@ protected:
 
     void renderPass(unsigned int nv, unsigned int nt, const double* coords, const int* triangles, const double* vertexNormals, const float* vertexColors, const double* triangleNormals, const float* triangleColors) const;
 
+    void fullUpdate();
+    bool updateModified();
+    void updateVertex(const Vertex* v);
+    void updateFace(const Face* f);
+    unsigned int updateFaceTriangulation(const Face* f);
+    void updateFlaggedEdges();
+
     enum {
         DRAW_FACES_WIREFRAME = 0b0100000000,
         DRAW_FLAGGED_EDGES = 0b1000000000
@@ -75,12 +87,24 @@ protected:
     std::vector<double> triangleNormals; /** \~Italian @brief vettore di normali ai triangoli usate per la visualizzazione: per aggiornare utilizzare il metodo update() */
     std::vector<float> triangleColors; /** \~Italian @brief vettore di colori associati ai triangoli (da considerare come triple rgb float) usati per la visualizzazione: per aggiornare utilizzare il metodo update() */
 
-    std::map<unsigned int, unsigned int> facesTrianglesMap; /** Maps the DcelFace to the first triangle associated to it */
+    std::vector<int> verticesIndicesMap; /** Maps the id of every Vertex to its index in vertexCoordinates (-1 for deleted vertices) */
+    std::vector<unsigned int> facesTrianglesMap; /** Maps the id of every Face to its first triangle; the last element is the number of triangles */
     std::vector<unsigned int> trianglesFacesMap; /** \~Italian @brief vettore di mappatura triangoli->facce (ogni entrata ha posizione corrispondente a un terzo della posizione della tripla in tris e presenta l'identificativo di una faccia */
     std::vector<std::pair<unsigned int, unsigned int> > facesWireframe; /** \~Italian @brief vettore di coppie usate per renderizzare degli edge: per aggiornare utilizzare metodo update() */
 
     std::vector<cg3::Point3d> flaggedEdges;
 
+    /**
+     * @brief Triangulation of a polygonal face, valid while the ids and the
+     * coordinates of the vertices of its borders do not change
+     */
+    struct FaceTriangulation {
+        std::vector<unsigned int> borders;   //vertex ids, borders separated by UINT_MAX
+        std::size_t coordinatesHash = 0;
+        std::vector<unsigned int> triangles; //vertex ids, three for every triangle
+    };
+    std::vector<FaceTriangulation> facesTriangulations; /** indexed by face id */
+
     int facesWireframeWidth = 1;
     float facesWireframeColor[3];
 
@@ -35,6 +35,15 @@ CG3_INLINE DrawableEigenMesh::DrawableEigenMesh(const std::string& filename)  :
 {
 }
 
+/**
+ * @brief Makes visible the changes made in the mesh: the data drawn by the
+ * viewer is uploaded again at the next draw.
+ */
+CG3_INLINE void DrawableEigenMesh::update()
+{
+    invalidateBuffers();
+}
+
 CG3_INLINE void DrawableEigenMesh::draw() const
 {
     DrawableMesh::draw(V.rows(), F.rows(), V.data(), F.data(), NV.data(), CV.data(), NF.data(), CF.data(), bb.min(), bb.max());
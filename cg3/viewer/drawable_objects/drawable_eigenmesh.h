@@ -16,6 +16,9 @@ namespace cg3 {
 /**
  * @ingroup cg3viewer
  * @brief The DrawableEigenMesh class
+ *
+ * In order to make visible any change made in the EigenMesh, you must execute
+ * the method DrawableEigenMesh::update().
  */
 class DrawableEigenMesh : public EigenMesh, public DrawableMesh
 {
@@ -26,6 +29,8 @@ public:
 	DrawableEigenMesh(const char* filename);
     DrawableEigenMesh(const std::string &filename);
 
+    void update();
+
     // DrawableObject interface
     void draw() const;
     Point3d sceneCenter() const;
@@ -13,24 +13,34 @@
 namespace cg3 {
 
 CG3_INLINE DrawableMixedObjects::DrawableMixedObjects(viewer::GLCanvas* canvas) :
+    layersUpdated(true),
+    cylinderLayer(internal::InstancedPrimitives::TUBE, 50),
     canvas(canvas)
 {
 }
 
 CG3_INLINE void DrawableMixedObjects::draw() const
 {
-    for (const Sphere& s : spheres){
-        opengl::drawSphere(s.center, s.radius, s.color, s.precision);
-    }
-    for (const Point& p : points){
-		opengl::drawPoint3(p.p, p.color, p.size);
+    updateLayers();
+    for (const std::pair<const int, internal::InstancedPrimitives>& l : sphereLayers){
+        l.second.draw();
     }
-    for (const Cylinder& c : cylinders){
-        opengl::drawCylinder(c.a, c.b, c.radius, c.radius, c.color);
+    glPushAttrib(GL_ENABLE_BIT | GL_POINT_BIT | GL_LINE_BIT);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_POINT_SMOOTH);
+    for (const std::pair<const int, internal::VertexBatch>& l : pointLayers){
+        glPointSize(l.first);
+        l.second.draw(GL_POINTS);
     }
-    for (const Line& l : lines){
-		opengl::drawLine3(l.a, l.b, l.color, l.width);
+    glPopAttrib();
+    cylinderLayer.draw();
+    glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT);
+    glDisable(GL_LIGHTING);
+    for (const std::pair<const int, internal::VertexBatch>& l : lineLayers){
+        glLineWidth(l.first);
+        l.second.draw(GL_LINES);
     }
+    glPopAttrib();
     for (const Triangle& t : triangles){
         opengl::drawTriangle(t.a, t.b, t.c, t.color, t.width, t.fill);
     }
@@ -57,6 +67,22 @@ CG3_INLINE double DrawableMixedObjects::sceneRadius() const
     return -1;
 }
 
+/**
+ * @brief Returns the sum of the statistics of the batches drawn by the last
+ * draw; triangles drawn one by one are not counted
+ */
+CG3_INLINE DrawStatistics DrawableMixedObjects::drawStatistics() const
+{
+    DrawStatistics s = cylinderLayer.drawStatistics();
+    for (const std::pair<const int, internal::InstancedPrimitives>& l : sphereLayers)
+        s += l.second.drawStatistics();
+    for (const std::pair<const int, internal::VertexBatch>& l : pointLayers)
+        s += l.second.drawStatistics();
+    for (const std::pair<const int, internal::VertexBatch>& l : lineLayers)
+        s += l.second.drawStatistics();
+    return s;
+}
+
 CG3_INLINE void DrawableMixedObjects::updateBoundingBox()
 {
     if (numberObjects() == 0) {
@@ -94,10 +120,71 @@ CG3_INLINE unsigned int DrawableMixedObjects::numberObjects() const
     return (unsigned int) (spheres.size() + cylinders.size() + lines.size());
 }
 
+/**
+ * @brief Rebuilds the batches of spheres, cylinders, points and lines if
+ * some of them has been added or removed.
+ */
+CG3_INLINE void DrawableMixedObjects::updateLayers() const
+{
+    if (layersUpdated)
+        return;
+
+    std::map<int, unsigned int> counts;
+    for (const Sphere& s : spheres)
+        counts[s.precision]++;
+    for (std::map<int, internal::InstancedPrimitives>::iterator it = sphereLayers.begin(); it != sphereLayers.end();){
+        if (counts.count(it->first) == 0)
+            it = sphereLayers.erase(it);
+        else
+            ++it;
+    }
+    for (std::pair<const int, unsigned int>& c : counts){
+        std::map<int, internal::InstancedPrimitives>::iterator it = sphereLayers.find(c.first);
+        if (it == sphereLayers.end())
+            it = sphereLayers.emplace(c.first, internal::InstancedPrimitives(internal::InstancedPrimitives::SPHERE, c.first)).first;
+        it->second.resize(c.second);
+        c.second = 0;
+    }
+    for (const Sphere& s : spheres)
+        sphereLayers[s.precision].setSphere(counts[s.precision]++, s.center, s.radius, s.color);
+
+    cylinderLayer.resize((unsigned int) cylinders.size());
+    for (unsigned int i = 0; i < cylinders.size(); ++i){
+        const Cylinder& c = cylinders[i];
+        cylinderLayer.setTube(i, c.a, c.radius, c.b, c.radius, c.color);
+    }
+
+    counts.clear();
+    for (const Point& p : points)
+        counts[p.size]++;
+    pointLayers.clear();
+    for (const std::pair<const int, unsigned int>& c : counts)
+        pointLayers[c.first].resize(c.second);
+    counts.clear();
+    for (const Point& p : points)
+        pointLayers[p.size].setVertex(counts[p.size]++, p.p, p.color);
+
+    counts.clear();
+    for (const Line& l : lines)
+        counts[l.width]++;
+    lineLayers.clear();
+    for (const std::pair<const int, unsigned int>& c : counts)
+        lineLayers[c.first].resize(c.second * 2);
+    counts.clear();
+    for (const Line& l : lines){
+        unsigned int i = counts[l.width]++;
+        lineLayers[l.width].setVertex(i*2, l.a, l.color);
+        lineLayers[l.width].setVertex(i*2+1, l.b, l.color);
+    }
+
+    layersUpdated = true;
+}
+
 CG3_INLINE unsigned int DrawableMixedObjects::addSphere(const Point3d& center, double radius, const QColor& color, int precision)
 {
     Sphere s = {center, radius, color, precision};
     spheres.push_back(s);
+    layersUpdated = false;
     bb.min() = bb.min().min(center);
     bb.max() = bb.max().max(center);
     return (unsigned int)spheres.size()-1;
@@ -106,6 +193,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addSphere(const Point3d& center, d
 CG3_INLINE void DrawableMixedObjects::clearSpheres()
 {
     spheres.clear();
+    layersUpdated = false;
     updateBoundingBox();
 }
 
@@ -113,6 +201,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addPoint(const Point3d& p, const Q
 {
     Point pp = {p, color, size};
     points.push_back(pp);
+    layersUpdated = false;
     bb.min() = bb.min().min(p);
     bb.max() = bb.max().max(p);
     return (unsigned int)points.size()-1;
@@ -120,6 +209,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addPoint(const Point3d& p, const Q
 
 CG3_INLINE void DrawableMixedObjects::clearPoints() {
     points.clear();
+    layersUpdated = false;
     updateBoundingBox();
 }
 
@@ -127,6 +217,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addCylinder(const Point3d& a, cons
 {
     Cylinder c = {a, b, radius, color};
     cylinders.push_back(c);
+    layersUpdated = false;
 
     bb.min() = bb.min().min(a);
     bb.min() = bb.min().min(b);
@@ -139,6 +230,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addCylinder(const Point3d& a, cons
 CG3_INLINE void DrawableMixedObjects::clearCylinders()
 {
     cylinders.clear();
+    layersUpdated = false;
     updateBoundingBox();
 }
 
@@ -146,6 +238,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addLine(const Point3d &a, const Po
 {
     Line l = {a, b, width, color};
     lines.push_back(l);
+    layersUpdated = false;
     bb.min() = bb.min().min(a);
     bb.min() = bb.min().min(b);
     bb.max() = bb.max().max(a);
@@ -159,6 +252,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addLine(const Point2d& a, const Po
     Point3d b_(b.x(), b.y(), 0);
     Line l = {a_, b_, width, color};
     lines.push_back(l);
+    layersUpdated = false;
     bb.min() = bb.min().min(a_);
     bb.min() = bb.min().min(b_);
     bb.max() = bb.max().max(a_);
@@ -169,6 +263,7 @@ CG3_INLINE unsigned int DrawableMixedObjects::addLine(const Point2d& a, const Po
 CG3_INLINE void DrawableMixedObjects::clearLines()
 {
     lines.clear();
+    layersUpdated = false;
     updateBoundingBox();
 }
 
@@ -9,15 +9,23 @@
 #define CG3_DRAWABLE_MIXED_OBJECTS_H
 
 #include "../interfaces/drawable_object.h"
+#include "../internal/instanced_primitives.h"
+#include "../internal/vertex_batch.h"
 #include <cg3/geometry/bounding_box3.h>
 #include <cg3/geometry/bounding_box2.h>
 #include <cg3/viewer/glcanvas.h>
 
+#include <map>
+
 namespace cg3 {
 
 /**
  * @ingroup cg3viewer
  * @brief The DrawableObjects class
+ *
+ * Spheres, cylinders, points and lines are drawn in batches: one instanced
+ * draw call for every sphere precision, one for all the cylinders, and one
+ * for every point size and line width.
  */
 class DrawableMixedObjects : public DrawableObject
 {
@@ -30,6 +38,7 @@ public:
     void draw() const;
     Point3d sceneCenter() const;
     double sceneRadius() const;
+    DrawStatistics drawStatistics() const;
 
     void updateBoundingBox();
     unsigned int numberObjects() const;
@@ -83,6 +92,8 @@ public:
     void clearTexts();
 
 protected:
+    void updateLayers() const;
+
     struct Object
     {
     };
@@ -137,6 +148,12 @@ protected:
 
     BoundingBox3 bb;
 
+    mutable bool layersUpdated;
+    mutable std::map<int, internal::InstancedPrimitives> sphereLayers; //one layer for every precision
+    mutable internal::InstancedPrimitives cylinderLayer;
+    mutable std::map<int, internal::VertexBatch> pointLayers; //one layer for every size
+    mutable std::map<int, internal::VertexBatch> lineLayers; //one layer for every width
+
     cg3::viewer::GLCanvas* canvas;
 };
 
@@ -0,0 +1,145 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "drawable_points3.h"
+
+#include <assert.h>
+
+namespace cg3 {
+
+CG3_INLINE DrawablePoints3::DrawablePoints3(int pointSize) :
+    _pointSize(pointSize),
+    bbUpdated(true)
+{
+}
+
+CG3_INLINE DrawablePoints3::DrawablePoints3(
+        const std::vector<Point3d>& points,
+        const QColor& color,
+        int pointSize) :
+    DrawablePoints3(pointSize)
+{
+    setPoints(points, color);
+}
+
+CG3_INLINE void DrawablePoints3::draw() const
+{
+    glPushAttrib(GL_ENABLE_BIT | GL_POINT_BIT);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_POINT_SMOOTH);
+    glPointSize(_pointSize);
+    batch.draw(GL_POINTS);
+    glPopAttrib();
+}
+
+CG3_INLINE Point3d DrawablePoints3::sceneCenter() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.center();
+    return Point3d();
+}
+
+CG3_INLINE double DrawablePoints3::sceneRadius() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.diag() / 2;
+    return -1;
+}
+
+CG3_INLINE DrawStatistics DrawablePoints3::drawStatistics() const
+{
+    return batch.drawStatistics();
+}
+
+CG3_INLINE unsigned int DrawablePoints3::size() const
+{
+    return (unsigned int) points.size();
+}
+
+CG3_INLINE void DrawablePoints3::clear()
+{
+    points.clear();
+    batch.clear();
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the points with the given points, all with the same
+ * color.
+ */
+CG3_INLINE void DrawablePoints3::setPoints(
+        const std::vector<Point3d>& points,
+        const QColor& color)
+{
+    this->points = points;
+    batch.resize((unsigned int) points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+        batch.setVertex(i, points[i], color);
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the points. The two vectors must have the same size.
+ */
+CG3_INLINE void DrawablePoints3::setPoints(
+        const std::vector<Point3d>& points,
+        const std::vector<QColor>& colors)
+{
+    assert(points.size() == colors.size());
+    this->points = points;
+    batch.resize((unsigned int) points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+        batch.setVertex(i, points[i], colors[i]);
+    bbUpdated = false;
+}
+
+CG3_INLINE unsigned int DrawablePoints3::addPoint(const Point3d& p, const QColor& color)
+{
+    unsigned int i = size();
+    points.push_back(p);
+    batch.resize(i+1);
+    batch.setVertex(i, p, color);
+    bbUpdated = false;
+    return i;
+}
+
+CG3_INLINE void DrawablePoints3::setPoint(unsigned int i, const Point3d& p, const QColor& color)
+{
+    points[i] = p;
+    batch.setVertex(i, p, color);
+    bbUpdated = false;
+}
+
+CG3_INLINE const Point3d& DrawablePoints3::point(unsigned int i) const
+{
+    return points[i];
+}
+
+CG3_INLINE int DrawablePoints3::pointSize() const
+{
+    return _pointSize;
+}
+
+CG3_INLINE void DrawablePoints3::setPointSize(int pointSize)
+{
+    _pointSize = pointSize;
+}
+
+CG3_INLINE void DrawablePoints3::updateBoundingBox() const
+{
+    if (bbUpdated)
+        return;
+    bb.reset();
+    for (const Point3d& p : points) {
+        bb.min() = bb.min().min(p);
+        bb.max() = bb.max().max(p);
+    }
+    bbUpdated = true;
+}
+
+} //namespace cg3
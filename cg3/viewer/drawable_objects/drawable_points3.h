@@ -0,0 +1,73 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_DRAWABLE_POINTS3_H
+#define CG3_DRAWABLE_POINTS3_H
+
+#include "../interfaces/drawable_object.h"
+#include "../internal/vertex_batch.h"
+#include <cg3/geometry/bounding_box3.h>
+#include <cg3/utilities/color.h>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3viewer
+ * @brief A set of points drawn with a single draw call.
+ *
+ * Use this class instead of many DrawablePoint3 objects: changing a point
+ * uploads only its data.
+ */
+class DrawablePoints3 : public DrawableObject
+{
+public:
+    DrawablePoints3(int pointSize = 3);
+    DrawablePoints3(
+            const std::vector<Point3d>& points,
+            const QColor& color = QColor(),
+            int pointSize = 3);
+
+    // DrawableObject interface
+    void draw() const;
+    Point3d sceneCenter() const;
+    double sceneRadius() const;
+    DrawStatistics drawStatistics() const;
+
+    unsigned int size() const;
+    void clear();
+    void setPoints(
+            const std::vector<Point3d>& points,
+            const QColor& color = QColor());
+    void setPoints(
+            const std::vector<Point3d>& points,
+            const std::vector<QColor>& colors);
+    unsigned int addPoint(const Point3d& p, const QColor& color = QColor());
+    void setPoint(unsigned int i, const Point3d& p, const QColor& color);
+
+    const Point3d& point(unsigned int i) const;
+
+    int pointSize() const;
+    void setPointSize(int pointSize);
+
+protected:
+    void updateBoundingBox() const;
+
+    std::vector<Point3d> points;
+    int _pointSize;
+    internal::VertexBatch batch;
+    mutable BoundingBox3 bb;
+    mutable bool bbUpdated;
+};
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_DRAWABLE_POINTS3_CPP "drawable_points3.cpp"
+#include CG3_DRAWABLE_POINTS3_CPP
+#undef CG3_DRAWABLE_POINTS3_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_DRAWABLE_POINTS3_H
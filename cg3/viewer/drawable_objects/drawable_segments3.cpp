@@ -0,0 +1,157 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "drawable_segments3.h"
+
+#include <assert.h>
+
+namespace cg3 {
+
+CG3_INLINE DrawableSegments3::DrawableSegments3(int width) :
+    _width(width),
+    bbUpdated(true)
+{
+}
+
+CG3_INLINE DrawableSegments3::DrawableSegments3(
+        const std::vector<Segment3d>& segments,
+        const QColor& color,
+        int width) :
+    DrawableSegments3(width)
+{
+    setSegments(segments, color);
+}
+
+CG3_INLINE void DrawableSegments3::draw() const
+{
+    glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT);
+    glDisable(GL_LIGHTING);
+    glLineWidth(_width);
+    batch.draw(GL_LINES);
+    glPopAttrib();
+}
+
+CG3_INLINE Point3d DrawableSegments3::sceneCenter() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.center();
+    return Point3d();
+}
+
+CG3_INLINE double DrawableSegments3::sceneRadius() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.diag() / 2;
+    return -1;
+}
+
+CG3_INLINE DrawStatistics DrawableSegments3::drawStatistics() const
+{
+    return batch.drawStatistics();
+}
+
+CG3_INLINE unsigned int DrawableSegments3::size() const
+{
+    return (unsigned int) segments.size();
+}
+
+CG3_INLINE void DrawableSegments3::clear()
+{
+    segments.clear();
+    batch.clear();
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the segments with the given segments, all with the same
+ * color.
+ */
+CG3_INLINE void DrawableSegments3::setSegments(
+        const std::vector<Segment3d>& segments,
+        const QColor& color)
+{
+    this->segments = segments;
+    batch.resize((unsigned int) segments.size() * 2);
+    for (unsigned int i = 0; i < segments.size(); ++i) {
+        batch.setVertex(i*2, segments[i].p1(), color);
+        batch.setVertex(i*2+1, segments[i].p2(), color);
+    }
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the segments. The two vectors must have the same size.
+ */
+CG3_INLINE void DrawableSegments3::setSegments(
+        const std::vector<Segment3d>& segments,
+        const std::vector<QColor>& colors)
+{
+    assert(segments.size() == colors.size());
+    this->segments = segments;
+    batch.resize((unsigned int) segments.size() * 2);
+    for (unsigned int i = 0; i < segments.size(); ++i) {
+        batch.setVertex(i*2, segments[i].p1(), colors[i]);
+        batch.setVertex(i*2+1, segments[i].p2(), colors[i]);
+    }
+    bbUpdated = false;
+}
+
+CG3_INLINE unsigned int DrawableSegments3::addSegment(
+        const Point3d& a,
+        const Point3d& b,
+        const QColor& color)
+{
+    unsigned int i = size();
+    segments.push_back(Segment3d(a, b));
+    batch.resize((i+1) * 2);
+    batch.setVertex(i*2, a, color);
+    batch.setVertex(i*2+1, b, color);
+    bbUpdated = false;
+    return i;
+}
+
+CG3_INLINE void DrawableSegments3::setSegment(
+        unsigned int i,
+        const Point3d& a,
+        const Point3d& b,
+        const QColor& color)
+{
+    segments[i].set(a, b);
+    batch.setVertex(i*2, a, color);
+    batch.setVertex(i*2+1, b, color);
+    bbUpdated = false;
+}
+
+CG3_INLINE const Segment3d& DrawableSegments3::segment(unsigned int i) const
+{
+    return segments[i];
+}
+
+CG3_INLINE int DrawableSegments3::width() const
+{
+    return _width;
+}
+
+CG3_INLINE void DrawableSegments3::setWidth(int width)
+{
+    _width = width;
+}
+
+CG3_INLINE void DrawableSegments3::updateBoundingBox() const
+{
+    if (bbUpdated)
+        return;
+    bb.reset();
+    for (const Segment3d& s : segments) {
+        bb.min() = bb.min().min(s.p1()).min(s.p2());
+        bb.max() = bb.max().max(s.p1()).max(s.p2());
+    }
+    bbUpdated = true;
+}
+
+} //namespace cg3
@@ -0,0 +1,81 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_DRAWABLE_SEGMENTS3_H
+#define CG3_DRAWABLE_SEGMENTS3_H
+
+#include "../interfaces/drawable_object.h"
+#include "../internal/vertex_batch.h"
+#include <cg3/geometry/bounding_box3.h>
+#include <cg3/geometry/segment3.h>
+#include <cg3/utilities/color.h>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3viewer
+ * @brief A set of segments drawn as lines with a single draw call.
+ *
+ * Use this class instead of many DrawableSegment3 objects: changing a segment
+ * uploads only its data.
+ */
+class DrawableSegments3 : public DrawableObject
+{
+public:
+    DrawableSegments3(int width = 3);
+    DrawableSegments3(
+            const std::vector<Segment3d>& segments,
+            const QColor& color = QColor(),
+            int width = 3);
+
+    // DrawableObject interface
+    void draw() const;
+    Point3d sceneCenter() const;
+    double sceneRadius() const;
+    DrawStatistics drawStatistics() const;
+
+    unsigned int size() const;
+    void clear();
+    void setSegments(
+            const std::vector<Segment3d>& segments,
+            const QColor& color = QColor());
+    void setSegments(
+            const std::vector<Segment3d>& segments,
+            const std::vector<QColor>& colors);
+    unsigned int addSegment(
+            const Point3d& a,
+            const Point3d& b,
+            const QColor& color = QColor());
+    void setSegment(
+            unsigned int i,
+            const Point3d& a,
+            const Point3d& b,
+            const QColor& color);
+
+    const Segment3d& segment(unsigned int i) const;
+
+    int width() const;
+    void setWidth(int width);
+
+protected:
+    void updateBoundingBox() const;
+
+    std::vector<Segment3d> segments;
+    int _width;
+    internal::VertexBatch batch; //two vertices for every segment
+    mutable BoundingBox3 bb;
+    mutable bool bbUpdated;
+};
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_DRAWABLE_SEGMENTS3_CPP "drawable_segments3.cpp"
+#include CG3_DRAWABLE_SEGMENTS3_CPP
+#undef CG3_DRAWABLE_SEGMENTS3_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_DRAWABLE_SEGMENTS3_H
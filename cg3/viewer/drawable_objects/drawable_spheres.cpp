@@ -0,0 +1,172 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "drawable_spheres.h"
+
+#include <assert.h>
+
+namespace cg3 {
+
+CG3_INLINE DrawableSpheres::DrawableSpheres(int precision) :
+    primitives(internal::InstancedPrimitives::SPHERE, (unsigned int) std::max(precision, 3)),
+    bbUpdated(true)
+{
+}
+
+CG3_INLINE DrawableSpheres::DrawableSpheres(
+        const std::vector<Point3d>& centers,
+        double radius,
+        const QColor& color,
+        int precision) :
+    DrawableSpheres(precision)
+{
+    setSpheres(centers, radius, color);
+}
+
+CG3_INLINE void DrawableSpheres::draw() const
+{
+    primitives.draw();
+}
+
+CG3_INLINE Point3d DrawableSpheres::sceneCenter() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.center();
+    return Point3d();
+}
+
+CG3_INLINE double DrawableSpheres::sceneRadius() const
+{
+    updateBoundingBox();
+    if (bb.isValid())
+        return bb.diag() / 2;
+    return -1;
+}
+
+CG3_INLINE DrawStatistics DrawableSpheres::drawStatistics() const
+{
+    return primitives.drawStatistics();
+}
+
+CG3_INLINE unsigned int DrawableSpheres::size() const
+{
+    return (unsigned int) centers.size();
+}
+
+CG3_INLINE void DrawableSpheres::clear()
+{
+    centers.clear();
+    radii.clear();
+    primitives.clear();
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the spheres with spheres centered in the given points,
+ * all with the same radius and color.
+ */
+CG3_INLINE void DrawableSpheres::setSpheres(
+        const std::vector<Point3d>& centers,
+        double radius,
+        const QColor& color)
+{
+    this->centers = centers;
+    radii.assign(centers.size(), radius);
+    primitives.resize((unsigned int) centers.size());
+    for (unsigned int i = 0; i < centers.size(); ++i)
+        primitives.setSphere(i, centers[i], radius, color);
+    bbUpdated = false;
+}
+
+/**
+ * @brief Replaces all the spheres. The three vectors must have the same size.
+ */
+CG3_INLINE void DrawableSpheres::setSpheres(
+        const std::vector<Point3d>& centers,
+        const std::vector<double>& radii,
+        const std::vector<QColor>& colors)
+{
+    assert(centers.size() == radii.size() && centers.size() == colors.size());
+    this->centers = centers;
+    this->radii = radii;
+    primitives.resize((unsigned int) centers.size());
+    for (unsigned int i = 0; i < centers.size(); ++i)
+        primitives.setSphere(i, centers[i], radii[i], colors[i]);
+    bbUpdated = false;
+}
+
+CG3_INLINE unsigned int DrawableSpheres::addSphere(
+        const Point3d& center,
+        double radius,
+        const QColor& color)
+{
+    unsigned int i = size();
+    centers.push_back(center);
+    radii.push_back(radius);
+    primitives.resize(i+1);
+    primitives.setSphere(i, center, radius, color);
+    bbUpdated = false;
+    return i;
+}
+
+CG3_INLINE void DrawableSpheres::setSphere(
+        unsigned int i,
+        const Point3d& center,
+        double radius,
+        const QColor& color)
+{
+    centers[i] = center;
+    radii[i] = radius;
+    primitives.setSphere(i, center, radius, color);
+    bbUpdated = false;
+}
+
+CG3_INLINE void DrawableSpheres::setColor(unsigned int i, const QColor& color)
+{
+    primitives.setColor(i, color);
+}
+
+CG3_INLINE void DrawableSpheres::setColor(const QColor& color)
+{
+    for (unsigned int i = 0; i < size(); ++i)
+        primitives.setColor(i, color);
+}
+
+CG3_INLINE const Point3d& DrawableSpheres::center(unsigned int i) const
+{
+    return centers[i];
+}
+
+CG3_INLINE double DrawableSpheres::radius(unsigned int i) const
+{
+    return radii[i];
+}
+
+CG3_INLINE int DrawableSpheres::precision() const
+{
+    return (int) primitives.resolution();
+}
+
+CG3_INLINE void DrawableSpheres::setPrecision(int precision)
+{
+    primitives.setResolution((unsigned int) std::max(precision, 3));
+}
+
+CG3_INLINE void DrawableSpheres::updateBoundingBox() const
+{
+    if (bbUpdated)
+        return;
+    bb.reset();
+    for (unsigned int i = 0; i < centers.size(); ++i) {
+        Point3d r(radii[i], radii[i], radii[i]);
+        bb.min() = bb.min().min(centers[i] - r);
+        bb.max() = bb.max().max(centers[i] + r);
+    }
+    bbUpdated = true;
+}
+
+} //namespace cg3
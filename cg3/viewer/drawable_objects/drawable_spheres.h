@@ -0,0 +1,86 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_DRAWABLE_SPHERES_H
+#define CG3_DRAWABLE_SPHERES_H
+
+#include "../interfaces/drawable_object.h"
+#include "../internal/instanced_primitives.h"
+#include <cg3/geometry/bounding_box3.h>
+#include <cg3/utilities/color.h>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3viewer
+ * @brief A set of spheres drawn as instances of a single sphere mesh.
+ *
+ * Use this class instead of many DrawableSphere objects: all the spheres are
+ * drawn with one draw call, and changing a sphere uploads only its data.
+ */
+class DrawableSpheres : public DrawableObject
+{
+public:
+    DrawableSpheres(int precision = 10);
+    DrawableSpheres(
+            const std::vector<Point3d>& centers,
+            double radius,
+            const QColor& color = QColor(128,128,128),
+            int precision = 10);
+
+    // DrawableObject interface
+    void draw() const;
+    Point3d sceneCenter() const;
+    double sceneRadius() const;
+    DrawStatistics drawStatistics() const;
+
+    unsigned int size() const;
+    void clear();
+    void setSpheres(
+            const std::vector<Point3d>& centers,
+            double radius,
+            const QColor& color = QColor(128,128,128));
+    void setSpheres(
+            const std::vector<Point3d>& centers,
+            const std::vector<double>& radii,
+            const std::vector<QColor>& colors);
+    unsigned int addSphere(
+            const Point3d& center,
+            double radius,
+            const QColor& color = QColor(128,128,128));
+    void setSphere(
+            unsigned int i,
+            const Point3d& center,
+            double radius,
+            const QColor& color);
+    void setColor(unsigned int i, const QColor& color);
+    void setColor(const QColor& color);
+
+    const Point3d& center(unsigned int i) const;
+    double radius(unsigned int i) const;
+
+    int precision() const;
+    void setPrecision(int precision);
+
+protected:
+    void updateBoundingBox() const;
+
+    std::vector<Point3d> centers;
+    std::vector<double> radii;
+    internal::InstancedPrimitives primitives;
+    mutable BoundingBox3 bb;
+    mutable bool bbUpdated;
+};
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_DRAWABLE_SPHERES_CPP "drawable_spheres.cpp"
+#include CG3_DRAWABLE_SPHERES_CPP
+#undef CG3_DRAWABLE_SPHERES_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_DRAWABLE_SPHERES_H
@@ -43,7 +43,8 @@ CG3_INLINE Point3d DrawableTriangle3::sceneCenter() const
 
 CG3_INLINE double DrawableTriangle3::sceneRadius() const
 {
-	return barycenter().dist(v[0]);
+	Point3d b = barycenter();
+	return std::max(b.dist(v[0]), std::max(b.dist(v[1]), b.dist(v[2])));
 }
 
 } //namespace cg3
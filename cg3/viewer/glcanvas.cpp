@@ -7,12 +7,14 @@
  */
 
 #include <iostream>
+#include <sstream>
 
 #include "glcanvas.h"
 #include <cg3/geometry/line3.h>
 #include <cg3/geometry/plane.h>
 #include <cg3/utilities/cg3_config_folder.h>
 #include <cg3/viewer/utilities/utils.h>
+#include <cg3/viewer/internal/view_frustum.h>
 
 namespace cg3 {
 namespace viewer {
@@ -22,7 +24,8 @@ CG3_INLINE GLCanvas::GLCanvas(QWidget * parent) :
     backgroundColor(Qt::white),
     mode(_3D),
     unitBox(Point3d(-1,-1,-1), Point3d(1,1,1)),
-    unitBoxEnabled(false)
+    unitBoxEnabled(false),
+    frustumCulling(true)
 {
     setParent(parent);
     setSnapshotQuality(100);
@@ -40,12 +43,25 @@ CG3_INLINE void GLCanvas::init()
 CG3_INLINE void GLCanvas::draw()
 {
     QGLViewer::setBackgroundColor(backgroundColor);
+    frameProfiler.beginFrame();
+
+    cg3::internal::ViewFrustum frustum;
+    if (frustumCulling)
+        frustum.update();
 
     for(unsigned int i=0; i<drawlist.size(); ++i) {
         if (drawlist[i]->isVisible()){
             const ManipulableObject* mobj = dynamic_cast<const ManipulableObject*>(drawlist[i]);
-            if (!mobj)
-                drawlist[i]->draw();
+            if (!mobj) {
+                //objects outside the view frustum are skipped, if their bounds are reliable
+                if (!frustumCulling ||
+                        !conservativeSceneBounds(drawlist[i]) ||
+                        frustum.isSphereVisible(drawlist[i]->sceneCenter(), drawlist[i]->sceneRadius())) {
+                    frameProfiler.beginDraw(drawlist[i]);
+                    drawlist[i]->draw();
+                    frameProfiler.endDraw(drawlist[i]);
+                }
+            }
             else {
                 // Save the current model view matrix (not needed here in fact)
                 glPushMatrix();
@@ -53,10 +69,12 @@ CG3_INLINE void GLCanvas::draw()
                 // Multiply matrix to get in the frame coordinate system.
                 glMultMatrixd(mobj->matrix());
 
+                frameProfiler.beginDraw(drawlist[i]);
                 if (mobj->grabsMouse())
                     mobj->drawHighlighted();
                 else
                     mobj->draw();
+                frameProfiler.endDraw(mobj);
 
                 if (mobj->drawRelativeAxis())
                     drawAxis();
@@ -68,6 +86,10 @@ CG3_INLINE void GLCanvas::draw()
     }
     if (unitBoxEnabled)
         unitBox.draw();
+
+    frameProfiler.endFrame();
+    if (frameProfiler.isEnabled())
+        drawProfilerOverlay();
 }
 
 CG3_INLINE void GLCanvas::drawWithNames()
@@ -81,6 +103,48 @@ CG3_INLINE void GLCanvas::drawWithNames()
     }
 }
 
+/**
+ * @brief Selects the element under a point of the window.
+ *
+ * If all the visible PickableObjects are ray pickable, the element is picked
+ * on the CPU casting a ray from the camera, and the signals objectPicked and
+ * elementPicked are emitted for the nearest hit. Otherwise, the QGLViewer
+ * selection (based on drawWithNames) is used.
+ */
+CG3_INLINE void GLCanvas::select(const QPoint& point)
+{
+    for (const PickableObject* pobj : pickList) {
+        if (pobj && pobj->isVisible() && !pobj->isRayPickable()) {
+            QGLViewer::select(point);
+            return;
+        }
+    }
+
+    Point3d origin;
+    Vec3d dir;
+    pickingView().ray(point.x(), point.y(), origin, dir);
+
+    const PickableObject* picked = nullptr;
+    PickHit nearest;
+    for (const PickableObject* pobj : pickList) {
+        PickHit hit;
+        if (pobj && pobj->isVisible() && pobj->pick(origin, dir, hit) &&
+                (picked == nullptr || hit.distance < nearest.distance)) {
+            picked = pobj;
+            nearest = hit;
+        }
+    }
+
+    if (picked != nullptr) {
+        emit objectPicked(picked, nearest.face);
+        emit elementPicked(picked, nearest);
+    }
+    else {
+        setSelectedName(-1);
+        postSelection(point);
+    }
+}
+
 CG3_INLINE void GLCanvas::postSelection(const QPoint& point)
 {
     int idName = selectedName();
@@ -115,6 +179,20 @@ CG3_INLINE void GLCanvas::postSelection(const QPoint& point)
     }
 }
 
+/**
+ * @brief Returns the current camera of the canvas, that can be used to pick
+ * regions of the window with PickableObject::pickFaces and
+ * PickableObject::pickVertices
+ */
+CG3_INLINE PickingView GLCanvas::pickingView() const
+{
+    GLdouble modelview[16], projection[16];
+    camera()->getModelViewMatrix(modelview);
+    camera()->getProjectionMatrix(projection);
+    int viewport[4] = {0, 0, width(), height()};
+    return PickingView(modelview, projection, viewport);
+}
+
 CG3_INLINE void GLCanvas::fitScene()
 {
     bool onlyVisible = true;
@@ -154,6 +232,63 @@ CG3_INLINE void GLCanvas::toggleUnitBox()
     update();
 }
 
+/**
+ * @brief Enables or disables the frustum culling: when enabled (default), the
+ * objects whose bounding sphere (sceneCenter() and sceneRadius()) is outside
+ * the view frustum are not drawn. Objects whose bounding sphere may not
+ * contain all they draw (a negative scene radius, or containers of such
+ * objects) and manipulable objects are always drawn.
+ */
+CG3_INLINE void GLCanvas::setFrustumCulling(bool b)
+{
+    frustumCulling = b;
+    update();
+}
+
+CG3_INLINE bool GLCanvas::isFrustumCullingEnabled() const
+{
+    return frustumCulling;
+}
+
+/**
+ * @brief Enables or disables the frame profiler: when enabled, the time spent
+ * by every DrawableObject, the statistics of the frames and the costs recorded
+ * as events are collected and shown in an overlay.
+ *
+ * The canvas is redrawn only when needed: frame rates refer to the frames
+ * actually drawn.
+ * @see FrameProfiler
+ */
+CG3_INLINE void GLCanvas::setProfiling(bool b)
+{
+    frameProfiler.setEnabled(b);
+    update();
+}
+
+CG3_INLINE bool GLCanvas::isProfilingEnabled() const
+{
+    return frameProfiler.isEnabled();
+}
+
+CG3_INLINE void GLCanvas::toggleProfiler()
+{
+    setProfiling(!frameProfiler.isEnabled());
+}
+
+/**
+ * @brief Returns the frame profiler of the canvas, that can be used to record
+ * events and to export the collected data.
+ */
+CG3_INLINE FrameProfiler& GLCanvas::profiler()
+{
+    return frameProfiler;
+}
+
+CG3_INLINE const FrameProfiler& GLCanvas::profiler() const
+{
+    return frameProfiler;
+}
+
 CG3_INLINE void GLCanvas::setBackgroundColor(const QColor &color)
 {
     backgroundColor = color;
@@ -457,5 +592,24 @@ CG3_INLINE void GLCanvas::setSelectionLeftButton(bool b)
 		enableRotation();
 }
 
+/**
+ * @brief Draws the summary of the last frames of the profiler on the top left
+ * corner of the canvas.
+ */
+CG3_INLINE void GLCanvas::drawProfilerOverlay()
+{
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    qglColor(backgroundColor.lightness() < 128 ? Qt::white : Qt::black);
+    std::istringstream summary(frameProfiler.summary());
+    std::string line;
+    int y = 20;
+    while (std::getline(summary, line)) {
+        drawText(10, y, QString::fromStdString(line));
+        y += 15;
+    }
+    glPopAttrib();
+}
+
 } //namespace cg3::viewer
 } //namespace cg3
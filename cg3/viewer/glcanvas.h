@@ -30,6 +30,7 @@
 #include "interfaces/pickable_object.h"
 #include "interfaces/manipulable_object.h"
 #include "drawable_objects/drawable_bounding_box3.h"
+#include "utilities/frame_profiler.h"
 #include <qmessagebox.h>
 
 namespace cg3 {
@@ -64,13 +65,22 @@ public:
     void init();
     void draw();
     void drawWithNames();
+    void select(const QPoint& point);
     void postSelection(const QPoint& point);
+    cg3::PickingView pickingView() const;
 
     //GLCanvas rendering member functions:
     void fitScene();
     void fitScene(const cg3::Point3d &center, double radius);
     void fitScene2d(const cg3::Point2d& center, double radius);
     void toggleUnitBox();
+    void setFrustumCulling(bool b);
+    bool isFrustumCullingEnabled() const;
+    void setProfiling(bool b);
+    bool isProfilingEnabled() const;
+    void toggleProfiler();
+    FrameProfiler& profiler();
+    const FrameProfiler& profiler() const;
     void setBackgroundColor(const QColor & color);
     void set2DMode();
     void set3DMode();
@@ -115,6 +125,7 @@ public:
 signals:
 
     void objectPicked(const cg3::PickableObject*, unsigned int);
+    void elementPicked(const cg3::PickableObject*, const cg3::PickHit&);
     void point2DClicked(cg3::Point2d);
 
 private:
@@ -123,6 +134,7 @@ private:
     void enableTranslation(bool b = true);
     void enableZoom(bool b = true);
     void setSelectionLeftButton(bool b = true);
+    void drawProfilerOverlay();
 
     QColor backgroundColor;
     std::vector<const cg3::DrawableObject*> drawlist;
@@ -133,6 +145,8 @@ private:
 
 	const DrawableBoundingBox3 unitBox;
     bool unitBoxEnabled;
+    bool frustumCulling;
+    FrameProfiler frameProfiler;
 };
 
 } //namespace cg3::viewer
@@ -109,6 +109,22 @@ CG3_INLINE double DrawableContainer::sceneRadius() const
     return totalBoundingBox().diag() / 2;
 }
 
+/**
+ * @brief Returns the sum of the statistics of the visible objects of the
+ * container
+ */
+CG3_INLINE DrawStatistics DrawableContainer::drawStatistics() const
+{
+    DrawStatistics s;
+    if (isVisible()){
+        for (const DrawableObject* o : objects){
+            if (o->isVisible())
+                s += o->drawStatistics();
+        }
+    }
+    return s;
+}
+
 CG3_INLINE BoundingBox3 DrawableContainer::totalBoundingBox() const
 {
     return cg3::fullBoundingBoxDrawableObjects(objects, true);
@@ -50,6 +50,7 @@ public:
     virtual void draw() const;
     virtual Point3d sceneCenter() const;
     virtual double sceneRadius() const;
+    virtual DrawStatistics drawStatistics() const;
 
 signals:
     void drawableContainerPushedObject(
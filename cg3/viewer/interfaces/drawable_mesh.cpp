@@ -7,6 +7,8 @@
 
 #include "drawable_mesh.h"
 
+#include "../internal/view_frustum.h"
+
 namespace cg3 {
 
 CG3_INLINE void DrawableMesh::init()
@@ -17,6 +19,9 @@ CG3_INLINE void DrawableMesh::init()
     wireframeColor[1] = (float)0.1;
     wireframeColor[2] = (float)0.1;
     pointWidth = 3;
+    useBuffers = -1;
+    numberLevelsOfDetail = 0;
+    pixelsPerTriangle = 2;
 }
 
 CG3_INLINE bool DrawableMesh::isWireframeEnabled() const
@@ -54,6 +59,20 @@ CG3_INLINE bool DrawableMesh::isVertexColorEnabled() const
     return drawMode & DRAW_VERTEXCOLOR;
 }
 
+CG3_INLINE bool DrawableMesh::isLevelsOfDetailEnabled() const
+{
+    return numberLevelsOfDetail > 0;
+}
+
+/**
+ * @brief Returns the number of vertices and triangles drawn by the last draw
+ * (of the level of detail, if one was drawn) and the bytes uploaded to the GPU
+ */
+CG3_INLINE DrawStatistics DrawableMesh::drawStatistics() const
+{
+    return lastDrawStatistics;
+}
+
 CG3_INLINE void DrawableMesh::setWireframe(bool b) const
 {
     if (b) drawMode |=  DRAW_WIREFRAME;
@@ -116,13 +135,114 @@ CG3_INLINE void DrawableMesh::setVisibleBoundingBox(bool b) const
     else   drawMode &= ~DRAW_BOUNDINGBOX;
 }
 
-CG3_INLINE DrawableMesh::DrawableMesh()
+/**
+ * @brief Enables or disables the levels of detail (disabled by default).
+ * Levels are computed in background every time the coordinates or the
+ * triangles of the mesh change; changes of normals and colors are applied to
+ * the existing levels.
+ * @param numberLevels: maximum number of simplified versions of the mesh
+ */
+CG3_INLINE void DrawableMesh::setLevelsOfDetail(bool b, unsigned int numberLevels) const
+{
+    numberLevelsOfDetail = b ? numberLevels : 0;
+    if (numberLevelsOfDetail == 0)
+        levelsOfDetail.clear();
+}
+
+/**
+ * @brief Sets how many pixels of the screen area covered by the mesh can be
+ * covered by a triangle before switching to a finer level of detail
+ * (default: 2). Greater values make the levels of detail used more often.
+ */
+CG3_INLINE void DrawableMesh::setLevelsOfDetailPixelsPerTriangle(double pixels) const
+{
+    pixelsPerTriangle = pixels;
+}
+
+CG3_INLINE DrawableMesh::DrawableMesh() :
+    drawnBuffers(nullptr),
+    geometryVersion(0),
+    attributesVersion(0)
 {
     init();
 }
 
+/**
+ * @brief Marks all the GPU buffers as modified: they will be uploaded again at
+ * the next draw
+ */
+CG3_INLINE void DrawableMesh::invalidateBuffers() const
+{
+    buffers.invalidate();
+    geometryVersion++;
+    attributesVersion++;
+}
+
+/**
+ * @brief Marks the given attributes (MeshAttributes flags) of the vertices
+ * from first to last (both included) as modified.
+ * @param updateTriangles: set it to false if the triangles incident to the
+ * vertices are invalidated with invalidateTriangleBuffers; otherwise the whole
+ * buffers used for triangle colors are uploaded again.
+ */
+CG3_INLINE void DrawableMesh::invalidateVertexBuffers(
+        unsigned int first,
+        unsigned int last,
+        int attributes,
+        bool updateTriangles) const
+{
+    buffers.invalidateVertices(first, last, attributes, updateTriangles);
+    if (attributes & MESH_COORDINATES)
+        geometryVersion++;
+    if (attributes & (MESH_NORMALS | MESH_COLORS))
+        attributesVersion++;
+}
+
+/**
+ * @brief Marks the given attributes (MeshAttributes flags) of the triangles
+ * from first to last (both included) as modified.
+ */
+CG3_INLINE void DrawableMesh::invalidateTriangleBuffers(
+        unsigned int first,
+        unsigned int last,
+        int attributes) const
+{
+    buffers.invalidateTriangles(first, last, attributes);
+    if (attributes & MESH_TOPOLOGY)
+        geometryVersion++;
+    if (attributes & (MESH_NORMALS | MESH_COLORS))
+        attributesVersion++;
+}
+
 CG3_INLINE void DrawableMesh::draw(unsigned int nv, unsigned int nt, const double* pCoords, const int* pTriangles, const double* pVertexNormals, const float* pVertexColors, const double* pTriangleNormals, const float* pTriangleColors, const Point3d &min, const Point3d &max) const
 {
+    if (useBuffers < 0)
+        useBuffers = opengl::buffersSupported();
+    drawnBuffers = &buffers;
+
+    //level of detail with enough triangles for the area covered on the screen
+    if (numberLevelsOfDetail > 0 && !(drawMode & DRAW_WIREFRAME)) {
+        levelsOfDetail.update({nv, nt, pCoords, pTriangles, pVertexNormals, pVertexColors, pTriangleNormals, pTriangleColors}, geometryVersion, attributesVersion, numberLevelsOfDetail);
+        if (levelsOfDetail.numberLevels() > 0) {
+            internal::ViewFrustum frustum;
+            frustum.update();
+            const double r = frustum.projectedRadius((min + max) / 2, min.dist(max) / 2);
+            const unsigned int level = levelsOfDetail.select(M_PI * r * r, pixelsPerTriangle);
+            if (level > 0) {
+                internal::MeshArrays l = levelsOfDetail.arrays(level);
+                nv = l.nv; nt = l.nt;
+                pCoords = l.coords; pTriangles = l.triangles;
+                pVertexNormals = l.vertexNormals; pVertexColors = l.vertexColors;
+                pTriangleNormals = l.triangleNormals; pTriangleColors = l.triangleColors;
+                drawnBuffers = &levelsOfDetail.buffers(level);
+            }
+        }
+    }
+
+    const unsigned long long int uploadedBefore = drawnBuffers->uploadedBytes();
+    if (useBuffers)
+        drawnBuffers->setArrays({nv, nt, pCoords, pTriangles, pVertexNormals, pVertexColors, pTriangleNormals, pTriangleColors});
+
     if (drawMode & DRAW_WIREFRAME) {
         if (drawMode & DRAW_POINTS) {
             glDisable(GL_LIGHTING);
@@ -180,9 +300,59 @@ CG3_INLINE void DrawableMesh::draw(unsigned int nv, unsigned int nt, const doubl
     if (drawMode & DRAW_BOUNDINGBOX) {
         opengl::drawBox3(min, max, QColor(0,0,0));
     }
+
+    lastDrawStatistics.vertices = nv;
+    lastDrawStatistics.triangles = (drawMode & DRAW_POINTS) && !(drawMode & DRAW_WIREFRAME) ? 0 : nt;
+    lastDrawStatistics.uploadedBytes = drawnBuffers->uploadedBytes() - uploadedBefore;
 }
 
+/**
+ * @brief Draws the mesh with the current draw mode, using the GPU buffers.
+ * Triangle colors are drawn with a triangle soup, in which every triangle has
+ * its own vertices.
+ */
 CG3_INLINE void DrawableMesh::renderPass(unsigned int nv, unsigned int nt, const double* coords, const int* triangles, const double* vertexNormals, const float* vertexColors, const double* triangleNormals, const float* triangleColors) const
+{
+    if (!useBuffers) {
+        renderPassImmediate(nv, nt, coords, triangles, vertexNormals, vertexColors, triangleNormals, triangleColors);
+        return;
+    }
+
+    if (drawMode & DRAW_POINTS) {
+        drawnBuffers->bindVertices(false, true);
+        glPointSize(pointWidth);
+        drawnBuffers->drawPoints();
+        drawnBuffers->unbind();
+    }
+    else if (drawMode & DRAW_SMOOTH || drawMode & DRAW_FLAT) {
+        if (drawMode & DRAW_FACECOLOR) {
+            drawnBuffers->bindTriangleSoup(drawMode & DRAW_SMOOTH, true);
+            drawnBuffers->drawTriangleSoup();
+            drawnBuffers->unbind();
+        }
+        else if (drawMode & DRAW_VERTEXCOLOR) {
+            drawnBuffers->bindVertices(true, true);
+            drawnBuffers->drawIndexedTriangles();
+            drawnBuffers->unbind();
+        }
+    }
+
+    if (drawMode & DRAW_WIREFRAME) {
+        drawnBuffers->bindVertices(false, false);
+
+        glLineWidth(wireframeWidth);
+        glColor4fv(wireframeColor);
+
+        drawnBuffers->drawIndexedTriangles();
+        drawnBuffers->unbind();
+    }
+}
+
+/**
+ * @brief Draws the mesh with client arrays and immediate mode, used when the
+ * OpenGL context does not support buffer objects
+ */
+CG3_INLINE void DrawableMesh::renderPassImmediate(unsigned int nv, unsigned int nt, const double* coords, const int* triangles, const double* vertexNormals, const float* vertexColors, const double* triangleNormals, const float* triangleColors) const
 {
     if (drawMode & DRAW_POINTS) {
         glEnableClientState(GL_VERTEX_ARRAY);
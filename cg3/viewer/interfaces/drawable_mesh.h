@@ -25,6 +25,8 @@
 #include <cg3/meshes/mesh.h>
 
 #include "../opengl_objects/opengl_objects3.h"
+#include "../internal/mesh_buffers.h"
+#include "../internal/mesh_levels_of_detail.h"
 #include "drawable_object.h"
 
 namespace cg3 {
@@ -44,6 +46,13 @@ void _check_gl_error(const char *file, int line);
  * @brief The DrawableMesh class
  * This is a non-instantiable class.
  * You can only inherit this class (protected constructors).
+ *
+ * When the OpenGL context supports buffer objects, the mesh is drawn from
+ * buffers stored in the GPU, that are uploaded at the first draw and then
+ * only when they are invalidated. Derived classes must call
+ * invalidateBuffers (or the range-based invalidations) every time the data
+ * of the mesh changes; a change of the number of vertices or triangles, or
+ * of the address of the arrays, is detected automatically.
  */
 class DrawableMesh : public virtual DrawableObject, public virtual Mesh
 {
@@ -60,6 +69,8 @@ public:
     bool isBboxEnabled() const;
     bool isTriangleColorEnabled() const;
     bool isVertexColorEnabled() const;
+    bool isLevelsOfDetailEnabled() const;
+    DrawStatistics drawStatistics() const;
 
     // rendering options setters
     //
@@ -73,12 +84,19 @@ public:
     void setEnableVertexColor() const;
     void setEnableTriangleColor() const;
     void setVisibleBoundingBox(bool b) const;
+    void setLevelsOfDetail(bool b, unsigned int numberLevels = 3) const;
+    void setLevelsOfDetailPixelsPerTriangle(double pixels) const;
 
 protected:
     DrawableMesh();
     virtual void draw() const = 0;
     virtual void draw(unsigned int nv, unsigned int nt, const double* pCoords, const int* pTriangles, const double* pVertexNormals, const float* pVertexColors, const double* pTriangleNormals, const float* pTriangleColors, const Point3d &min, const Point3d &max) const;
     virtual void renderPass(unsigned int nv, unsigned int nt, const double* coords, const int* triangles, const double* vertexNormals, const float* vertexColors, const double* triangleNormals, const float* triangleColors) const;
+    void renderPassImmediate(unsigned int nv, unsigned int nt, const double* coords, const int* triangles, const double* vertexNormals, const float* vertexColors, const double* triangleNormals, const float* triangleColors) const;
+
+    void invalidateBuffers() const;
+    void invalidateVertexBuffers(unsigned int first, unsigned int last, int attributes = MESH_ALL, bool updateTriangles = true) const;
+    void invalidateTriangleBuffers(unsigned int first, unsigned int last, int attributes = MESH_ALL) const;
 
     enum {
         DRAW_MESH        = 0b00000001,
@@ -95,6 +113,18 @@ protected:
     mutable int   wireframeWidth;
     mutable float wireframeColor[3];
     mutable int   pointWidth;
+
+    mutable internal::MeshBuffers buffers;
+    mutable internal::MeshBuffers* drawnBuffers; //buffers of the full mesh or of the level of detail drawn
+    mutable int useBuffers; //-1: not checked yet
+    mutable unsigned long long int geometryVersion; //incremented when coordinates or triangles are invalidated
+    mutable unsigned long long int attributesVersion; //incremented when normals or colors are invalidated
+
+    mutable internal::MeshLevelsOfDetail levelsOfDetail;
+    mutable unsigned int numberLevelsOfDetail; //0: levels of detail disabled
+    mutable double pixelsPerTriangle;
+
+    mutable DrawStatistics lastDrawStatistics;
 };
 
 } //namespace cg3
@@ -21,6 +21,25 @@ class GLCanvas;
 
 class DrawableContainer;
 
+/**
+ * @ingroup cg3viewer
+ * @brief Statistics of the last draw of a DrawableObject, collected by the
+ * frame profiler of the GLCanvas.
+ */
+struct DrawStatistics
+{
+    unsigned long long int triangles = 0;
+    unsigned long long int vertices = 0;
+    unsigned long long int uploadedBytes = 0; /**< @brief Bytes uploaded to the GPU during the last draw */
+
+    DrawStatistics& operator+=(const DrawStatistics& other) {
+        triangles += other.triangles;
+        vertices += other.vertices;
+        uploadedBytes += other.uploadedBytes;
+        return *this;
+    }
+};
+
 /**
  * @ingroup cg3viewer
  * @interface DrawableObject
@@ -65,6 +84,11 @@ public :
                                                          It should return the ray of the bounding sphere of the object, but also half diagonal of the
                                                          bounding box of the object is a good approximation. Return -1 if the object shouldn't influence
                                                          the position of the camera. */
+    inline virtual DrawStatistics drawStatistics() const { /**< @brief Returns the number of primitives drawn and of bytes
+                                                                    uploaded by the last draw, if the object counts them. */
+        return DrawStatistics();
+    }
+
     inline virtual bool isVisible() const {
         return visibility;
     }
@@ -24,6 +24,66 @@ PickableObject::PickableObject() : DrawableObject()
 {
 }
 
+/**
+ * @brief Returns true if the object implements pick(). Default is false.
+ */
+bool PickableObject::isRayPickable() const
+{
+    return false;
+}
+
+/**
+ * @brief Casts a ray (in the coordinates of the object) and returns the nearest
+ * element hit. Default implementation does not pick anything.
+ * @param[in] origin: origin of the ray
+ * @param[in] dir: direction of the ray; hit.distance is expressed in its units
+ * @param[out] hit: picked element
+ * @return true if the ray hits the object
+ */
+bool PickableObject::pick(const Point3d& origin, const Vec3d& dir, PickHit& hit) const
+{
+    CG3_SUPPRESS_WARNING(origin);
+    CG3_SUPPRESS_WARNING(dir);
+    CG3_SUPPRESS_WARNING(hit);
+    return false;
+}
+
+/**
+ * @brief Returns the ids of the faces projected inside a region of the window,
+ * also if they are occluded. Default implementation returns no faces.
+ * @param[in] view: camera used to project the object
+ * @param[in] region: rectangle (two opposite corners, or four corners) or lasso,
+ * in window coordinates
+ * @param[in] completely: if true, faces must be entirely inside the region,
+ * otherwise at least one of their vertices
+ */
+std::vector<unsigned int> PickableObject::pickFaces(
+        const PickingView& view,
+        const std::vector<Point2d>& region,
+        bool completely) const
+{
+    CG3_SUPPRESS_WARNING(view);
+    CG3_SUPPRESS_WARNING(region);
+    CG3_SUPPRESS_WARNING(completely);
+    return std::vector<unsigned int>();
+}
+
+/**
+ * @brief Returns the ids of the vertices projected inside a region of the
+ * window, also if they are occluded. Default implementation returns no vertices.
+ * @param[in] view: camera used to project the object
+ * @param[in] region: rectangle (two opposite corners, or four corners) or lasso,
+ * in window coordinates
+ */
+std::vector<unsigned int> PickableObject::pickVertices(
+        const PickingView& view,
+        const std::vector<Point2d>& region) const
+{
+    CG3_SUPPRESS_WARNING(view);
+    CG3_SUPPRESS_WARNING(region);
+    return std::vector<unsigned int>();
+}
+
 void PickableObject::setMeshBits(unsigned int nBits)
 {
     if (nBits < 32) {
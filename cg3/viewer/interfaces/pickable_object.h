@@ -9,6 +9,7 @@
 #define CG3_PICKABLE_OBJECT_H
 
 #include "drawable_object.h"
+#include "../utilities/picking.h"
 
 namespace cg3 {
 namespace viewer {
@@ -43,6 +44,12 @@ class GLCanvas;
  * max xxx pickable elements for every PickableObject pushed in the canvas).
  * If you need different values, be sure to change PickableObject::objectBits BEFORE
  * pushing a PickableObject to the GLCanvas.
+ *
+ * Objects that can be picked on the CPU (without drawing them with names) should
+ * return true in isRayPickable() and implement pick(): if all the visible objects
+ * of a GLCanvas are ray pickable, clicks are resolved casting a ray, and the
+ * drawWithNames() member function is not used. pickFaces() and pickVertices()
+ * implement rectangle and lasso selections.
  */
 class PickableObject : public virtual DrawableObject
 {
@@ -54,6 +61,16 @@ public:
 
     virtual void drawWithNames() const = 0; /**< @brief Draws all the pickable objects of the object */
 
+    virtual bool isRayPickable() const;
+    virtual bool pick(const Point3d& origin, const Vec3d& dir, PickHit& hit) const;
+    virtual std::vector<unsigned int> pickFaces(
+            const PickingView& view,
+            const std::vector<Point2d>& region,
+            bool completely = true) const;
+    virtual std::vector<unsigned int> pickVertices(
+            const PickingView& view,
+            const std::vector<Point2d>& region) const;
+
 protected:
     static void setMeshBits(unsigned int nBits);
     void glPushName(unsigned int idElement) const;
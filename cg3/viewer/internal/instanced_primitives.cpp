@@ -0,0 +1,431 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "instanced_primitives.h"
+
+#include <cg3/cg3lib.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cg3 {
+
+namespace internal {
+
+//lighting of the first light, with the color used as ambient and diffuse
+//material (GL_COLOR_MATERIAL), as computed by the fixed function pipeline
+static const char* INSTANCED_LIGHTING_GLSL =
+        "vec4 lighting(vec3 p, vec3 n, vec4 c)\n"
+        "{\n"
+        "    vec4 lp = gl_LightSource[0].position;\n"
+        "    vec3 l = normalize(lp.w == 0.0 ? lp.xyz : lp.xyz - p);\n"
+        "    float d = max(dot(n, l), 0.0);\n"
+        "    vec4 color = gl_FrontMaterial.emission + gl_LightModel.ambient * c +\n"
+        "            gl_LightSource[0].ambient * c + d * gl_LightSource[0].diffuse * c;\n"
+        "    if (d > 0.0) {\n"
+        "        vec3 h = normalize(l + vec3(0.0, 0.0, 1.0));\n"
+        "        color += pow(max(dot(n, h), 0.0), gl_FrontMaterial.shininess) *\n"
+        "                gl_LightSource[0].specular * gl_FrontMaterial.specular;\n"
+        "    }\n"
+        "    color.a = c.a;\n"
+        "    return color;\n"
+        "}\n";
+
+static const char* INSTANCED_SPHERE_GLSL =
+        "attribute vec3 unitVertex;\n"
+        "attribute vec4 sphere;\n"
+        "attribute vec4 color;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 p = gl_ModelViewMatrix * vec4(sphere.xyz + sphere.w * unitVertex, 1.0);\n"
+        "    vec3 n = normalize(gl_NormalMatrix * unitVertex);\n"
+        "    gl_FrontColor = lighting(p.xyz / p.w, n, color);\n"
+        "    gl_Position = gl_ProjectionMatrix * p;\n"
+        "}\n";
+
+static const char* INSTANCED_TUBE_GLSL =
+        "attribute vec4 unitVertex;\n"
+        "attribute vec4 a;\n"
+        "attribute vec4 b;\n"
+        "attribute vec4 color;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 axis = b.xyz - a.xyz;\n"
+        "    float len = length(axis);\n"
+        "    vec3 w = len > 0.0 ? axis / len : vec3(0.0, 0.0, 1.0);\n"
+        "    vec3 e1 = normalize(cross(w, abs(w.x) < 0.9 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0)));\n"
+        "    vec3 radial = unitVertex.x * e1 + unitVertex.y * cross(w, e1);\n"
+        "    vec3 n;\n"
+        "    if (unitVertex.w > 0.5)\n"
+        "        n = normalize(radial * len + w * (a.w - b.w));\n"
+        "    else\n"
+        "        n = unitVertex.z < 0.5 ? -w : w;\n"
+        "    vec4 p = gl_ModelViewMatrix * vec4(a.xyz + unitVertex.z * axis + mix(a.w, b.w, unitVertex.z) * radial, 1.0);\n"
+        "    gl_FrontColor = lighting(p.xyz / p.w, normalize(gl_NormalMatrix * n), color);\n"
+        "    gl_Position = gl_ProjectionMatrix * p;\n"
+        "}\n";
+
+/**
+ * @brief Creates an empty set of instances.
+ * @param resolution: slices and stacks of the unit sphere (at least 3), or
+ * slices of the unit tube (at least 3)
+ */
+CG3_INLINE InstancedPrimitives::InstancedPrimitives(Shape shape, unsigned int resolution) :
+    _shape(shape),
+    res(std::max(resolution, 3u)),
+    useInstancing(-1),
+    unitIndexBuffer(GL_ELEMENT_ARRAY_BUFFER),
+    unitModified(true),
+    allModified(true),
+    firstModified(1),
+    lastModified(0),
+    uploadedBytes(0)
+{
+    buildUnitMesh();
+}
+
+CG3_INLINE InstancedPrimitives::Shape InstancedPrimitives::shape() const
+{
+    return _shape;
+}
+
+CG3_INLINE unsigned int InstancedPrimitives::resolution() const
+{
+    return res;
+}
+
+CG3_INLINE void InstancedPrimitives::setResolution(unsigned int resolution)
+{
+    resolution = std::max(resolution, 3u);
+    if (resolution != res) {
+        res = resolution;
+        buildUnitMesh();
+    }
+}
+
+CG3_INLINE unsigned int InstancedPrimitives::size() const
+{
+    return (unsigned int) colors.size() / 4;
+}
+
+CG3_INLINE void InstancedPrimitives::clear()
+{
+    resize(0);
+}
+
+/**
+ * @brief Changes the number of instances. New instances are degenerate
+ * (radius 0) until they are set.
+ */
+CG3_INLINE void InstancedPrimitives::resize(unsigned int n)
+{
+    instances.resize((size_t) n * floatsPerInstance(), 0.0f);
+    colors.resize((size_t) n * 4, 0);
+    allModified = true;
+}
+
+CG3_INLINE void InstancedPrimitives::setSphere(
+        unsigned int i,
+        const Point3d& center,
+        double radius,
+        const Color& color)
+{
+    float* s = &instances[(size_t) i * 4];
+    s[0] = (float) center.x();
+    s[1] = (float) center.y();
+    s[2] = (float) center.z();
+    s[3] = (float) radius;
+    setColor(i, color);
+}
+
+CG3_INLINE void InstancedPrimitives::setTube(
+        unsigned int i,
+        const Point3d& a,
+        double radiusA,
+        const Point3d& b,
+        double radiusB,
+        const Color& color)
+{
+    float* t = &instances[(size_t) i * 8];
+    t[0] = (float) a.x();
+    t[1] = (float) a.y();
+    t[2] = (float) a.z();
+    t[3] = (float) radiusA;
+    t[4] = (float) b.x();
+    t[5] = (float) b.y();
+    t[6] = (float) b.z();
+    t[7] = (float) radiusB;
+    setColor(i, color);
+}
+
+CG3_INLINE void InstancedPrimitives::setColor(unsigned int i, const Color& color)
+{
+    unsigned char* c = &colors[(size_t) i * 4];
+    c[0] = (unsigned char) color.red();
+    c[1] = (unsigned char) color.green();
+    c[2] = (unsigned char) color.blue();
+    c[3] = (unsigned char) color.alpha();
+    invalidate(i);
+}
+
+/**
+ * @brief Draws all the instances, with smooth shading and lighting enabled
+ * (as opengl::drawSphere and opengl::drawCylinder do).
+ */
+CG3_INLINE void InstancedPrimitives::draw() const
+{
+    uploadedBytes = 0;
+    if (size() == 0)
+        return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_LIGHTING_BIT | GL_POLYGON_BIT);
+    glEnable(GL_LIGHTING);
+    glShadeModel(GL_SMOOTH);
+    if (_shape == TUBE) {
+        glDisable(GL_CULL_FACE);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    }
+
+    if (useInstancing < 0)
+        useInstancing = opengl::instancingSupported() && opengl::buffersSupported();
+    if (useInstancing && !prepareProgram())
+        useInstancing = 0;
+
+    if (useInstancing)
+        drawInstanced();
+    else
+        drawArrays();
+
+    glPopAttrib();
+}
+
+/**
+ * @brief Returns the triangles and vertices drawn by the last draw, and the
+ * bytes uploaded to the GPU
+ */
+CG3_INLINE DrawStatistics InstancedPrimitives::drawStatistics() const
+{
+    DrawStatistics s;
+    s.triangles = (unsigned long long int) size() * (unitIndices.size() / 3);
+    s.vertices = (unsigned long long int) size() * (unitVertices.size() / floatsPerVertex());
+    s.uploadedBytes = uploadedBytes;
+    return s;
+}
+
+/**
+ * @brief Unit sphere with res slices and res stacks, as gluSphere, or unit
+ * tube with res slices along the z axis, from z = 0 to z = 1.
+ */
+CG3_INLINE void InstancedPrimitives::buildUnitMesh()
+{
+    unitVertices.clear();
+    unitIndices.clear();
+    if (_shape == SPHERE) {
+        for (unsigned int i = 0; i <= res; i++) {
+            double phi = M_PI * i / res;
+            for (unsigned int j = 0; j <= res; j++) {
+                double theta = 2 * M_PI * j / res;
+                unitVertices.push_back((float) (std::cos(theta) * std::sin(phi)));
+                unitVertices.push_back((float) (std::sin(theta) * std::sin(phi)));
+                unitVertices.push_back((float) std::cos(phi));
+            }
+        }
+        for (unsigned int i = 0; i < res; i++) {
+            for (unsigned int j = 0; j < res; j++) {
+                unsigned int a = i * (res + 1) + j, b = a + res + 1;
+                unitIndices.insert(unitIndices.end(), {a, b, a + 1, a + 1, b, b + 1});
+            }
+        }
+    }
+    else {
+        //side: pairs of vertices at z = 0 and z = 1
+        for (unsigned int j = 0; j <= res; j++) {
+            float c = (float) std::cos(2 * M_PI * j / res), s = (float) std::sin(2 * M_PI * j / res);
+            unitVertices.insert(unitVertices.end(), {c, s, 0, 1, c, s, 1, 1});
+        }
+        for (unsigned int j = 0; j < res; j++) {
+            unsigned int a = 2 * j, b = a + 2;
+            unitIndices.insert(unitIndices.end(), {a, b, a + 1, a + 1, b, b + 1});
+        }
+        //disks: center and border
+        for (unsigned int k = 0; k < 2; k++) {
+            unsigned int center = (unsigned int) unitVertices.size() / 4;
+            unitVertices.insert(unitVertices.end(), {0, 0, (float) k, 0});
+            for (unsigned int j = 0; j <= res; j++) {
+                float c = (float) std::cos(2 * M_PI * j / res), s = (float) std::sin(2 * M_PI * j / res);
+                unitVertices.insert(unitVertices.end(), {c, s, (float) k, 0});
+            }
+            for (unsigned int j = 0; j < res; j++) {
+                if (k == 0)
+                    unitIndices.insert(unitIndices.end(), {center, center + j + 2, center + j + 1});
+                else
+                    unitIndices.insert(unitIndices.end(), {center, center + j + 1, center + j + 2});
+            }
+        }
+    }
+    unitModified = true;
+}
+
+CG3_INLINE void InstancedPrimitives::invalidate(unsigned int i)
+{
+    if (allModified)
+        return;
+    if (firstModified > lastModified) {
+        firstModified = lastModified = i;
+    }
+    else {
+        firstModified = std::min(firstModified, i);
+        lastModified = std::max(lastModified, i);
+    }
+}
+
+CG3_INLINE unsigned int InstancedPrimitives::floatsPerInstance() const
+{
+    return _shape == SPHERE ? 4 : 8;
+}
+
+CG3_INLINE unsigned int InstancedPrimitives::floatsPerVertex() const
+{
+    return _shape == SPHERE ? 3 : 4;
+}
+
+CG3_INLINE bool InstancedPrimitives::prepareProgram() const
+{
+    if (program.isCreated())
+        return true;
+    std::string source = std::string("#version 120\n") + INSTANCED_LIGHTING_GLSL;
+    if (_shape == SPHERE)
+        return program.create(
+                    source + INSTANCED_SPHERE_GLSL, "",
+                    {{0, "unitVertex"}, {1, "sphere"}, {3, "color"}});
+    else
+        return program.create(
+                    source + INSTANCED_TUBE_GLSL, "",
+                    {{0, "unitVertex"}, {1, "a"}, {2, "b"}, {3, "color"}});
+}
+
+/**
+ * @brief Uploads the unit mesh if it has been rebuilt, and the modified
+ * instances.
+ */
+CG3_INLINE void InstancedPrimitives::upload() const
+{
+    if (unitModified || !unitVertexBuffer.isCreated()) {
+        unitVertexBuffer.allocate(unitVertices.data(), unitVertices.size() * sizeof(float));
+        unitIndexBuffer.allocate(unitIndices.data(), unitIndices.size() * sizeof(unsigned int));
+        uploadedBytes += unitVertices.size() * sizeof(float) + unitIndices.size() * sizeof(unsigned int);
+        unitModified = false;
+    }
+    if (allModified || instanceBuffer.size() != instances.size() * sizeof(float)) {
+        instanceBuffer.allocate(instances.data(), instances.size() * sizeof(float));
+        colorBuffer.allocate(colors.data(), colors.size());
+        uploadedBytes += instances.size() * sizeof(float) + colors.size();
+    }
+    else if (firstModified <= lastModified) {
+        const size_t fpi = floatsPerInstance();
+        const size_t n = lastModified - firstModified + 1;
+        instanceBuffer.write(firstModified * fpi * sizeof(float), &instances[firstModified * fpi], n * fpi * sizeof(float));
+        colorBuffer.write(firstModified * 4, &colors[firstModified * 4], n * 4);
+        uploadedBytes += n * (fpi * sizeof(float) + 4);
+    }
+    allModified = false;
+    firstModified = 1;
+    lastModified = 0;
+}
+
+CG3_INLINE void InstancedPrimitives::drawInstanced() const
+{
+    upload();
+    program.bind();
+
+    unitVertexBuffer.bind();
+    opengl::enableVertexAttribArray(0);
+    opengl::vertexAttribPointer(0, floatsPerVertex(), GL_FLOAT, false, 0, nullptr);
+
+    const GLsizei stride = floatsPerInstance() * sizeof(float);
+    const GLuint lastAttribute = _shape == SPHERE ? 1 : 2;
+    instanceBuffer.bind();
+    for (GLuint a = 1; a <= lastAttribute; a++) {
+        opengl::enableVertexAttribArray(a);
+        opengl::vertexAttribPointer(a, 4, GL_FLOAT, false, stride, (const void*) ((a - 1) * 4 * sizeof(float)));
+        opengl::vertexAttribDivisor(a, 1);
+    }
+    colorBuffer.bind();
+    opengl::enableVertexAttribArray(3);
+    opengl::vertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, true, 0, nullptr);
+    opengl::vertexAttribDivisor(3, 1);
+
+    unitIndexBuffer.bind();
+    opengl::drawElementsInstanced(GL_TRIANGLES, (GLsizei) unitIndices.size(), GL_UNSIGNED_INT, nullptr, (GLsizei) size());
+
+    //divisors are state of the context: the other objects use per vertex attributes
+    for (GLuint a = 0; a <= 3; a++) {
+        if (a > lastAttribute && a < 3)
+            continue;
+        opengl::vertexAttribDivisor(a, 0);
+        opengl::disableVertexAttribArray(a);
+    }
+    unitIndexBuffer.release();
+    colorBuffer.release();
+    program.release();
+}
+
+/**
+ * @brief Draws every instance from vertex arrays, for contexts without
+ * instancing
+ */
+CG3_INLINE void InstancedPrimitives::drawArrays() const
+{
+    const unsigned int nv = (unsigned int) unitVertices.size() / floatsPerVertex();
+    coords.resize(nv * 3);
+    normals.resize(nv * 3);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, coords.data());
+    glNormalPointer(GL_FLOAT, 0, normals.data());
+
+    for (unsigned int i = 0; i < size(); i++) {
+        const float* p = &instances[(size_t) i * floatsPerInstance()];
+        if (_shape == SPHERE) {
+            for (unsigned int v = 0; v < nv; v++) {
+                for (unsigned int k = 0; k < 3; k++) {
+                    normals[3*v+k] = unitVertices[3*v+k];
+                    coords[3*v+k] = p[k] + p[3] * unitVertices[3*v+k];
+                }
+            }
+        }
+        else {
+            Vec3d a(p[0], p[1], p[2]), axis = Vec3d(p[4], p[5], p[6]) - a;
+            double length = axis.length();
+            Vec3d w = length > 0 ? axis / length : Vec3d(0, 0, 1);
+            Vec3d e1 = w.cross(std::abs(w.x()) < 0.9 ? Vec3d(1, 0, 0) : Vec3d(0, 1, 0));
+            e1.normalize();
+            Vec3d e2 = w.cross(e1);
+            for (unsigned int v = 0; v < nv; v++) {
+                const float* u = &unitVertices[4*v];
+                Vec3d radial = e1 * u[0] + e2 * u[1];
+                Vec3d n = u[3] > 0.5f ? radial * length + w * (p[3] - p[7]) : (u[2] < 0.5f ? -w : w);
+                n.normalize();
+                Vec3d c = a + axis * u[2] + radial * (p[3] + (p[7] - p[3]) * u[2]);
+                for (unsigned int k = 0; k < 3; k++) {
+                    coords[3*v+k] = (float) c[k];
+                    normals[3*v+k] = (float) n[k];
+                }
+            }
+        }
+        glColor4ubv(&colors[(size_t) i * 4]);
+        glDrawElements(GL_TRIANGLES, (GLsizei) unitIndices.size(), GL_UNSIGNED_INT, unitIndices.data());
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+}
+
+} //namespace cg3::internal
+
+} //namespace cg3
@@ -0,0 +1,104 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_INSTANCED_PRIMITIVES_H
+#define CG3_INSTANCED_PRIMITIVES_H
+
+#include "../opengl_objects/opengl_buffer.h"
+#include "../opengl_objects/opengl_program.h"
+
+#include <cg3/geometry/point3.h>
+#include <cg3/utilities/color.h>
+#include "../interfaces/drawable_object.h"
+
+#include <vector>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Instances of a unit sphere or of a unit tube, drawn with a single
+ * instanced draw call.
+ *
+ * The unit mesh is built once and stored in GPU buffers, together with a
+ * buffer of per instance parameters (center and radius of the spheres, end
+ * points and radii of the tubes) and a buffer of per instance colors. A vertex
+ * shader places the unit mesh and computes the lighting of the first light as
+ * the fixed function pipeline does. Only the ranges of modified instances are
+ * uploaded again.
+ *
+ * A tube goes from a point a to a point b, and its radius varies linearly
+ * from the radius at a to the radius at b: cylinders, cones and truncated
+ * cones, closed by two disks.
+ *
+ * If the OpenGL context does not support instancing, every instance is drawn
+ * from vertex arrays computed from the unit mesh.
+ */
+class InstancedPrimitives
+{
+public:
+    enum Shape {SPHERE, TUBE};
+
+    InstancedPrimitives(Shape shape = SPHERE, unsigned int resolution = 10);
+
+    Shape shape() const;
+    unsigned int resolution() const;
+    void setResolution(unsigned int resolution);
+
+    unsigned int size() const;
+    void clear();
+    void resize(unsigned int n);
+    void setSphere(unsigned int i, const Point3d& center, double radius, const Color& color);
+    void setTube(unsigned int i, const Point3d& a, double radiusA, const Point3d& b, double radiusB, const Color& color);
+    void setColor(unsigned int i, const Color& color);
+
+    void draw() const;
+    DrawStatistics drawStatistics() const;
+
+protected:
+    void buildUnitMesh();
+    void invalidate(unsigned int i);
+    unsigned int floatsPerInstance() const;
+    unsigned int floatsPerVertex() const;
+    bool prepareProgram() const;
+    void upload() const;
+    void drawInstanced() const;
+    void drawArrays() const;
+
+    Shape _shape;
+    unsigned int res;
+
+    std::vector<float> unitVertices;   //(x, y, z) on the unit sphere, (cos, sin, t, side) on the unit tube
+    std::vector<unsigned int> unitIndices;
+    std::vector<float> instances;      //(center, radius) or (a, radius a, b, radius b)
+    std::vector<unsigned char> colors; //RGBA
+
+    mutable int useInstancing;
+    mutable opengl::Program program;
+    mutable opengl::Buffer unitVertexBuffer;
+    mutable opengl::Buffer unitIndexBuffer;
+    mutable opengl::Buffer instanceBuffer;
+    mutable opengl::Buffer colorBuffer;
+    mutable bool unitModified;
+    mutable bool allModified;
+    mutable unsigned int firstModified, lastModified;
+    mutable unsigned long long int uploadedBytes; //by the last draw
+    mutable std::vector<float> coords, normals; //vertex arrays used without instancing
+};
+
+} //namespace cg3::internal
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_INSTANCED_PRIMITIVES_CPP "instanced_primitives.cpp"
+#include CG3_INSTANCED_PRIMITIVES_CPP
+#undef CG3_INSTANCED_PRIMITIVES_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_INSTANCED_PRIMITIVES_H
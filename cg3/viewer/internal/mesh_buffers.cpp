@@ -0,0 +1,356 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "mesh_buffers.h"
+
+#include <cg3/cg3lib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace cg3 {
+namespace internal {
+
+namespace {
+
+//ranges smaller than this are converted sequentially
+const long long int PARALLEL_CONVERSION_THRESHOLD = 16384;
+
+inline void toFloat3(const double* in, float* out)
+{
+    out[0] = (float)in[0];
+    out[1] = (float)in[1];
+    out[2] = (float)in[2];
+}
+
+//normals are stored as 4 shorts (the 4th is padding), normalized by OpenGL
+inline void toShort4(const double* in, short* out)
+{
+    for (uint i = 0; i < 3; ++i)
+        out[i] = (short)std::lround(std::min(1.0, std::max(-1.0, in[i])) * 32767);
+    out[3] = 0;
+}
+
+inline void toRGBA8(const float* in, unsigned char* out)
+{
+    for (uint i = 0; i < 3; ++i)
+        out[i] = (unsigned char)std::lround(std::min(1.0f, std::max(0.0f, in[i])) * 255);
+    out[3] = 255;
+}
+
+} //namespace
+
+CG3_INLINE void MeshBuffers::DirtyRange::add(unsigned int f, unsigned int l)
+{
+    if (all)
+        return;
+    if (empty()) {
+        first = f;
+        last = l;
+    }
+    else {
+        first = std::min(first, f);
+        last = std::max(last, l);
+    }
+}
+
+CG3_INLINE bool MeshBuffers::DirtyRange::empty() const
+{
+    return !all && first >= last;
+}
+
+CG3_INLINE void MeshBuffers::DirtyRange::clear()
+{
+    all = false;
+    first = last = 0;
+}
+
+CG3_INLINE MeshBuffers::AttributeBuffer::AttributeBuffer(GLenum target) :
+    buffer(target),
+    elements(0)
+{
+}
+
+CG3_INLINE MeshBuffers::MeshBuffers() :
+    m({0, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr}),
+    soupSmoothNormals(true),
+    buffers(N_BUFFERS),
+    uploaded(0)
+{
+    buffers[INDICES] = AttributeBuffer(GL_ELEMENT_ARRAY_BUFFER);
+}
+
+/**
+ * @brief Sets the arrays of the mesh that will be drawn. If the number of
+ * elements or the location of an array changed, all the buffers are uploaded
+ * again.
+ */
+CG3_INLINE void MeshBuffers::setArrays(const MeshArrays& arrays)
+{
+    if (arrays.nv != m.nv || arrays.nt != m.nt ||
+            arrays.coords != m.coords || arrays.triangles != m.triangles ||
+            arrays.vertexNormals != m.vertexNormals || arrays.vertexColors != m.vertexColors ||
+            arrays.triangleNormals != m.triangleNormals || arrays.triangleColors != m.triangleColors) {
+        invalidate();
+    }
+    m = arrays;
+}
+
+/**
+ * @brief Marks all the buffers as modified
+ */
+CG3_INLINE void MeshBuffers::invalidate()
+{
+    for (AttributeBuffer& b : buffers)
+        b.dirty.all = true;
+}
+
+/**
+ * @brief Marks the given attributes of the vertices from first to last (both
+ * included) as modified.
+ * @param updateTriangles: if true, the triangle soup is uploaded again: it
+ * duplicates coordinates and normals of the vertices in every triangle.
+ * Set it to false if the triangles incident to the modified vertices are
+ * invalidated with invalidateTriangles.
+ */
+CG3_INLINE void MeshBuffers::invalidateVertices(
+        unsigned int first,
+        unsigned int last,
+        int attributes,
+        bool updateTriangles)
+{
+    if (attributes & MESH_COORDINATES) {
+        buffers[V_COORDS].dirty.add(first, last + 1);
+        if (updateTriangles)
+            buffers[S_COORDS].dirty.all = true;
+    }
+    if (attributes & MESH_NORMALS) {
+        buffers[V_NORMALS].dirty.add(first, last + 1);
+        if (updateTriangles)
+            buffers[S_NORMALS].dirty.all = true;
+    }
+    if (attributes & MESH_COLORS)
+        buffers[V_COLORS].dirty.add(first, last + 1);
+}
+
+/**
+ * @brief Marks the given attributes of the triangles from first to last (both
+ * included) as modified. Coordinates and normals refer to the triangle soup,
+ * that copies the coordinates and normals of the vertices of the triangles.
+ */
+CG3_INLINE void MeshBuffers::invalidateTriangles(
+        unsigned int first,
+        unsigned int last,
+        int attributes)
+{
+    if (attributes & MESH_TOPOLOGY)
+        buffers[INDICES].dirty.add(first, last + 1);
+    if (attributes & (MESH_COORDINATES | MESH_TOPOLOGY))
+        buffers[S_COORDS].dirty.add(first, last + 1);
+    if (attributes & (MESH_NORMALS | MESH_TOPOLOGY))
+        buffers[S_NORMALS].dirty.add(first, last + 1);
+    if (attributes & (MESH_COLORS | MESH_TOPOLOGY))
+        buffers[S_COLORS].dirty.add(first, last + 1);
+}
+
+/**
+ * @brief Uploads (if needed) and binds the per-vertex arrays, enabling the
+ * client states of the fixed pipeline.
+ */
+CG3_INLINE void MeshBuffers::bindVertices(bool normals, bool colors)
+{
+    prepare(V_COORDS);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, nullptr);
+    if (normals) {
+        prepare(V_NORMALS);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glNormalPointer(GL_SHORT, 4 * sizeof(short), nullptr);
+    }
+    if (colors) {
+        prepare(V_COLORS);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+    }
+    buffers[V_COORDS].buffer.release();
+}
+
+/**
+ * @brief Uploads (if needed) and binds the arrays of the triangle soup,
+ * enabling the client states of the fixed pipeline.
+ * @param smoothNormals: vertex normals if true, triangle normals otherwise
+ */
+CG3_INLINE void MeshBuffers::bindTriangleSoup(bool smoothNormals, bool colors)
+{
+    if (smoothNormals != soupSmoothNormals) {
+        soupSmoothNormals = smoothNormals;
+        buffers[S_NORMALS].dirty.all = true;
+    }
+    prepare(S_COORDS);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, nullptr);
+    prepare(S_NORMALS);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glNormalPointer(GL_SHORT, 4 * sizeof(short), nullptr);
+    if (colors) {
+        prepare(S_COLORS);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+    }
+    buffers[S_COORDS].buffer.release();
+}
+
+/**
+ * @brief Draws the triangles using the index buffer. Vertex arrays must be
+ * bound with bindVertices.
+ */
+CG3_INLINE void MeshBuffers::drawIndexedTriangles()
+{
+    prepare(INDICES);
+    glDrawElements(GL_TRIANGLES, 3 * m.nt, GL_UNSIGNED_INT, nullptr);
+    buffers[INDICES].buffer.release();
+}
+
+CG3_INLINE void MeshBuffers::drawPoints()
+{
+    glDrawArrays(GL_POINTS, 0, m.nv);
+}
+
+CG3_INLINE void MeshBuffers::drawTriangleSoup()
+{
+    glDrawArrays(GL_TRIANGLES, 0, 3 * m.nt);
+}
+
+/**
+ * @brief Disables the client states enabled by bindVertices and
+ * bindTriangleSoup
+ */
+CG3_INLINE void MeshBuffers::unbind()
+{
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+/**
+ * @brief Returns the total number of bytes uploaded to the GPU
+ */
+CG3_INLINE unsigned long long int MeshBuffers::uploadedBytes() const
+{
+    return uploaded;
+}
+
+/**
+ * @brief Uploads the modified range of the buffer b, and leaves it bound.
+ * The buffer is reallocated if it has never been uploaded or if the number
+ * of its elements changed.
+ */
+CG3_INLINE void MeshBuffers::prepare(unsigned int b)
+{
+    AttributeBuffer& ab = buffers[b];
+    unsigned int n = b < INDICES ? m.nv : m.nt;
+    if (n != ab.elements || !ab.buffer.isCreated())
+        ab.dirty.all = true;
+
+    if (!ab.dirty.empty()) {
+        unsigned int first = ab.dirty.all ? 0 : ab.dirty.first;
+        unsigned int last = ab.dirty.all ? n : std::min(ab.dirty.last, n);
+        std::size_t es = elementSize(b);
+        if (first < last)
+            fill(b, first, last, staging);
+        if (ab.dirty.all) {
+            ab.buffer.allocate(n > 0 ? staging.data() : nullptr, n * es);
+            ab.elements = n;
+        }
+        else if (first < last) {
+            ab.buffer.write(first * es, staging.data(), (last - first) * es);
+        }
+        if (first < last)
+            uploaded += (last - first) * es;
+        ab.dirty.clear();
+    }
+    ab.buffer.bind();
+}
+
+/**
+ * @brief Converts the elements of buffer b from first to last (excluded)
+ * in the format of the buffer.
+ */
+CG3_INLINE void MeshBuffers::fill(
+        unsigned int b,
+        unsigned int first,
+        unsigned int last,
+        std::vector<unsigned char>& data) const
+{
+    const std::size_t es = elementSize(b);
+    data.resize((last - first) * es);
+    unsigned char* out = data.data();
+    const double zero[3] = {0, 0, 0};
+    const float white[3] = {1, 1, 1};
+
+    if (b == INDICES) {
+        std::memcpy(out, m.triangles + 3 * first, (last - first) * es);
+        return;
+    }
+
+    #pragma omp parallel for if((long long int)(last - first) > PARALLEL_CONVERSION_THRESHOLD)
+    for (long long int i = first; i < (long long int)last; ++i) {
+        unsigned char* e = out + (i - first) * es;
+        const int* t = m.triangles + 3 * i;
+        switch (b) {
+        case V_COORDS:
+            toFloat3(m.coords + 3 * i, (float*)e);
+            break;
+        case V_NORMALS:
+            toShort4(m.vertexNormals ? m.vertexNormals + 3 * i : zero, (short*)e);
+            break;
+        case V_COLORS:
+            toRGBA8(m.vertexColors ? m.vertexColors + 3 * i : white, e);
+            break;
+        case S_COORDS:
+            for (uint c = 0; c < 3; ++c)
+                toFloat3(m.coords + 3 * t[c], (float*)e + 3 * c);
+            break;
+        case S_NORMALS:
+            for (uint c = 0; c < 3; ++c) {
+                const double* n = zero;
+                if (soupSmoothNormals && m.vertexNormals)
+                    n = m.vertexNormals + 3 * t[c];
+                else if (!soupSmoothNormals && m.triangleNormals)
+                    n = m.triangleNormals + 3 * i;
+                toShort4(n, (short*)e + 4 * c);
+            }
+            break;
+        case S_COLORS:
+            for (uint c = 0; c < 3; ++c)
+                toRGBA8(m.triangleColors ? m.triangleColors + 3 * i : white, e + 4 * c);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Size in bytes of the data stored for a vertex (per-vertex buffers)
+ * or for a triangle (indices and triangle soup)
+ */
+CG3_INLINE unsigned int MeshBuffers::elementSize(unsigned int b)
+{
+    switch (b) {
+    case V_COORDS:  return 3 * sizeof(float);
+    case V_NORMALS: return 4 * sizeof(short);
+    case V_COLORS:  return 4;
+    case INDICES:   return 3 * sizeof(GLuint);
+    case S_COORDS:  return 9 * sizeof(float);
+    case S_NORMALS: return 12 * sizeof(short);
+    case S_COLORS:  return 12;
+    default:        return 0;
+    }
+}
+
+} //namespace cg3::internal
+} //namespace cg3
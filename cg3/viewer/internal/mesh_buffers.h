@@ -0,0 +1,118 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_MESH_BUFFERS_H
+#define CG3_MESH_BUFFERS_H
+
+#include "../opengl_objects/opengl_buffer.h"
+
+#include <vector>
+
+namespace cg3 {
+
+/**
+ * @brief Attributes of a DrawableMesh that can be marked as modified
+ */
+enum MeshAttributes {
+    MESH_COORDINATES = 0b0001,
+    MESH_NORMALS     = 0b0010,
+    MESH_COLORS      = 0b0100,
+    MESH_TOPOLOGY    = 0b1000,
+    MESH_ALL         = 0b1111
+};
+
+namespace internal {
+
+/**
+ * @brief Arrays of a mesh, as given to DrawableMesh::draw
+ */
+struct MeshArrays {
+    unsigned int nv;
+    unsigned int nt;
+    const double* coords;
+    const int* triangles;
+    const double* vertexNormals;
+    const float* vertexColors;
+    const double* triangleNormals;
+    const float* triangleColors;
+};
+
+/**
+ * @brief Retained GPU buffers of a DrawableMesh.
+ *
+ * Indexed buffers (one entry for every vertex, plus the triangle indices) are
+ * used for points, vertex colors and wireframe. Triangle colors need an
+ * attribute per triangle: they use a triangle soup, in which every triangle
+ * has its own three vertices, with vertex normals (smooth shading) or
+ * triangle normals (flat shading).
+ *
+ * Coordinates are stored as floats, normals as normalized shorts and colors
+ * as RGBA bytes. Buffers are created only when a draw mode needs them, and
+ * only the ranges marked as modified are uploaded again.
+ */
+class MeshBuffers
+{
+public:
+    MeshBuffers();
+
+    void setArrays(const MeshArrays& arrays);
+    void invalidate();
+    void invalidateVertices(unsigned int first, unsigned int last, int attributes, bool updateTriangles = true);
+    void invalidateTriangles(unsigned int first, unsigned int last, int attributes);
+
+    void bindVertices(bool normals, bool colors);
+    void bindTriangleSoup(bool smoothNormals, bool colors);
+    void drawIndexedTriangles();
+    void drawPoints();
+    void drawTriangleSoup();
+    void unbind();
+
+    unsigned long long int uploadedBytes() const;
+
+protected:
+    /**
+     * @brief Range of modified elements of a buffer
+     */
+    struct DirtyRange {
+        unsigned int first = 0, last = 0;
+        bool all = true;
+        void add(unsigned int f, unsigned int l);
+        bool empty() const;
+        void clear();
+    };
+
+    struct AttributeBuffer {
+        AttributeBuffer(GLenum target = GL_ARRAY_BUFFER);
+        opengl::Buffer buffer;
+        DirtyRange dirty;
+        unsigned int elements;
+    };
+
+    enum { V_COORDS, V_NORMALS, V_COLORS, INDICES, S_COORDS, S_NORMALS, S_COLORS, N_BUFFERS };
+
+    void prepare(unsigned int b);
+    void fill(unsigned int b, unsigned int first, unsigned int last, std::vector<unsigned char>& data) const;
+    static unsigned int elementSize(unsigned int b);
+
+    MeshArrays m;
+    bool soupSmoothNormals;
+    std::vector<AttributeBuffer> buffers;
+    std::vector<unsigned char> staging;
+    unsigned long long int uploaded;
+};
+
+} //namespace cg3::internal
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_MESH_BUFFERS_CPP "mesh_buffers.cpp"
+#include CG3_MESH_BUFFERS_CPP
+#undef CG3_MESH_BUFFERS_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_MESH_BUFFERS_H
@@ -0,0 +1,369 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "mesh_levels_of_detail.h"
+
+#include <cg3/cg3lib.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cg3 {
+
+namespace internal {
+
+namespace lod {
+
+struct TriangleHash {
+    size_t operator()(const std::array<int, 3>& t) const
+    {
+        return std::hash<long long int>()(((long long int) t[0] * 73856093) ^ ((long long int) t[1] * 19349663) ^ ((long long int) t[2] * 83492791));
+    }
+};
+
+} //namespace cg3::internal::lod
+
+CG3_INLINE bool MeshLevelsOfDetail::Key::operator==(const Key& other) const
+{
+    return version == other.version && nv == other.nv && nt == other.nt &&
+            coords == other.coords && triangles == other.triangles &&
+            numberLevels == other.numberLevels;
+}
+
+CG3_INLINE MeshLevelsOfDetail::MeshLevelsOfDetail() :
+    attributesKey(0)
+{
+}
+
+/**
+ * @brief The copy has no levels: they are computed again at the next update.
+ */
+CG3_INLINE MeshLevelsOfDetail::MeshLevelsOfDetail(const MeshLevelsOfDetail&) :
+    attributesKey(0)
+{
+}
+
+/**
+ * @brief Waits for the levels that are being computed, if any.
+ */
+CG3_INLINE MeshLevelsOfDetail::~MeshLevelsOfDetail()
+{
+    if (building.valid())
+        building.wait();
+}
+
+CG3_INLINE MeshLevelsOfDetail& MeshLevelsOfDetail::operator=(const MeshLevelsOfDetail& other)
+{
+    if (this != &other)
+        clear();
+    return *this;
+}
+
+/**
+ * @brief Collects the levels computed in background and, if the geometry of
+ * the mesh changed since they have been requested, starts computing them
+ * again. If only normals or colors changed, they are updated in the existing
+ * levels. It must be called at every draw, with the OpenGL context current.
+ * @param geometryVersion: must change every time coordinates or triangles change
+ * @param attributesVersion: must change every time normals or colors change
+ */
+CG3_INLINE void MeshLevelsOfDetail::update(
+        const MeshArrays& mesh,
+        unsigned long long int geometryVersion,
+        unsigned long long int attributesVersion,
+        unsigned int numberLevels)
+{
+    Key k;
+    k.version = geometryVersion;
+    k.nv = mesh.nv;
+    k.nt = mesh.nt;
+    k.coords = mesh.coords;
+    k.triangles = mesh.triangles;
+    k.numberLevels = numberLevels;
+
+    if (building.valid()) {
+        if (building.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+        Levels result = building.get();
+        if (buildingKey == k) {
+            levels = std::move(result);
+            key = k;
+            updateAttributes(mesh);
+            attributesKey = attributesVersion;
+        }
+    }
+    if (key == k) {
+        if (attributesKey != attributesVersion) {
+            updateAttributes(mesh);
+            attributesKey = attributesVersion;
+        }
+        return;
+    }
+
+    levels.clear();
+    key = Key();
+    if (mesh.nt < MIN_TRIANGLES || numberLevels == 0 || mesh.coords == nullptr || mesh.triangles == nullptr)
+        return;
+
+    //copy of the geometry: the arrays may change while the levels are computed
+    std::shared_ptr<Source> source = std::make_shared<Source>();
+    source->nv = mesh.nv;
+    source->nt = mesh.nt;
+    source->coords.assign(mesh.coords, mesh.coords + mesh.nv * 3);
+    source->triangles.assign(mesh.triangles, mesh.triangles + mesh.nt * 3);
+
+    buildingKey = k;
+    building = std::async(std::launch::async, &MeshLevelsOfDetail::build, std::shared_ptr<const Source>(source), numberLevels);
+}
+
+CG3_INLINE void MeshLevelsOfDetail::clear()
+{
+    if (building.valid())
+        building.wait();
+    building = std::future<Levels>();
+    levels.clear();
+    key = Key();
+}
+
+/**
+ * @brief Number of the simplified levels ready to be drawn.
+ * Levels go from 1 (the finest) to numberLevels() (the coarsest); level 0 is
+ * the full mesh.
+ */
+CG3_INLINE unsigned int MeshLevelsOfDetail::numberLevels() const
+{
+    return (unsigned int) levels.size();
+}
+
+CG3_INLINE unsigned int MeshLevelsOfDetail::numberTriangles(unsigned int level) const
+{
+    return (unsigned int) levels[level-1]->triangles.size() / 3;
+}
+
+/**
+ * @brief Returns the coarsest level having at least a triangle every
+ * pixelsPerTriangle pixels of the given area, or 0 (the full mesh) if no
+ * level has enough triangles.
+ */
+CG3_INLINE unsigned int MeshLevelsOfDetail::select(double projectedArea, double pixelsPerTriangle) const
+{
+    const double triangles = projectedArea / pixelsPerTriangle;
+    for (unsigned int l = numberLevels(); l > 0; l--) {
+        if (numberTriangles(l) >= triangles)
+            return l;
+    }
+    return 0;
+}
+
+CG3_INLINE MeshArrays MeshLevelsOfDetail::arrays(unsigned int level) const
+{
+    const Level& l = *levels[level-1];
+    return {
+        (unsigned int) l.coords.size() / 3,
+        (unsigned int) l.triangles.size() / 3,
+        l.coords.data(),
+        l.triangles.data(),
+        l.vertexNormals.data(),
+        l.vertexColors.data(),
+        l.triangleNormals.data(),
+        l.triangleColors.data()};
+}
+
+CG3_INLINE MeshBuffers& MeshLevelsOfDetail::buffers(unsigned int level)
+{
+    return levels[level-1]->buffers;
+}
+
+/**
+ * @brief Computes the levels, each one with a quarter of the vertices of the
+ * previous one. Stops when a level does not reduce enough the triangles of the
+ * previous one, or when it becomes too small.
+ */
+CG3_INLINE MeshLevelsOfDetail::Levels MeshLevelsOfDetail::build(
+        std::shared_ptr<const Source> source,
+        unsigned int numberLevels)
+{
+    Levels levels;
+    unsigned int targetVertices = source->nv;
+    unsigned int previousTriangles = source->nt;
+    for (unsigned int i = 0; i < numberLevels; i++) {
+        targetVertices /= 4;
+        if (targetVertices < 32)
+            break;
+        std::unique_ptr<Level> l = cluster(*source, targetVertices);
+        const unsigned int nt = (unsigned int) l->triangles.size() / 3;
+        if (nt < 64 || nt > previousTriangles * 0.8)
+            break;
+        previousTriangles = nt;
+        levels.push_back(std::move(l));
+    }
+    return levels;
+}
+
+/**
+ * @brief Vertex clustering: the vertices in the same cell of a uniform grid
+ * are merged in their average, and the triangles that become degenerate or
+ * duplicated are removed. The size of the cells is adjusted to obtain about
+ * targetVertices vertices.
+ */
+CG3_INLINE std::unique_ptr<MeshLevelsOfDetail::Level> MeshLevelsOfDetail::cluster(
+        const Source& source,
+        unsigned int targetVertices)
+{
+    const unsigned int nv = source.nv;
+    const unsigned int nt = source.nt;
+    const std::vector<double>& coords = source.coords;
+
+    double min[3], max[3];
+    for (unsigned int j = 0; j < 3; j++) {
+        min[j] = std::numeric_limits<double>::max();
+        max[j] = std::numeric_limits<double>::lowest();
+    }
+    for (unsigned int i = 0; i < nv; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            min[j] = std::min(min[j], coords[i*3+j]);
+            max[j] = std::max(max[j], coords[i*3+j]);
+        }
+    }
+    const double longest = std::max(max[0]-min[0], std::max(max[1]-min[1], max[2]-min[2]));
+
+    //cells along the longest side: surfaces occupy about (cells)^2 cells
+    double cells = std::sqrt((double) targetVertices);
+    std::vector<unsigned int> cellOf(nv);
+    std::unordered_map<unsigned long long int, unsigned int> clusters;
+    for (unsigned int iteration = 0; iteration < 4; iteration++) {
+        cells = std::min(std::max(cells, 1.0), 1048575.0);
+        const double cellSize = longest > 0 ? longest / cells : 1;
+        clusters.clear();
+        for (unsigned int i = 0; i < nv; i++) {
+            unsigned long long int key = 0;
+            for (unsigned int j = 0; j < 3; j++) {
+                unsigned long long int c = (unsigned long long int) ((coords[i*3+j] - min[j]) / cellSize);
+                key = (key << 21) | std::min(c, 2097151ull);
+            }
+            std::pair<std::unordered_map<unsigned long long int, unsigned int>::iterator, bool> it =
+                    clusters.emplace(key, (unsigned int) clusters.size());
+            cellOf[i] = it.first->second;
+        }
+        const double ratio = (double) targetVertices / clusters.size();
+        if (ratio > 0.7 && ratio < 1.4)
+            break;
+        cells *= std::sqrt(ratio);
+    }
+
+    std::unique_ptr<Level> l(new Level());
+    const unsigned int nc = (unsigned int) clusters.size();
+    l->clusterOf.swap(cellOf);
+    l->clusterSize.assign(nc, 0);
+    l->coords.assign(nc * 3, 0);
+    for (unsigned int i = 0; i < nv; i++) {
+        const unsigned int c = l->clusterOf[i];
+        l->clusterSize[c]++;
+        for (unsigned int j = 0; j < 3; j++)
+            l->coords[c*3+j] += coords[i*3+j];
+    }
+    for (unsigned int c = 0; c < nc; c++) {
+        for (unsigned int j = 0; j < 3; j++)
+            l->coords[c*3+j] /= l->clusterSize[c];
+    }
+
+    std::unordered_set<std::array<int, 3>, lod::TriangleHash> inserted;
+    for (unsigned int t = 0; t < nt; t++) {
+        const int a = (int) l->clusterOf[source.triangles[t*3]];
+        const int b = (int) l->clusterOf[source.triangles[t*3+1]];
+        const int c = (int) l->clusterOf[source.triangles[t*3+2]];
+        if (a == b || b == c || a == c)
+            continue;
+        std::array<int, 3> sorted = {{a, b, c}};
+        std::sort(sorted.begin(), sorted.end());
+        if (!inserted.insert(sorted).second)
+            continue;
+        l->triangles.push_back(a);
+        l->triangles.push_back(b);
+        l->triangles.push_back(c);
+        l->sourceTriangles.push_back(t);
+
+        //normal of the new triangle, or of the original one if degenerate
+        const double* pa = &l->coords[a*3];
+        const double* pb = &l->coords[b*3];
+        const double* pc = &l->coords[c*3];
+        double u[3] = {pb[0]-pa[0], pb[1]-pa[1], pb[2]-pa[2]};
+        double v[3] = {pc[0]-pa[0], pc[1]-pa[1], pc[2]-pa[2]};
+        double n[3] = {u[1]*v[2]-u[2]*v[1], u[2]*v[0]-u[0]*v[2], u[0]*v[1]-u[1]*v[0]};
+        double length = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+        if (length == 0)
+            l->degenerate.push_back((unsigned int) l->sourceTriangles.size() - 1);
+        for (unsigned int j = 0; j < 3; j++)
+            l->triangleNormals.push_back(length > 0 ? n[j] / length : (j == 2 ? 1 : 0));
+    }
+    l->vertexNormals.resize(nc * 3);
+    l->vertexColors.resize(nc * 3);
+    l->triangleColors.resize(l->triangles.size());
+    return l;
+}
+
+/**
+ * @brief Computes the vertex normals and colors of every level as averages of
+ * the ones of the clustered vertices of the mesh, and the triangle colors from
+ * the triangles of the mesh, marking them as modified in the GPU buffers.
+ */
+CG3_INLINE void MeshLevelsOfDetail::updateAttributes(const MeshArrays& mesh)
+{
+    for (std::unique_ptr<Level>& pl : levels) {
+        Level& l = *pl;
+        const unsigned int nc = (unsigned int) l.clusterSize.size();
+        const unsigned int nt = (unsigned int) l.sourceTriangles.size();
+
+        std::fill(l.vertexNormals.begin(), l.vertexNormals.end(), 0.0);
+        std::fill(l.vertexColors.begin(), l.vertexColors.end(), mesh.vertexColors ? 0.0f : 0.5f);
+        for (unsigned int i = 0; i < mesh.nv; i++) {
+            const unsigned int c = l.clusterOf[i];
+            for (unsigned int j = 0; j < 3; j++) {
+                if (mesh.vertexNormals)
+                    l.vertexNormals[c*3+j] += mesh.vertexNormals[i*3+j];
+                if (mesh.vertexColors)
+                    l.vertexColors[c*3+j] += mesh.vertexColors[i*3+j];
+            }
+        }
+        for (unsigned int c = 0; c < nc; c++) {
+            double length = 0;
+            for (unsigned int j = 0; j < 3; j++) {
+                if (mesh.vertexColors)
+                    l.vertexColors[c*3+j] /= l.clusterSize[c];
+                length += l.vertexNormals[c*3+j] * l.vertexNormals[c*3+j];
+            }
+            length = std::sqrt(length);
+            for (unsigned int j = 0; j < 3; j++)
+                l.vertexNormals[c*3+j] = length > 0 ? l.vertexNormals[c*3+j] / length : (j == 2 ? 1 : 0);
+        }
+
+        for (unsigned int t = 0; t < nt; t++) {
+            for (unsigned int j = 0; j < 3; j++)
+                l.triangleColors[t*3+j] = mesh.triangleColors ? mesh.triangleColors[l.sourceTriangles[t]*3+j] : 0.5f;
+        }
+        if (mesh.triangleNormals) {
+            for (unsigned int t : l.degenerate) {
+                for (unsigned int j = 0; j < 3; j++)
+                    l.triangleNormals[t*3+j] = mesh.triangleNormals[l.sourceTriangles[t]*3+j];
+            }
+        }
+
+        if (nc > 0)
+            l.buffers.invalidateVertices(0, nc - 1, MESH_NORMALS | MESH_COLORS);
+        if (nt > 0)
+            l.buffers.invalidateTriangles(0, nt - 1, MESH_NORMALS | MESH_COLORS);
+    }
+}
+
+} //namespace cg3::internal
+
+} //namespace cg3
@@ -0,0 +1,111 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_MESH_LEVELS_OF_DETAIL_H
+#define CG3_MESH_LEVELS_OF_DETAIL_H
+
+#include "mesh_buffers.h"
+
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Simplified versions of the mesh of a DrawableMesh, used when the mesh
+ * covers a small part of the screen.
+ *
+ * Every level is computed by vertex clustering on a uniform grid, and has
+ * about a quarter of the vertices of the previous one. Levels are computed in
+ * a background thread from a copy of the coordinates and of the triangles of
+ * the mesh, taken only when the geometry changes: until they are ready, only
+ * the full mesh can be drawn. Normals and colors are not part of the copy:
+ * every level keeps the cluster of every vertex of the mesh, so changes of
+ * normals and colors are averaged into the existing levels without computing
+ * them again. Every level has its own GPU buffers.
+ */
+class MeshLevelsOfDetail
+{
+public:
+    static const unsigned int MIN_TRIANGLES = 20000; //smaller meshes have no levels of detail
+
+    MeshLevelsOfDetail();
+    MeshLevelsOfDetail(const MeshLevelsOfDetail& other);
+    ~MeshLevelsOfDetail();
+
+    MeshLevelsOfDetail& operator=(const MeshLevelsOfDetail& other);
+
+    void update(
+            const MeshArrays& mesh,
+            unsigned long long int geometryVersion,
+            unsigned long long int attributesVersion,
+            unsigned int numberLevels);
+    void clear();
+
+    unsigned int numberLevels() const;
+    unsigned int numberTriangles(unsigned int level) const;
+    unsigned int select(double projectedArea, double pixelsPerTriangle) const;
+    MeshArrays arrays(unsigned int level) const;
+    MeshBuffers& buffers(unsigned int level);
+
+protected:
+    /**
+     * @brief Identifies the geometry from which the levels are computed
+     */
+    struct Key {
+        unsigned long long int version = 0;
+        unsigned int nv = 0, nt = 0;
+        const double* coords = nullptr;
+        const int* triangles = nullptr;
+        unsigned int numberLevels = 0;
+        bool operator==(const Key& other) const;
+    };
+
+    struct Source {
+        unsigned int nv, nt;
+        std::vector<double> coords;
+        std::vector<int> triangles;
+    };
+
+    struct Level {
+        std::vector<double> coords, vertexNormals, triangleNormals;
+        std::vector<int> triangles;
+        std::vector<float> vertexColors, triangleColors;
+        std::vector<unsigned int> clusterOf;        //level vertex of every vertex of the mesh
+        std::vector<unsigned int> clusterSize;      //number of vertices of the mesh of every level vertex
+        std::vector<unsigned int> sourceTriangles;  //triangle of the mesh of every level triangle
+        std::vector<unsigned int> degenerate;       //level triangles with the normal of the mesh triangle
+        MeshBuffers buffers;
+    };
+
+    typedef std::vector<std::unique_ptr<Level>> Levels;
+
+    static Levels build(std::shared_ptr<const Source> source, unsigned int numberLevels);
+    static std::unique_ptr<Level> cluster(const Source& source, unsigned int targetVertices);
+    void updateAttributes(const MeshArrays& mesh);
+
+    Levels levels; //from the finest to the coarsest
+    Key key;
+    Key buildingKey;
+    unsigned long long int attributesKey;
+    std::future<Levels> building;
+};
+
+} //namespace cg3::internal
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_MESH_LEVELS_OF_DETAIL_CPP "mesh_levels_of_detail.cpp"
+#include CG3_MESH_LEVELS_OF_DETAIL_CPP
+#undef CG3_MESH_LEVELS_OF_DETAIL_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_MESH_LEVELS_OF_DETAIL_H
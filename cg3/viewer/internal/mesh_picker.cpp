@@ -0,0 +1,132 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "mesh_picker.h"
+
+#include <algorithm>
+
+namespace cg3 {
+namespace internal {
+
+CG3_INLINE MeshPicker::MeshPicker() :
+    nv(0),
+    nt(0),
+    coords(nullptr),
+    tris(nullptr),
+    version(0),
+    valid(false)
+{
+}
+
+/**
+ * @brief Sets the arrays of the mesh. The hierarchy is built again at the next
+ * query if something changed.
+ * @param version: number that the mesh changes every time it modifies the
+ * coordinates of its vertices or its triangles
+ */
+CG3_INLINE void MeshPicker::setArrays(
+        unsigned int nv,
+        unsigned int nt,
+        const double* coords,
+        const int* triangles,
+        unsigned long long int version)
+{
+    if (nv != this->nv || nt != this->nt || coords != this->coords ||
+            triangles != this->tris || version != this->version) {
+        valid = false;
+    }
+    this->nv = nv;
+    this->nt = nt;
+    this->coords = coords;
+    this->tris = triangles;
+    this->version = version;
+}
+
+CG3_INLINE void MeshPicker::invalidate()
+{
+    valid = false;
+}
+
+/**
+ * @brief Returns the hierarchy of the triangles, building it if needed
+ */
+CG3_INLINE const TriangleBVH& MeshPicker::bvh() const
+{
+    if (!valid) {
+        if (nt > 0 && coords != nullptr && tris != nullptr)
+            tree.construction(coords, nv, tris, nt);
+        else
+            tree.clear();
+        valid = true;
+    }
+    return tree;
+}
+
+/**
+ * @brief Closest triangle hit by a ray
+ */
+CG3_INLINE bool MeshPicker::ray(const Point3d& origin, const Vec3d& dir, TriangleBVH::RayHit& hit) const
+{
+    return bvh().rayIntersection(origin, dir, hit);
+}
+
+/**
+ * @brief Triangles projected in a region of the window, occluded ones included.
+ * @param region: rectangle (two opposite corners, or four corners) or lasso
+ * @param completely: if true, all the vertices of the triangles must be inside
+ * the region, otherwise at least one
+ */
+CG3_INLINE void MeshPicker::triangles(
+        const PickingView& view,
+        const std::vector<Point2d>& region,
+        bool completely,
+        std::vector<unsigned int>& outTriangles) const
+{
+    bvh().trianglesInside(view.frustum(region), outTriangles, completely);
+    if (PickingView::isRectangle(region))
+        return;
+
+    auto inside = [&](int v) {
+        Point3d p = view.project(Point3d(coords[3*v], coords[3*v+1], coords[3*v+2]));
+        return PickingView::polygonContains(region, Point2d(p.x(), p.y()));
+    };
+    std::vector<unsigned int>::iterator last = std::remove_if(
+                outTriangles.begin(), outTriangles.end(),
+                [&](unsigned int t) {
+        unsigned int n = 0;
+        for (unsigned int i = 0; i < 3; ++i)
+            n += inside(tris[3*t+i]) ? 1 : 0;
+        return completely ? n < 3 : n == 0;
+    });
+    outTriangles.erase(last, outTriangles.end());
+}
+
+/**
+ * @brief Vertices of the triangles projected in a region of the window,
+ * occluded ones included.
+ * @param region: rectangle (two opposite corners, or four corners) or lasso
+ */
+CG3_INLINE void MeshPicker::vertices(
+        const PickingView& view,
+        const std::vector<Point2d>& region,
+        std::vector<unsigned int>& outVertices) const
+{
+    bvh().verticesInside(view.frustum(region), outVertices);
+    if (PickingView::isRectangle(region))
+        return;
+
+    std::vector<unsigned int>::iterator last = std::remove_if(
+                outVertices.begin(), outVertices.end(),
+                [&](unsigned int v) {
+        Point3d p = view.project(Point3d(coords[3*v], coords[3*v+1], coords[3*v+2]));
+        return !PickingView::polygonContains(region, Point2d(p.x(), p.y()));
+    });
+    outVertices.erase(last, outVertices.end());
+}
+
+} //namespace cg3::internal
+} //namespace cg3
@@ -0,0 +1,70 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_MESH_PICKER_H
+#define CG3_MESH_PICKER_H
+
+#include "../utilities/picking.h"
+
+namespace cg3 {
+namespace internal {
+
+/**
+ * @brief Picking on the CPU of the triangles and vertices of a DrawableMesh.
+ *
+ * A TriangleBVH is built on the arrays of the mesh at the first query, and
+ * again only after that the arrays change: the number of elements, the
+ * address of the arrays or the geometry version given by the mesh.
+ * It does not need an OpenGL context.
+ */
+class MeshPicker
+{
+public:
+    MeshPicker();
+
+    void setArrays(
+            unsigned int nv,
+            unsigned int nt,
+            const double* coords,
+            const int* triangles,
+            unsigned long long int version);
+    void invalidate();
+
+    const TriangleBVH& bvh() const;
+
+    bool ray(const Point3d& origin, const Vec3d& dir, TriangleBVH::RayHit& hit) const;
+    void triangles(
+            const PickingView& view,
+            const std::vector<Point2d>& region,
+            bool completely,
+            std::vector<unsigned int>& outTriangles) const;
+    void vertices(
+            const PickingView& view,
+            const std::vector<Point2d>& region,
+            std::vector<unsigned int>& outVertices) const;
+
+protected:
+    unsigned int nv;
+    unsigned int nt;
+    const double* coords;
+    const int* tris;
+    unsigned long long int version;
+
+    mutable TriangleBVH tree;
+    mutable bool valid;
+};
+
+} //namespace cg3::internal
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_MESH_PICKER_CPP "mesh_picker.cpp"
+#include CG3_MESH_PICKER_CPP
+#undef CG3_MESH_PICKER_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_MESH_PICKER_H
@@ -0,0 +1,125 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "vertex_batch.h"
+
+#include <cg3/cg3lib.h>
+
+#include <algorithm>
+
+namespace cg3 {
+
+namespace internal {
+
+CG3_INLINE VertexBatch::VertexBatch() :
+    useBuffers(-1),
+    allModified(true),
+    firstModified(1),
+    lastModified(0),
+    uploadedBytes(0)
+{
+}
+
+CG3_INLINE unsigned int VertexBatch::size() const
+{
+    return (unsigned int) colors.size() / 4;
+}
+
+CG3_INLINE void VertexBatch::clear()
+{
+    resize(0);
+}
+
+CG3_INLINE void VertexBatch::resize(unsigned int n)
+{
+    coords.resize((size_t) n * 3, 0.0f);
+    colors.resize((size_t) n * 4, 0);
+    allModified = true;
+}
+
+CG3_INLINE void VertexBatch::setVertex(unsigned int i, const Point3d& p, const Color& color)
+{
+    float* v = &coords[(size_t) i * 3];
+    v[0] = (float) p.x();
+    v[1] = (float) p.y();
+    v[2] = (float) p.z();
+    unsigned char* c = &colors[(size_t) i * 4];
+    c[0] = (unsigned char) color.red();
+    c[1] = (unsigned char) color.green();
+    c[2] = (unsigned char) color.blue();
+    c[3] = (unsigned char) color.alpha();
+    if (allModified)
+        return;
+    if (firstModified > lastModified) {
+        firstModified = lastModified = i;
+    }
+    else {
+        firstModified = std::min(firstModified, i);
+        lastModified = std::max(lastModified, i);
+    }
+}
+
+/**
+ * @brief Draws the vertices with the given mode (GL_POINTS or GL_LINES).
+ * Point size, line width and the other states are the current ones.
+ */
+CG3_INLINE void VertexBatch::draw(GLenum mode) const
+{
+    uploadedBytes = 0;
+    if (size() == 0)
+        return;
+    if (useBuffers < 0)
+        useBuffers = opengl::buffersSupported();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    if (useBuffers) {
+        if (allModified || coordBuffer.size() != coords.size() * sizeof(float)) {
+            coordBuffer.allocate(coords.data(), coords.size() * sizeof(float));
+            colorBuffer.allocate(colors.data(), colors.size());
+            uploadedBytes = coords.size() * sizeof(float) + colors.size();
+        }
+        else if (firstModified <= lastModified) {
+            const size_t n = lastModified - firstModified + 1;
+            coordBuffer.write((size_t) firstModified * 3 * sizeof(float), &coords[(size_t) firstModified * 3], n * 3 * sizeof(float));
+            colorBuffer.write((size_t) firstModified * 4, &colors[(size_t) firstModified * 4], n * 4);
+            uploadedBytes = n * (3 * sizeof(float) + 4);
+        }
+        allModified = false;
+        firstModified = 1;
+        lastModified = 0;
+
+        coordBuffer.bind();
+        glVertexPointer(3, GL_FLOAT, 0, nullptr);
+        colorBuffer.bind();
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+        colorBuffer.release();
+    }
+    else {
+        glVertexPointer(3, GL_FLOAT, 0, coords.data());
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
+    }
+    glDrawArrays(mode, 0, (GLsizei) size());
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+}
+
+/**
+ * @brief Returns the vertices drawn by the last draw, and the bytes uploaded
+ * to the GPU
+ */
+CG3_INLINE DrawStatistics VertexBatch::drawStatistics() const
+{
+    DrawStatistics s;
+    s.vertices = size();
+    s.uploadedBytes = uploadedBytes;
+    return s;
+}
+
+} //namespace cg3::internal
+
+} //namespace cg3
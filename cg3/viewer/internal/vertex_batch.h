@@ -0,0 +1,66 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_VERTEX_BATCH_H
+#define CG3_VERTEX_BATCH_H
+
+#include "../opengl_objects/opengl_buffer.h"
+
+#include <cg3/geometry/point3.h>
+#include <cg3/utilities/color.h>
+#include "../interfaces/drawable_object.h"
+
+#include <vector>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Colored vertices drawn as GL_POINTS or GL_LINES with a single draw
+ * call.
+ *
+ * Coordinates (floats) and colors (RGBA bytes) are stored in GPU buffers, and
+ * only the ranges of modified vertices are uploaded again. Without buffer
+ * objects, the vertex arrays are drawn from the main memory.
+ */
+class VertexBatch
+{
+public:
+    VertexBatch();
+
+    unsigned int size() const;
+    void clear();
+    void resize(unsigned int n);
+    void setVertex(unsigned int i, const Point3d& p, const Color& color);
+
+    void draw(GLenum mode) const;
+    DrawStatistics drawStatistics() const;
+
+protected:
+    std::vector<float> coords;
+    std::vector<unsigned char> colors;
+
+    mutable int useBuffers;
+    mutable opengl::Buffer coordBuffer;
+    mutable opengl::Buffer colorBuffer;
+    mutable bool allModified;
+    mutable unsigned int firstModified, lastModified;
+    mutable unsigned long long int uploadedBytes; //by the last draw
+};
+
+} //namespace cg3::internal
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_VERTEX_BATCH_CPP "vertex_batch.cpp"
+#include CG3_VERTEX_BATCH_CPP
+#undef CG3_VERTEX_BATCH_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_VERTEX_BATCH_H
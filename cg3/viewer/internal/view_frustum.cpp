@@ -0,0 +1,111 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "view_frustum.h"
+
+#include <cg3/cg3lib.h>
+
+#include <cmath>
+#include <limits>
+
+namespace cg3 {
+
+namespace internal {
+
+CG3_INLINE ViewFrustum::ViewFrustum()
+{
+    for (unsigned int i = 0; i < 16; i++) {
+        modelView[i] = projection[i] = (i % 5 == 0) ? 1 : 0;
+    }
+    viewport[0] = viewport[1] = 0;
+    viewport[2] = viewport[3] = 1;
+    for (unsigned int i = 0; i < 6; i++) {
+        for (unsigned int j = 0; j < 4; j++)
+            planes[i][j] = 0;
+    }
+}
+
+/**
+ * @brief Reads the current matrices and viewport, and computes the planes of
+ * the frustum. It must be called with the OpenGL context current, before
+ * testing the objects.
+ */
+CG3_INLINE void ViewFrustum::update()
+{
+    glGetDoublev(GL_MODELVIEW_MATRIX, modelView);
+    glGetDoublev(GL_PROJECTION_MATRIX, projection);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    //clip = projection * modelView (column-major)
+    double clip[16];
+    for (unsigned int c = 0; c < 4; c++) {
+        for (unsigned int r = 0; r < 4; r++) {
+            clip[c*4+r] = 0;
+            for (unsigned int k = 0; k < 4; k++)
+                clip[c*4+r] += projection[k*4+r] * modelView[c*4+k];
+        }
+    }
+
+    //planes from the rows of the clip matrix: row 3 +/- rows 0, 1 and 2
+    for (unsigned int i = 0; i < 6; i++) {
+        const unsigned int row = i / 2;
+        const double sign = (i % 2 == 0) ? 1 : -1;
+        double length = 0;
+        for (unsigned int j = 0; j < 4; j++) {
+            planes[i][j] = clip[j*4+3] + sign * clip[j*4+row];
+            if (j < 3)
+                length += planes[i][j] * planes[i][j];
+        }
+        length = std::sqrt(length);
+        if (length > 0) {
+            for (unsigned int j = 0; j < 4; j++)
+                planes[i][j] /= length;
+        }
+    }
+}
+
+/**
+ * @brief Returns true if the sphere, given in object coordinates, intersects
+ * the frustum. Spheres with a non positive radius (objects without a scene
+ * radius) are always visible.
+ */
+CG3_INLINE bool ViewFrustum::isSphereVisible(const Point3d& center, double radius) const
+{
+    if (radius <= 0)
+        return true;
+    for (unsigned int i = 0; i < 6; i++) {
+        const double d = planes[i][0] * center.x() + planes[i][1] * center.y() + planes[i][2] * center.z() + planes[i][3];
+        if (d < -radius)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the radius in pixels of the projection of the sphere, given in
+ * object coordinates. It is infinite if the center is behind the camera.
+ */
+CG3_INLINE double ViewFrustum::projectedRadius(const Point3d& center, double radius) const
+{
+    double eye[4];
+    for (unsigned int r = 0; r < 4; r++) {
+        eye[r] = modelView[r] * center.x() + modelView[4+r] * center.y() + modelView[8+r] * center.z() + modelView[12+r];
+    }
+    double w = 0;
+    for (unsigned int k = 0; k < 4; k++)
+        w += projection[k*4+3] * eye[k];
+    if (w <= 0)
+        return std::numeric_limits<double>::infinity();
+
+    //scale of the modelview matrix, to take into account scaled objects
+    const double scale = std::sqrt(modelView[0]*modelView[0] + modelView[1]*modelView[1] + modelView[2]*modelView[2]);
+    return radius * scale * std::abs(projection[5]) * viewport[3] / 2 / w;
+}
+
+} //namespace cg3::internal
+
+} //namespace cg3
@@ -0,0 +1,61 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_VIEW_FRUSTUM_H
+#define CG3_VIEW_FRUSTUM_H
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <cg3/geometry/point3.h>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief The view frustum given by the current OpenGL modelview and projection
+ * matrices and viewport.
+ *
+ * It is used to skip the objects that are outside the frustum, and to compute
+ * the size of an object on the screen.
+ */
+class ViewFrustum
+{
+public:
+    ViewFrustum();
+
+    void update();
+
+    bool isSphereVisible(const Point3d& center, double radius) const;
+    double projectedRadius(const Point3d& center, double radius) const;
+
+protected:
+    GLdouble modelView[16];
+    GLdouble projection[16];
+    GLint viewport[4];
+    double planes[6][4]; //a, b, c, d of the normalized planes, normals toward the inside
+};
+
+} //namespace cg3::internal
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_VIEW_FRUSTUM_CPP "view_frustum.cpp"
+#include CG3_VIEW_FRUSTUM_CPP
+#undef CG3_VIEW_FRUSTUM_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_VIEW_FRUSTUM_H
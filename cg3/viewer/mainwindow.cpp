@@ -67,6 +67,7 @@ CG3_INLINE MainWindow::MainWindow(QWidget* parent) :
     ui->console->hide();
 
     povLS.addSupportedExtension("cg3pov");
+    profilerLS.addSupportedExtension("csv", "json");
     #ifdef CG3_DCEL_DEFINED
     meshLS.addSupportedExtension("obj", "ply", "dcel");
     #else
@@ -118,6 +119,7 @@ CG3_INLINE void MainWindow::pushDrawableObject(
 {
     if (obj != nullptr && !canvas.containsDrawableObject(obj)) {
         canvas.pushDrawableObject(obj, checkBoxChecked);
+        canvas.profiler().setObjectName(obj, checkBoxName);
         DrawableObjectDrawListManager* manager =
                 new DrawableObjectDrawListManager(this, obj, checkBoxName, checkBoxChecked, closeButtonVisible);
         mapDrawListManagers[obj] = manager;
@@ -152,6 +154,7 @@ CG3_INLINE bool MainWindow::deleteDrawableObject(const DrawableObject* obj)
 {
     if (obj != nullptr && mapDrawListManagers.find(obj) != mapDrawListManagers.end()){
         canvas.deleteDrawableObject(obj);
+        canvas.profiler().removeObjectName(obj);
         //mapDrawListManagers[obj]->deleteSubManager();
         scrollAreaLayout->removeWidget(mapDrawListManagers[obj]);
         delete mapDrawListManagers[obj];
@@ -241,6 +244,7 @@ CG3_INLINE bool MainWindow::setDrawableObjectName(const DrawableObject* obj, con
 {
     if (mapDrawListManagers.find(obj) != mapDrawListManagers.end()){
         mapDrawListManagers[obj]->setDrawableObjectName(newName);
+        canvas.profiler().setObjectName(obj, newName);
         return true;
     }
     return false;
@@ -381,6 +385,15 @@ CG3_INLINE void MainWindow::toggleConsole()
     }
 }
 
+/**
+ * @brief Enables/Disables the frame profiler of the canvas and its overlay.
+ * @see GLCanvas::setProfiling
+ */
+CG3_INLINE void MainWindow::toggleProfiler()
+{
+    canvas.toggleProfiler();
+}
+
 /**
  * @brief Manages a Key Event and executes relative operations or emits signals.
  */
@@ -536,6 +549,27 @@ CG3_INLINE void MainWindow::on_actionShow_Hide_Console_triggered()
     toggleConsole();
 }
 
+CG3_INLINE void MainWindow::on_actionShow_Hide_Profiler_triggered()
+{
+    toggleProfiler();
+}
+
+/**
+ * @brief Saves the frames collected by the profiler as a CSV file or, with
+ * the json extension, as a Chrome trace.
+ */
+CG3_INLINE void MainWindow::on_actionSave_Profiler_Data_triggered()
+{
+    std::string ext;
+    std::string s = profilerLS.saveDialog("Save Profiler Data", ext);
+    if (s != ""){
+        if (ext == "json" || (s.size() > 5 && s.substr(s.size() - 5) == ".json"))
+            canvas.profiler().saveChromeTrace(s);
+        else
+            canvas.profiler().saveCsv(s);
+    }
+}
+
 CG3_INLINE void MainWindow::on_actionShow_Hide_DrawList_triggered()
 {
     if (ui->dockDrawList->isHidden())
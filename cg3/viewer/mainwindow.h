@@ -120,6 +120,7 @@ public:
     //Window Options:
     void setFullScreen(bool);
     void toggleConsole(); //work in progress...
+    void toggleProfiler();
     void keyPressEvent(QKeyEvent * event); //event options for keys pressed
 	void showDockWidget();
 	void hideDockWidget();
@@ -164,6 +165,8 @@ private slots:
     void on_actionSave_Point_Of_View_as_triggered();
     void on_actionShow_Hide_Console_triggered();
     void on_actionShow_Hide_DrawList_triggered();
+    void on_actionShow_Hide_Profiler_triggered();
+    void on_actionSave_Profiler_Data_triggered();
     void on_actionToggle_Debug_Objects_triggered();
     void on_action2D_Mode_triggered();
     void on_action3D_Mode_triggered();
@@ -189,6 +192,7 @@ private:
     bool consoleEnabled;
     QVBoxLayout* scrollAreaLayout;
     cg3::viewer::LoaderSaver povLS;
+    cg3::viewer::LoaderSaver profilerLS;
     QSpacerItem* m_spacer;
 
     // Mesh Stack
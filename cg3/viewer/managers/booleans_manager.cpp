@@ -374,12 +374,15 @@ CG3_INLINE void BooleansManager::on_plusXButton_clicked()
 {
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->translate(Point3d(ui->stepSpinBox->value(), 0, 0));
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->translate(Point3d(ui->stepSpinBox->value(), 0, 0));
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->translate(Point3d(ui->stepSpinBox->value(), 0, 0));
+        result->update();
     }
 	mainWindow.updateCanvas();
 }
@@ -388,12 +391,15 @@ CG3_INLINE void BooleansManager::on_minusXButton_clicked()
 {
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->translate(Point3d(-ui->stepSpinBox->value(), 0, 0));
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->translate(Point3d(-ui->stepSpinBox->value(), 0, 0));
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->translate(Point3d(-ui->stepSpinBox->value(), 0, 0));
+        result->update();
     }
 	mainWindow.updateCanvas();
 }
@@ -402,12 +408,15 @@ CG3_INLINE void BooleansManager::on_plusYButton_clicked()
 {
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->translate(Point3d(0, ui->stepSpinBox->value(), 0));
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->translate(Point3d(0, ui->stepSpinBox->value(), 0));
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->translate(Point3d(0, ui->stepSpinBox->value(), 0));
+        result->update();
     }
 	mainWindow.updateCanvas();
 }
@@ -416,12 +425,15 @@ CG3_INLINE void BooleansManager::on_minusYButton_clicked()
 {
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->translate(Point3d(0, -ui->stepSpinBox->value(), 0));
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->translate(Point3d(0, -ui->stepSpinBox->value(), 0));
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->translate(Point3d(0, -ui->stepSpinBox->value(), 0));
+        result->update();
     }
 	mainWindow.updateCanvas();
 }
@@ -430,12 +442,15 @@ CG3_INLINE void BooleansManager::on_plusZButton_clicked()
 {
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->translate(Point3d(0, 0, ui->stepSpinBox->value()));
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->translate(Point3d(0, 0, ui->stepSpinBox->value()));
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->translate(Point3d(0, 0, ui->stepSpinBox->value()));
+        result->update();
     }
 	mainWindow.updateCanvas();
 }
@@ -444,12 +459,15 @@ CG3_INLINE void BooleansManager::on_minusZButton_clicked()
 {
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->translate(Point3d(0, 0, -ui->stepSpinBox->value()));
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->translate(Point3d(0, 0, -ui->stepSpinBox->value()));
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->translate(Point3d(0, 0, -ui->stepSpinBox->value()));
+        result->update();
     }
 	mainWindow.updateCanvas();
 }
@@ -464,12 +482,15 @@ CG3_INLINE void BooleansManager::on_rotateButton_clicked()
     cg3::rotationMatrix(axis, angle, m);
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->rotate(m);
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->rotate(m);
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->rotate(m);
+        result->update();
     }
     ui->undoRotateButton->setEnabled(true);
 	mainWindow.updateCanvas();
@@ -481,12 +502,15 @@ CG3_INLINE void BooleansManager::on_undoRotateButton_clicked()
     cg3::rotationMatrix(-lastAxis, lastAngle, m);
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->rotate(m);
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->rotate(m);
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->rotate(m);
+        result->update();
     }
     ui->undoRotateButton->setEnabled(false);
 	mainWindow.updateCanvas();
@@ -514,12 +538,15 @@ CG3_INLINE void BooleansManager::on_scalePushButton_clicked()
 
     if (ui->mesh1CheckBox->isChecked() && meshes[0] != nullptr){
         meshes[0]->scale(scaleFactor);
+        meshes[0]->update();
     }
     if (ui->mesh2CheckBox->isChecked() && meshes[1] != nullptr){
         meshes[1]->scale(scaleFactor);
+        meshes[1]->update();
     }
     if (ui->resultCheckBox->isChecked() && result != nullptr){
         result->scale(scaleFactor);
+        result->update();
     }
 	mainWindow.updateCanvas();
 }
@@ -54,6 +54,7 @@ CG3_INLINE void EigenMeshManager::on_loadMeshButton_clicked()
         loaded = mesh.loadFromFile(filename);
 
         if (loaded) {
+            mesh.update();
             mesh.setEnableTriangleColor();
             mainWindow.pushDrawableObject(&mesh, filename.substr(filename.find_last_of("/") + 1));
             setButtonsMeshLoaded(true);
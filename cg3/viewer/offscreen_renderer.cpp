@@ -0,0 +1,468 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "offscreen_renderer.h"
+
+//EGL must not include the X11 headers: their macros clash with Qt
+#ifndef EGL_NO_X11
+#define EGL_NO_X11
+#endif
+#ifndef MESA_EGL_NO_X11_HEADERS
+#define MESA_EGL_NO_X11_HEADERS
+#endif
+#include <EGL/egl.h>
+
+#include <cg3/io/serialize.h>
+#include <cg3/viewer/interfaces/manipulable_object.h>
+#include <cg3/viewer/utilities/utils.h>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+namespace cg3 {
+namespace viewer {
+
+namespace internal {
+
+typedef EGLDisplay (EGLAPIENTRY *GetPlatformDisplayFunction)(EGLenum, void*, const EGLint*);
+
+/**
+ * @brief Initializes an EGL display that does not need a display server:
+ * the surfaceless platform if available, the default display otherwise.
+ */
+CG3_INLINE EGLDisplay offscreenDisplay()
+{
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (extensions != nullptr && std::strstr(extensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+        GetPlatformDisplayFunction getPlatformDisplay =
+                (GetPlatformDisplayFunction) eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay != nullptr) {
+            EGLDisplay d = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (d != EGL_NO_DISPLAY && eglInitialize(d, nullptr, nullptr))
+                return d;
+        }
+    }
+    EGLDisplay d = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (d != EGL_NO_DISPLAY && eglInitialize(d, nullptr, nullptr))
+        return d;
+    return EGL_NO_DISPLAY;
+}
+
+} //namespace cg3::viewer::internal
+
+/**
+ * @brief Creates the OpenGL context and a render target of the given size.
+ * @param samples: samples per pixel used for antialiasing; if the
+ * implementation does not support multisampling, 1 sample is used.
+ * Check isValid() before rendering.
+ */
+CG3_INLINE OffscreenRenderer::OffscreenRenderer(
+        unsigned int width,
+        unsigned int height,
+        unsigned int samples) :
+    zoomSceneFactor(3),
+    display(EGL_NO_DISPLAY),
+    config(nullptr),
+    context(EGL_NO_CONTEXT),
+    surface(EGL_NO_SURFACE),
+    w(0),
+    h(0),
+    backgroundColor(Qt::white),
+    sceneCenter(0, 0, 0),
+    sceneRadius(1),
+    fov(M_PI / 4),
+    orthographic(false)
+{
+    resetPointOfView();
+
+    display = internal::offscreenDisplay();
+    if (display == EGL_NO_DISPLAY || !eglBindAPI(EGL_OPENGL_API))
+        return;
+
+    EGLint attributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_SAMPLE_BUFFERS, samples > 1 ? 1 : 0,
+        EGL_SAMPLES, samples > 1 ? (EGLint) samples : 0,
+        EGL_NONE};
+    EGLint nConfigs = 0;
+    if (!eglChooseConfig(display, attributes, &config, 1, &nConfigs) || nConfigs == 0) {
+        attributes[14] = EGL_NONE; //without multisampling
+        if (!eglChooseConfig(display, attributes, &config, 1, &nConfigs) || nConfigs == 0)
+            return;
+    }
+
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+    if (context == EGL_NO_CONTEXT)
+        return;
+    if (createSurface(width, height))
+        setupContext();
+}
+
+CG3_INLINE OffscreenRenderer::~OffscreenRenderer()
+{
+    if (display == EGL_NO_DISPLAY)
+        return;
+    if (eglGetCurrentContext() == context)
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (surface != EGL_NO_SURFACE)
+        eglDestroySurface(display, surface);
+    if (context != EGL_NO_CONTEXT)
+        eglDestroyContext(display, context);
+    //the display is not terminated: it is shared with the other renderers
+}
+
+/**
+ * @brief Returns true if the OpenGL context has been created
+ */
+CG3_INLINE bool OffscreenRenderer::isValid() const
+{
+    return surface != EGL_NO_SURFACE;
+}
+
+CG3_INLINE unsigned int OffscreenRenderer::width() const
+{
+    return w;
+}
+
+CG3_INLINE unsigned int OffscreenRenderer::height() const
+{
+    return h;
+}
+
+/**
+ * @brief Changes the size of the rendered images. The context is kept, then
+ * the objects that have already been rendered are not uploaded again.
+ */
+CG3_INLINE bool OffscreenRenderer::resize(unsigned int width, unsigned int height)
+{
+    if (context == EGL_NO_CONTEXT)
+        return false;
+    if (width == w && height == h && surface != EGL_NO_SURFACE)
+        return true;
+    return createSurface(width, height);
+}
+
+CG3_INLINE void OffscreenRenderer::setBackgroundColor(const QColor& color)
+{
+    backgroundColor = color;
+}
+
+CG3_INLINE Point3d OffscreenRenderer::cameraPosition() const
+{
+    return position;
+}
+
+CG3_INLINE Vec3d OffscreenRenderer::cameraDirection() const
+{
+    return direction;
+}
+
+CG3_INLINE Vec3d OffscreenRenderer::cameraUpVector() const
+{
+    return up;
+}
+
+/**
+ * @brief Sets the point of view of GLCanvas::resetPointOfView
+ */
+CG3_INLINE void OffscreenRenderer::resetPointOfView()
+{
+    position = Point3d(0, 0, 2.61313);
+    direction = Vec3d(0, 0, -1);
+    up = Vec3d(0, 1, 0);
+}
+
+CG3_INLINE void OffscreenRenderer::setCameraPosition(const Point3d& pos)
+{
+    position = pos;
+}
+
+/**
+ * @brief Sets the view direction, keeping the up vector if it is not
+ * parallel to the direction.
+ */
+CG3_INLINE void OffscreenRenderer::setCameraDirection(const Vec3d& vec)
+{
+    double length = vec.length();
+    if (length > 0)
+        direction = vec / length;
+}
+
+CG3_INLINE void OffscreenRenderer::setCameraUpVector(const Vec3d& vec)
+{
+    double length = vec.length();
+    if (length > 0)
+        up = vec / length;
+}
+
+/**
+ * @brief Points the camera towards the target, without moving it
+ */
+CG3_INLINE void OffscreenRenderer::lookAt(const Point3d& target)
+{
+    setCameraDirection(target - position);
+}
+
+/**
+ * @brief Loads a point of view saved by GLCanvas::savePointOfView.
+ * The camera orientation is a quaternion that rotates the -z axis in the view
+ * direction and the y axis in the up vector.
+ */
+CG3_INLINE bool OffscreenRenderer::loadPointOfView(const std::string& filename)
+{
+    std::ifstream file;
+    file.open(filename, std::ios::in | std::ios::binary);
+    double x, y, z, q[4];
+    try {
+        deserializeObjectAttributes(
+                    "cg3PointOfView", file, x, y, z,
+                    q[0], q[1], q[2], q[3]);
+    }
+    catch(...){
+        return false;
+    }
+
+    //v' = v + w t + q x t, with t = 2 q x v
+    auto rotate = [&q](const Vec3d& v) {
+        Vec3d qv(q[0], q[1], q[2]);
+        Vec3d t = qv.cross(v) * 2;
+        return v + t * q[3] + qv.cross(t);
+    };
+    position = Point3d(x, y, z);
+    setCameraDirection(rotate(Vec3d(0, 0, -1)));
+    setCameraUpVector(rotate(Vec3d(0, 1, 0)));
+    return true;
+}
+
+CG3_INLINE void OffscreenRenderer::setPerspectiveCamera()
+{
+    orthographic = false;
+}
+
+CG3_INLINE void OffscreenRenderer::setOrthographicCamera()
+{
+    orthographic = true;
+}
+
+CG3_INLINE bool OffscreenRenderer::isOrthographicCamera() const
+{
+    return orthographic;
+}
+
+/**
+ * @brief Sets the vertical field of view, in radians (default pi/4).
+ * For orthographic cameras, it defines the size of the view volume as in
+ * QGLViewer.
+ */
+CG3_INLINE void OffscreenRenderer::setFieldOfView(double fov)
+{
+    this->fov = fov;
+}
+
+/**
+ * @brief Moves the camera along its view direction, so that the sphere is
+ * entirely visible. Near and far planes are computed on the sphere.
+ */
+CG3_INLINE void OffscreenRenderer::fitScene(const Point3d& center, double radius)
+{
+    sceneCenter = center;
+    sceneRadius = radius;
+    double aspect = h > 0 ? (double) w / h : 1;
+    double distance;
+    if (orthographic) {
+        distance = radius / std::tan(fov / 2);
+    }
+    else {
+        double horizontalFov = 2 * std::atan(std::tan(fov / 2) * aspect);
+        distance = std::max(radius / std::sin(fov / 2), radius / std::sin(horizontalFov / 2));
+    }
+    position = center - direction * distance;
+}
+
+/**
+ * @brief Fits the scene on the visible objects (on all the objects if none is
+ * visible), as GLCanvas::fitScene.
+ */
+CG3_INLINE void OffscreenRenderer::fitScene(const std::vector<const DrawableObject*>& objects)
+{
+    bool onlyVisible = false;
+    for (const DrawableObject* obj : objects)
+        if (obj->isVisible())
+            onlyVisible = true;
+    BoundingBox3 bb = fullBoundingBoxDrawableObjects(objects, onlyVisible);
+    fitScene(bb.center(), bb.diag() / zoomSceneFactor);
+}
+
+/**
+ * @brief Modelview matrix of the camera, column-major
+ */
+CG3_INLINE void OffscreenRenderer::modelViewMatrix(double m[16]) const
+{
+    Vec3d f = direction;
+    Vec3d s = f.cross(up);
+    if (s.length() < 1e-12) //up parallel to the direction: any orthogonal vector
+        s = f.cross(std::abs(f.x()) < 0.9 ? Vec3d(1, 0, 0) : Vec3d(0, 1, 0));
+    s.normalize();
+    Vec3d u = s.cross(f);
+    const Vec3d rows[3] = {s, u, -f};
+    for (unsigned int r = 0; r < 3; r++) {
+        m[r]      = rows[r].x();
+        m[r + 4]  = rows[r].y();
+        m[r + 8]  = rows[r].z();
+        m[r + 12] = -rows[r].dot(position);
+    }
+    m[3] = m[7] = m[11] = 0;
+    m[15] = 1;
+}
+
+/**
+ * @brief Projection matrix of the camera, column-major. Near and far planes
+ * are computed as QGLViewer does, on the scene sphere.
+ */
+CG3_INLINE void OffscreenRenderer::projectionMatrix(double m[16]) const
+{
+    const double zClippingCoefficient = std::sqrt(3.0);
+    const double zNearCoefficient = 0.005;
+    double aspect = h > 0 ? (double) w / h : 1;
+    double distance = std::abs((sceneCenter - position).dot(direction));
+    double zFar = distance + zClippingCoefficient * sceneRadius;
+    double zNear = distance - zClippingCoefficient * sceneRadius;
+    double zMin = zNearCoefficient * zClippingCoefficient * sceneRadius;
+    if (zNear < zMin)
+        zNear = orthographic ? 0 : zMin;
+
+    std::fill(m, m + 16, 0.0);
+    if (orthographic) {
+        double d = std::tan(fov / 2) * distance;
+        double halfWidth = d * (aspect < 1 ? 1 : aspect);
+        double halfHeight = d * (aspect < 1 ? 1 / aspect : 1);
+        m[0] = 1 / halfWidth;
+        m[5] = 1 / halfHeight;
+        m[10] = -2 / (zFar - zNear);
+        m[14] = -(zFar + zNear) / (zFar - zNear);
+        m[15] = 1;
+    }
+    else {
+        double f = 1 / std::tan(fov / 2);
+        m[0] = f / aspect;
+        m[5] = f;
+        m[10] = (zNear + zFar) / (zNear - zFar);
+        m[11] = -1;
+        m[14] = 2 * zNear * zFar / (zNear - zFar);
+    }
+}
+
+/**
+ * @brief Returns the camera of the renderer, that can be used to project
+ * points on the rendered images
+ */
+CG3_INLINE PickingView OffscreenRenderer::pickingView() const
+{
+    double modelview[16], projection[16];
+    modelViewMatrix(modelview);
+    projectionMatrix(projection);
+    int viewport[4] = {0, 0, (int) w, (int) h};
+    return PickingView(modelview, projection, viewport);
+}
+
+/**
+ * @brief Renders the visible objects, as GLCanvas::draw does.
+ * Returns a null image if the renderer is not valid.
+ */
+CG3_INLINE QImage OffscreenRenderer::render(const std::vector<const DrawableObject*>& objects)
+{
+    if (!makeCurrent())
+        return QImage();
+
+    double modelview[16], projection[16];
+    modelViewMatrix(modelview);
+    projectionMatrix(projection);
+
+    glViewport(0, 0, w, h);
+    glClearColor(backgroundColor.redF(), backgroundColor.greenF(), backgroundColor.blueF(), backgroundColor.alphaF());
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixd(projection);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixd(modelview);
+
+    for (const DrawableObject* obj : objects) {
+        if (obj->isVisible()) {
+            const ManipulableObject* mobj = dynamic_cast<const ManipulableObject*>(obj);
+            if (!mobj)
+                obj->draw();
+            else {
+                glPushMatrix();
+                glMultMatrixd(mobj->matrix());
+                mobj->draw();
+                glPopMatrix();
+            }
+        }
+    }
+
+    //rows are read bottom-up
+    pixels.resize((size_t) w * h * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return QImage(pixels.data(), w, h, QImage::Format_RGBA8888).mirrored();
+}
+
+CG3_INLINE QImage OffscreenRenderer::render(const DrawableObject& object)
+{
+    return render(std::vector<const DrawableObject*>{&object});
+}
+
+CG3_INLINE bool OffscreenRenderer::makeCurrent() const
+{
+    if (surface == EGL_NO_SURFACE)
+        return false;
+    if (eglGetCurrentContext() == context && eglGetCurrentSurface(EGL_DRAW) == surface)
+        return true;
+    return eglMakeCurrent(display, surface, surface, context);
+}
+
+CG3_INLINE bool OffscreenRenderer::createSurface(unsigned int width, unsigned int height)
+{
+    if (surface != EGL_NO_SURFACE) {
+        if (eglGetCurrentSurface(EGL_DRAW) == surface)
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroySurface(display, surface);
+        surface = EGL_NO_SURFACE;
+    }
+    const EGLint attributes[] = {EGL_WIDTH, (EGLint) width, EGL_HEIGHT, (EGLint) height, EGL_NONE};
+    surface = eglCreatePbufferSurface(display, config, attributes);
+    if (surface == EGL_NO_SURFACE)
+        return false;
+    w = width;
+    h = height;
+    return makeCurrent();
+}
+
+/**
+ * @brief OpenGL state set by QGLViewer when a canvas is initialized
+ */
+CG3_INLINE void OffscreenRenderer::setupContext() const
+{
+    glEnable(GL_LIGHT0);
+    glEnable(GL_LIGHTING);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_COLOR_MATERIAL);
+}
+
+} //namespace cg3::viewer
+} //namespace cg3
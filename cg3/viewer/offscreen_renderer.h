@@ -0,0 +1,181 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_OFFSCREEN_RENDERER_H
+#define CG3_OFFSCREEN_RENDERER_H
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <QColor>
+#include <QImage>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cg3/geometry/point3.h>
+#include "interfaces/drawable_object.h"
+#include "utilities/picking.h"
+
+namespace cg3 {
+namespace viewer {
+
+/**
+ * @brief The OffscreenRenderer class
+ *
+ * Renders DrawableObjects to images without a window and without a display
+ * server: the OpenGL context is created through EGL (using the surfaceless
+ * platform when available, e.g. Mesa llvmpipe on machines without a GPU).
+ *
+ * The context, the render target and the read back buffer are created once
+ * and reused by all the renders, that are drawn as GLCanvas::draw does, with
+ * the same default lights and camera of the canvas. Points of view saved by
+ * GLCanvas::savePointOfView can be loaded with loadPointOfView().
+ *
+ * All the member functions must be called by the thread that created the
+ * renderer; DrawableObjects that allocate OpenGL buffers (e.g. DrawableMesh)
+ * must be destroyed by the same thread, when the renderer is still alive.
+ *
+ * \code{*.cpp}
+ * cg3::viewer::OffscreenRenderer renderer(512, 512);
+ * cg3::DrawableEigenMesh mesh("bunny.obj");
+ * renderer.fitScene({&mesh});
+ * renderer.render(mesh).save("bunny.png");
+ * \endcode
+ *
+ * renderBatch() renders a sequence of objects, loading the next one and
+ * storing the previous image in other threads while the current one is
+ * rendered.
+ *
+ * @ingroup cg3viewer
+ */
+class OffscreenRenderer
+{
+public:
+    OffscreenRenderer(unsigned int width = 1024, unsigned int height = 768, unsigned int samples = 4);
+    ~OffscreenRenderer();
+
+    OffscreenRenderer(const OffscreenRenderer&) = delete;
+    OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
+
+    bool isValid() const;
+    unsigned int width() const;
+    unsigned int height() const;
+    bool resize(unsigned int width, unsigned int height);
+    void setBackgroundColor(const QColor& color);
+
+    // Point of View member functions:
+    cg3::Point3d cameraPosition() const;
+    cg3::Vec3d cameraDirection() const;
+    cg3::Vec3d cameraUpVector() const;
+    void resetPointOfView();
+    void setCameraPosition(const cg3::Point3d& pos);
+    void setCameraDirection(const cg3::Vec3d& vec);
+    void setCameraUpVector(const cg3::Vec3d& vec);
+    void lookAt(const cg3::Point3d& target);
+    bool loadPointOfView(const std::string& filename);
+    void setPerspectiveCamera();
+    void setOrthographicCamera();
+    bool isOrthographicCamera() const;
+    void setFieldOfView(double fov);
+    void fitScene(const cg3::Point3d& center, double radius);
+    void fitScene(const std::vector<const cg3::DrawableObject*>& objects);
+
+    void modelViewMatrix(double m[16]) const;
+    void projectionMatrix(double m[16]) const;
+    cg3::PickingView pickingView() const;
+
+    QImage render(const std::vector<const cg3::DrawableObject*>& objects);
+    QImage render(const cg3::DrawableObject& object);
+
+    template <typename Loader, typename Consumer>
+    void renderBatch(unsigned int n, Loader load, Consumer consume, bool fit = true);
+
+    unsigned int zoomSceneFactor;
+
+private:
+    bool makeCurrent() const;
+    bool createSurface(unsigned int width, unsigned int height);
+    void setupContext() const;
+
+    void* display;  //EGLDisplay
+    void* config;   //EGLConfig
+    void* context;  //EGLContext
+    void* surface;  //EGLSurface
+    unsigned int w, h;
+
+    QColor backgroundColor;
+    cg3::Point3d position;
+    cg3::Vec3d direction, up;
+    cg3::Point3d sceneCenter;
+    double sceneRadius;
+    double fov;
+    bool orthographic;
+
+    std::vector<unsigned char> pixels;
+};
+
+/**
+ * @brief Renders n objects, one at a time, pipelining their loading and the
+ * consumption of their images with the rendering.
+ *
+ * While the i-th object is rendered by this thread, the (i+1)-th is loaded and
+ * the image of the (i-1)-th is consumed, each in its own thread:
+ * - load(i) must return a std::unique_ptr or std::shared_ptr to the i-th
+ *   DrawableObject, or nullptr if it cannot be loaded. It must not make
+ *   OpenGL calls: objects are uploaded by the first render.
+ * - consume(i, image) receives the image of the i-th object (a null QImage if
+ *   the object was not loaded), e.g. to save it. Calls are in order and never
+ *   concurrent.
+ *
+ * Objects are destroyed by this thread after their render. If fit is true,
+ * the scene is fitted on every object before its render, keeping the view
+ * direction.
+ */
+template <typename Loader, typename Consumer>
+void OffscreenRenderer::renderBatch(unsigned int n, Loader load, Consumer consume, bool fit)
+{
+    if (n == 0)
+        return;
+    auto next = std::async(std::launch::async, load, 0u);
+    std::future<void> consumed;
+    for (unsigned int i = 0; i < n; i++) {
+        auto object = next.get();
+        if (i + 1 < n)
+            next = std::async(std::launch::async, load, i + 1);
+
+        QImage image;
+        if (object) {
+            if (fit)
+                fitScene(std::vector<const DrawableObject*>{object.get()});
+            image = render(*object);
+            object.reset();
+        }
+
+        if (consumed.valid())
+            consumed.get();
+        consumed = std::async(std::launch::async, [&consume, i](const QImage& img) {
+            consume(i, img);
+        }, std::move(image));
+    }
+    consumed.get();
+}
+
+} //namespace cg3::viewer
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_OFFSCREEN_RENDERER_CPP "offscreen_renderer.cpp"
+#include CG3_OFFSCREEN_RENDERER_CPP
+#undef CG3_OFFSCREEN_RENDERER_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_OFFSCREEN_RENDERER_H
@@ -0,0 +1,196 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "opengl_buffer.h"
+
+#include <cg3/cg3lib.h>
+
+#include <cassert>
+#include <cstdlib>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#if !defined(WIN32) && !defined(__APPLE__)
+//buffer objects are core since OpenGL 1.5 and exported by libGL, but their
+//prototypes may have been excluded by the first inclusion of gl.h
+#ifndef GL_VERSION_1_5
+typedef std::ptrdiff_t GLsizeiptr;
+typedef std::ptrdiff_t GLintptr;
+#endif
+extern "C" {
+void APIENTRY glGenBuffers(GLsizei n, GLuint* buffers);
+void APIENTRY glDeleteBuffers(GLsizei n, const GLuint* buffers);
+void APIENTRY glBindBuffer(GLenum target, GLuint buffer);
+void APIENTRY glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+void APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+}
+#endif
+
+namespace cg3 {
+
+namespace opengl {
+
+namespace internal {
+
+#ifdef WIN32
+//on Windows, functions after OpenGL 1.1 must be loaded at runtime
+typedef void (APIENTRY *GenBuffersFunction)(GLsizei, GLuint*);
+typedef void (APIENTRY *DeleteBuffersFunction)(GLsizei, const GLuint*);
+typedef void (APIENTRY *BindBufferFunction)(GLenum, GLuint);
+typedef void (APIENTRY *BufferDataFunction)(GLenum, std::ptrdiff_t, const void*, GLenum);
+typedef void (APIENTRY *BufferSubDataFunction)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*);
+
+struct BufferFunctions {
+    GenBuffersFunction genBuffers = nullptr;
+    DeleteBuffersFunction deleteBuffers = nullptr;
+    BindBufferFunction bindBuffer = nullptr;
+    BufferDataFunction bufferData = nullptr;
+    BufferSubDataFunction bufferSubData = nullptr;
+};
+
+CG3_INLINE const BufferFunctions& bufferFunctions()
+{
+    static BufferFunctions f;
+    if (f.genBuffers == nullptr && wglGetCurrentContext() != nullptr) {
+        f.genBuffers = (GenBuffersFunction)wglGetProcAddress("glGenBuffers");
+        f.deleteBuffers = (DeleteBuffersFunction)wglGetProcAddress("glDeleteBuffers");
+        f.bindBuffer = (BindBufferFunction)wglGetProcAddress("glBindBuffer");
+        f.bufferData = (BufferDataFunction)wglGetProcAddress("glBufferData");
+        f.bufferSubData = (BufferSubDataFunction)wglGetProcAddress("glBufferSubData");
+    }
+    return f;
+}
+
+CG3_INLINE void genBuffers(GLsizei n, GLuint* b) { bufferFunctions().genBuffers(n, b); }
+CG3_INLINE void deleteBuffers(GLsizei n, const GLuint* b) { bufferFunctions().deleteBuffers(n, b); }
+CG3_INLINE void bindBuffer(GLenum t, GLuint b) { bufferFunctions().bindBuffer(t, b); }
+CG3_INLINE void bufferData(GLenum t, std::size_t s, const void* d, GLenum u) { bufferFunctions().bufferData(t, s, d, u); }
+CG3_INLINE void bufferSubData(GLenum t, std::size_t o, std::size_t s, const void* d) { bufferFunctions().bufferSubData(t, o, s, d); }
+#else
+CG3_INLINE void genBuffers(GLsizei n, GLuint* b) { glGenBuffers(n, b); }
+CG3_INLINE void deleteBuffers(GLsizei n, const GLuint* b) { glDeleteBuffers(n, b); }
+CG3_INLINE void bindBuffer(GLenum t, GLuint b) { glBindBuffer(t, b); }
+CG3_INLINE void bufferData(GLenum t, std::size_t s, const void* d, GLenum u) { glBufferData(t, s, d, u); }
+CG3_INLINE void bufferSubData(GLenum t, std::size_t o, std::size_t s, const void* d) { glBufferSubData(t, o, s, d); }
+#endif
+
+} //namespace cg3::opengl::internal
+
+/**
+ * @brief Returns true if the current OpenGL context supports buffer objects
+ * (OpenGL 1.5 or later).
+ */
+CG3_INLINE bool buffersSupported()
+{
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version == nullptr)
+        return false;
+    #ifdef WIN32
+    if (internal::bufferFunctions().bufferSubData == nullptr)
+        return false;
+    #endif
+    char* end;
+    long major = std::strtol(version, &end, 10);
+    long minor = *end == '.' ? std::strtol(end + 1, nullptr, 10) : 0;
+    return major > 1 || (major == 1 && minor >= 5);
+}
+
+/**
+ * @brief Creates an empty buffer. The buffer object is created by allocate().
+ * @param target: GL_ARRAY_BUFFER for vertex attributes, GL_ELEMENT_ARRAY_BUFFER for indices
+ */
+CG3_INLINE Buffer::Buffer(GLenum target) :
+    target(target),
+    id(0),
+    bytes(0)
+{
+}
+
+CG3_INLINE Buffer::Buffer(const Buffer& other) :
+    target(other.target),
+    id(0),
+    bytes(0)
+{
+}
+
+CG3_INLINE Buffer::~Buffer()
+{
+    destroy();
+}
+
+CG3_INLINE Buffer& Buffer::operator=(const Buffer& other)
+{
+    if (this != &other) {
+        destroy();
+        target = other.target;
+    }
+    return *this;
+}
+
+CG3_INLINE bool Buffer::isCreated() const
+{
+    return id != 0;
+}
+
+/**
+ * @brief Returns the size in bytes of the allocated buffer
+ */
+CG3_INLINE std::size_t Buffer::size() const
+{
+    return bytes;
+}
+
+CG3_INLINE void Buffer::bind() const
+{
+    internal::bindBuffer(target, id);
+}
+
+CG3_INLINE void Buffer::release() const
+{
+    internal::bindBuffer(target, 0);
+}
+
+/**
+ * @brief (Re)allocates the buffer with the given size, and fills it with data
+ * if data is not nullptr. The buffer is left bound.
+ */
+CG3_INLINE void Buffer::allocate(const void* data, std::size_t bytes, GLenum usage)
+{
+    if (id == 0)
+        internal::genBuffers(1, &id);
+    bind();
+    internal::bufferData(target, bytes, data, usage);
+    this->bytes = bytes;
+}
+
+/**
+ * @brief Overwrites a range of the allocated buffer. The buffer is left bound.
+ */
+CG3_INLINE void Buffer::write(std::size_t offset, const void* data, std::size_t bytes)
+{
+    assert(offset + bytes <= this->bytes);
+    bind();
+    internal::bufferSubData(target, offset, bytes, data);
+}
+
+/**
+ * @brief Deletes the buffer object
+ */
+CG3_INLINE void Buffer::destroy()
+{
+    if (id != 0) {
+        internal::deleteBuffers(1, &id);
+        id = 0;
+        bytes = 0;
+    }
+}
+
+} //namespace cg3::opengl
+
+} //namespace cg3
@@ -0,0 +1,78 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_OPENGL_BUFFER_H
+#define CG3_OPENGL_BUFFER_H
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <cstddef>
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER         0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STATIC_DRAW          0x88E4
+#define GL_DYNAMIC_DRAW         0x88E8
+#endif
+
+namespace cg3 {
+
+namespace opengl {
+
+bool buffersSupported();
+
+/**
+ * @brief A buffer object (VBO) stored in the memory of the GPU.
+ *
+ * All the methods must be called with the OpenGL context current.
+ * Copying a Buffer does not copy the buffer object: the copy is empty and
+ * must be uploaded again.
+ */
+class Buffer
+{
+public:
+    Buffer(GLenum target = GL_ARRAY_BUFFER);
+    Buffer(const Buffer& other);
+    ~Buffer();
+
+    Buffer& operator=(const Buffer& other);
+
+    bool isCreated() const;
+    std::size_t size() const;
+
+    void bind() const;
+    void release() const;
+
+    void allocate(const void* data, std::size_t bytes, GLenum usage = GL_STATIC_DRAW);
+    void write(std::size_t offset, const void* data, std::size_t bytes);
+    void destroy();
+
+private:
+    GLenum target;
+    GLuint id;
+    std::size_t bytes;
+};
+
+} //namespace cg3::opengl
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_OPENGL_BUFFER_CPP "opengl_buffer.cpp"
+#include CG3_OPENGL_BUFFER_CPP
+#undef CG3_OPENGL_BUFFER_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_OPENGL_BUFFER_H
@@ -58,6 +58,7 @@ inline void drawSphere(
     gluQuadricNormals(sphere, GLU_SMOOTH);
     gluQuadricOrientation(sphere, GLU_OUTSIDE);
     gluSphere(sphere, radius, precision, precision);
+    gluDeleteQuadric(sphere);
     glPopMatrix();
 
 }
@@ -102,11 +103,13 @@ inline void drawCylinder(
     gluQuadricNormals(cylinder, GLU_SMOOTH);
     gluQuadricOrientation(cylinder, GLU_OUTSIDE);
     gluCylinder(cylinder, top_radius, bottom_radius, (a-b).length(), slices, stacks);
+	gluDeleteQuadric(cylinder);
 
 	GLUquadric *disk1 = gluNewQuadric();
 	gluQuadricNormals(disk1, GLU_SMOOTH);
 	gluQuadricOrientation(disk1, GLU_INSIDE);
 	gluDisk(disk1, 0, top_radius, slices, stacks);
+	gluDeleteQuadric(disk1);
 
 	/*glTranslated((b-a).x(), (b-a).y(), (b-a).z());
 	GLUquadric *disk2 = gluNewQuadric();
@@ -0,0 +1,367 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "opengl_program.h"
+
+#include <cg3/cg3lib.h>
+
+#include <cstdlib>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_VERTEX_SHADER
+#define GL_FRAGMENT_SHADER  0x8B30
+#define GL_VERTEX_SHADER    0x8B31
+#define GL_COMPILE_STATUS   0x8B81
+#define GL_LINK_STATUS      0x8B82
+#define GL_INFO_LOG_LENGTH  0x8B84
+#endif
+
+#if !defined(WIN32) && !defined(__APPLE__)
+//shaders and instancing are exported by libGL, but their prototypes may have
+//been excluded by the first inclusion of gl.h
+#ifndef GL_VERSION_2_0
+typedef char GLchar;
+#endif
+extern "C" {
+GLuint APIENTRY glCreateShader(GLenum type);
+void APIENTRY glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void APIENTRY glCompileShader(GLuint shader);
+void APIENTRY glGetShaderiv(GLuint shader, GLenum pname, GLint* params);
+void APIENTRY glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void APIENTRY glDeleteShader(GLuint shader);
+GLuint APIENTRY glCreateProgram();
+void APIENTRY glAttachShader(GLuint program, GLuint shader);
+void APIENTRY glBindAttribLocation(GLuint program, GLuint index, const GLchar* name);
+void APIENTRY glLinkProgram(GLuint program);
+void APIENTRY glGetProgramiv(GLuint program, GLenum pname, GLint* params);
+void APIENTRY glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void APIENTRY glUseProgram(GLuint program);
+void APIENTRY glDeleteProgram(GLuint program);
+void APIENTRY glEnableVertexAttribArray(GLuint index);
+void APIENTRY glDisableVertexAttribArray(GLuint index);
+void APIENTRY glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+void APIENTRY glVertexAttribDivisor(GLuint index, GLuint divisor);
+void APIENTRY glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount);
+}
+#endif
+
+namespace cg3 {
+
+namespace opengl {
+
+namespace internal {
+
+#if defined(WIN32)
+//on Windows, functions after OpenGL 1.1 must be loaded at runtime
+struct ProgramFunctions {
+    GLuint (APIENTRY *createShader)(GLenum) = nullptr;
+    void (APIENTRY *shaderSource)(GLuint, GLsizei, const char* const*, const GLint*) = nullptr;
+    void (APIENTRY *compileShader)(GLuint) = nullptr;
+    void (APIENTRY *getShaderiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY *getShaderInfoLog)(GLuint, GLsizei, GLsizei*, char*) = nullptr;
+    void (APIENTRY *deleteShader)(GLuint) = nullptr;
+    GLuint (APIENTRY *createProgram)() = nullptr;
+    void (APIENTRY *attachShader)(GLuint, GLuint) = nullptr;
+    void (APIENTRY *bindAttribLocation)(GLuint, GLuint, const char*) = nullptr;
+    void (APIENTRY *linkProgram)(GLuint) = nullptr;
+    void (APIENTRY *getProgramiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY *getProgramInfoLog)(GLuint, GLsizei, GLsizei*, char*) = nullptr;
+    void (APIENTRY *useProgram)(GLuint) = nullptr;
+    void (APIENTRY *deleteProgram)(GLuint) = nullptr;
+    void (APIENTRY *enableVertexAttribArray)(GLuint) = nullptr;
+    void (APIENTRY *disableVertexAttribArray)(GLuint) = nullptr;
+    void (APIENTRY *vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = nullptr;
+    void (APIENTRY *vertexAttribDivisor)(GLuint, GLuint) = nullptr;
+    void (APIENTRY *drawElementsInstanced)(GLenum, GLsizei, GLenum, const void*, GLsizei) = nullptr;
+};
+
+template <typename F>
+inline void loadFunction(F& f, const char* name)
+{
+    f = (F) wglGetProcAddress(name);
+}
+
+CG3_INLINE const ProgramFunctions& programFunctions()
+{
+    static ProgramFunctions f;
+    if (f.createShader == nullptr && wglGetCurrentContext() != nullptr) {
+        loadFunction(f.createShader, "glCreateShader");
+        loadFunction(f.shaderSource, "glShaderSource");
+        loadFunction(f.compileShader, "glCompileShader");
+        loadFunction(f.getShaderiv, "glGetShaderiv");
+        loadFunction(f.getShaderInfoLog, "glGetShaderInfoLog");
+        loadFunction(f.deleteShader, "glDeleteShader");
+        loadFunction(f.createProgram, "glCreateProgram");
+        loadFunction(f.attachShader, "glAttachShader");
+        loadFunction(f.bindAttribLocation, "glBindAttribLocation");
+        loadFunction(f.linkProgram, "glLinkProgram");
+        loadFunction(f.getProgramiv, "glGetProgramiv");
+        loadFunction(f.getProgramInfoLog, "glGetProgramInfoLog");
+        loadFunction(f.useProgram, "glUseProgram");
+        loadFunction(f.deleteProgram, "glDeleteProgram");
+        loadFunction(f.enableVertexAttribArray, "glEnableVertexAttribArray");
+        loadFunction(f.disableVertexAttribArray, "glDisableVertexAttribArray");
+        loadFunction(f.vertexAttribPointer, "glVertexAttribPointer");
+        loadFunction(f.vertexAttribDivisor, "glVertexAttribDivisor");
+        loadFunction(f.drawElementsInstanced, "glDrawElementsInstanced");
+    }
+    return f;
+}
+
+CG3_INLINE bool functionsLoaded() { return programFunctions().drawElementsInstanced != nullptr && programFunctions().vertexAttribDivisor != nullptr; }
+CG3_INLINE GLuint createShader(GLenum t) { return programFunctions().createShader(t); }
+CG3_INLINE void shaderSource(GLuint s, const char* src) { programFunctions().shaderSource(s, 1, &src, nullptr); }
+CG3_INLINE void compileShader(GLuint s) { programFunctions().compileShader(s); }
+CG3_INLINE void getShaderiv(GLuint s, GLenum p, GLint* v) { programFunctions().getShaderiv(s, p, v); }
+CG3_INLINE void getShaderInfoLog(GLuint s, GLsizei n, char* l) { programFunctions().getShaderInfoLog(s, n, nullptr, l); }
+CG3_INLINE void deleteShader(GLuint s) { programFunctions().deleteShader(s); }
+CG3_INLINE GLuint createProgram() { return programFunctions().createProgram(); }
+CG3_INLINE void attachShader(GLuint p, GLuint s) { programFunctions().attachShader(p, s); }
+CG3_INLINE void bindAttribLocation(GLuint p, GLuint i, const char* n) { programFunctions().bindAttribLocation(p, i, n); }
+CG3_INLINE void linkProgram(GLuint p) { programFunctions().linkProgram(p); }
+CG3_INLINE void getProgramiv(GLuint p, GLenum n, GLint* v) { programFunctions().getProgramiv(p, n, v); }
+CG3_INLINE void getProgramInfoLog(GLuint p, GLsizei n, char* l) { programFunctions().getProgramInfoLog(p, n, nullptr, l); }
+CG3_INLINE void useProgram(GLuint p) { programFunctions().useProgram(p); }
+CG3_INLINE void deleteProgram(GLuint p) { programFunctions().deleteProgram(p); }
+CG3_INLINE void enableAttrib(GLuint i) { programFunctions().enableVertexAttribArray(i); }
+CG3_INLINE void disableAttrib(GLuint i) { programFunctions().disableVertexAttribArray(i); }
+CG3_INLINE void attribPointer(GLuint i, GLint s, GLenum t, GLboolean n, GLsizei st, const void* p) { programFunctions().vertexAttribPointer(i, s, t, n, st, p); }
+CG3_INLINE void attribDivisor(GLuint i, GLuint d) { programFunctions().vertexAttribDivisor(i, d); }
+CG3_INLINE void drawInstanced(GLenum m, GLsizei c, GLenum t, const void* i, GLsizei n) { programFunctions().drawElementsInstanced(m, c, t, i, n); }
+#elif defined(__APPLE__)
+//the compatibility profile of macOS is OpenGL 2.1: instancing is never used
+CG3_INLINE bool functionsLoaded() { return false; }
+CG3_INLINE GLuint createShader(GLenum) { return 0; }
+CG3_INLINE void shaderSource(GLuint, const char*) {}
+CG3_INLINE void compileShader(GLuint) {}
+CG3_INLINE void getShaderiv(GLuint, GLenum, GLint* v) { *v = 0; }
+CG3_INLINE void getShaderInfoLog(GLuint, GLsizei, char* l) { *l = 0; }
+CG3_INLINE void deleteShader(GLuint) {}
+CG3_INLINE GLuint createProgram() { return 0; }
+CG3_INLINE void attachShader(GLuint, GLuint) {}
+CG3_INLINE void bindAttribLocation(GLuint, GLuint, const char*) {}
+CG3_INLINE void linkProgram(GLuint) {}
+CG3_INLINE void getProgramiv(GLuint, GLenum, GLint* v) { *v = 0; }
+CG3_INLINE void getProgramInfoLog(GLuint, GLsizei, char* l) { *l = 0; }
+CG3_INLINE void useProgram(GLuint) {}
+CG3_INLINE void deleteProgram(GLuint) {}
+CG3_INLINE void enableAttrib(GLuint) {}
+CG3_INLINE void disableAttrib(GLuint) {}
+CG3_INLINE void attribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+CG3_INLINE void attribDivisor(GLuint, GLuint) {}
+CG3_INLINE void drawInstanced(GLenum, GLsizei, GLenum, const void*, GLsizei) {}
+#else
+CG3_INLINE bool functionsLoaded() { return true; }
+CG3_INLINE GLuint createShader(GLenum t) { return glCreateShader(t); }
+CG3_INLINE void shaderSource(GLuint s, const char* src) { glShaderSource(s, 1, &src, nullptr); }
+CG3_INLINE void compileShader(GLuint s) { glCompileShader(s); }
+CG3_INLINE void getShaderiv(GLuint s, GLenum p, GLint* v) { glGetShaderiv(s, p, v); }
+CG3_INLINE void getShaderInfoLog(GLuint s, GLsizei n, char* l) { glGetShaderInfoLog(s, n, nullptr, l); }
+CG3_INLINE void deleteShader(GLuint s) { glDeleteShader(s); }
+CG3_INLINE GLuint createProgram() { return glCreateProgram(); }
+CG3_INLINE void attachShader(GLuint p, GLuint s) { glAttachShader(p, s); }
+CG3_INLINE void bindAttribLocation(GLuint p, GLuint i, const char* n) { glBindAttribLocation(p, i, n); }
+CG3_INLINE void linkProgram(GLuint p) { glLinkProgram(p); }
+CG3_INLINE void getProgramiv(GLuint p, GLenum n, GLint* v) { glGetProgramiv(p, n, v); }
+CG3_INLINE void getProgramInfoLog(GLuint p, GLsizei n, char* l) { glGetProgramInfoLog(p, n, nullptr, l); }
+CG3_INLINE void useProgram(GLuint p) { glUseProgram(p); }
+CG3_INLINE void deleteProgram(GLuint p) { glDeleteProgram(p); }
+CG3_INLINE void enableAttrib(GLuint i) { glEnableVertexAttribArray(i); }
+CG3_INLINE void disableAttrib(GLuint i) { glDisableVertexAttribArray(i); }
+CG3_INLINE void attribPointer(GLuint i, GLint s, GLenum t, GLboolean n, GLsizei st, const void* p) { glVertexAttribPointer(i, s, t, n, st, p); }
+CG3_INLINE void attribDivisor(GLuint i, GLuint d) { glVertexAttribDivisor(i, d); }
+CG3_INLINE void drawInstanced(GLenum m, GLsizei c, GLenum t, const void* i, GLsizei n) { glDrawElementsInstanced(m, c, t, i, n); }
+#endif
+
+} //namespace cg3::opengl::internal
+
+/**
+ * @brief Returns true if the current OpenGL context supports GLSL programs
+ * and instanced arrays (OpenGL 3.3 or later, compatibility profile).
+ */
+CG3_INLINE bool instancingSupported()
+{
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version == nullptr || !internal::functionsLoaded())
+        return false;
+    char* end;
+    long major = std::strtol(version, &end, 10);
+    long minor = *end == '.' ? std::strtol(end + 1, nullptr, 10) : 0;
+    return major > 3 || (major == 3 && minor >= 3);
+}
+
+CG3_INLINE void enableVertexAttribArray(GLuint index)
+{
+    internal::enableAttrib(index);
+}
+
+CG3_INLINE void disableVertexAttribArray(GLuint index)
+{
+    internal::disableAttrib(index);
+}
+
+/**
+ * @brief Sets the array of a generic vertex attribute: if a buffer is bound
+ * to GL_ARRAY_BUFFER, pointer is an offset in the buffer.
+ */
+CG3_INLINE void vertexAttribPointer(
+        GLuint index,
+        GLint size,
+        GLenum type,
+        bool normalized,
+        GLsizei stride,
+        const void* pointer)
+{
+    internal::attribPointer(index, size, type, normalized ? GL_TRUE : GL_FALSE, stride, pointer);
+}
+
+/**
+ * @brief Sets how many instances share an element of the array of a generic
+ * attribute: 0 for per vertex attributes, 1 for per instance attributes.
+ */
+CG3_INLINE void vertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    internal::attribDivisor(index, divisor);
+}
+
+CG3_INLINE void drawElementsInstanced(
+        GLenum mode,
+        GLsizei count,
+        GLenum type,
+        const void* indices,
+        GLsizei instances)
+{
+    internal::drawInstanced(mode, count, type, indices, instances);
+}
+
+CG3_INLINE Program::Program() :
+    id(0)
+{
+}
+
+CG3_INLINE Program::Program(const Program&) :
+    id(0)
+{
+}
+
+CG3_INLINE Program::~Program()
+{
+    destroy();
+}
+
+CG3_INLINE Program& Program::operator=(const Program& other)
+{
+    if (this != &other)
+        destroy();
+    return *this;
+}
+
+CG3_INLINE bool Program::isCreated() const
+{
+    return id != 0;
+}
+
+/**
+ * @brief Compiles and links the program.
+ * @param attributes: locations of the generic attributes of the vertex shader
+ * @return false if the program cannot be created: log() contains the errors
+ */
+CG3_INLINE bool Program::create(
+        const std::string& vertexShader,
+        const std::string& fragmentShader,
+        const std::vector<std::pair<GLuint, std::string>>& attributes)
+{
+    destroy();
+    _log.clear();
+
+    auto compile = [&](GLenum type, const std::string& source) {
+        GLuint shader = internal::createShader(type);
+        internal::shaderSource(shader, source.c_str());
+        internal::compileShader(shader);
+        GLint ok = 0, length = 0;
+        internal::getShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            internal::getShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+            std::vector<char> log(length + 1, 0);
+            internal::getShaderInfoLog(shader, length, log.data());
+            _log += log.data();
+            internal::deleteShader(shader);
+            return (GLuint) 0;
+        }
+        return shader;
+    };
+
+    GLuint vs = compile(GL_VERTEX_SHADER, vertexShader);
+    GLuint fs = fragmentShader.empty() ? 0 : compile(GL_FRAGMENT_SHADER, fragmentShader);
+    if (vs == 0 || (!fragmentShader.empty() && fs == 0)) {
+        if (vs != 0)
+            internal::deleteShader(vs);
+        if (fs != 0)
+            internal::deleteShader(fs);
+        return false;
+    }
+
+    id = internal::createProgram();
+    internal::attachShader(id, vs);
+    if (fs != 0)
+        internal::attachShader(id, fs);
+    for (const std::pair<GLuint, std::string>& a : attributes)
+        internal::bindAttribLocation(id, a.first, a.second.c_str());
+    internal::linkProgram(id);
+    //shaders are deleted with the program
+    internal::deleteShader(vs);
+    if (fs != 0)
+        internal::deleteShader(fs);
+
+    GLint ok = 0, length = 0;
+    internal::getProgramiv(id, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        internal::getProgramiv(id, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length + 1, 0);
+        internal::getProgramInfoLog(id, length, log.data());
+        _log += log.data();
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Errors of the last create()
+ */
+CG3_INLINE const std::string& Program::log() const
+{
+    return _log;
+}
+
+CG3_INLINE void Program::bind() const
+{
+    internal::useProgram(id);
+}
+
+CG3_INLINE void Program::release() const
+{
+    internal::useProgram(0);
+}
+
+/**
+ * @brief Deletes the program object
+ */
+CG3_INLINE void Program::destroy()
+{
+    if (id != 0) {
+        internal::deleteProgram(id);
+        id = 0;
+    }
+}
+
+} //namespace cg3::opengl
+
+} //namespace cg3
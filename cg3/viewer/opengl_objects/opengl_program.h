@@ -0,0 +1,84 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_OPENGL_PROGRAM_H
+#define CG3_OPENGL_PROGRAM_H
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cg3 {
+
+namespace opengl {
+
+bool instancingSupported();
+
+void enableVertexAttribArray(GLuint index);
+void disableVertexAttribArray(GLuint index);
+void vertexAttribPointer(GLuint index, GLint size, GLenum type, bool normalized, GLsizei stride, const void* pointer);
+void vertexAttribDivisor(GLuint index, GLuint divisor);
+void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances);
+
+/**
+ * @brief A GLSL program, made by a vertex shader and an optional fragment
+ * shader.
+ *
+ * Shaders are written for the compatibility profile (GLSL 1.20), so they can
+ * use the fixed function state (matrices, lights, materials); without a
+ * fragment shader, fragments are processed by the fixed function pipeline.
+ *
+ * All the methods must be called with the OpenGL context current.
+ * Copying a Program does not copy the program object: the copy must be
+ * created again.
+ */
+class Program
+{
+public:
+    Program();
+    Program(const Program& other);
+    ~Program();
+
+    Program& operator=(const Program& other);
+
+    bool isCreated() const;
+    bool create(
+            const std::string& vertexShader,
+            const std::string& fragmentShader = "",
+            const std::vector<std::pair<GLuint, std::string>>& attributes = {});
+    const std::string& log() const;
+
+    void bind() const;
+    void release() const;
+    void destroy();
+
+private:
+    GLuint id;
+    std::string _log;
+};
+
+} //namespace cg3::opengl
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_OPENGL_PROGRAM_CPP "opengl_program.cpp"
+#include CG3_OPENGL_PROGRAM_CPP
+#undef CG3_OPENGL_PROGRAM_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_OPENGL_PROGRAM_H
@@ -0,0 +1,168 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "opengl_query.h"
+
+#include <cg3/cg3lib.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED             0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT             0x8866
+#define GL_QUERY_RESULT_AVAILABLE   0x8867
+#endif
+
+#if !defined(WIN32) && !defined(__APPLE__)
+//queries are exported by libGL, but their prototypes may have been excluded
+//by the first inclusion of gl.h
+#ifndef GL_VERSION_3_2
+typedef uint64_t GLuint64;
+#endif
+extern "C" {
+void APIENTRY glGenQueries(GLsizei n, GLuint* ids);
+void APIENTRY glDeleteQueries(GLsizei n, const GLuint* ids);
+void APIENTRY glBeginQuery(GLenum target, GLuint id);
+void APIENTRY glEndQuery(GLenum target);
+void APIENTRY glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params);
+void APIENTRY glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params);
+}
+#endif
+
+namespace cg3 {
+
+namespace opengl {
+
+namespace internal {
+
+#if defined(WIN32)
+//on Windows, functions after OpenGL 1.1 must be loaded at runtime
+struct QueryFunctions {
+    void (APIENTRY *genQueries)(GLsizei, GLuint*) = nullptr;
+    void (APIENTRY *deleteQueries)(GLsizei, const GLuint*) = nullptr;
+    void (APIENTRY *beginQuery)(GLenum, GLuint) = nullptr;
+    void (APIENTRY *endQuery)(GLenum) = nullptr;
+    void (APIENTRY *getQueryObjectiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY *getQueryObjectui64v)(GLuint, GLenum, unsigned long long int*) = nullptr;
+};
+
+CG3_INLINE const QueryFunctions& queryFunctions()
+{
+    static QueryFunctions f;
+    if (f.genQueries == nullptr && wglGetCurrentContext() != nullptr) {
+        f.genQueries = (void (APIENTRY *)(GLsizei, GLuint*)) wglGetProcAddress("glGenQueries");
+        f.deleteQueries = (void (APIENTRY *)(GLsizei, const GLuint*)) wglGetProcAddress("glDeleteQueries");
+        f.beginQuery = (void (APIENTRY *)(GLenum, GLuint)) wglGetProcAddress("glBeginQuery");
+        f.endQuery = (void (APIENTRY *)(GLenum)) wglGetProcAddress("glEndQuery");
+        f.getQueryObjectiv = (void (APIENTRY *)(GLuint, GLenum, GLint*)) wglGetProcAddress("glGetQueryObjectiv");
+        f.getQueryObjectui64v = (void (APIENTRY *)(GLuint, GLenum, unsigned long long int*)) wglGetProcAddress("glGetQueryObjectui64v");
+    }
+    return f;
+}
+
+CG3_INLINE bool queryFunctionsLoaded() { return queryFunctions().getQueryObjectui64v != nullptr; }
+CG3_INLINE void genQuery(GLuint* q) { queryFunctions().genQueries(1, q); }
+CG3_INLINE void deleteQuery(GLuint q) { queryFunctions().deleteQueries(1, &q); }
+CG3_INLINE void beginQuery(GLuint q) { queryFunctions().beginQuery(GL_TIME_ELAPSED, q); }
+CG3_INLINE void endQuery() { queryFunctions().endQuery(GL_TIME_ELAPSED); }
+CG3_INLINE void queryAvailable(GLuint q, GLint* v) { queryFunctions().getQueryObjectiv(q, GL_QUERY_RESULT_AVAILABLE, v); }
+CG3_INLINE void queryResult(GLuint q, unsigned long long int* v) { queryFunctions().getQueryObjectui64v(q, GL_QUERY_RESULT, v); }
+#elif defined(__APPLE__)
+//the compatibility profile of macOS is OpenGL 2.1: timer queries are never used
+CG3_INLINE bool queryFunctionsLoaded() { return false; }
+CG3_INLINE void genQuery(GLuint* q) { *q = 0; }
+CG3_INLINE void deleteQuery(GLuint) {}
+CG3_INLINE void beginQuery(GLuint) {}
+CG3_INLINE void endQuery() {}
+CG3_INLINE void queryAvailable(GLuint, GLint* v) { *v = 0; }
+CG3_INLINE void queryResult(GLuint, unsigned long long int* v) { *v = 0; }
+#else
+CG3_INLINE bool queryFunctionsLoaded() { return true; }
+CG3_INLINE void genQuery(GLuint* q) { glGenQueries(1, q); }
+CG3_INLINE void deleteQuery(GLuint q) { glDeleteQueries(1, &q); }
+CG3_INLINE void beginQuery(GLuint q) { glBeginQuery(GL_TIME_ELAPSED, q); }
+CG3_INLINE void endQuery() { glEndQuery(GL_TIME_ELAPSED); }
+CG3_INLINE void queryAvailable(GLuint q, GLint* v) { glGetQueryObjectiv(q, GL_QUERY_RESULT_AVAILABLE, v); }
+CG3_INLINE void queryResult(GLuint q, unsigned long long int* v) { GLuint64 r = 0; glGetQueryObjectui64v(q, GL_QUERY_RESULT, &r); *v = r; }
+#endif
+
+} //namespace cg3::opengl::internal
+
+/**
+ * @brief Returns true if the current OpenGL context supports timer queries
+ * (OpenGL 3.3 or later).
+ */
+CG3_INLINE bool timerQueriesSupported()
+{
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version == nullptr || !internal::queryFunctionsLoaded())
+        return false;
+    char* end;
+    long major = std::strtol(version, &end, 10);
+    long minor = *end == '.' ? std::strtol(end + 1, nullptr, 10) : 0;
+    return major > 3 || (major == 3 && minor >= 3);
+}
+
+CG3_INLINE GLuint createTimerQuery()
+{
+    GLuint query = 0;
+    internal::genQuery(&query);
+    return query;
+}
+
+CG3_INLINE void deleteTimerQuery(GLuint query)
+{
+    if (query != 0)
+        internal::deleteQuery(query);
+}
+
+/**
+ * @brief Starts measuring the time spent by the GPU on the next commands.
+ * Timer queries cannot be nested.
+ */
+CG3_INLINE void beginTimerQuery(GLuint query)
+{
+    internal::beginQuery(query);
+}
+
+CG3_INLINE void endTimerQuery()
+{
+    internal::endQuery();
+}
+
+/**
+ * @brief Returns true if the GPU finished the commands measured by the query,
+ * that is, if timerQueryMilliseconds can be called without waiting.
+ */
+CG3_INLINE bool isTimerQueryAvailable(GLuint query)
+{
+    GLint available = 0;
+    internal::queryAvailable(query, &available);
+    return available != 0;
+}
+
+/**
+ * @brief Returns the time measured by the query, waiting for the GPU if the
+ * result is not available yet.
+ */
+CG3_INLINE double timerQueryMilliseconds(GLuint query)
+{
+    unsigned long long int ns = 0;
+    internal::queryResult(query, &ns);
+    return ns / 1e6;
+}
+
+} //namespace cg3::opengl
+
+} //namespace cg3
@@ -0,0 +1,44 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_OPENGL_QUERY_H
+#define CG3_OPENGL_QUERY_H
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+namespace cg3 {
+
+namespace opengl {
+
+bool timerQueriesSupported();
+
+GLuint createTimerQuery();
+void deleteTimerQuery(GLuint query);
+void beginTimerQuery(GLuint query);
+void endTimerQuery();
+bool isTimerQueryAvailable(GLuint query);
+double timerQueryMilliseconds(GLuint query);
+
+} //namespace cg3::opengl
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_OPENGL_QUERY_CPP "opengl_query.cpp"
+#include CG3_OPENGL_QUERY_CPP
+#undef CG3_OPENGL_QUERY_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_OPENGL_QUERY_H
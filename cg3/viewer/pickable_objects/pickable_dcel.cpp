@@ -8,6 +8,9 @@
 
 #include "pickable_dcel.h"
 
+#include <algorithm>
+#include <limits>
+
 #ifdef __APPLE__
 #include <gl.h>
 #else
@@ -72,6 +75,120 @@ CG3_INLINE void PickableDcel::draw() const
     }
 }
 
+CG3_INLINE bool PickableDcel::isRayPickable() const
+{
+    return true;
+}
+
+/**
+ * @brief Casts a ray and returns the nearest face hit, with the vertex and the
+ * half edge of the face nearest to the hit point.
+ */
+CG3_INLINE bool PickableDcel::pick(const Point3d& origin, const Vec3d& dir, PickHit& hit) const
+{
+    TriangleBVH::RayHit rh;
+    if (!meshPicker().ray(origin, dir, rh))
+        return false;
+
+    const Face* f = face(trianglesFacesMap[rh.triangle]);
+    hit.face = f->id();
+    hit.distance = rh.t;
+    hit.point = origin + dir * rh.t;
+    hit.barycentric = Point3d(1 - rh.u - rh.v, rh.u, rh.v);
+
+    //half edges of the outer and inner borders of the face
+    std::vector<const HalfEdge*> borders;
+    for (const HalfEdge* he : f->incidentHalfEdgeIterator())
+        borders.push_back(he);
+    for (const HalfEdge* inner : f->innerHalfEdgeIterator()) {
+        const HalfEdge* he = inner;
+        do {
+            borders.push_back(he);
+            he = he->next();
+        } while (he != inner);
+    }
+
+    double vDist = std::numeric_limits<double>::max();
+    double eDist = std::numeric_limits<double>::max();
+    for (const HalfEdge* he : borders) {
+        const Vertex* v = he->fromVertex();
+        for (unsigned int i = 0; i < 3; ++i)
+            if (verticesIndicesMap[v->id()] == triangles[3*rh.triangle+i])
+                hit.triangleVertices[i] = v->id();
+
+        double d = v->coordinate().dist(hit.point);
+        if (d < vDist) {
+            vDist = d;
+            hit.vertex = v->id();
+        }
+
+        //distance between the hit point and the segment of the half edge
+        const Point3d& a = v->coordinate();
+        const Point3d& b = he->toVertex()->coordinate();
+        Vec3d ab = b - a;
+        double l = ab.dot(ab);
+        double t = l > 0 ? std::min(1.0, std::max(0.0, (hit.point - a).dot(ab) / l)) : 0;
+        d = (a + ab * t).dist(hit.point);
+        if (d < eDist) {
+            eDist = d;
+            hit.edge = he->id();
+            hit.edgeVertices[0] = v->id();
+            hit.edgeVertices[1] = he->toVertex()->id();
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Ids of the faces projected in a region of the window (occluded ones
+ * included). A polygonal face is inside if all its triangles are inside
+ * (completely) or if at least one of them is.
+ */
+CG3_INLINE std::vector<unsigned int> PickableDcel::pickFaces(
+        const PickingView& view,
+        const std::vector<Point2d>& region,
+        bool completely) const
+{
+    std::vector<unsigned int> tris;
+    meshPicker().triangles(view, region, completely, tris);
+
+    std::vector<unsigned int> count(faces.size(), 0);
+    for (unsigned int t : tris)
+        count[trianglesFacesMap[t]]++;
+
+    std::vector<unsigned int> picked;
+    for (unsigned int fid = 0; fid < count.size(); ++fid) {
+        unsigned int nt = facesTrianglesMap[fid+1] - facesTrianglesMap[fid];
+        if (count[fid] > 0 && (!completely || count[fid] == nt))
+            picked.push_back(fid);
+    }
+    return picked;
+}
+
+/**
+ * @brief Ids of the vertices projected in a region of the window (occluded ones
+ * included)
+ */
+CG3_INLINE std::vector<unsigned int> PickableDcel::pickVertices(
+        const PickingView& view,
+        const std::vector<Point2d>& region) const
+{
+    std::vector<unsigned int> indices;
+    meshPicker().vertices(view, region, indices);
+
+    std::vector<bool> inside(vertexCoordinates.size() / 3, false);
+    for (unsigned int i : indices)
+        inside[i] = true;
+
+    std::vector<unsigned int> picked;
+    picked.reserve(indices.size());
+    for (unsigned int vid = 0; vid < verticesIndicesMap.size(); ++vid) {
+        if (verticesIndicesMap[vid] >= 0 && inside[verticesIndicesMap[vid]])
+            picked.push_back(vid);
+    }
+    return picked;
+}
+
 CG3_INLINE void PickableDcel::setSelectionColor(Color color)
 {
     selectionColor = color;
@@ -90,13 +207,7 @@ CG3_INLINE void PickableDcel::setSelectionWidth(int value)
 CG3_INLINE void PickableDcel::drawFace(const Face* f) const
 {
     unsigned int firstIndex = facesTrianglesMap.at(f->id());
-    std::map<unsigned int, unsigned int>::const_iterator it = facesTrianglesMap.find(f->id());
-    ++it;
-    unsigned int lastIndex;
-    if (it == facesTrianglesMap.end())
-        lastIndex = (unsigned int)triangles.size()/3;
-    else
-        lastIndex = it->second;
+    unsigned int lastIndex = facesTrianglesMap.at(f->id()+1);
 
     std::vector<int> face_triangles;
     face_triangles.reserve((lastIndex-firstIndex)*3);
@@ -110,6 +221,21 @@ CG3_INLINE void PickableDcel::drawFace(const Face* f) const
     glDrawElements(GL_TRIANGLES, (GLsizei)face_triangles.size(), GL_UNSIGNED_INT, face_triangles.data());
 }
 
+/**
+ * @brief Returns the picker of the drawn triangles, synchronized with the
+ * last update of the DrawableDcel
+ */
+CG3_INLINE const internal::MeshPicker& PickableDcel::meshPicker() const
+{
+    picker.setArrays(
+                (unsigned int)vertexCoordinates.size() / 3,
+                (unsigned int)triangles.size() / 3,
+                vertexCoordinates.data(),
+                triangles.data(),
+                geometryVersion);
+    return picker;
+}
+
 CG3_INLINE void PickableDcel::setSelectedFacesContour(std::vector<Dcel::HalfEdge*> selected_faces_contour)
 {
     this->selectedFacesContour = selected_faces_contour;
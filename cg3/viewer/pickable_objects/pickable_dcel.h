@@ -11,12 +11,17 @@
 
 #include "../drawable_objects/drawable_dcel.h"
 #include <cg3/viewer/interfaces/pickable_object.h>
+#include <cg3/viewer/internal/mesh_picker.h>
 
 namespace cg3 {
 
 /**
  * @ingroup cg3viewer
  * @brief The PickableDcel class
+ *
+ * Faces, vertices and half edges can be picked on the CPU with a bounding volume
+ * hierarchy built on the drawn triangles at the first pick, and built again only
+ * after DrawableDcel::update() changed coordinates or topology.
  */
 class PickableDcel : public DrawableDcel, public PickableObject
 {
@@ -25,16 +30,30 @@ public:
     PickableDcel(const Dcel &d);
     void drawWithNames() const;
     void draw() const;
+
+    bool isRayPickable() const;
+    bool pick(const Point3d& origin, const Vec3d& dir, PickHit& hit) const;
+    std::vector<unsigned int> pickFaces(
+            const PickingView& view,
+            const std::vector<Point2d>& region,
+            bool completely = true) const;
+    std::vector<unsigned int> pickVertices(
+            const PickingView& view,
+            const std::vector<Point2d>& region) const;
+
     void setSelectedFacesContour(std::vector<Dcel::HalfEdge*> selectedFacesContour);
     void setSelectionColor(Color color);
     void setSelectionWidth(int value);
 
 protected:
     void drawFace(const Face* f) const;
+    const internal::MeshPicker& meshPicker() const;
 
     std::vector<Dcel::HalfEdge*> selectedFacesContour;
     Color selectionColor;
     int selectionWidth;
+
+    mutable internal::MeshPicker picker;
 };
 
 } //namespace cg3
@@ -8,6 +8,9 @@
 
 #include "pickable_eigenmesh.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace cg3 {
 
 CG3_INLINE PickableEigenMesh::PickableEigenMesh()
@@ -61,4 +64,94 @@ CG3_INLINE void PickableEigenMesh::drawWithNames() const
 
 }
 
+CG3_INLINE bool PickableEigenMesh::isRayPickable() const
+{
+    return true;
+}
+
+/**
+ * @brief Casts a ray and returns the nearest face hit, with the vertex and the
+ * edge (3*face + i, from the i-th vertex of the face) nearest to the hit point.
+ */
+CG3_INLINE bool PickableEigenMesh::pick(const Point3d& origin, const Vec3d& dir, PickHit& hit) const
+{
+    TriangleBVH::RayHit rh;
+    if (!meshPicker().ray(origin, dir, rh))
+        return false;
+
+    hit.face = rh.triangle;
+    hit.distance = rh.t;
+    hit.point = origin + dir * rh.t;
+    hit.barycentric = Point3d(1 - rh.u - rh.v, rh.u, rh.v);
+
+    double vDist = std::numeric_limits<double>::max();
+    double eDist = std::numeric_limits<double>::max();
+    for (unsigned int i = 0; i < 3; ++i) {
+        unsigned int v1 = F(rh.triangle, i), v2 = F(rh.triangle, (i+1)%3);
+        hit.triangleVertices[i] = v1;
+        Point3d a(V(v1,0), V(v1,1), V(v1,2));
+        Point3d b(V(v2,0), V(v2,1), V(v2,2));
+
+        double d = a.dist(hit.point);
+        if (d < vDist) {
+            vDist = d;
+            hit.vertex = v1;
+        }
+
+        Vec3d ab = b - a;
+        double l = ab.dot(ab);
+        double t = l > 0 ? std::min(1.0, std::max(0.0, (hit.point - a).dot(ab) / l)) : 0;
+        d = (a + ab * t).dist(hit.point);
+        if (d < eDist) {
+            eDist = d;
+            hit.edge = 3 * rh.triangle + i;
+            hit.edgeVertices[0] = v1;
+            hit.edgeVertices[1] = v2;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Indices of the faces projected in a region of the window (occluded
+ * ones included)
+ */
+CG3_INLINE std::vector<unsigned int> PickableEigenMesh::pickFaces(
+        const PickingView& view,
+        const std::vector<Point2d>& region,
+        bool completely) const
+{
+    std::vector<unsigned int> picked;
+    meshPicker().triangles(view, region, completely, picked);
+    return picked;
+}
+
+/**
+ * @brief Indices of the vertices projected in a region of the window
+ * (occluded ones included)
+ */
+CG3_INLINE std::vector<unsigned int> PickableEigenMesh::pickVertices(
+        const PickingView& view,
+        const std::vector<Point2d>& region) const
+{
+    std::vector<unsigned int> picked;
+    meshPicker().vertices(view, region, picked);
+    return picked;
+}
+
+/**
+ * @brief Returns the picker of the faces, synchronized with the last update
+ * of the DrawableEigenMesh
+ */
+CG3_INLINE const internal::MeshPicker& PickableEigenMesh::meshPicker() const
+{
+    picker.setArrays(
+                (unsigned int)V.rows(),
+                (unsigned int)F.rows(),
+                V.data(),
+                F.data(),
+                geometryVersion);
+    return picker;
+}
+
 } //namespace cg3
@@ -11,12 +11,17 @@
 
 #include "../drawable_objects/drawable_eigenmesh.h"
 #include <cg3/viewer/interfaces/pickable_object.h>
+#include <cg3/viewer/internal/mesh_picker.h>
 
 namespace cg3 {
 
 /**
  * @ingroup cg3viewer
  * @brief The PickableEigenmesh class
+ *
+ * Faces, vertices and edges can be picked on the CPU with a bounding volume
+ * hierarchy built at the first pick, and built again only after
+ * DrawableEigenMesh::update().
  */
 class PickableEigenMesh : public DrawableEigenMesh, public PickableObject
 {
@@ -24,6 +29,21 @@ public:
     PickableEigenMesh();
     PickableEigenMesh(const EigenMesh &e);
     void drawWithNames() const;
+
+    bool isRayPickable() const;
+    bool pick(const Point3d& origin, const Vec3d& dir, PickHit& hit) const;
+    std::vector<unsigned int> pickFaces(
+            const PickingView& view,
+            const std::vector<Point2d>& region,
+            bool completely = true) const;
+    std::vector<unsigned int> pickVertices(
+            const PickingView& view,
+            const std::vector<Point2d>& region) const;
+
+protected:
+    const internal::MeshPicker& meshPicker() const;
+
+    mutable internal::MeshPicker picker;
 };
 
 } //namespace cg3
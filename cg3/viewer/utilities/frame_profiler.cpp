@@ -0,0 +1,464 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include "frame_profiler.h"
+
+#include "../opengl_objects/opengl_query.h"
+
+#include <cg3/cg3lib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace cg3 {
+namespace viewer {
+
+namespace internal {
+
+CG3_INLINE std::string csvString(const std::string& s)
+{
+    if (s.find_first_of(",\"\n") == std::string::npos)
+        return s;
+    std::string r = "\"";
+    for (char c : s){
+        if (c == '"')
+            r += '"';
+        r += c;
+    }
+    return r + "\"";
+}
+
+CG3_INLINE std::string jsonString(const std::string& s)
+{
+    std::string r = "\"";
+    for (char c : s){
+        if (c == '"' || c == '\\'){
+            r += '\\';
+            r += c;
+        }
+        else if ((unsigned char)c < 0x20){
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", (unsigned int)c);
+            r += code;
+        }
+        else
+            r += c;
+    }
+    return r + "\"";
+}
+
+} //namespace cg3::viewer::internal
+
+/**
+ * @brief Starts measuring the cost of the scope, that will be recorded as an
+ * event with the given name when the Scope object is destroyed.
+ */
+CG3_INLINE FrameProfiler::Scope::Scope(FrameProfiler& profiler, const std::string& name) :
+    profiler(profiler),
+    name(name),
+    start(profiler.time())
+{
+}
+
+CG3_INLINE FrameProfiler::Scope::~Scope()
+{
+    profiler.addEvent(name, start, profiler.time() - start);
+}
+
+/**
+ * @brief Creates a disabled profiler that keeps the last maxFrames frames.
+ */
+CG3_INLINE FrameProfiler::FrameProfiler(unsigned int maxFrames) :
+    enabled(false),
+    _maxFrames(maxFrames),
+    epoch(std::chrono::steady_clock::now()),
+    inFrame(false),
+    drawDepth(0),
+    drawSample(0),
+    frameNumber(0),
+    useQueries(-1)
+{
+}
+
+CG3_INLINE FrameProfiler::~FrameProfiler()
+{
+    for (unsigned int q : freeQueries)
+        opengl::deleteTimerQuery(q);
+    for (const PendingQuery& p : pendingQueries)
+        opengl::deleteTimerQuery(p.query);
+}
+
+CG3_INLINE void FrameProfiler::setEnabled(bool b)
+{
+    enabled = b;
+}
+
+CG3_INLINE bool FrameProfiler::isEnabled() const
+{
+    return enabled;
+}
+
+CG3_INLINE void FrameProfiler::setMaxFrames(unsigned int maxFrames)
+{
+    _maxFrames = maxFrames;
+    while (_frames.size() > _maxFrames)
+        _frames.pop_front();
+}
+
+CG3_INLINE unsigned int FrameProfiler::maxFrames() const
+{
+    return _maxFrames;
+}
+
+/**
+ * @brief Sets the name used for the samples of the draws of the given object.
+ */
+CG3_INLINE void FrameProfiler::setObjectName(const DrawableObject* object, const std::string& name)
+{
+    names[object] = name;
+}
+
+CG3_INLINE void FrameProfiler::removeObjectName(const DrawableObject* object)
+{
+    names.erase(object);
+}
+
+/**
+ * @brief Starts a new frame, and reads the timer queries of the previous
+ * frames that have been completed by the GPU.
+ */
+CG3_INLINE void FrameProfiler::beginFrame()
+{
+    if (!enabled)
+        return;
+    if (useQueries < 0)
+        useQueries = opengl::timerQueriesSupported();
+    if (inFrame)
+        endFrame();
+    readQueries();
+
+    Frame f;
+    f.number = frameNumber++;
+    f.start = time();
+    f.cpuTime = 0;
+    f.gpuTime = -1;
+    f.samples.swap(pendingEvents);
+    _frames.push_back(f);
+    inFrame = true;
+}
+
+CG3_INLINE void FrameProfiler::endFrame()
+{
+    if (!inFrame)
+        return;
+    while (drawDepth > 0)
+        endDraw();
+    Frame& f = _frames.back();
+    f.cpuTime = time() - f.start;
+    inFrame = false;
+
+    if (_frames.size() > _maxFrames)
+        _frames.pop_front();
+}
+
+/**
+ * @brief Starts measuring the draw of the given object. Draws nested in
+ * another draw (e.g. the objects of a DrawableContainer) are counted in the
+ * outer one.
+ */
+CG3_INLINE void FrameProfiler::beginDraw(const DrawableObject* object)
+{
+    if (!inFrame)
+        return;
+    if (drawDepth++ > 0)
+        return;
+
+    Frame& f = _frames.back();
+    Sample s;
+    s.name = objectName(object);
+    s.start = time();
+    s.cpuTime = 0;
+    s.gpuTime = -1;
+    s.event = false;
+    f.samples.push_back(s);
+    drawSample = (unsigned int)f.samples.size() - 1;
+
+    if (useQueries > 0){
+        unsigned int q;
+        if (freeQueries.empty())
+            q = opengl::createTimerQuery();
+        else {
+            q = freeQueries.back();
+            freeQueries.pop_back();
+        }
+        opengl::beginTimerQuery(q);
+        pendingQueries.push_back({f.number, drawSample, q});
+    }
+}
+
+/**
+ * @brief Ends the measure of the draw started with beginDraw, storing the
+ * statistics of the drawn object. The statistics are asked to the object only
+ * when the draw is recorded, hence nothing is computed if the profiler is
+ * disabled.
+ */
+CG3_INLINE void FrameProfiler::endDraw(const DrawableObject* object)
+{
+    if (!inFrame || drawDepth == 0)
+        return;
+    if (--drawDepth > 0)
+        return;
+
+    if (useQueries > 0)
+        opengl::endTimerQuery();
+    Frame& f = _frames.back();
+    if (drawSample >= f.samples.size())
+        return; //the profiler has been cleared during the draw
+    Sample& s = f.samples[drawSample];
+    s.cpuTime = time() - s.start;
+    if (object != nullptr){
+        s.statistics = object->drawStatistics();
+        f.statistics += s.statistics;
+    }
+}
+
+/**
+ * @brief Records an event with the given name, start (see time()) and
+ * duration in milliseconds. Events recorded outside a frame are attached to
+ * the next frame.
+ */
+CG3_INLINE void FrameProfiler::addEvent(const std::string& name, double start, double duration)
+{
+    if (!enabled)
+        return;
+    Sample s;
+    s.name = name;
+    s.start = start;
+    s.cpuTime = duration;
+    s.gpuTime = -1;
+    s.event = true;
+    if (inFrame)
+        _frames.back().samples.push_back(s);
+    else
+        pendingEvents.push_back(s);
+}
+
+/**
+ * @brief Returns the milliseconds elapsed from the creation of the profiler.
+ */
+CG3_INLINE double FrameProfiler::time() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+CG3_INLINE const std::deque<FrameProfiler::Frame>& FrameProfiler::frames() const
+{
+    return _frames;
+}
+
+/**
+ * @brief Returns a text with the averages of the last completed frames: frame
+ * time, frame rate, statistics and the times of every object and event.
+ */
+CG3_INLINE std::string FrameProfiler::summary(unsigned int lastFrames) const
+{
+    unsigned int end = (unsigned int)_frames.size() - (inFrame ? 1 : 0);
+    if (_frames.size() == 0 || end == 0)
+        return "No frames profiled";
+    unsigned int begin = end > lastFrames ? end - lastFrames : 0;
+    unsigned int n = end - begin;
+
+    struct Total {
+        double cpu = 0, gpu = 0;
+        unsigned int gpuSamples = 0;
+        unsigned long long int triangles = 0;
+        bool event = false;
+    };
+    std::map<std::string, Total> totals;
+    std::vector<std::string> order;
+    double cpu = 0, gpu = 0;
+    unsigned int gpuFrames = 0;
+    DrawStatistics stats;
+    for (unsigned int i = begin; i < end; ++i){
+        const Frame& f = _frames[i];
+        cpu += f.cpuTime;
+        if (f.gpuTime >= 0){
+            gpu += f.gpuTime;
+            gpuFrames++;
+        }
+        stats += f.statistics;
+        for (const Sample& s : f.samples){
+            if (totals.find(s.name) == totals.end())
+                order.push_back(s.name);
+            Total& t = totals[s.name];
+            t.cpu += s.cpuTime;
+            if (s.gpuTime >= 0){
+                t.gpu += s.gpuTime;
+                t.gpuSamples++;
+            }
+            t.triangles += s.statistics.triangles;
+            t.event = s.event;
+        }
+    }
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Frame: " << cpu / n << " ms CPU";
+    if (gpuFrames > 0)
+        ss << ", " << gpu / gpuFrames << " ms GPU";
+    if (n > 1){
+        double elapsed = _frames[end-1].start - _frames[begin].start;
+        if (elapsed > 0)
+            ss << ", " << std::setprecision(1) << (n - 1) * 1000.0 / elapsed << " fps" << std::setprecision(2);
+    }
+    ss << "\n";
+    ss << "Triangles: " << stats.triangles / n << ", vertices: " << stats.vertices / n
+       << ", uploaded: " << stats.uploadedBytes / 1024.0 / n << " KB\n";
+
+    std::stable_sort(order.begin(), order.end(), [&](const std::string& a, const std::string& b){
+        return totals[a].cpu > totals[b].cpu;
+    });
+    for (const std::string& name : order){
+        const Total& t = totals[name];
+        ss << name << ": " << t.cpu / n << " ms";
+        if (t.event)
+            ss << " (event)";
+        else {
+            if (t.gpuSamples > 0)
+                ss << " CPU, " << t.gpu / t.gpuSamples << " ms GPU";
+            ss << ", " << t.triangles / n << " triangles";
+        }
+        ss << "\n";
+    }
+    return ss.str();
+}
+
+/**
+ * @brief Saves a CSV file with a row for every frame, draw and event.
+ * Times are in milliseconds; a GPU time of -1 means not measured.
+ */
+CG3_INLINE bool FrameProfiler::saveCsv(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+    file << std::fixed << std::setprecision(4);
+    file << "frame,type,name,start_ms,cpu_ms,gpu_ms,triangles,vertices,uploaded_bytes\n";
+    for (const Frame& f : _frames){
+        file << f.number << ",frame,," << f.start << "," << f.cpuTime << "," << f.gpuTime << ","
+             << f.statistics.triangles << "," << f.statistics.vertices << "," << f.statistics.uploadedBytes << "\n";
+        for (const Sample& s : f.samples){
+            file << f.number << "," << (s.event ? "event" : "draw") << "," << internal::csvString(s.name) << ","
+                 << s.start << "," << s.cpuTime << "," << s.gpuTime << ","
+                 << s.statistics.triangles << "," << s.statistics.vertices << "," << s.statistics.uploadedBytes << "\n";
+        }
+    }
+    return file.good();
+}
+
+/**
+ * @brief Saves the frames in the Chrome trace event format, that can be
+ * opened with chrome://tracing or with Perfetto.
+ *
+ * Frames and CPU times of draws and events are in the thread 1; GPU times of
+ * the draws are in the thread 2, placed one after the other starting from the
+ * CPU start of each draw (the GPU clock is not synchronized with the CPU one).
+ */
+CG3_INLINE bool FrameProfiler::saveChromeTrace(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    auto writeEvent = [&](const std::string& name, const char* category, int tid, double start, double duration, const DrawStatistics* stats){
+        file << ",\n{\"name\":" << internal::jsonString(name) << ",\"cat\":\"" << category << "\",\"ph\":\"X\""
+             << ",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << start * 1000 << ",\"dur\":" << duration * 1000;
+        if (stats != nullptr){
+            file << ",\"args\":{\"triangles\":" << stats->triangles << ",\"vertices\":" << stats->vertices
+                 << ",\"uploadedBytes\":" << stats->uploadedBytes << "}";
+        }
+        file << "}";
+    };
+    for (const Frame& f : _frames){
+        writeEvent("Frame " + std::to_string(f.number), "frame", 1, f.start, f.cpuTime, &f.statistics);
+        double gpuCursor = f.start;
+        for (const Sample& s : f.samples){
+            writeEvent(s.name, s.event ? "event" : "draw", 1, s.start, s.cpuTime, s.event ? nullptr : &s.statistics);
+            if (s.gpuTime >= 0){
+                gpuCursor = std::max(gpuCursor, s.start);
+                writeEvent(s.name, "gpu", 2, gpuCursor, s.gpuTime, nullptr);
+                gpuCursor += s.gpuTime;
+            }
+        }
+    }
+    file << "\n]}\n";
+    return file.good();
+}
+
+/**
+ * @brief Removes all the recorded frames and events.
+ */
+CG3_INLINE void FrameProfiler::clear()
+{
+    //results of the queries in flight will be discarded
+    for (PendingQuery& p : pendingQueries)
+        p.frame = (unsigned long long int)-1;
+    drawSample = (unsigned int)-1;
+    if (inFrame){
+        Frame f = _frames.back();
+        f.samples.clear();
+        _frames.clear();
+        _frames.push_back(f);
+    }
+    else
+        _frames.clear();
+    pendingEvents.clear();
+}
+
+CG3_INLINE std::string FrameProfiler::objectName(const DrawableObject* object) const
+{
+    std::map<const DrawableObject*, std::string>::const_iterator it = names.find(object);
+    if (it != names.end())
+        return it->second;
+    std::ostringstream ss;
+    ss << "Object " << object;
+    return ss.str();
+}
+
+/**
+ * @brief Reads the results of the timer queries completed by the GPU and
+ * stores them in the frames; the queries are then reused.
+ */
+CG3_INLINE void FrameProfiler::readQueries()
+{
+    std::vector<PendingQuery> notReady;
+    for (const PendingQuery& p : pendingQueries){
+        if (!opengl::isTimerQueryAvailable(p.query)){
+            notReady.push_back(p);
+            continue;
+        }
+        double ms = opengl::timerQueryMilliseconds(p.query);
+        freeQueries.push_back(p.query);
+        if (_frames.size() > 0 && p.frame >= _frames.front().number && p.frame <= _frames.back().number){
+            Frame& f = _frames[p.frame - _frames.front().number];
+            if (p.sample < f.samples.size()){
+                f.samples[p.sample].gpuTime = ms;
+                f.gpuTime = (f.gpuTime < 0 ? 0 : f.gpuTime) + ms;
+            }
+        }
+    }
+    pendingQueries.swap(notReady);
+}
+
+} //namespace cg3::viewer
+} //namespace cg3
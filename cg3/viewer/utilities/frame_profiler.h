@@ -0,0 +1,140 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#ifndef CG3_FRAME_PROFILER_H
+#define CG3_FRAME_PROFILER_H
+
+#include "../interfaces/drawable_object.h"
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cg3 {
+namespace viewer {
+
+/**
+ * @brief The FrameProfiler class collects, for every frame drawn by a
+ * GLCanvas, the CPU time spent in the draw of every DrawableObject, the GPU
+ * time measured with timer queries (when the OpenGL context supports them),
+ * and the statistics returned by DrawableObject::drawStatistics.
+ *
+ * Other costs (e.g. the update of a drawable mesh after an algorithm) can be
+ * recorded as events, that are attached to the frame being drawn or to the
+ * next one:
+ *
+ * \code{*.cpp}
+ * {
+ *     cg3::viewer::FrameProfiler::Scope s(mw.canvas.profiler(), "Dcel update");
+ *     dcel.update();
+ * }
+ * \endcode
+ *
+ * The results of the timer queries are read in the following frames, when the
+ * GPU made them available, so the profiler never stalls the pipeline. The last
+ * frames are kept in memory and can be exported as a CSV file or as a trace
+ * in the Chrome trace event format (chrome://tracing, Perfetto).
+ *
+ * beginFrame, endFrame, beginDraw and endDraw must be called with the OpenGL
+ * context current.
+ */
+class FrameProfiler
+{
+public:
+    struct Sample {
+        std::string name;
+        double start;    //milliseconds from the creation of the profiler
+        double cpuTime;  //milliseconds
+        double gpuTime;  //milliseconds, -1 if not measured (yet)
+        DrawStatistics statistics;
+        bool event;      //true for the events, false for the draws
+    };
+
+    struct Frame {
+        unsigned long long int number;
+        double start;
+        double cpuTime;
+        double gpuTime; //sum of the gpu times of the draws, -1 if not measured
+        DrawStatistics statistics;
+        std::vector<Sample> samples;
+    };
+
+    class Scope
+    {
+    public:
+        Scope(FrameProfiler& profiler, const std::string& name);
+        ~Scope();
+    private:
+        FrameProfiler& profiler;
+        std::string name;
+        double start;
+    };
+
+    FrameProfiler(unsigned int maxFrames = 600);
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+    ~FrameProfiler();
+
+    void setEnabled(bool b);
+    bool isEnabled() const;
+    void setMaxFrames(unsigned int maxFrames);
+    unsigned int maxFrames() const;
+    void setObjectName(const DrawableObject* object, const std::string& name);
+    void removeObjectName(const DrawableObject* object);
+
+    void beginFrame();
+    void endFrame();
+    void beginDraw(const DrawableObject* object);
+    void endDraw(const DrawableObject* object = nullptr);
+    void addEvent(const std::string& name, double start, double duration);
+    double time() const;
+
+    const std::deque<Frame>& frames() const;
+    std::string summary(unsigned int lastFrames = 60) const;
+    bool saveCsv(const std::string& filename) const;
+    bool saveChromeTrace(const std::string& filename) const;
+    void clear();
+
+private:
+    struct PendingQuery {
+        unsigned long long int frame;
+        unsigned int sample;
+        unsigned int query;
+    };
+
+    std::string objectName(const DrawableObject* object) const;
+    void readQueries();
+
+    bool enabled;
+    unsigned int _maxFrames;
+    std::chrono::steady_clock::time_point epoch;
+    std::map<const DrawableObject*, std::string> names;
+
+    std::deque<Frame> _frames;
+    bool inFrame;
+    unsigned int drawDepth;
+    unsigned int drawSample; //index of the sample of the current draw
+    unsigned long long int frameNumber;
+    std::vector<Sample> pendingEvents; //recorded outside a frame
+
+    int useQueries; //-1: not checked yet
+    std::vector<unsigned int> freeQueries;
+    std::vector<PendingQuery> pendingQueries;
+};
+
+} //namespace cg3::viewer
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_FRAME_PROFILER_CPP "frame_profiler.cpp"
+#include CG3_FRAME_PROFILER_CPP
+#undef CG3_FRAME_PROFILER_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_FRAME_PROFILER_H
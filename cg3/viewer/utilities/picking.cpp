@@ -0,0 +1,208 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "picking.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cg3 {
+
+/**
+ * @brief Creates a view with identity matrices and an empty viewport
+ */
+CG3_INLINE PickingView::PickingView()
+{
+    mvp.fill(0);
+    for (unsigned int i = 0; i < 4; ++i)
+        mvp[5*i] = 1;
+    invMvp = mvp;
+    viewport = {{0, 0, 0, 0}};
+}
+
+/**
+ * @brief Creates a view from the OpenGL matrices and viewport
+ * (glGetDoublev(GL_MODELVIEW_MATRIX, ...), glGetDoublev(GL_PROJECTION_MATRIX, ...),
+ * glGetIntegerv(GL_VIEWPORT, ...)).
+ */
+CG3_INLINE PickingView::PickingView(
+        const double modelview[16],
+        const double projection[16],
+        const int viewport[4])
+{
+    for (unsigned int r = 0; r < 4; ++r) {
+        for (unsigned int c = 0; c < 4; ++c) {
+            double v = 0;
+            for (unsigned int k = 0; k < 4; ++k)
+                v += projection[r + 4*k] * modelview[k + 4*c];
+            mvp[r + 4*c] = v;
+        }
+    }
+    for (unsigned int i = 0; i < 4; ++i)
+        this->viewport[i] = viewport[i];
+
+    //inverse with Gauss-Jordan elimination, partial pivoting
+    double a[4][8];
+    for (unsigned int r = 0; r < 4; ++r) {
+        for (unsigned int c = 0; c < 4; ++c) {
+            a[r][c] = mvp[r + 4*c];
+            a[r][c+4] = r == c ? 1 : 0;
+        }
+    }
+    for (unsigned int c = 0; c < 4; ++c) {
+        unsigned int pivot = c;
+        for (unsigned int r = c + 1; r < 4; ++r)
+            if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+                pivot = r;
+        for (unsigned int k = 0; k < 8; ++k)
+            std::swap(a[c][k], a[pivot][k]);
+        double p = a[c][c];
+        if (p == 0)
+            continue;
+        for (unsigned int k = 0; k < 8; ++k)
+            a[c][k] /= p;
+        for (unsigned int r = 0; r < 4; ++r) {
+            if (r != c) {
+                double f = a[r][c];
+                for (unsigned int k = 0; k < 8; ++k)
+                    a[r][k] -= f * a[c][k];
+            }
+        }
+    }
+    for (unsigned int r = 0; r < 4; ++r)
+        for (unsigned int c = 0; c < 4; ++c)
+            invMvp[r + 4*c] = a[r][c+4];
+}
+
+/**
+ * @brief Ray passing through a point of the window, in object coordinates.
+ * The origin lies on the near plane, and origin + dir lies on the far plane.
+ */
+CG3_INLINE void PickingView::ray(double x, double y, Point3d& origin, Vec3d& dir) const
+{
+    double ndcX = 2 * (x - viewport[0]) / viewport[2] - 1;
+    double ndcY = 1 - 2 * (y - viewport[1]) / viewport[3];
+    double n[3], f[3];
+    unproject(ndcX, ndcY, -1, n);
+    unproject(ndcX, ndcY, 1, f);
+    origin = Point3d(n[0], n[1], n[2]);
+    dir = Vec3d(f[0] - n[0], f[1] - n[1], f[2] - n[2]);
+}
+
+/**
+ * @brief Projects a point in window coordinates: x and y are pixels,
+ * z is the normalized depth in [-1, 1].
+ */
+CG3_INLINE Point3d PickingView::project(const Point3d& p) const
+{
+    double clip[4];
+    for (unsigned int r = 0; r < 4; ++r)
+        clip[r] = mvp[r] * p.x() + mvp[r+4] * p.y() + mvp[r+8] * p.z() + mvp[r+12];
+    double x = clip[0] / clip[3], y = clip[1] / clip[3], z = clip[2] / clip[3];
+    return Point3d(
+                viewport[0] + (x + 1) / 2 * viewport[2],
+                viewport[1] + (1 - y) / 2 * viewport[3],
+                z);
+}
+
+/**
+ * @brief Frustum, in object coordinates, of the points that are projected in
+ * the rectangle of the window having (x0, y0) and (x1, y1) as opposite corners,
+ * between the near and the far planes.
+ */
+CG3_INLINE std::vector<TriangleBVH::HalfSpace> PickingView::frustum(
+        double x0,
+        double y0,
+        double x1,
+        double y1) const
+{
+    double left   = 2 * (std::min(x0, x1) - viewport[0]) / viewport[2] - 1;
+    double right  = 2 * (std::max(x0, x1) - viewport[0]) / viewport[2] - 1;
+    double top    = 1 - 2 * (std::min(y0, y1) - viewport[1]) / viewport[3];
+    double bottom = 1 - 2 * (std::max(y0, y1) - viewport[1]) / viewport[3];
+
+    //a point p is inside if, for its clip coordinates c = mvp * p,
+    //left <= c.x/c.w <= right, bottom <= c.y/c.w <= top and -1 <= c.z/c.w <= 1
+    auto plane = [&](double a, unsigned int row, double b) {
+        TriangleBVH::HalfSpace h;
+        for (unsigned int c = 0; c < 4; ++c)
+            h[c] = a * mvp[row + 4*c] + b * mvp[3 + 4*c];
+        return h;
+    };
+    return std::vector<TriangleBVH::HalfSpace> {
+        plane(1, 0, -left),
+        plane(-1, 0, right),
+        plane(1, 1, -bottom),
+        plane(-1, 1, top),
+        plane(1, 2, 1),
+        plane(-1, 2, 1)};
+}
+
+/**
+ * @brief Frustum of the bounding rectangle of a region of the window
+ */
+CG3_INLINE std::vector<TriangleBVH::HalfSpace> PickingView::frustum(
+        const std::vector<Point2d>& region) const
+{
+    if (region.empty())
+        return frustum(0, 0, 0, 0);
+    double x0 = region[0].x(), x1 = x0, y0 = region[0].y(), y1 = y0;
+    for (const Point2d& p : region) {
+        x0 = std::min(x0, p.x());
+        x1 = std::max(x1, p.x());
+        y0 = std::min(y0, p.y());
+        y1 = std::max(y1, p.y());
+    }
+    return frustum(x0, y0, x1, y1);
+}
+
+/**
+ * @brief Returns true if the region is a rectangle with sides parallel to the
+ * axes: two opposite corners, or four corners in order.
+ */
+CG3_INLINE bool PickingView::isRectangle(const std::vector<Point2d>& region)
+{
+    if (region.size() == 2)
+        return true;
+    if (region.size() != 4)
+        return false;
+    for (unsigned int i = 0; i < 4; ++i) {
+        const Point2d& a = region[i];
+        const Point2d& b = region[(i+1)%4];
+        if (a.x() != b.x() && a.y() != b.y())
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Even-odd test of a point with respect to a polygon (e.g. a lasso)
+ */
+CG3_INLINE bool PickingView::polygonContains(const std::vector<Point2d>& polygon, const Point2d& p)
+{
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const Point2d& a = polygon[i];
+        const Point2d& b = polygon[j];
+        if ((a.y() > p.y()) != (b.y() > p.y()) &&
+                p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x())
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+CG3_INLINE void PickingView::unproject(double ndcX, double ndcY, double ndcZ, double out[3]) const
+{
+    double p[4];
+    for (unsigned int r = 0; r < 4; ++r)
+        p[r] = invMvp[r] * ndcX + invMvp[r+4] * ndcY + invMvp[r+8] * ndcZ + invMvp[r+12];
+    for (unsigned int i = 0; i < 3; ++i)
+        out[i] = p[i] / p[3];
+}
+
+} //namespace cg3
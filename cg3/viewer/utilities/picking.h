@@ -0,0 +1,77 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_VIEWER_PICKING_H
+#define CG3_VIEWER_PICKING_H
+
+#include <array>
+#include <vector>
+
+#include <cg3/geometry/point2.h>
+#include <cg3/geometry/point3.h>
+#include <cg3/data_structures/trees/triangle_bvh.h>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3viewer
+ * @brief Element of a PickableObject hit by a ray.
+ *
+ * Ids are the ones of the picked object: for a Dcel, ids of face, vertex and
+ * half edge; for an EigenMesh, indices of face and vertex, and 3*face+i for
+ * the edge going from the i-th to the (i+1)-th vertex of the face.
+ */
+struct PickHit {
+    unsigned int face;
+    unsigned int vertex;             //vertex of the face nearest to the hit point
+    unsigned int edge;               //edge of the face nearest to the hit point
+    unsigned int edgeVertices[2];
+    unsigned int triangleVertices[3]; //vertices of the hit triangle
+    Point3d barycentric;             //coordinates of the hit point w.r.t. triangleVertices
+    Point3d point;
+    double distance;                 //distance from the origin of the ray, in units of its direction
+};
+
+/**
+ * @ingroup cg3viewer
+ * @brief Camera used to convert window coordinates in rays and regions.
+ *
+ * It is defined by OpenGL modelview and projection matrices (column-major)
+ * and by the viewport. Window coordinates have the origin on the top-left
+ * corner, as the ones of the mouse events. It does not need an OpenGL
+ * context.
+ */
+class PickingView
+{
+public:
+    PickingView();
+    PickingView(const double modelview[16], const double projection[16], const int viewport[4]);
+
+    void ray(double x, double y, Point3d& origin, Vec3d& dir) const;
+    Point3d project(const Point3d& p) const;
+
+    std::vector<TriangleBVH::HalfSpace> frustum(double x0, double y0, double x1, double y1) const;
+    std::vector<TriangleBVH::HalfSpace> frustum(const std::vector<Point2d>& region) const;
+    static bool isRectangle(const std::vector<Point2d>& region);
+    static bool polygonContains(const std::vector<Point2d>& polygon, const Point2d& p);
+
+protected:
+    void unproject(double ndcX, double ndcY, double ndcZ, double out[3]) const;
+
+    std::array<double, 16> mvp;    //projection * modelview, column-major
+    std::array<double, 16> invMvp;
+    std::array<int, 4> viewport;
+};
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_VIEWER_PICKING_CPP "picking.cpp"
+#include CG3_VIEWER_PICKING_CPP
+#undef CG3_VIEWER_PICKING_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_VIEWER_PICKING_H
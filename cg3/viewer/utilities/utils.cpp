@@ -8,6 +8,7 @@
 
 #include <cg3/viewer/interfaces/drawable_object.h>
 #include <cg3/viewer/interfaces/manipulable_object.h>
+#include <cg3/viewer/interfaces/drawable_container.h>
 
 namespace cg3 {
 
@@ -92,4 +93,27 @@ CG3_INLINE BoundingBox3 fullBoundingBoxDrawableObjects(
     return bb;
 }
 
+/**
+ * @brief Returns true if the sphere given by sceneCenter() and sceneRadius()
+ * of the object contains everything the object draws, and therefore can be
+ * used to cull it.
+ *
+ * Objects with sceneRadius() <= 0 are unbounded. The bounding box of a
+ * DrawableContainer skips its unbounded objects, so a container is bounded
+ * only if all its visible objects are bounded.
+ */
+CG3_INLINE bool conservativeSceneBounds(const DrawableObject* obj)
+{
+    if (obj->sceneRadius() <= 0)
+        return false;
+    const cg3::DrawableContainer* cont = dynamic_cast<const cg3::DrawableContainer*>(obj);
+    if (cont) {
+        for (unsigned int i = 0; i < cont->size(); i++) {
+            if ((*cont)[i]->isVisible() && !conservativeSceneBounds((*cont)[i]))
+                return false;
+        }
+    }
+    return true;
+}
+
 } //namespace cg3
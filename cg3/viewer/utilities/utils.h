@@ -18,6 +18,8 @@ BoundingBox3 fullBoundingBoxDrawableObjects(
         const std::vector<const DrawableObject*>& drawlist,
         bool onlyVisible = true);
 
+bool conservativeSceneBounds(const DrawableObject* obj);
+
 } //namespace cg3
 
 #ifndef CG3_STATIC
@@ -25,14 +25,16 @@ isEmpty(VOROPLUSPLUS_PATH):!isEmpty(VOROPLUSPLUS_ENV_VARIABLE):exists($$VOROPLUS
     LIBS += -L$$VOROPLUSPLUS_PATH/ -lvoro++
 
     HEADERS += \
+        $$PWD/voro++/lloyd_relaxation3.h \
         $$PWD/voro++/voronoi_cell3.h \
         $$PWD/voro++/voronoi_diagram3.h \
-        $$PWD/voro++/internal/voro_parser.h
+        $$PWD/voro++/internal/voro_cells.h
 
     CG3_STATIC {
     SOURCES += \
+        $$PWD/voro++/lloyd_relaxation3.cpp \
         $$PWD/voro++/voronoi_cell3.cpp \
         $$PWD/voro++/voronoi_diagram3.cpp \
-        $$PWD/voro++/internal/voro_parser.cpp
+        $$PWD/voro++/internal/voro_cells.cpp
     }
 }
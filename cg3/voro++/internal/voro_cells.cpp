@@ -0,0 +1,230 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "voro_cells.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cg3 {
+namespace voro {
+namespace internal {
+
+/**
+ * @brief Copies the geometry of a cell computed by voro++
+ * @param c: the cell
+ * @param pos: position of the particle of the cell
+ * @param cell: output geometry
+ */
+CG3_INLINE void copyCellGeometry(
+		::voro::voronoicell_neighbor& c,
+		const double* pos,
+		std::vector<double>& v,
+		std::vector<int>& fv,
+		CellGeometry& cell)
+{
+	c.vertices(pos[0], pos[1], pos[2], v);
+	cell.vertices.resize(v.size() / 3);
+	for (uint vi = 0; vi < cell.vertices.size(); ++vi)
+		cell.vertices[vi] = cg3::Point3d(v[3*vi], v[3*vi+1], v[3*vi+2]);
+
+	//face_vertices: for every face, the number of vertices followed by their indices
+	c.face_vertices(fv);
+	cell.faces.clear();
+	for (uint fi = 0; fi < fv.size(); fi += fv[fi] + 1) {
+		std::vector<uint> face(fv.begin() + fi + 1, fv.begin() + fi + 1 + fv[fi]);
+		std::reverse(face.begin(), face.end());
+		cell.faces.push_back(std::move(face));
+	}
+
+	c.neighbors(cell.adjacences);
+}
+
+/**
+ * @brief Number of blocks for every axis of a container of nSites sites:
+ * voro++ computes cells efficiently with about 5 sites per block
+ */
+CG3_INLINE int blocksPerAxis(uint nSites)
+{
+	return std::max(1, (int)std::round(std::cbrt(nSites / 5.0)));
+}
+
+/**
+ * @brief Returns true if voro++ accepts p in the container: the box of a non
+ * periodic container is half-open, since a particle lying on one of its max
+ * faces would fall outside the last block and is discarded by put()
+ */
+CG3_INLINE bool isInContainer(const ::voro::container& container, const Point3d& p)
+{
+	//same computation of the block done by voro++
+	const double f[3] = {
+		(p.x() - container.ax) * container.xsp,
+		(p.y() - container.ay) * container.ysp,
+		(p.z() - container.az) * container.zsp};
+	const int n[3] = {container.nx, container.ny, container.nz};
+	for (uint a = 0; a < 3; ++a)
+		if (!(f[a] >= 0 && f[a] < n[a]))
+			return false;
+	return true;
+}
+
+/**
+ * @brief Moves a point lying on a max face of the container (or rounded to it)
+ * inside the container by the smallest amount. Other points are not changed.
+ */
+CG3_INLINE Point3d moveInContainer(const ::voro::container& container, const Point3d& p)
+{
+	const double min[3] = {container.ax, container.ay, container.az};
+	const double max[3] = {container.bx, container.by, container.bz};
+	const double sp[3] = {container.xsp, container.ysp, container.zsp};
+	const int n[3] = {container.nx, container.ny, container.nz};
+	double q[3] = {p.x(), p.y(), p.z()};
+	for (uint a = 0; a < 3; ++a) {
+		while (q[a] > min[a] && q[a] <= max[a] && (q[a] - min[a]) * sp[a] >= n[a])
+			q[a] = std::nextafter(q[a], min[a]);
+	}
+	return Point3d(q[0], q[1], q[2]);
+}
+
+/**
+ * @brief cg3::voro::internal::locateParticle
+ * Finds the block and the index in the block of a particle that has been just
+ * put in the container.
+ * @return false if the particle is not in the container
+ */
+CG3_INLINE bool locateParticle(
+		const ::voro::container& container,
+		int id,
+		const Point3d& p,
+		CellLocation& location)
+{
+	//the particle is the last one of the block containing its position
+	int i = std::min(container.nx - 1, std::max(0, (int)((p.x() - container.ax) * container.xsp)));
+	int j = std::min(container.ny - 1, std::max(0, (int)((p.y() - container.ay) * container.ysp)));
+	int k = std::min(container.nz - 1, std::max(0, (int)((p.z() - container.az) * container.zsp)));
+	int ijk = i + container.nx * j + container.nxy * k;
+	for (int q = container.co[ijk] - 1; q >= 0; --q) {
+		if (container.id[ijk][q] == id) {
+			location.ijk = ijk;
+			location.q = q;
+			return true;
+		}
+	}
+
+	for (ijk = 0; ijk < container.nxyz; ++ijk) {
+		for (int q = 0; q < container.co[ijk]; ++q) {
+			if (container.id[ijk][q] == id) {
+				location.ijk = ijk;
+				location.q = q;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief cg3::voro::internal::computeAllCells
+ * Computes the cells of all the particles of the container, copying their
+ * geometry directly from the voronoicell_neighbor computed by voro++.
+ *
+ * Blocks of the container are processed in parallel: the voro_compute of
+ * the container is not thread safe, hence every thread uses its own.
+ *
+ * @param container
+ * @param cells: geometry of the cells, indexed by particle id. Must be already
+ * sized to contain all the ids of the particles in the container; cells of
+ * the ids that are not in the container are left untouched
+ */
+CG3_INLINE void computeAllCells(
+		::voro::container& container,
+		std::vector<CellGeometry>& cells)
+{
+	const int nx = container.nx, nxy = container.nxy;
+	const long long int nBlocks = container.nxyz;
+
+	#pragma omp parallel
+	{
+		::voro::voro_compute<::voro::container> vc(container, container.nx, container.ny, container.nz);
+		::voro::voronoicell_neighbor c;
+		std::vector<double> v;
+		std::vector<int> fv;
+
+		#pragma omp for schedule(dynamic, 1)
+		for (long long int b = 0; b < nBlocks; ++b) {
+			int ijk = (int)b;
+			int k = ijk / nxy;
+			int j = (ijk - k * nxy) / nx;
+			int i = ijk - k * nxy - j * nx;
+			for (int q = 0; q < container.co[ijk]; ++q) {
+				if (vc.compute_cell(c, ijk, q, i, j, k))
+					copyCellGeometry(c, container.p[ijk] + 3 * q, v, fv, cells[container.id[ijk][q]]);
+			}
+		}
+	}
+}
+
+/**
+ * @brief cg3::voro::internal::computeCells
+ * Computes the cells of the given particles.
+ *
+ * Few cells (e.g. the neighbours of a new site, or a single outdated cell) are
+ * computed serially with the voro_compute owned by the container, which is
+ * built once with the container. Otherwise cells are computed in parallel and
+ * every thread builds its own voro_compute, whose setup is proportional to the
+ * number of blocks of the container: hence the parallel path is taken only
+ * when there are enough cells to amortize it.
+ *
+ * @param container
+ * @param locations: location of every particle in the container, indexed by id
+ * @param ids: ids of the particles whose cells are computed
+ * @param cells: output geometry of the cells, parallel to ids
+ */
+CG3_INLINE void computeCells(
+		::voro::container& container,
+		const std::vector<CellLocation>& locations,
+		const std::vector<uint>& ids,
+		std::vector<CellGeometry>& cells)
+{
+	const int nx = container.nx, nxy = container.nxy;
+	cells.resize(ids.size());
+
+	if (ids.size() <= 16 || ids.size() * 16 < (size_t)container.nxyz) {
+		::voro::voronoicell_neighbor c;
+		std::vector<double> v;
+		std::vector<int> fv;
+		for (uint id = 0; id < ids.size(); ++id) {
+			const CellLocation& l = locations[ids[id]];
+			cells[id] = CellGeometry();
+			if (container.compute_cell(c, l.ijk, l.q))
+				copyCellGeometry(c, container.p[l.ijk] + 3 * l.q, v, fv, cells[id]);
+		}
+		return;
+	}
+
+	#pragma omp parallel
+	{
+		::voro::voro_compute<::voro::container> vc(container, container.nx, container.ny, container.nz);
+		::voro::voronoicell_neighbor c;
+		std::vector<double> v;
+		std::vector<int> fv;
+
+		#pragma omp for schedule(dynamic, 16)
+		for (long long int id = 0; id < (long long int)ids.size(); ++id) {
+			const CellLocation& l = locations[ids[id]];
+			int k = l.ijk / nxy;
+			int j = (l.ijk - k * nxy) / nx;
+			int i = l.ijk - k * nxy - j * nx;
+			cells[id] = CellGeometry();
+			if (vc.compute_cell(c, l.ijk, l.q, i, j, k))
+				copyCellGeometry(c, container.p[l.ijk] + 3 * l.q, v, fv, cells[id]);
+		}
+	}
+}
+
+} //namespace cg3::voro::internal
+} //namespace cg3::voro
+} //namespace cg3
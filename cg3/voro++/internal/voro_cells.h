@@ -0,0 +1,73 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_VORO_CELLS_H
+#define CG3_VORO_CELLS_H
+
+#include <cg3/geometry/point3.h>
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <voro++.hh>
+#pragma GCC diagnostic pop
+#else
+#include <voro++.hh>
+#endif
+
+namespace cg3 {
+namespace voro {
+namespace internal {
+
+/**
+ * @brief Geometry of a cell computed by voro++: vertices, faces as lists of
+ * vertex indices and, for every face, the id of the adjacent cell (negative
+ * numbers are the walls of the container)
+ */
+struct CellGeometry {
+	std::vector<cg3::Point3d> vertices;
+	std::vector<std::vector<uint>> faces;
+	std::vector<int> adjacences;
+};
+
+/**
+ * @brief Position of a particle in the container: block and index in the block
+ */
+struct CellLocation {
+	int ijk;
+	int q;
+};
+
+int blocksPerAxis(uint nSites);
+
+bool isInContainer(const ::voro::container& container, const cg3::Point3d& p);
+cg3::Point3d moveInContainer(const ::voro::container& container, const cg3::Point3d& p);
+
+bool locateParticle(
+		const ::voro::container& container,
+		int id,
+		const cg3::Point3d& p,
+		CellLocation& location);
+
+void computeAllCells(::voro::container& container, std::vector<CellGeometry>& cells);
+
+void computeCells(
+		::voro::container& container,
+		const std::vector<CellLocation>& locations,
+		const std::vector<uint>& ids,
+		std::vector<CellGeometry>& cells);
+
+} //namespace cg3::voro::internal
+} //namespace cg3::voro
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_VORO_CELLS_CPP "voro_cells.cpp"
+#include CG3_VORO_CELLS_CPP
+#undef CG3_VORO_CELLS_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_VORO_CELLS_H
@@ -0,0 +1,259 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "lloyd_relaxation3.h"
+
+#include <cg3/utilities/timer.h>
+
+#include <cmath>
+#include <iostream>
+
+namespace cg3 {
+namespace voro {
+
+/**
+ * @brief Creates the Lloyd relaxation of the given sites in the given box.
+ * Sites must be inside the box. Since voro++ does not accept sites on the max
+ * faces of the box, these sites are moved inside by the smallest amount
+ * (e.g. in the box [0,1]^3, the x of the site (1, 0.5, 0.5) becomes the
+ * largest double less than 1): sites() returns the moved sites.
+ * @param bb
+ * @param sites
+ */
+CG3_INLINE LloydRelaxation3::LloydRelaxation3(
+        const BoundingBox3& bb,
+        const std::vector<Point3d>& sites) :
+    bb(bb),
+    container(bb.minX(), bb.maxX(),
+              bb.minY(), bb.maxY(),
+              bb.minZ(), bb.maxZ(),
+              internal::blocksPerAxis(sites.size()),
+              internal::blocksPerAxis(sites.size()),
+              internal::blocksPerAxis(sites.size()),
+              false, false, false, 8),
+    _sites(sites),
+    _masses(sites.size(), 0),
+    hasDensity(false),
+    verbose(false)
+{
+    for (uint i = 0; i < _sites.size(); ++i) {
+        assert(bb.isInside(_sites[i]));
+        _sites[i] = internal::moveInContainer(container, _sites[i]);
+        container.put(i, _sites[i].x(), _sites[i].y(), _sites[i].z());
+    }
+}
+
+/**
+ * @brief Sets the density used to compute the centroids of the cells.
+ * The density is interpolated trilinearly between the vertices of the lattice,
+ * and it is clamped outside the bounding box of the lattice.
+ */
+CG3_INLINE void LloydRelaxation3::setDensity(const RegularLattice3D<double>& density)
+{
+    densityLattice = density;
+    hasDensity = true;
+}
+
+CG3_INLINE void LloydRelaxation3::setUniformDensity()
+{
+    densityLattice = RegularLattice3D<double>();
+    hasDensity = false;
+}
+
+/**
+ * @brief If verbose, every iteration prints its time and the maximum
+ * displacement of the sites on the standard output
+ */
+CG3_INLINE void LloydRelaxation3::setVerbose(bool verbose)
+{
+    this->verbose = verbose;
+}
+
+/**
+ * @brief Moves every site to the centroid of its cell.
+ * @return the maximum displacement of the sites
+ */
+CG3_INLINE double LloydRelaxation3::iterate()
+{
+    Timer t("Lloyd iteration");
+    std::vector<Point3d> centroids;
+    computeCentroids(centroids);
+
+    double maxDisplacement = 0;
+    #pragma omp parallel for reduction(max:maxDisplacement)
+    for (long long int i = 0; i < (long long int)_sites.size(); ++i) {
+        maxDisplacement = std::max(maxDisplacement, _sites[i].dist(centroids[i]));
+    }
+    _sites = std::move(centroids);
+
+    //the container keeps its memory: sites are put again in the blocks
+    container.clear();
+    for (uint i = 0; i < _sites.size(); ++i) {
+        _sites[i] = internal::moveInContainer(container, _sites[i]);
+        container.put(i, _sites[i].x(), _sites[i].y(), _sites[i].z());
+    }
+
+    t.stop();
+    times.push_back(t.delay());
+    _displacements.push_back(maxDisplacement);
+    if (verbose) {
+        std::cout << "Lloyd iteration " << times.size() << ": "
+                  << t.delay() << " s, max displacement " << maxDisplacement << std::endl;
+    }
+    return maxDisplacement;
+}
+
+/**
+ * @brief Runs the Lloyd iterations until the maximum displacement of the sites
+ * is less than tolerance times the diagonal of the box, or maxIterations is
+ * reached.
+ * @return the number of executed iterations
+ */
+CG3_INLINE unsigned int LloydRelaxation3::run(unsigned int maxIterations, double tolerance)
+{
+    double threshold = tolerance * bb.diag();
+    for (unsigned int i = 0; i < maxIterations; ++i) {
+        if (iterate() < threshold)
+            return i + 1;
+    }
+    return maxIterations;
+}
+
+CG3_INLINE unsigned int LloydRelaxation3::numSites() const
+{
+    return _sites.size();
+}
+
+CG3_INLINE const std::vector<Point3d>& LloydRelaxation3::sites() const
+{
+    return _sites;
+}
+
+/**
+ * @brief Masses of the cells computed in the last iteration: volumes of the
+ * cells if the density is uniform
+ */
+CG3_INLINE const std::vector<double>& LloydRelaxation3::masses() const
+{
+    return _masses;
+}
+
+CG3_INLINE const std::vector<double>& LloydRelaxation3::displacements() const
+{
+    return _displacements;
+}
+
+CG3_INLINE const std::vector<double>& LloydRelaxation3::iterationTimes() const
+{
+    return times;
+}
+
+/**
+ * @brief Returns the Voronoi Diagram of the current sites, bounded by the
+ * box of the relaxation
+ */
+CG3_INLINE VoronoiDiagram3 LloydRelaxation3::diagram() const
+{
+    VoronoiDiagram3 vd(bb, _sites.size(), false);
+    vd.addSites(_sites);
+    return vd;
+}
+
+CG3_INLINE double LloydRelaxation3::density(const Point3d& p) const
+{
+    const BoundingBox3& lbb = densityLattice.boundingBox();
+    const uint res[3] = {densityLattice.resX(), densityLattice.resY(), densityLattice.resZ()};
+    uint i0[3];
+    double t[3];
+    for (uint a = 0; a < 3; ++a) {
+        double f = (p[a] - lbb.min()[a]) / densityLattice.unit();
+        f = std::min((double)res[a] - 1, std::max(0.0, f));
+        i0[a] = std::min(res[a] > 1 ? res[a] - 2 : 0, (uint)f);
+        t[a] = res[a] > 1 ? f - i0[a] : 0;
+    }
+    double d = 0;
+    for (uint c = 0; c < 8; ++c) {
+        uint di = c & 1, dj = (c >> 1) & 1, dk = (c >> 2) & 1;
+        double w = (di ? t[0] : 1 - t[0]) * (dj ? t[1] : 1 - t[1]) * (dk ? t[2] : 1 - t[2]);
+        if (w > 0)
+            d += w * densityLattice.vertexProperty(i0[0] + di, i0[1] + dj, i0[2] + dk);
+    }
+    return d;
+}
+
+/**
+ * @brief Computes the centroid and the mass of every cell, in parallel over
+ * the blocks of the container.
+ *
+ * With uniform density, volume and centroid are given by voro++. Otherwise,
+ * the cell is split in tetrahedra joining its site with the triangles of its
+ * faces, and the density is sampled at the barycenter of every tetrahedron.
+ * Sites whose cell cannot be computed do not move.
+ */
+CG3_INLINE void LloydRelaxation3::computeCentroids(std::vector<Point3d>& centroids)
+{
+    centroids = _sites;
+    _masses.assign(_sites.size(), 0);
+    const int nx = container.nx, nxy = container.nxy;
+    const long long int nBlocks = container.nxyz;
+
+    #pragma omp parallel
+    {
+        ::voro::voro_compute<::voro::container> vc(container, container.nx, container.ny, container.nz);
+        ::voro::voronoicell_neighbor c;
+        std::vector<double> v;
+        std::vector<int> fv;
+
+        #pragma omp for schedule(dynamic, 1)
+        for (long long int b = 0; b < nBlocks; ++b) {
+            int ijk = (int)b;
+            int k = ijk / nxy;
+            int j = (ijk - k * nxy) / nx;
+            int i = ijk - k * nxy - j * nx;
+            for (int q = 0; q < container.co[ijk]; ++q) {
+                if (!vc.compute_cell(c, ijk, q, i, j, k))
+                    continue;
+                int id = container.id[ijk][q];
+                Point3d site(container.p[ijk][3*q], container.p[ijk][3*q+1], container.p[ijk][3*q+2]);
+
+                if (!hasDensity) {
+                    double cx, cy, cz;
+                    c.centroid(cx, cy, cz);
+                    _masses[id] = c.volume();
+                    centroids[id] = site + Point3d(cx, cy, cz);
+                    continue;
+                }
+
+                //vertices are relative to the site
+                c.vertices(v);
+                c.face_vertices(fv);
+                double mass = 0;
+                Point3d centroid;
+                for (uint fi = 0; fi < fv.size(); fi += fv[fi] + 1) {
+                    const double* a = &v[3 * fv[fi+1]];
+                    Point3d pa(a[0], a[1], a[2]);
+                    for (int fj = 2; fj < fv[fi]; ++fj) {
+                        const double* pb = &v[3 * fv[fi+fj]];
+                        const double* pc = &v[3 * fv[fi+fj+1]];
+                        Point3d b(pb[0], pb[1], pb[2]);
+                        Point3d cc(pc[0], pc[1], pc[2]);
+                        double volume = std::abs(pa.dot(b.cross(cc))) / 6;
+                        Point3d tetCentroid = (pa + b + cc) / 4;
+                        double m = volume * density(site + tetCentroid);
+                        mass += m;
+                        centroid += tetCentroid * m;
+                    }
+                }
+                _masses[id] = mass;
+                if (mass > 0)
+                    centroids[id] = site + centroid / mass;
+            }
+        }
+    }
+}
+
+} //namespace cg3::voro
+} //namespace cg3
@@ -0,0 +1,73 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#ifndef CG3_LLOYD_RELAXATION3_H
+#define CG3_LLOYD_RELAXATION3_H
+
+#include "voronoi_diagram3.h"
+#include <cg3/data_structures/lattices/regular_lattice.h>
+
+namespace cg3 {
+namespace voro {
+
+/**
+ * @brief Computes a Centroidal Voronoi Tessellation of a box with the Lloyd
+ * algorithm: at every iteration, every site is moved to the centroid of its
+ * Voronoi cell.
+ *
+ * The voro++ container is created once and reused by all the iterations.
+ * Centroids and volumes are computed directly from the voro++ cells, in
+ * parallel over the blocks of the container. An optional density, sampled on
+ * a RegularLattice3D and trilinearly interpolated, makes the centroids mass
+ * centroids: sites concentrate where the density is high.
+ *
+ * run() stops when the maximum displacement of the sites in an iteration is
+ * less than the given tolerance times the diagonal of the box.
+ */
+class LloydRelaxation3
+{
+public:
+    LloydRelaxation3(const cg3::BoundingBox3& bb, const std::vector<cg3::Point3d>& sites);
+
+    void setDensity(const cg3::RegularLattice3D<double>& density);
+    void setUniformDensity();
+    void setVerbose(bool verbose);
+
+    double iterate();
+    unsigned int run(unsigned int maxIterations, double tolerance = 1e-4);
+
+    unsigned int numSites() const;
+    const std::vector<cg3::Point3d>& sites() const;
+    const std::vector<double>& masses() const;
+    const std::vector<double>& displacements() const;
+    const std::vector<double>& iterationTimes() const;
+    VoronoiDiagram3 diagram() const;
+
+protected:
+    double density(const cg3::Point3d& p) const;
+    void computeCentroids(std::vector<cg3::Point3d>& centroids);
+
+    cg3::BoundingBox3 bb;
+    ::voro::container container;
+    std::vector<cg3::Point3d> _sites;
+    std::vector<double> _masses;
+    bool hasDensity;
+    cg3::RegularLattice3D<double> densityLattice;
+    bool verbose;
+    std::vector<double> _displacements; //max displacement of every iteration
+    std::vector<double> times;          //seconds of every iteration
+};
+
+} //namespace cg3::voro
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_LLOYD_RELAXATION3_CPP "lloyd_relaxation3.cpp"
+#include CG3_LLOYD_RELAXATION3_CPP
+#undef CG3_LLOYD_RELAXATION3_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_LLOYD_RELAXATION3_H
@@ -105,13 +105,27 @@ CG3_INLINE void VoronoiCell3::setAdjacents(const std::vector<int>& adjacences)
     this->adjacences = adjacences;
 }
 
+CG3_INLINE void VoronoiCell3::setAdjacents(std::vector<int>&& adjacences)
+{
+    this->adjacences = std::move(adjacences);
+}
+
 CG3_INLINE void VoronoiCell3::setGeometry(
         const std::vector<Point3d>& coords,
         const std::vector<std::vector<uint> >& faces)
 {
     this->_coords = coords;
     this->faces = faces;
-    bb = BoundingBox3(_coords);
+    bb = BoundingBox3(_coords.begin(), _coords.end());
+}
+
+CG3_INLINE void VoronoiCell3::setGeometry(
+        std::vector<Point3d>&& coords,
+        std::vector<std::vector<uint> >&& faces)
+{
+    this->_coords = std::move(coords);
+    this->faces = std::move(faces);
+    bb = BoundingBox3(_coords.begin(), _coords.end());
 }
 
 } //namespace cg3::voro
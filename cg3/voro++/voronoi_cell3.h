@@ -52,8 +52,11 @@ protected:
     void clearAdjacences();
     void addAdjacent(int adj);
     void setAdjacents(const std::vector<int>& adjacences);
+    void setAdjacents(std::vector<int>&& adjacences);
     void setGeometry(const std::vector<cg3::Point3d>& _coords,
                      const std::vector<std::vector<uint>>& faces);
+    void setGeometry(std::vector<cg3::Point3d>&& _coords,
+                     std::vector<std::vector<uint>>&& faces);
 
     uint _id;
     cg3::Point3d _site;
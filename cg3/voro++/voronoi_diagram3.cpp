@@ -6,8 +6,6 @@
  */
 #include "voronoi_diagram3.h"
 
-#include "internal/voro_parser.h"
-
 namespace cg3 {
 namespace voro {
 
@@ -16,15 +14,19 @@ CG3_INLINE VoronoiDiagram3::VoronoiDiagram3(const VoronoiDiagram3& vd) :
     container(this->bb.minX(), this->bb.maxX(),
               this->bb.minY(), this->bb.maxY(),
               this->bb.minZ(), this->bb.maxZ(),
-              6, 6, 6, false, false, false,
-              vd.nPoints),
+              internal::blocksPerAxis(vd.nPoints), internal::blocksPerAxis(vd.nPoints), internal::blocksPerAxis(vd.nPoints),
+              false, false, false,
+              BLOCK_MEMORY),
     cells(vd.cells),
     mapCells(vd.mapCells),
+    nOutdated(0),
     nPoints(vd.nPoints)
 {
 
     for (uint i = 0; i < cells.size(); ++i){
-        container.put(i, cells[i].site().x(), cells[i].site().y(), cells[i].site().z());
+        bool found = putInContainer(i);
+        assert(found);
+        CG3_SUPPRESS_WARNING(found);
     }
     finalize();
 }
@@ -37,19 +39,69 @@ CG3_INLINE uint VoronoiDiagram3::numSites() const
 CG3_INLINE const VoronoiCell3& VoronoiDiagram3::cell(uint i)
 {
     assert(i < cells.size());
+    updateCell(i);
     return cells[i];
 }
 
 CG3_INLINE const VoronoiCell3 &VoronoiDiagram3::cell(const Point3d &site)
 {
-    assert(mapCells.find(site) != mapCells.end());
-    return cells[mapCells[site]];
+    std::unordered_map<cg3::Point3d, uint>::const_iterator it = mapCells.find(site);
+    assert(it != mapCells.end());
+    return cell(it->second);
 }
 
-CG3_INLINE void VoronoiDiagram3::addSite(const Point3d &p)
+/**
+ * @brief Adds a site to the Voronoi Diagram. Only the cell of the new site
+ * is computed: its neighbour cells are updated when accessed.
+ *
+ * Sites already in the diagram or outside its box are ignored. The box is
+ * half-open, since voro++ does not accept sites on its max faces:
+ *
+ * \code{*.cpp}
+ * cg3::voro::VoronoiDiagram3 vd(cg3::BoundingBox3(cg3::Point3d(0,0,0), cg3::Point3d(1,1,1)), 100, false);
+ * vd.addSite(cg3::Point3d(0, 0.5, 0.5)); //added: on a min face
+ * vd.addSite(cg3::Point3d(1, 0.5, 0.5)); //ignored: on a max face
+ * \endcode
+ *
+ * With the default enlargeBox, the max faces of the given box are inside the
+ * box of the diagram.
+ * @param p
+ * @return true if the site has been added
+ */
+CG3_INLINE bool VoronoiDiagram3::addSite(const Point3d &p)
 {
-    addSite(cells.size(), p);
-    finalize();
+    uint first = cells.size();
+    bool added = addSite(cells.size(), p);
+    updateNewCells(first);
+    return added;
+}
+
+/**
+ * @brief Computes the geometry of all the cells that are outdated after the
+ * insertion of new sites. Called by begin(): call it explicitly before sharing
+ * a const VoronoiDiagram3 between threads.
+ */
+CG3_INLINE void VoronoiDiagram3::updateCells() const
+{
+    if (nOutdated == 0)
+        return;
+
+    std::vector<uint> ids;
+    ids.reserve(nOutdated);
+    for (uint i = 0; i < cells.size(); ++i)
+        if (outdated[i])
+            ids.push_back(i);
+
+    std::vector<internal::CellGeometry> geometries;
+    internal::computeCells(const_cast<::voro::container&>(container), locations, ids, geometries);
+
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)ids.size(); i++) {
+        cells[ids[i]].setGeometry(std::move(geometries[i].vertices), std::move(geometries[i].faces));
+        cells[ids[i]].setAdjacents(std::move(geometries[i].adjacences));
+        outdated[ids[i]] = false;
+    }
+    nOutdated = 0;
 }
 
 CG3_INLINE void VoronoiDiagram3::clear()
@@ -57,6 +109,9 @@ CG3_INLINE void VoronoiDiagram3::clear()
     container.clear();
     cells.clear();
     mapCells.clear();
+    locations.clear();
+    outdated.clear();
+    nOutdated = 0;
 }
 
 CG3_INLINE VoronoiDiagram3& VoronoiDiagram3::operator=(const VoronoiDiagram3& vd)
@@ -66,14 +121,18 @@ CG3_INLINE VoronoiDiagram3& VoronoiDiagram3::operator=(const VoronoiDiagram3& vd
         cells = vd.cells;
         mapCells = vd.mapCells;
         nPoints = vd.nPoints;
+        locations.clear();
         (&container)->~container();
 		new (&container) ::voro::container(this->bb.minX(), this->bb.maxX(),
                                          this->bb.minY(), this->bb.maxY(),
                                          this->bb.minZ(), this->bb.maxZ(),
-                                         6, 6, 6, false, false, false,
-                                         nPoints);
+                                         internal::blocksPerAxis(nPoints), internal::blocksPerAxis(nPoints), internal::blocksPerAxis(nPoints),
+                                         false, false, false,
+                                         BLOCK_MEMORY);
         for (uint i = 0; i < cells.size(); ++i){
-            container.put(i, cells[i].site().x(), cells[i].site().y(), cells[i].site().z());
+            bool found = putInContainer(i);
+            assert(found);
+            CG3_SUPPRESS_WARNING(found);
         }
         finalize();
     }
@@ -82,6 +141,7 @@ CG3_INLINE VoronoiDiagram3& VoronoiDiagram3::operator=(const VoronoiDiagram3& vd
 
 CG3_INLINE std::vector<VoronoiCell3>::const_iterator VoronoiDiagram3::begin() const
 {
+    updateCells();
     return cells.begin();
 }
 
@@ -92,46 +152,125 @@ CG3_INLINE std::vector<VoronoiCell3>::const_iterator VoronoiDiagram3::end() cons
 
 CG3_INLINE void VoronoiDiagram3::serialize(std::ofstream& binaryFile) const
 {
-    cg3::serializeObjectAttributes("cg3VoronoiDiagram", binaryFile, bb, cells, mapCells, nPoints);
+    updateCells();
+    std::map<cg3::Point3d, uint> sortedMapCells(mapCells.begin(), mapCells.end());
+    cg3::serializeObjectAttributes("cg3VoronoiDiagram", binaryFile, bb, cells, sortedMapCells, nPoints);
 }
 
 CG3_INLINE void VoronoiDiagram3::deserialize(std::ifstream& binaryFile)
 {
-    cg3::deserializeObjectAttributes("cg3VoronoiDiagram", binaryFile, bb, cells, mapCells, nPoints);
+    std::map<cg3::Point3d, uint> sortedMapCells;
+    cg3::deserializeObjectAttributes("cg3VoronoiDiagram", binaryFile, bb, cells, sortedMapCells, nPoints);
+    mapCells = std::unordered_map<cg3::Point3d, uint>(sortedMapCells.begin(), sortedMapCells.end());
+    locations.clear();
     (&container)->~container();
 	new (&container) ::voro::container(this->bb.minX(), this->bb.maxX(),
                                      this->bb.minY(), this->bb.maxY(),
                                      this->bb.minZ(), this->bb.maxZ(),
-                                     6, 6, 6, false, false, false,
-                                     nPoints);
+                                     internal::blocksPerAxis(nPoints), internal::blocksPerAxis(nPoints), internal::blocksPerAxis(nPoints),
+                                     false, false, false,
+                                     BLOCK_MEMORY);
     for (uint i = 0; i < cells.size(); ++i){
-        container.put(i, cells[i].site().x(), cells[i].site().y(), cells[i].site().z());
+        bool found = putInContainer(i);
+        assert(found);
+        CG3_SUPPRESS_WARNING(found);
     }
     finalize();
 }
 
-CG3_INLINE void VoronoiDiagram3::addSite(uint i, const Point3d &site)
+/**
+ * @brief Adds the i-th cell with the given site. If voro++ does not put the
+ * site in the container, the cell is removed and false is returned.
+ */
+CG3_INLINE bool VoronoiDiagram3::addSite(uint i, const Point3d &site)
 {
-    if (bb.isInside(site) && mapCells.find(site) == mapCells.end()) {
-        container.put(i, site.x(), site.y(), site.z());
-        cells.push_back(VoronoiCell3(i, site));
-        mapCells[site] = i;
+    if (!internal::isInContainer(container, site) || mapCells.find(site) != mapCells.end())
+        return false;
+    cells.push_back(VoronoiCell3(i, site));
+    mapCells[site] = i;
+    if (!putInContainer(i)) {
+        cells.pop_back();
+        mapCells.erase(site);
+        locations.resize(i);
+        return false;
     }
+    return true;
 }
 
-CG3_INLINE void VoronoiDiagram3::finalize()
+/**
+ * @brief Puts the site of the i-th cell in the container and stores its location
+ * @return false if voro++ discarded the site
+ */
+CG3_INLINE bool VoronoiDiagram3::putInContainer(uint i)
 {
-    std::vector<std::vector<cg3::Point3d>> vertices = internal::parseAllVertices(container);
-    std::vector<std::vector<std::vector<uint>>> faces = internal::parseAllFaces(container);
-    std::vector<std::vector<int>> adjs = internal::parseAdjacences(container);
+    const Point3d& site = cells[i].site();
+    container.put(i, site.x(), site.y(), site.z());
+    if (locations.size() <= i)
+        locations.resize(i + 1);
+    return internal::locateParticle(container, i, site, locations[i]);
+}
 
-    assert(faces.size() == cells.size());
-    assert(adjs.size() == cells.size());
+/**
+ * @brief Computes the cells of the sites added starting from firstNewCell, and
+ * marks as outdated their neighbours, which are the only cells changed by the
+ * new sites. When many sites are added, all the cells are recomputed.
+ */
+CG3_INLINE void VoronoiDiagram3::updateNewCells(uint firstNewCell)
+{
+    uint nNew = cells.size() - firstNewCell;
+    if (nNew == 0)
+        return;
+    outdated.resize(cells.size(), false);
+    if (nNew > cells.size() / 8) {
+        finalize();
+        return;
+    }
+
+    std::vector<uint> ids(nNew);
+    for (uint i = 0; i < nNew; ++i)
+        ids[i] = firstNewCell + i;
+    std::vector<internal::CellGeometry> geometries;
+    internal::computeCells(container, locations, ids, geometries);
+
+    for (uint i = 0; i < nNew; ++i) {
+        for (int adj : geometries[i].adjacences) {
+            if (adj >= 0 && (uint)adj < firstNewCell && !outdated[adj]) {
+                outdated[adj] = true;
+                nOutdated++;
+            }
+        }
+        cells[ids[i]].setGeometry(std::move(geometries[i].vertices), std::move(geometries[i].faces));
+        cells[ids[i]].setAdjacents(std::move(geometries[i].adjacences));
+    }
+}
+
+/**
+ * @brief Recomputes the geometry of the i-th cell if it is outdated
+ */
+CG3_INLINE void VoronoiDiagram3::updateCell(uint i) const
+{
+    if (!outdated[i])
+        return;
+    std::vector<internal::CellGeometry> geometries;
+    internal::computeCells(const_cast<::voro::container&>(container), locations, std::vector<uint>(1, i), geometries);
+    cells[i].setGeometry(std::move(geometries[0].vertices), std::move(geometries[0].faces));
+    cells[i].setAdjacents(std::move(geometries[0].adjacences));
+    outdated[i] = false;
+    nOutdated--;
+}
+
+CG3_INLINE void VoronoiDiagram3::finalize()
+{
+    std::vector<internal::CellGeometry> geometries(cells.size());
+    internal::computeAllCells(container, geometries);
 
-    for (uint i = 0; i < cells.size(); i++) {
-        cells[i].setGeometry(vertices[i], faces[i]);
-        cells[i].setAdjacents(adjs[i]);
+    #pragma omp parallel for
+    for (long long int i = 0; i < (long long int)cells.size(); i++) {
+        cells[i].setGeometry(std::move(geometries[i].vertices), std::move(geometries[i].faces));
+        cells[i].setAdjacents(std::move(geometries[i].adjacences));
     }
+    outdated.assign(cells.size(), false);
+    nOutdated = 0;
 }
 
 } //namespace cg3::voro
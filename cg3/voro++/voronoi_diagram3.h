@@ -8,22 +8,23 @@
 #define CG3_VORONOI_DIAGRAM3_H
 
 #include <limits>
+#include <unordered_map>
 
 #include "voronoi_cell3.h"
+#include "internal/voro_cells.h"
 #include <cg3/geometry/bounding_box3.h>
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#include <voro++.hh>
-#pragma GCC diagnostic pop
-#else
-#include <voro++.hh>
-#endif
-
 namespace cg3 {
 namespace voro {
 
+/**
+ * @brief A Voronoi Diagram of a set of sites in a box, computed with voro++.
+ *
+ * Sites can be added incrementally: the cell of a new site is computed
+ * immediately, while its neighbour cells (the only ones that change) are
+ * marked as outdated and their geometry is recomputed only when they are
+ * accessed through cell(), begin() or updateCells().
+ */
 class VoronoiDiagram3 : virtual public SerializableObject
 {
 public:
@@ -33,7 +34,7 @@ public:
     static const int MIN_Z = -5, MAX_Z = -6;
 
 	VoronoiDiagram3();
-	VoronoiDiagram3(const BoundingBox3& bb, uint nPoints = 500);
+	VoronoiDiagram3(const BoundingBox3& bb, uint nPoints = 500, bool enlargeBox = true);
     template<class Container>
 	VoronoiDiagram3(const Container& c);
     template<class Iterator>
@@ -44,12 +45,13 @@ public:
 	const VoronoiCell3& cell(uint i);
 	const VoronoiCell3& cell(const cg3::Point3d& site);
 
-    void addSite(const cg3::Point3d& p);
+    bool addSite(const cg3::Point3d& p);
     template<class Container>
     void addSites(const Container& c);
     template<class Iterator>
     void addSites(Iterator begin, Iterator end);
 
+    void updateCells() const;
     void clear();
 
 	VoronoiDiagram3& operator=(const VoronoiDiagram3& vd);
@@ -63,18 +65,25 @@ public:
 
 protected:
     const int DEFAULT_N_POINTS = 1000;
+    static const int BLOCK_MEMORY = 8; //initial number of sites allocated for each block
     static BoundingBox3 bbInitializer(BoundingBox3 bb){
         bb.min() -= cg3::Point3d(1,1,1);
         bb.max() += cg3::Point3d(1,1,1);
         return bb;
     }
 
-    void addSite(uint i, const cg3::Point3d& site);
+    bool addSite(uint i, const cg3::Point3d& site);
+    bool putInContainer(uint i);
+    void updateNewCells(uint firstNewCell);
+    void updateCell(uint i) const;
     virtual void finalize();
     cg3::BoundingBox3 bb;
 	::voro::container container;
-	std::vector<VoronoiCell3> cells;
-    std::map<cg3::Point3d, uint> mapCells;
+	mutable std::vector<VoronoiCell3> cells;
+    std::unordered_map<cg3::Point3d, uint> mapCells;
+    std::vector<internal::CellLocation> locations; //position of the sites in the container
+    mutable std::vector<unsigned char> outdated; //cells whose geometry must be recomputed
+    mutable uint nOutdated;
     uint nPoints;
 };
 
@@ -89,8 +98,10 @@ inline VoronoiDiagram3::VoronoiDiagram3() :
     container(this->bb.minX(), this->bb.maxX(),
               this->bb.minY(), this->bb.maxY(),
               this->bb.minZ(), this->bb.maxZ(),
-              6, 6, 6, false, false, false,
-              DEFAULT_N_POINTS),
+              internal::blocksPerAxis(DEFAULT_N_POINTS), internal::blocksPerAxis(DEFAULT_N_POINTS), internal::blocksPerAxis(DEFAULT_N_POINTS),
+              false, false, false,
+              BLOCK_MEMORY),
+    nOutdated(0),
     nPoints(DEFAULT_N_POINTS)
 {
 }
@@ -100,14 +111,20 @@ inline VoronoiDiagram3::VoronoiDiagram3() :
  * Bounding Box and the given maximum number of sites.
  * @param bb
  * @param nPoints
+ * @param enlargeBox: if true (default), the box of the diagram is bb enlarged
+ * by 1 in every direction; otherwise the walls of the diagram are exactly
+ * the faces of bb, and sites lying on the max faces of bb are not accepted
+ * (see addSite())
  */
-inline VoronoiDiagram3::VoronoiDiagram3(const BoundingBox3& bb, uint nPoints) :
-    bb(bbInitializer(bb)),
+inline VoronoiDiagram3::VoronoiDiagram3(const BoundingBox3& bb, uint nPoints, bool enlargeBox) :
+    bb(enlargeBox ? bbInitializer(bb) : bb),
     container(this->bb.minX(), this->bb.maxX(),
               this->bb.minY(), this->bb.maxY(),
               this->bb.minZ(), this->bb.maxZ(),
-              6, 6, 6, false, false, false,
-              nPoints + 2),
+              internal::blocksPerAxis(nPoints + 2), internal::blocksPerAxis(nPoints + 2), internal::blocksPerAxis(nPoints + 2),
+              false, false, false,
+              BLOCK_MEMORY),
+    nOutdated(0),
     nPoints(nPoints+2)
 {
 }
@@ -122,9 +139,8 @@ template<class Iterator>
 VoronoiDiagram3::VoronoiDiagram3(Iterator begin, Iterator end) :
 	VoronoiDiagram3(BoundingBox3(begin, end), std::distance(begin, end))
 {
-    uint i = 0;
-    for (Iterator it = begin; it != end; ++it, ++i){
-        addSite(i, *it);
+    for (Iterator it = begin; it != end; ++it){
+        addSite(cells.size(), *it);
     }
     finalize();
 }
@@ -138,11 +154,11 @@ void VoronoiDiagram3::addSites(const Container &c)
 template<class Iterator>
 void VoronoiDiagram3::addSites(Iterator begin, Iterator end)
 {
-    uint i = cells.size();
-    for (Iterator it = begin; it != end; ++it, ++i){
-        addSite(i, *it);
+    uint first = cells.size();
+    for (Iterator it = begin; it != end; ++it){
+        addSite(cells.size(), *it);
     }
-    finalize();
+    updateNewCells(first);
 }
 
 } //namespace cg3::voro
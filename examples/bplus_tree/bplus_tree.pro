@@ -0,0 +1,6 @@
+CONFIG += CG3_CORE CG3_DATA_STRUCTURES
+
+include (../../cg3.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,99 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+#include <cg3/cg3lib.h>
+#include <cg3/utilities/timer.h>
+#include <cg3/data_structures/trees/avlleaf.h>
+#include <cg3/data_structures/trees/bplustree.h>
+
+/**
+ * Benchmark of an ordered container: construction, lookups, insertions,
+ * range scans, full iteration and deletions.
+ */
+template <class Tree>
+void benchmark(const std::string& name, const std::vector<long long>& keys, const std::vector<long long>& queries)
+{
+	std::cout << "------ " << name << " ------" << std::endl;
+
+	cg3::Timer t(name + ": construction");
+	Tree tree(keys);
+	t.stopAndPrint();
+
+	t = cg3::Timer(name + ": find");
+	size_t found = 0;
+	for (long long q : queries) {
+		if (tree.find(q) != tree.end())
+			found++;
+	}
+	t.stopAndPrint();
+
+	t = cg3::Timer(name + ": range scans");
+	long long sum = 0;
+	std::vector<typename Tree::iterator> out;
+	for (size_t i = 0; i < queries.size() / 100; i++) {
+		out.clear();
+		tree.rangeQuery(queries[i], queries[i] + (long long) keys.size() / 100, std::back_inserter(out));
+		for (typename Tree::iterator& it : out)
+			sum += *it;
+	}
+	t.stopAndPrint();
+
+	t = cg3::Timer(name + ": full iteration");
+	for (long long v : tree)
+		sum += v;
+	t.stopAndPrint();
+
+	t = cg3::Timer(name + ": insert");
+	for (long long q : queries)
+		tree.insert(q + 1);
+	t.stopAndPrint();
+
+	t = cg3::Timer(name + ": erase");
+	for (long long q : queries)
+		tree.erase(q);
+	t.stopAndPrint();
+
+	std::cout << "(found: " << found << ", checksum: " << sum << ", size: " << tree.size() << ")" << std::endl << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t n = 1000000;
+	if (argc > 1)
+		n = std::strtoul(argv[1], nullptr, 10);
+
+	std::cout << "------ B+ tree benchmark (" << n << " keys) ------" << std::endl << std::endl;
+
+	std::mt19937 rng(0);
+	std::uniform_int_distribution<long long> dist(0, 4 * (long long) n);
+
+	std::vector<long long> keys(n);
+	for (long long& k : keys)
+		k = dist(rng);
+
+	std::vector<long long> queries(n / 10);
+	for (long long& q : queries)
+		q = dist(rng);
+
+	benchmark<cg3::AVLLeaf<long long>>("AVLLeaf", keys, queries);
+	benchmark<cg3::BPlusTree<long long>>("BPlusTree", keys, queries);
+
+	//Bulk loading from sorted input: no sort is needed
+	std::sort(keys.begin(), keys.end());
+	cg3::Timer t("BPlusTree: sorted construction");
+	cg3::BPlusTree<long long> tree;
+	tree.sortedConstruction(keys);
+	t.stopAndPrint();
+
+	return 0;
+}
@@ -0,0 +1,10 @@
+CONFIG += CG3_CORE CG3_DATA_STRUCTURES
+
+include (../../cg3.pri)
+
+unix:!macx{
+    LIBS += -lpthread
+}
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,213 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+
+#include <cg3/cg3lib.h>
+#include <cg3/utilities/timer.h>
+#include <cg3/data_structures/trees/avlleaf.h>
+#include <cg3/data_structures/trees/concurrent_tree.h>
+
+typedef cg3::AVLLeaf<long long> Tree;
+
+static const long long PAIR_OFFSET = 1000000000LL;
+
+/**
+ * Stress test: a writer inserts and erases pairs of keys (k, k + PAIR_OFFSET)
+ * in a single write operation, while the readers check that they never
+ * see half of a pair and that the tree is always sorted.
+ */
+bool stressTest(unsigned int nReaders, unsigned int nWrites)
+{
+	cg3::ConcurrentTree<Tree> tree;
+
+	std::atomic<bool> done(false);
+	std::atomic<long long> errors(0);
+	std::atomic<long long> reads(0);
+
+	std::vector<std::thread> readers;
+	for (unsigned int r = 0; r < nReaders; r++) {
+		readers.push_back(std::thread([&, r]() {
+			std::mt19937 rng(r);
+			std::uniform_int_distribution<long long> dist(0, nWrites);
+			while (!done.load()) {
+				long long k = dist(rng);
+				bool ok = tree.read([&](Tree& t) {
+					bool first = t.find(k) != t.end();
+					bool second = t.find(k + PAIR_OFFSET) != t.end();
+					if (first != second)
+						return false;
+
+					//Full scan: sorted, and as many small keys as big keys
+					long long last = -1;
+					size_t small = 0, big = 0;
+					for (long long v : t) {
+						if (v <= last)
+							return false;
+						last = v;
+						if (v < PAIR_OFFSET)
+							small++;
+						else
+							big++;
+					}
+					return small == big && small + big == t.size();
+				});
+				if (!ok)
+					errors++;
+				reads++;
+			}
+		}));
+	}
+
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<long long> dist(0, nWrites);
+	unsigned int i = 0;
+	for (; i < nWrites || reads.load() < 1000; i++) {
+		long long k = dist(rng);
+		bool erase = (i % 3 == 2);
+		tree.write([&](Tree& t) {
+			if (erase) {
+				t.erase(k);
+				t.erase(k + PAIR_OFFSET);
+			}
+			else {
+				t.insert(k);
+				t.insert(k + PAIR_OFFSET);
+			}
+		});
+	}
+
+	done.store(true);
+	for (std::thread& t : readers)
+		t.join();
+
+	std::cout << "Stress test: " << reads.load() << " reads, " << i << " writes, " <<
+				 errors.load() << " errors" << std::endl << std::endl;
+
+	return errors.load() == 0;
+}
+
+/**
+ * Throughput of the read threads (range queries) while one thread keeps
+ * inserting and erasing keys. Read function is executed with the given
+ * wrapper (ConcurrentTree or a tree guarded by a mutex).
+ */
+template <class ReadFunction, class WriteFunction>
+void throughput(
+		const std::string& name,
+		unsigned int nReaders,
+		double seconds,
+		long long maxKey,
+		ReadFunction readFunction,
+		WriteFunction writeFunction)
+{
+	std::atomic<bool> done(false);
+	std::atomic<long long> reads(0);
+	std::atomic<long long> writes(0);
+
+	std::vector<std::thread> threads;
+	for (unsigned int r = 0; r < nReaders; r++) {
+		threads.push_back(std::thread([&, r]() {
+			std::mt19937 rng(r);
+			std::uniform_int_distribution<long long> dist(0, maxKey);
+			long long count = 0;
+			while (!done.load()) {
+				readFunction(dist(rng));
+				count++;
+			}
+			reads += count;
+		}));
+	}
+	threads.push_back(std::thread([&]() {
+		std::mt19937 rng(9999);
+		std::uniform_int_distribution<long long> dist(0, maxKey);
+		long long count = 0;
+		while (!done.load()) {
+			writeFunction(dist(rng), count % 2 == 1);
+			count++;
+		}
+		writes += count;
+	}));
+
+	cg3::Timer t(name);
+	while (t.delay() < seconds)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	done.store(true);
+	for (std::thread& th : threads)
+		th.join();
+	t.stop();
+
+	std::cout << name << ": " << (long long) (reads.load() / t.delay()) << " reads/s, " <<
+				 (long long) (writes.load() / t.delay()) << " writes/s" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t n = 1000000;
+	unsigned int nReaders = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	if (argc > 1)
+		n = std::strtoul(argv[1], nullptr, 10);
+	if (argc > 2)
+		nReaders = (unsigned int) std::strtoul(argv[2], nullptr, 10);
+
+	std::cout << "------ Concurrent tree (" << n << " keys, " << nReaders << " readers) ------" << std::endl << std::endl;
+
+	if (!stressTest(nReaders, 2000))
+		return 1;
+
+	std::mt19937 rng(0);
+	const long long maxKey = 4 * (long long) n;
+	std::uniform_int_distribution<long long> dist(0, maxKey);
+	std::vector<long long> keys(n);
+	for (long long& k : keys)
+		k = dist(rng);
+
+	const long long rangeSize = maxKey / 10000;
+
+	//Concurrent tree: readers never wait
+	cg3::ConcurrentTree<Tree> concurrentTree{Tree(keys)};
+	throughput("ConcurrentTree", nReaders, 3,  maxKey,
+		[&](long long k) {
+			concurrentTree.read([&](Tree& t) {
+				std::vector<Tree::iterator> out;
+				t.rangeQuery(k, k + rangeSize, std::back_inserter(out));
+				return out.size();
+			});
+		},
+		[&](long long k, bool erase) {
+			if (erase)
+				concurrentTree.erase(k);
+			else
+				concurrentTree.insert(k);
+		});
+
+	//Tree guarded by a mutex
+	Tree lockedTree(keys);
+	std::mutex mutex;
+	throughput("Mutex", nReaders, 3, maxKey,
+		[&](long long k) {
+			std::lock_guard<std::mutex> lock(mutex);
+			std::vector<Tree::iterator> out;
+			lockedTree.rangeQuery(k, k + rangeSize, std::back_inserter(out));
+			return out.size();
+		},
+		[&](long long k, bool erase) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (erase)
+				lockedTree.erase(k);
+			else
+				lockedTree.insert(k);
+		});
+
+	return 0;
+}
@@ -6,7 +6,9 @@ SUBDIRS      += aabb_tree \
                 adding_manager \
                 array \
                 bipartite_graph \
+                bplus_tree \
                 bst_tree \
+                concurrent_tree \
                 convex_hull_2d \
                 convex_hull_3d \
                 dcel_manipulation \
@@ -15,4 +17,10 @@ SUBDIRS      += aabb_tree \
                 libigl_booleans \
                 mesh_picking \
                 range_tree \
-                viewer
+                viewer \
+                voronoi_adaptive_sampling
+
+#offscreen rendering needs EGL, found by viewer.pri only in the same case
+unix:!macx:exists(/usr/include/EGL/egl.h) {
+    SUBDIRS += offscreen_snapshots
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include <cg3/viewer/offscreen_renderer.h>
+#include <cg3/viewer/drawable_objects/drawable_eigenmesh.h>
+
+#include <iostream>
+
+/**
+ * Saves a png snapshot for every mesh given as argument, without opening any
+ * window (it runs also on machines without a display and without a GPU):
+ *
+ * ./offscreen_snapshots [-pov file.cg3pov] mesh1.obj mesh2.ply ...
+ *
+ * A point of view saved from a GLCanvas can be used for all the snapshots.
+ * The next mesh is loaded and the previous snapshot is saved while the
+ * current mesh is rendered.
+ */
+
+int main(int argc, char *argv[])
+{
+	std::vector<std::string> meshes;
+	std::string pov;
+	for (int i = 1; i < argc; i++) {
+		if (std::string(argv[i]) == "-pov" && i + 1 < argc)
+			pov = argv[++i];
+		else
+			meshes.push_back(argv[i]);
+	}
+
+	cg3::viewer::OffscreenRenderer renderer(1024, 768);
+	if (!renderer.isValid()) {
+		std::cerr << "Cannot create an OpenGL context.\n";
+		return 1;
+	}
+	if (!pov.empty() && !renderer.loadPointOfView(pov))
+		std::cerr << "Cannot load " << pov << "\n";
+
+	renderer.renderBatch(
+				(unsigned int) meshes.size(),
+				[&](unsigned int i) {
+					std::unique_ptr<cg3::DrawableEigenMesh> mesh(new cg3::DrawableEigenMesh(meshes[i]));
+					if (mesh->numberVertices() == 0)
+						mesh.reset();
+					return mesh;
+				},
+				[&](unsigned int i, const QImage& image) {
+					std::string filename = meshes[i].substr(0, meshes[i].find_last_of('.')) + ".png";
+					if (image.isNull() || !image.save(QString::fromStdString(filename)))
+						std::cerr << "Cannot render " << meshes[i] << "\n";
+					else
+						std::cout << filename << "\n";
+				});
+
+	return 0;
+}
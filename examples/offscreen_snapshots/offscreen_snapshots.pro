@@ -0,0 +1,9 @@
+CONFIG += CG3_CORE CG3_MESHES CG3_VIEWER
+
+include(../../cg3.pri)
+
+!contains(DEFINES, CG3_EGL_DEFINED){
+    error(The offscreen_snapshots example requires EGL!)
+}
+
+SOURCES +=	main.cpp
@@ -0,0 +1,94 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <algorithm>
+
+#include <cg3/cg3lib.h>
+#include <cg3/utilities/timer.h>
+#include <cg3/voro++/voronoi_diagram3.h>
+
+/**
+ * Benchmark of the adaptive sampling pattern: a few sites are added at every
+ * iteration to a large Voronoi Diagram, and the cells of the new sites and
+ * their neighbours are read. The incremental update of the diagram is
+ * compared with the computation of the whole diagram from scratch.
+ *
+ * Usage: voronoi_adaptive_sampling [nSites] [nIterations] [sitesPerIteration]
+ */
+int main(int argc, char *argv[])
+{
+	unsigned int nSites = argc > 1 ? std::atoi(argv[1]) : 500000;
+	unsigned int nIterations = argc > 2 ? std::atoi(argv[2]) : 100;
+	unsigned int sitesPerIteration = argc > 3 ? std::atoi(argv[3]) : 4;
+
+	std::mt19937 mt(0);
+	std::uniform_real_distribution<> dist(0, 1);
+
+	std::vector<cg3::Point3d> sites;
+	sites.reserve(nSites + nIterations * sitesPerIteration + 2);
+	sites.push_back(cg3::Point3d(0,0,0)); //bounding box of the diagram
+	sites.push_back(cg3::Point3d(1,1,1));
+	for (unsigned int i = 2; i < nSites; i++)
+		sites.push_back(cg3::Point3d(dist(mt), dist(mt), dist(mt)));
+
+	cg3::Timer tBuild("Initial diagram");
+	cg3::voro::VoronoiDiagram3 vd(sites);
+	tBuild.stop();
+	std::cout << "Sites: " << vd.numSites() << "; initial diagram: " << tBuild.delay() << " s\n";
+
+	//at every iteration, new sites are added between the sites of random cells and their vertices
+	cg3::Timer tIncremental("Incremental");
+	unsigned long long int nReadFaces = 0;
+	std::vector<cg3::Point3d> newSites;
+	for (unsigned int it = 0; it < nIterations; it++) {
+		newSites.clear();
+		for (unsigned int s = 0; s < sitesPerIteration; s++) {
+			const cg3::voro::VoronoiCell3& c = vd.cell(mt() % vd.numSites());
+			cg3::Point3d p = c.coords()[mt() % c.coords().size()];
+			newSites.push_back((c.site() + p) / 2);
+		}
+		vd.addSites(newSites);
+		for (const cg3::Point3d& p : newSites) {
+			const cg3::voro::VoronoiCell3& c = vd.cell(p);
+			for (int adj : c)
+				if (adj >= 0)
+					nReadFaces += vd.cell(adj).coords().size();
+		}
+	}
+	tIncremental.stop();
+	std::cout << "Incremental: " << nIterations << " iterations in " << tIncremental.delay()
+			  << " s (" << tIncremental.delay() / nIterations << " s per iteration, "
+			  << nReadFaces << " vertices read)\n";
+
+	//recomputing the diagram at every iteration
+	std::vector<cg3::Point3d> allSites;
+	for (const cg3::voro::VoronoiCell3& c : vd)
+		allSites.push_back(c.site());
+	cg3::Timer tFull("Full");
+	cg3::voro::VoronoiDiagram3 full(allSites);
+	tFull.stop();
+	std::cout << "Full recomputation: " << tFull.delay() << " s per iteration\n";
+
+	//the incremental diagram must have the same cells of the one computed from scratch
+	unsigned int nDifferent = 0;
+	for (unsigned int i = 0; i < vd.numSites(); i++) {
+		const cg3::voro::VoronoiCell3& a = vd.cell(i);
+		const cg3::voro::VoronoiCell3& b = full.cell(a.site());
+		std::vector<int> adjA(a.begin(), a.end()), adjB(b.begin(), b.end());
+		std::sort(adjA.begin(), adjA.end());
+		std::sort(adjB.begin(), adjB.end());
+		if (a.coords().size() != b.coords().size() || adjA != adjB)
+			nDifferent++;
+	}
+	std::cout << "Cells different from the full recomputation: " << nDifferent << "\n";
+
+	return nDifferent == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,5 @@
+CONFIG += CG3_CORE CG3_VORO++
+
+include(../../cg3.pri)
+
+SOURCES += main.cpp